@@ -1,7 +1,9 @@
 #!/usr/bin/env python3
 """
 Script para preparar e fazer upload dos arquivos da pasta data/ para SPIFFS
-do ESP32S3 usando a ferramenta esptool.
+do ESP32S3 usando a ferramenta esptool. O modelo (.tflite) e os pesos
+empacotados (.i8pk) também são gravados nas partições cruas model/packed,
+que o firmware mapeia sem cópia; a cópia na SPIFFS é só o fallback.
 """
 
 import os
@@ -9,6 +11,7 @@ import sys
 import subprocess
 import glob
 import shutil
+import struct
 import time  # Adicionado import time para permitir pausas
 
 # Constantes
@@ -16,7 +19,16 @@ FIRMWARE_DIR = os.path.dirname(os.path.abspath(__file__))
 DATA_DIR = os.path.join(FIRMWARE_DIR, 'data')
 BUILD_DIR = os.path.join(FIRMWARE_DIR, '.pio', 'build', 'seeed_xiao_esp32s3')
 SPIFFS_BIN = os.path.join(BUILD_DIR, 'spiffs.bin')
-SPIFFS_SIZE = 0x100000  # 1MB
+SPIFFS_SIZE = 0x2E0000  # partitions_model.csv
+SPIFFS_OFFSET = 0x510000
+
+# Partições cruas do modelo (partitions_model.csv), mapeadas sem cópia pelo
+# ModelFile::openPartition: (arquivo em data/, offset, tamanho)
+MODEL_PARTITIONS = [
+    ('model_int8.tflite', 0x310000, 0x100000),
+    ('model_int8.i8pk', 0x410000, 0x100000),
+]
+MODEL_IMAGE_MAGIC = b'MDLI'  # ModelImageHeader (model_file.h): magic, tamanho, 8 bytes livres
 
 # Constante para a porta serial (macOS)
 SERIAL_PORT = '/dev/cu.usbmodem11401'  # Porta detectada no seu sistema
@@ -54,6 +66,59 @@ def check_files():
 
     return True
 
+def check_model():
+    """Avisa se o modelo carregado pelo firmware (model_file.h) não está em data/"""
+    for name in ('model_int8.tflite', 'model_int8.i8pk'):
+        path = os.path.join(DATA_DIR, name)
+        if os.path.exists(path):
+            print(f"🧠 {name}: {os.path.getsize(path)} bytes")
+        else:
+            print(f"⚠️ {name} ausente em data/. Gere com:")
+            print("   python3 ../model/convert_to_c_array.py ../model/model_int8.tflite "
+                  "-o ../model/model.h --spiffs data")
+
+def build_model_images():
+    """Gera as imagens das partições do modelo: cabeçalho de 16 bytes + arquivo"""
+    os.makedirs(BUILD_DIR, exist_ok=True)
+    images = []
+    for name, offset, size in MODEL_PARTITIONS:
+        path = os.path.join(DATA_DIR, name)
+        if not os.path.exists(path):
+            continue
+        with open(path, 'rb') as f:
+            blob = f.read()
+        if len(blob) + 16 > size:
+            print(f"❌ Erro: {name} ({len(blob)} bytes) não cabe na partição de {size} bytes")
+            return None
+        image = os.path.join(BUILD_DIR, name + '.bin')
+        with open(image, 'wb') as f:
+            f.write(struct.pack('<4sI8x', MODEL_IMAGE_MAGIC, len(blob)))
+            f.write(blob)
+        print(f"🧠 {name} -> partição em 0x{offset:x} ({len(blob)} bytes)")
+        images.append((offset, image))
+    return images
+
+def upload_model_partitions(images):
+    """Grava as imagens do modelo nas partições cruas (lidas por mmap, sem cópia)"""
+    if not images:
+        return True
+    print("📤 Gravando as partições do modelo...")
+    cmd = ['python3', '-m', 'esptool', '--chip', 'esp32s3', '--port', SERIAL_PORT,
+           '--baud', '921600', 'write_flash']
+    for offset, image in images:
+        cmd += [f'0x{offset:x}', image]
+    try:
+        result = subprocess.run(cmd, cwd=FIRMWARE_DIR, capture_output=True, text=True,
+                                timeout=120)
+    except subprocess.TimeoutExpired:
+        print("❌ Timeout ao gravar as partições do modelo")
+        return False
+    if result.returncode != 0:
+        print(f"❌ Erro ao gravar as partições do modelo: {result.stderr}")
+        return False
+    print("✅ Partições do modelo gravadas")
+    return True
+
 def build_spiffs():
     """Constrói a imagem SPIFFS"""
     print("🔧 Construindo imagem SPIFFS...")
@@ -109,7 +174,7 @@ def upload_spiffs():
                 # Este comando é equivalente ao que o PlatformIO executaria
                 result = subprocess.run(
                     ['python3', '-m', 'esptool', '--chip', 'esp32s3', '--port', SERIAL_PORT,
-                     '--baud', '921600', 'write_flash', '0x310000', SPIFFS_BIN],
+                     '--baud', '921600', 'write_flash', f'0x{SPIFFS_OFFSET:x}', SPIFFS_BIN],
                     cwd=FIRMWARE_DIR,
                     capture_output=True,
                     text=True,
@@ -148,7 +213,7 @@ def upload_spiffs():
     print("2. Pressione o botão de reset no ESP32S3")
     print("3. Feche qualquer programa que possa estar usando a porta serial")
     print("4. Reinicie seu computador")
-    print(f"5. Tente executar manualmente: pio run --target uploadfs ou esptool.py --chip esp32s3 --port {SERIAL_PORT} write_flash 0x310000 {SPIFFS_BIN}")
+    print(f"5. Tente executar manualmente: pio run --target uploadfs ou esptool.py --chip esp32s3 --port {SERIAL_PORT} write_flash 0x{SPIFFS_OFFSET:x} {SPIFFS_BIN}")
 
     return False
 
@@ -165,6 +230,12 @@ def main():
     # Verifica os arquivos
     if not check_files():
         sys.exit(1)
+    check_model()
+
+    # Imagens das partições do modelo (o caminho sem cópia do firmware)
+    images = build_model_images()
+    if images is None:
+        sys.exit(1)
 
     # Constrói a imagem SPIFFS
     if not build_spiffs():
@@ -173,6 +244,8 @@ def main():
     # Faz o upload
     if not upload_spiffs():
         sys.exit(1)
+    if not upload_model_partitions(images):
+        sys.exit(1)
 
     print("\n🎉 Processo concluído com sucesso!")
     print("Agora você pode acessar a interface web conectando ao WiFi 'ESP32S3_HP_Detector'")
@@ -0,0 +1,70 @@
+#!/bin/bash
+# SPRINT 3 - Build Host do Motor INT8
+# ===================================
+#
+# Compila o motor de inferência (lib/int8_engine) e as ferramentas
+# de medição para rodar no PC, sem ESP32 nem PlatformIO.
+#
+# Uso:
+#   ./build_host.sh            # compila tudo em ./build
+#   ./build_host.sh clean      # remove ./build
+
+set -e
+
+HOST_DIR="$(cd "$(dirname "$0")" && pwd)"
+FIRMWARE_DIR="$(dirname "$HOST_DIR")"
+ENGINE_DIR="$FIRMWARE_DIR/lib/int8_engine"
+VISION_DIR="$FIRMWARE_DIR/lib/vision"
+# tjpgd vem do esp32-camera baixado pelo 'pio run' do env padrão (camera_test);
+# TJPGD_DIR=<.../esp32-camera/target> aponta para outra cópia
+TJPGD_DIR="${TJPGD_DIR:-$FIRMWARE_DIR/.pio/libdeps/camera_test/esp32-camera/target}"
+BUILD_DIR="$HOST_DIR/build"
+
+CXX="${CXX:-g++}"
+CC="${CC:-gcc}"
+CXXFLAGS="${CXXFLAGS:--O2 -std=c++14 -Wall}"
+CFLAGS="${CFLAGS:--O2 -w}"
+INCLUDES="-I$ENGINE_DIR -I$VISION_DIR -I$HOST_DIR -I$FIRMWARE_DIR/src -I$TJPGD_DIR/jpeg_include"
+
+# Ferramentas (cada uma é <nome>.cpp neste diretório)
+TOOLS="host_infer host_plan host_fusion host_compiled host_packed host_gemv host_gate host_profile host_patch host_loader host_requant host_backends host_first_layer host_winograd host_int4 host_sparse host_preprocess host_jpeg_scaled host_jpeg_stream host_jpeg_luma host_buffer_pool host_image_stats host_yuv422 host_capture_pipeline host_shared_frame"
+
+if [ "$1" == "clean" ]; then
+    rm -rf "$BUILD_DIR"
+    echo "🧹 Build host removido"
+    exit 0
+fi
+
+if [ ! -f "$TJPGD_DIR/tjpgd.c" ]; then
+    echo "❌ ERRO: tjpgd.c não encontrado em $TJPGD_DIR"
+    echo "Execute 'pio pkg install -e camera_test' (ou 'pio run') para baixar o esp32-camera,"
+    echo "ou defina TJPGD_DIR=<caminho>/esp32-camera/target"
+    exit 1
+fi
+
+mkdir -p "$BUILD_DIR/obj"
+
+echo "🔨 Compilando motor INT8 para o host..."
+OBJS=""
+for src in "$ENGINE_DIR"/*.cpp "$VISION_DIR"/*.cpp "$HOST_DIR/host_common.cpp"; do
+    obj="$BUILD_DIR/obj/$(basename "${src%.cpp}").o"
+    $CXX $CXXFLAGS $INCLUDES -c "$src" -o "$obj"
+    OBJS="$OBJS $obj"
+done
+$CC $CFLAGS -I"$TJPGD_DIR/jpeg_include" -c "$TJPGD_DIR/tjpgd.c" -o "$BUILD_DIR/obj/tjpgd.o"
+OBJS="$OBJS $BUILD_DIR/obj/tjpgd.o"
+for src in "$VISION_DIR"/*.c; do
+    obj="$BUILD_DIR/obj/$(basename "${src%.c}").o"
+    $CC $CFLAGS -I"$VISION_DIR" -c "$src" -o "$obj"
+    OBJS="$OBJS $obj"
+done
+
+for tool in $TOOLS; do
+    echo "🔗 $tool"
+    $CXX $CXXFLAGS $INCLUDES "$HOST_DIR/$tool.cpp" $OBJS -o "$BUILD_DIR/$tool" -lm -pthread
+done
+
+echo "✅ Build host concluído em $BUILD_DIR"
+echo ""
+echo "📊 Para medir a latência no dataset representativo:"
+echo "  cd $HOST_DIR && ./build/host_infer"
@@ -0,0 +1,321 @@
+/*
+ * SPRINT 3 - Teste Diferencial e Benchmark dos Backends de Kernels
+ * ================================================================
+ *
+ * 1) Kernels isolados: para cada backend disponível (kernel_backend.h),
+ *    compara Conv2D, Conv2D+MaxPool e FullyConnected com o backend
+ *    escalar em formas aleatórias, incluindo padding (o g_model só usa
+ *    VALID, então as bordas não seriam exercitadas pelo modelo).
+ * 2) Modelo: Int8Engine::compareKernelBackends camada a camada no
+ *    g_model, com e sem patches, em entradas pseudoaleatórias e nas
+ *    imagens do dataset representativo.
+ * 3) Tabela de MACs/ciclo por camada e backend com o LayerProfiler
+ *    (no host os "ciclos" são nanossegundos).
+ *
+ * Qualquer divergência de um bit faz a ferramenta sair com código 1.
+ *
+ * Uso:
+ *     ./build/host_backends [dados]
+ *
+ * Autor: Equipe SPRINT 3
+ * Data: 2025
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <vector>
+
+#include "host_common.h"
+#include "int8_engine.h"
+#include "model.h"
+
+static const size_t kHostArenaSize = 1024 * 1024;
+static const size_t kCompareScratch = 256 * 1024;
+static const int kRandomShapes = 300;
+static const int kRandomInputs = 8;
+static const int kPatchLayers = 3;
+static const int kPatchGrid = 4;
+static const int kPasses = 5;
+
+static uint32_t g_seed = 0x2025;
+
+static uint32_t nextRandom() {
+  g_seed = g_seed * 1664525u + 1013904223u;
+  return g_seed >> 8;
+}
+
+static int randomInt(int lo, int hi) { return lo + (int)(nextRandom() % (uint32_t)(hi - lo + 1)); }
+
+static void fillRandom(int8_t* data, size_t size) {
+  for (size_t i = 0; i < size; ++i) data[i] = (int8_t)nextRandom();
+}
+
+// =============================================================================
+// KERNELS ISOLADOS
+// =============================================================================
+
+struct RandomRequant {
+  std::vector<int32_t> multiplier;
+  std::vector<int32_t> shift;
+  RequantParams rq;
+};
+
+static void randomRequant(int channels, RandomRequant* r) {
+  r->multiplier.resize(channels);
+  r->shift.resize(channels);
+  for (int c = 0; c < channels; ++c) {
+    quantizeMultiplier(0.0005 + (nextRandom() % 1000) * 0.00002, &r->multiplier[c], &r->shift[c]);
+  }
+  r->rq.multiplier = r->multiplier.data();
+  r->rq.shift = r->shift.data();
+  r->rq.output_offset = randomInt(-20, 20);
+  r->rq.act_min = nextRandom() & 1 ? -128 : randomInt(-128, 0);
+  r->rq.act_max = 127;
+}
+
+static ConvShape randomConv() {
+  static const int kChannels[] = { 1, 3, 8, 16, 24, 32, 64 };
+  ConvShape s;
+  s.in_c = kChannels[randomInt(0, 6)];
+  s.out_c = kChannels[randomInt(0, 6)];
+  s.k_h = randomInt(1, 5);
+  s.k_w = randomInt(1, 5);
+  s.stride_h = randomInt(1, 2);
+  s.stride_w = randomInt(1, 2);
+  s.in_h = randomInt(s.k_h, 14);
+  s.in_w = randomInt(s.k_w, 14);
+  const bool same = nextRandom() & 1;
+  if (same) {
+    s.out_h = (s.in_h + s.stride_h - 1) / s.stride_h;
+    s.out_w = (s.in_w + s.stride_w - 1) / s.stride_w;
+    const int pad_h = (s.out_h - 1) * s.stride_h + s.k_h - s.in_h;
+    const int pad_w = (s.out_w - 1) * s.stride_w + s.k_w - s.in_w;
+    s.pad_h = pad_h > 0 ? pad_h / 2 : 0;
+    s.pad_w = pad_w > 0 ? pad_w / 2 : 0;
+  } else {
+    s.out_h = (s.in_h - s.k_h) / s.stride_h + 1;
+    s.out_w = (s.in_w - s.k_w) / s.stride_w + 1;
+    s.pad_h = s.pad_w = 0;
+  }
+  return s;
+}
+
+// Soma dos pesos de cada canal de saída, como Int8Engine::begin() pré-calcula
+static std::vector<int32_t> channelSums(const std::vector<int8_t>& filter, int channels) {
+  std::vector<int32_t> sums(channels, 0);
+  const size_t per_channel = filter.size() / channels;
+  for (size_t i = 0; i < filter.size(); ++i) sums[i / per_channel] += filter[i];
+  return sums;
+}
+
+// Retorna o número de casos divergentes do backend contra o escalar; cada
+// kernel roda sem e com as somas de pesos pré-calculadas
+static int checkKernels(const KernelBackend* backend) {
+  const KernelBackend* ref = scalarKernelBackend();
+  int failures = 0;
+  for (int t = 0; t < kRandomShapes; ++t) {
+    const ConvShape s = randomConv();
+    std::vector<int8_t> input((size_t)s.in_h * s.in_w * s.in_c);
+    std::vector<int8_t> filter((size_t)s.out_c * s.k_h * s.k_w * s.in_c);
+    std::vector<int32_t> bias(s.out_c);
+    fillRandom(input.data(), input.size());
+    fillRandom(filter.data(), filter.size());
+    for (int32_t& b : bias) b = randomInt(-4000, 4000);
+    const int32_t input_offset = randomInt(-127, 128);
+    RandomRequant r;
+    randomRequant(s.out_c, &r);
+
+    std::vector<int8_t> expected((size_t)s.out_h * s.out_w * s.out_c);
+    std::vector<int8_t> got(expected.size());
+    std::vector<int32_t> sums = channelSums(filter, s.out_c);
+    std::vector<int8_t> got_sums(expected.size());
+    ref->conv2d(s, input.data(), input_offset, filter.data(), bias.data(), nullptr, r.rq,
+                expected.data());
+    backend->conv2d(s, input.data(), input_offset, filter.data(), bias.data(), nullptr, r.rq,
+                    got.data());
+    backend->conv2d(s, input.data(), input_offset, filter.data(), bias.data(), sums.data(), r.rq,
+                    got_sums.data());
+    if (expected != got || expected != got_sums) {
+      ++failures;
+      printf("   ❌ conv2d %dx%dx%d k%dx%d s%d p%d/%d -> %d\n", s.in_h, s.in_w, s.in_c, s.k_h,
+             s.k_w, s.stride_h, s.pad_h, s.pad_w, s.out_c);
+    }
+
+    ConvShape pool = ConvShape();
+    pool.in_h = s.out_h;
+    pool.in_w = s.out_w;
+    pool.in_c = pool.out_c = s.out_c;
+    pool.k_h = pool.k_w = 2;
+    pool.stride_h = pool.stride_w = 2;
+    pool.out_h = s.out_h / 2 > 0 ? s.out_h / 2 : 1;
+    pool.out_w = s.out_w / 2 > 0 ? s.out_w / 2 : 1;
+    expected.assign((size_t)pool.out_h * pool.out_w * s.out_c, 0);
+    got.assign(expected.size(), 0);
+    got_sums.assign(expected.size(), 0);
+    ref->conv2dMaxPool(s, pool, input.data(), input_offset, filter.data(), bias.data(), nullptr,
+                       r.rq, expected.data());
+    backend->conv2dMaxPool(s, pool, input.data(), input_offset, filter.data(), bias.data(),
+                           nullptr, r.rq, got.data());
+    backend->conv2dMaxPool(s, pool, input.data(), input_offset, filter.data(), bias.data(),
+                           sums.data(), r.rq, got_sums.data());
+    if (expected != got || expected != got_sums) {
+      ++failures;
+      printf("   ❌ conv2d+maxpool %dx%dx%d k%dx%d\n", s.in_h, s.in_w, s.in_c, s.k_h, s.k_w);
+    }
+
+    const int in_features = randomInt(1, 700);
+    const int out_features = randomInt(1, 40);
+    input.resize(in_features);
+    filter.resize((size_t)in_features * out_features);
+    fillRandom(input.data(), input.size());
+    fillRandom(filter.data(), filter.size());
+    bias.resize(out_features);
+    for (int32_t& b : bias) b = randomInt(-4000, 4000);
+    randomRequant(out_features, &r);
+    expected.assign(out_features, 0);
+    got.assign(out_features, 0);
+    got_sums.assign(out_features, 0);
+    sums = channelSums(filter, out_features);
+    ref->fullyConnected(in_features, out_features, input.data(), input_offset, filter.data(),
+                        bias.data(), nullptr, r.rq, expected.data());
+    backend->fullyConnected(in_features, out_features, input.data(), input_offset, filter.data(),
+                            bias.data(), nullptr, r.rq, got.data());
+    backend->fullyConnected(in_features, out_features, input.data(), input_offset, filter.data(),
+                            bias.data(), sums.data(), r.rq, got_sums.data());
+    if (expected != got || expected != got_sums) {
+      ++failures;
+      printf("   ❌ fully_connected %d -> %d\n", in_features, out_features);
+    }
+  }
+  return failures;
+}
+
+// =============================================================================
+// MODELO
+// =============================================================================
+
+struct Frame {
+  std::vector<uint8_t> gray;
+  int width;
+  int height;
+};
+
+static std::vector<Frame> loadFrames(const char* data_dir) {
+  std::vector<Frame> frames;
+  for (const LabeledImage& img : listRepresentativeImages(data_dir)) {
+    size_t len = 0;
+    uint8_t* jpeg = loadFile(img.path.c_str(), &len);
+    Frame frame;
+    if (jpeg && decodeJpegGray(jpeg, len, &frame.gray, &frame.width, &frame.height)) {
+      frames.push_back(std::move(frame));
+    }
+    free(jpeg);
+  }
+  return frames;
+}
+
+// Retorna o número de entradas em que alguma camada divergiu
+static int checkModel(Int8Engine& engine, const KernelBackend* backend,
+                      const std::vector<Frame>& frames, int8_t* scratch) {
+  const int input_size = engine.inputWidth() * engine.inputHeight() * engine.inputChannels();
+  const int cases = kRandomInputs + (int)frames.size();
+  int failures = 0;
+  for (int c = 0; c < cases; ++c) {
+    if (c < kRandomInputs) {
+      fillRandom(engine.input(), input_size);
+    } else {
+      const Frame& f = frames[c - kRandomInputs];
+      engine.setInputFromGray(f.gray.data(), f.width, f.height);
+    }
+    const int layer = engine.compareKernelBackends(scalarKernelBackend(), backend, scratch,
+                                                   kCompareScratch);
+    if (layer != -1) {
+      ++failures;
+      printf("   ❌ entrada %d: %s\n", c, layer == -2 ? engine.errorMessage() : "divergiu");
+      if (layer >= 0) printf("      camada #%d (%s)\n", layer,
+                             LayerProfiler::opName(engine.layer(layer).op));
+    }
+  }
+  return failures;
+}
+
+int main(int argc, char** argv) {
+  const char* data_dir = argc > 1 ? argv[1] : kDefaultDataDir;
+  const int count = kernelBackendCount();
+  printf("🧪 Backends disponíveis:");
+  for (int b = 0; b < count; ++b) printf(" %s", kernelBackend(b)->name);
+  printf(" (melhor: %s)\n\n", bestKernelBackend()->name);
+
+  int failures = 0;
+  printf("1) Kernels isolados (%d formas aleatórias, com padding)\n", kRandomShapes);
+  for (int b = 1; b < count; ++b) {
+    const int f = checkKernels(kernelBackend(b));
+    printf("   %-8s %s\n", kernelBackend(b)->name, f == 0 ? "✅ idêntico ao escalar" : "❌");
+    failures += f;
+  }
+
+  static uint8_t arena[kHostArenaSize];
+  static int8_t scratch[kCompareScratch];
+  static Int8Engine engine;
+  const std::vector<Frame> frames = loadFrames(data_dir);
+  printf("\n2) g_model camada a camada (%d aleatórias + %zu imagens)\n", kRandomInputs,
+         frames.size());
+  for (int patches = 0; patches <= 1; ++patches) {
+    engine.setPatchInference(patches ? kPatchLayers : 0, kPatchGrid);
+    if (!engine.begin(g_model, g_model_len, arena, sizeof(arena))) {
+      fprintf(stderr, "❌ Falha ao carregar modelo: %s\n", engine.errorMessage());
+      return 1;
+    }
+    for (int b = 1; b < count; ++b) {
+      const int f = checkModel(engine, kernelBackend(b), frames, scratch);
+      printf("   %-8s %-12s %s\n", kernelBackend(b)->name, patches ? "patches 4x4" : "inteiro",
+             f == 0 ? "✅ idêntico ao escalar" : "❌");
+      failures += f;
+    }
+  }
+
+  // Benchmark sem patches, para comparar os kernels sobre os mapas inteiros
+  printf("\n3) MACs/ciclo por camada (sem patches, %d passadas)\n\n", kPasses);
+  engine.setPatchInference(0, 0);
+  static LayerProfiler profilers[4];
+  for (int b = 0; b < count; ++b) {
+    engine.setKernelBackend(kernelBackend(b));
+    engine.setProfiler(&profilers[b]);
+    if (!engine.begin(g_model, g_model_len, arena, sizeof(arena))) return 1;
+    for (int pass = 0; pass <= kPasses; ++pass) {
+      if (pass == 1) profilers[b].reset();
+      for (const Frame& f : frames) {
+        engine.setInputFromGray(f.gray.data(), f.width, f.height);
+        if (!engine.invoke()) {
+          fprintf(stderr, "❌ Falha na inferência: %s\n", engine.errorMessage());
+          return 1;
+        }
+      }
+    }
+  }
+  printf("%-3s %-16s %10s", "#", "operador", "MACs");
+  for (int b = 0; b < count; ++b) printf(" %10s", kernelBackend(b)->name);
+  printf("  (MAC/ciclo)\n");
+  for (int i = 0; i < profilers[0].layerCount(); ++i) {
+    const LayerProfile& p = profilers[0].layer(i);
+    printf("%-3d %-16s %10u", i, LayerProfiler::opName(p.op), p.macs);
+    for (int b = 0; b < count; ++b) printf(" %10.3f", profilers[b].macsPerCycle(i));
+    printf("\n");
+  }
+  printf("%-3s %-16s %10u", "", "total (ms)", profilers[0].totalMacs());
+  for (int b = 0; b < count; ++b) printf(" %10.2f", profilers[b].meanInferenceUs() / 1000.0f);
+  printf("\n");
+  for (int b = 1; b < count; ++b) {
+    printf("⚡ %s: %.2fx sobre o escalar\n", kernelBackend(b)->name,
+           profilers[0].meanInferenceUs() / profilers[b].meanInferenceUs());
+  }
+
+  if (failures) {
+    printf("\n❌ %d divergência(s) em relação ao backend escalar\n", failures);
+    return 1;
+  }
+  printf("\n✅ Todos os backends reproduzem o escalar bit a bit\n");
+  return 0;
+}
@@ -0,0 +1,165 @@
+/*
+ * SPRINT 3 - Benchmark do Pool de Buffers em Streaming Contínuo
+ * =============================================================
+ *
+ * Roda o caminho por frame do firmware (jpegScaledDecodeLuma na escala
+ * do jpegScaleFor + InputAreaStream, ou a luminância reduzida quando o
+ * frame não cabe no stream) sobre as fotos da Sprint 1 (ou o dataset
+ * representativo) em sequência, como um streaming contínuo, com os
+ * buffers por frame vindos:
+ *
+ *   - do heap: malloc/free a cada frame;
+ *   - do BufferPool com a mesma reserva do boot do main_real_advanced.
+ *
+ * Reporta us/frame, chamadas ao alocador por frame, hits/misses do pool
+ * e o heap em uso (mallinfo2) no primeiro e no último frame: com o
+ * pool, tudo é hit depois do boot e o heap não se move.
+ *
+ * Uso:
+ *     ./build/host_buffer_pool [dataset_sprint1] [dados_representativos]
+ *
+ * Autor: Equipe SPRINT 3
+ * Data: 2025
+ */
+
+#include <malloc.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "buffer_pool.h"
+#include "feature_gate.h"
+#include "host_common.h"
+#include "input_preprocess.h"
+#include "int8_engine.h"
+#include "jpeg_scaled.h"
+#include "model.h"
+
+static const size_t kHostArenaSize = 1024 * 1024;
+static const int kStreamFrames = 500;
+// Mesma reserva do main_real_advanced (luminância de um frame IMG_W x IMG_H)
+static const size_t kFrameLumaSize = 320 * 240;
+
+struct Photo {
+  std::vector<uint8_t> jpeg;
+  int width, height;
+};
+
+// Buffers do frame: do heap (pool == nullptr) ou emprestados do pool
+struct FrameBuffers {
+  BufferPool* pool;
+  int allocations;
+
+  void* get(size_t size, PoolMemory memory) {
+    if (size == 0) return nullptr;
+    if (pool) return pool->borrow(size, memory);
+    ++allocations;
+    return malloc(size);
+  }
+  void put(void* data) {
+    if (pool) pool->release(data);
+    else free(data);
+  }
+};
+
+// Um frame do firmware: características + tensor de entrada
+static bool processFrame(Int8Engine& engine, const Photo& p, FrameBuffers* buffers,
+                         float* features) {
+  const int scale = jpegScaleFor(p.width, p.height, engine.inputWidth(), engine.inputHeight());
+  const int w = p.width >> scale, h = p.height >> scale;
+  uint8_t* work = (uint8_t*)buffers->get(kJpegLumaWorkSize, kPoolInternal);
+  InputAreaStream* stream =
+      (InputAreaStream*)buffers->get(sizeof(InputAreaStream), kPoolInternal);
+  const bool use_stream = stream && engine.beginInputStream(stream, w, h);
+  const size_t luma_size = use_stream ? 0 : (size_t)w * h;
+  uint8_t* luma = (uint8_t*)buffers->get(luma_size, kPoolPsram);
+
+  JpegScaledSink sink;
+  jpegScaledBegin(&sink, p.jpeg.data(), luma, luma_size);
+  sink.stream = use_stream ? stream : nullptr;
+  sink.work = work;
+  sink.work_size = kJpegLumaWorkSize;
+  bool ok = work && jpegScaledDecodeLuma(&sink, p.jpeg.size(), scale);
+  if (ok) {
+    imageStatsFeatures(sink.stats, p.jpeg.size(), p.width, p.height, features);
+    ok = use_stream ? inputAreaStreamDone(*stream)
+                    : luma && engine.setInputFromGray(luma, sink.width, sink.height);
+  }
+  buffers->put(luma);
+  buffers->put(stream);
+  buffers->put(work);
+  return ok;
+}
+
+int main(int argc, char** argv) {
+  const char* sprint1_dir = argc > 1 ? argv[1] : kSprint1DataDir;
+  const char* data_dir = argc > 2 ? argv[2] : kDefaultDataDir;
+  static uint8_t arena[kHostArenaSize];
+  static Int8Engine engine;
+  if (!engine.begin(g_model, g_model_len, arena, sizeof(arena))) {
+    fprintf(stderr, "❌ Falha ao carregar modelo: %s\n", engine.errorMessage());
+    return 1;
+  }
+
+  std::vector<LabeledImage> images = listSprint1Images(sprint1_dir);
+  if (images.empty()) images = listRepresentativeImages(data_dir);
+  std::vector<Photo> photos;
+  for (const LabeledImage& img : images) {
+    size_t len = 0;
+    uint8_t* jpeg = loadFile(img.path.c_str(), &len);
+    if (!jpeg) continue;
+    Photo p;
+    p.jpeg.assign(jpeg, jpeg + len);
+    free(jpeg);
+    std::vector<uint8_t> rgb;
+    if (!decodeJpegRgb(p.jpeg.data(), len, &rgb, &p.width, &p.height)) continue;
+    photos.push_back(std::move(p));
+  }
+  if (photos.empty()) {
+    fprintf(stderr, "❌ Nenhuma imagem em %s nem em %s\n", sprint1_dir, data_dir);
+    return 1;
+  }
+
+  BufferPool pool;
+  if (!pool.reserve(kPoolInternal, kJpegLumaWorkSize, 1) ||
+      !pool.reserve(kPoolInternal, sizeof(InputAreaStream), 1) ||
+      !pool.reserve(kPoolPsram, kFrameLumaSize, 1)) {
+    fprintf(stderr, "❌ Falha ao reservar o pool\n");
+    return 1;
+  }
+  printf("🎞️  %d frames em streaming (%zu JPEGs em ciclo)\n", kStreamFrames, photos.size());
+  printf("📦 Reserva: %zu B internos + %zu B PSRAM em %d buffers\n\n",
+         pool.reservedBytes(kPoolInternal), pool.reservedBytes(kPoolPsram), pool.slotCount());
+
+  printf("%-16s %10s %12s %10s %10s %16s\n", "buffers", "us/frame", "alocs/frame", "hits",
+         "misses", "Δ heap (bytes)");
+  bool ok = true;
+  for (int use_pool = 0; use_pool < 2; ++use_pool) {
+    FrameBuffers buffers = { use_pool ? &pool : nullptr, 0 };
+    pool.resetStats();
+    size_t heap_first = 0, heap_last = 0;
+    auto t0 = std::chrono::steady_clock::now();
+    for (int f = 0; f < kStreamFrames; ++f) {
+      float features[kGateFeatures];
+      ok = processFrame(engine, photos[f % photos.size()], &buffers, features) && ok;
+      const size_t heap = mallinfo2().uordblks;
+      if (f == 0) heap_first = heap;
+      heap_last = heap;
+    }
+    const double us = elapsedUs(t0) / kStreamFrames;
+    const PoolStats& s = pool.stats();
+    const int allocations = use_pool ? (int)s.misses : buffers.allocations;
+    printf("%-16s %10.1f %12.2f %10u %10u %16ld\n", use_pool ? "BufferPool" : "malloc/free",
+           us, (double)allocations / kStreamFrames, use_pool ? s.hits : 0u,
+           use_pool ? s.misses : 0u, (long)heap_last - (long)heap_first);
+    if (use_pool) {
+      ok = ok && s.in_use == 0;
+      printf("\n📊 Hit rate: %.1f%% | pico emprestado: %u | em uso no fim: %u\n",
+             pool.hitRate() * 100.0f, s.peak_in_use, s.in_use);
+    }
+  }
+  if (!ok) printf("❌ Algum frame falhou\n");
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,324 @@
+/*
+ * SPRINT 3 - Benchmark do Pipeline Captura -> Anel SPSC -> Inferência
+ * ===================================================================
+ *
+ * Reproduz no PC o pipeline do main_real_advanced com std::thread:
+ *
+ *   - fonte de frames em arquivo: cada captura lê um JPEG da Sprint 1
+ *     (ou do dataset representativo) do disco, e o "sensor" roda livre
+ *     como no CAMERA_GRAB_LATEST: um frame novo a cada período, e os
+ *     que ninguém pegou a tempo são perdidos;
+ *   - 2 frame buffers (fb_count = 2): os livres voltam da inferência
+ *     para a captura por um segundo anel, como o esp_camera_fb_return;
+ *   - análise do firmware por frame: jpegScaledDecodeLuma na escala do
+ *     jpegScaleFor + InputAreaStream, características e a CNN INT8.
+ *
+ * Compara o laço serial (captura e análise na mesma tarefa, como o
+ * handleCapture antes do pipeline) com captura e inferência em threads
+ * ligadas pelo SpscRing, com o sensor na metade, igual e no dobro do
+ * tempo de análise. Reporta fps de ponta a ponta, latência da captura
+ * ao resultado e frames perdidos pelo sensor, e confere que a ordem e a
+ * classe de cada frame são as da análise serial. Antes, um teste de
+ * estresse do SpscRing com 2 threads (ordem e soma de 1M itens).
+ *
+ * Uso:
+ *     ./build/host_capture_pipeline [dataset_sprint1] [dados_representativos]
+ *
+ * Autor: Equipe SPRINT 3
+ * Data: 2025
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+#include "feature_gate.h"
+#include "host_common.h"
+#include "image_stats.h"
+#include "input_preprocess.h"
+#include "int8_engine.h"
+#include "jpeg_scaled.h"
+#include "model.h"
+#include "spsc_ring.h"
+
+typedef std::chrono::steady_clock Clock;
+
+static const size_t kHostArenaSize = 1024 * 1024;
+static const int kCameraFbCount = 2;             // Como o main_real_advanced
+static const int kPipelineFrames = 200;
+static const uint32_t kStressItems = 1000000;
+static const double kPeriodFactors[] = { 0.5, 1.0, 2.0 };
+
+// Um JPEG da fonte, com o tamanho que o camera_fb_t traria
+struct SourceFrame {
+  std::string path;
+  int width, height;
+};
+
+struct HostFb {
+  std::vector<uint8_t> buf;
+  size_t len;
+  int width, height;
+  uint32_t seq;                   // Índice do frame do sensor
+  uint32_t source;                // JPEG da fonte (as capturas seguem a lista em ciclo)
+  Clock::time_point captured;
+};
+
+// Câmera simulada sobre arquivos, com o sensor rodando livre (GRAB_LATEST)
+class FileFrameSource {
+ public:
+  FileFrameSource(const std::vector<SourceFrame>& frames, double period_us)
+      : frames_(frames),
+        period_us_(period_us),
+        start_(Clock::now()),
+        next_(0),
+        captures_(0),
+        dropped_(0) {}
+
+  // Espera o próximo frame do sensor e lê o JPEG dele do disco. A cena é o
+  // próximo JPEG da lista a cada captura, não a cada frame do sensor: os
+  // modos analisam a mesma sequência, mesmo perdendo frames diferentes
+  bool capture(HostFb* fb) {
+    const double now_us = elapsedUs(start_);
+    const uint32_t ready = (uint32_t)(now_us / period_us_);   // Último frame pronto
+    uint32_t seq = next_;
+    if (ready > seq) {
+      dropped_ += ready - seq;   // Frames que passaram sem ninguém pegar
+      seq = ready;
+    }
+    const double at_us = (seq + 1) * period_us_;
+    if (at_us > now_us) {
+      std::this_thread::sleep_for(std::chrono::duration<double, std::micro>(at_us - now_us));
+    }
+    next_ = seq + 1;
+
+    fb->source = captures_++ % frames_.size();
+    const SourceFrame& src = frames_[fb->source];
+    FILE* f = fopen(src.path.c_str(), "rb");
+    if (!f) return false;
+    fb->len = fread(fb->buf.data(), 1, fb->buf.size(), f);
+    fclose(f);
+    fb->width = src.width;
+    fb->height = src.height;
+    fb->seq = seq;
+    fb->captured = Clock::now();
+    return fb->len > 0;
+  }
+
+  uint32_t dropped() const { return dropped_; }
+
+ private:
+  const std::vector<SourceFrame>& frames_;
+  double period_us_;
+  Clock::time_point start_;
+  uint32_t next_;
+  uint32_t captures_;
+  uint32_t dropped_;
+};
+
+// Análise por frame do firmware; devolve a classe da CNN (-1 em falha)
+static int analyzeFrame(Int8Engine& engine, const HostFb& fb, std::vector<uint8_t>* luma) {
+  const int width = fb.width, height = fb.height;
+  const int scale = jpegScaleFor(width, height, engine.inputWidth(), engine.inputHeight());
+  static InputAreaStream stream;
+  const bool use_stream = engine.beginInputStream(&stream, width >> scale, height >> scale);
+  JpegScaledSink sink;
+  jpegScaledBegin(&sink, fb.buf.data(), use_stream ? nullptr : luma->data(),
+                  use_stream ? 0 : luma->size());
+  sink.stream = use_stream ? &stream : nullptr;
+  if (!jpegScaledDecodeLuma(&sink, fb.len, scale)) return -1;
+  float features[kGateFeatures];
+  imageStatsFeatures(sink.stats, fb.len, width, height, features);
+  const bool ready = use_stream ? inputAreaStreamDone(stream)
+                                : engine.setInputFromGray(luma->data(), sink.width, sink.height);
+  if (!ready || !engine.invoke()) return -1;
+  return engine.outputValue(0) >= engine.outputValue(1) ? 0 : 1;
+}
+
+struct RunResult {
+  double fps;
+  double latency_ms;
+  uint32_t dropped;
+  bool ok;                        // Ordem crescente e classes da análise serial
+};
+
+static void recordFrame(const HostFb& fb, int cls, const std::vector<int>& expected,
+                        uint32_t* last_seq, double* latency_us, RunResult* r) {
+  *latency_us += elapsedUs(fb.captured);
+  r->ok = r->ok && (int)fb.seq >= (int)*last_seq && cls == expected[fb.source];
+  *last_seq = fb.seq + 1;
+}
+
+// Captura e análise na mesma tarefa
+static RunResult runSerial(Int8Engine& engine, const std::vector<SourceFrame>& frames,
+                           double period_us, const std::vector<int>& expected, size_t max_len,
+                           size_t max_pixels) {
+  RunResult r = { 0.0, 0.0, 0, true };
+  FileFrameSource source(frames, period_us);
+  HostFb fb;
+  fb.buf.resize(max_len);
+  std::vector<uint8_t> luma(max_pixels);
+  uint32_t last_seq = 0;
+  double latency_us = 0.0;
+  const Clock::time_point t0 = Clock::now();
+  for (int f = 0; f < kPipelineFrames; ++f) {
+    r.ok = source.capture(&fb) && r.ok;
+    recordFrame(fb, analyzeFrame(engine, fb, &luma), expected, &last_seq, &latency_us, &r);
+  }
+  r.fps = kPipelineFrames / (elapsedUs(t0) / 1e6);
+  r.latency_ms = latency_us / kPipelineFrames / 1000.0;
+  r.dropped = source.dropped();
+  return r;
+}
+
+// Captura numa thread, inferência em outra, ligadas por dois anéis SPSC
+static RunResult runPipeline(Int8Engine& engine, const std::vector<SourceFrame>& frames,
+                             double period_us, const std::vector<int>& expected,
+                             size_t max_len, size_t max_pixels) {
+  RunResult r = { 0.0, 0.0, 0, true };
+  FileFrameSource source(frames, period_us);
+  HostFb fbs[kCameraFbCount];
+  static SpscRing<HostFb*, kCameraFbCount - 1> frame_ring;   // Captura -> inferência
+  static SpscRing<HostFb*, kCameraFbCount> free_ring;        // fb_return
+  for (HostFb& fb : fbs) {
+    fb.buf.resize(max_len);
+    free_ring.push(&fb);
+  }
+
+  const Clock::time_point t0 = Clock::now();
+  bool capture_ok = true;
+  std::thread capture([&]() {
+    for (int f = 0; f < kPipelineFrames; ++f) {
+      HostFb* fb = nullptr;
+      while (!free_ring.pop(&fb)) std::this_thread::yield();
+      capture_ok = source.capture(fb) && capture_ok;
+      while (!frame_ring.push(fb)) std::this_thread::yield();
+    }
+  });
+  std::thread inference([&]() {
+    std::vector<uint8_t> luma(max_pixels);
+    uint32_t last_seq = 0;
+    double latency_us = 0.0;
+    for (int f = 0; f < kPipelineFrames; ++f) {
+      HostFb* fb = nullptr;
+      while (!frame_ring.pop(&fb)) std::this_thread::yield();
+      recordFrame(*fb, analyzeFrame(engine, *fb, &luma), expected, &last_seq, &latency_us, &r);
+      while (!free_ring.push(fb)) std::this_thread::yield();
+    }
+    r.latency_ms = latency_us / kPipelineFrames / 1000.0;
+  });
+  capture.join();
+  inference.join();
+  r.fps = kPipelineFrames / (elapsedUs(t0) / 1e6);
+  r.dropped = source.dropped();
+  r.ok = r.ok && capture_ok;
+  // Devolve os buffers ao anel livre vazio para a próxima rodada
+  HostFb* fb = nullptr;
+  while (free_ring.pop(&fb)) {
+  }
+  return r;
+}
+
+// Produtor e consumidor em threads: ordem e soma de kStressItems itens
+static bool stressRing(double* mitems_per_s) {
+  static SpscRing<uint32_t, 8> ring;
+  uint64_t sum = 0;
+  bool ordered = true;
+  const Clock::time_point t0 = Clock::now();
+  std::thread producer([&]() {
+    for (uint32_t i = 1; i <= kStressItems; ++i) {
+      while (!ring.push(i)) std::this_thread::yield();
+    }
+  });
+  std::thread consumer([&]() {
+    uint32_t expected = 1, v = 0;
+    while (expected <= kStressItems) {
+      if (!ring.pop(&v)) {
+        std::this_thread::yield();
+        continue;
+      }
+      ordered = ordered && v == expected;
+      sum += v;
+      ++expected;
+    }
+  });
+  producer.join();
+  consumer.join();
+  *mitems_per_s = kStressItems / elapsedUs(t0);
+  return ordered && sum == (uint64_t)kStressItems * (kStressItems + 1) / 2 && ring.empty();
+}
+
+int main(int argc, char** argv) {
+  const char* sprint1_dir = argc > 1 ? argv[1] : kSprint1DataDir;
+  const char* data_dir = argc > 2 ? argv[2] : kDefaultDataDir;
+  static uint8_t arena[kHostArenaSize];
+  static Int8Engine engine;
+  if (!engine.begin(g_model, g_model_len, arena, sizeof(arena))) {
+    fprintf(stderr, "❌ Falha ao carregar modelo: %s\n", engine.errorMessage());
+    return 1;
+  }
+
+  double mitems_per_s = 0.0;
+  const bool ring_ok = stressRing(&mitems_per_s);
+  printf("🔁 SpscRing<8>: %u itens entre 2 threads, %.1f M itens/s %s\n\n", kStressItems,
+         mitems_per_s, ring_ok ? "✅ ordem e soma" : "❌ PERDA/DESORDEM");
+
+  std::vector<LabeledImage> images = listSprint1Images(sprint1_dir);
+  if (images.empty()) images = listRepresentativeImages(data_dir);
+  // Só frames que a análise do firmware aceita; classe serial de referência
+  std::vector<SourceFrame> frames;
+  std::vector<int> expected;
+  size_t max_len = 0, max_pixels = 0;
+  double analysis_us = 0.0;
+  for (const LabeledImage& img : images) {
+    HostFb fb;
+    uint8_t* jpeg = loadFile(img.path.c_str(), &fb.len);
+    if (!jpeg) continue;
+    fb.buf.assign(jpeg, jpeg + fb.len);
+    free(jpeg);
+    std::vector<uint8_t> rgb;
+    if (!decodeJpegRgb(fb.buf.data(), fb.len, &rgb, &fb.width, &fb.height)) continue;
+    std::vector<uint8_t> luma((size_t)fb.width * fb.height);
+    const Clock::time_point t0 = Clock::now();
+    const int cls = analyzeFrame(engine, fb, &luma);
+    if (cls < 0) continue;
+    analysis_us += elapsedUs(t0);
+    frames.push_back({ img.path, fb.width, fb.height });
+    expected.push_back(cls);
+    max_len = std::max(max_len, fb.len);
+    max_pixels = std::max(max_pixels, luma.size());
+  }
+  if (frames.empty()) {
+    fprintf(stderr, "❌ Nenhuma imagem em %s nem em %s\n", sprint1_dir, data_dir);
+    return 1;
+  }
+  analysis_us /= frames.size();
+  printf("🎞️  %zu JPEGs em ciclo, %d frames por rodada, %d frame buffers, análise ~%.1f ms\n\n",
+         frames.size(), kPipelineFrames, kCameraFbCount, analysis_us / 1000.0);
+
+  printf("%-14s %-10s %8s %14s %10s %8s  %s\n", "sensor", "modo", "fps", "latência ms",
+         "perdidos", "ganho", "ordem/classe");
+  bool ok = ring_ok;
+  for (double factor : kPeriodFactors) {
+    const double period_us = analysis_us * factor;
+    double serial_fps = 0.0;
+    for (int pipelined = 0; pipelined < 2; ++pipelined) {
+      const RunResult r =
+          pipelined ? runPipeline(engine, frames, period_us, expected, max_len, max_pixels)
+                    : runSerial(engine, frames, period_us, expected, max_len, max_pixels);
+      if (!pipelined) serial_fps = r.fps;
+      ok = ok && r.ok;
+      char sensor[32];
+      snprintf(sensor, sizeof(sensor), "%.1f ms", period_us / 1000.0);
+      printf("%-14s %-10s %8.1f %14.2f %10u %7.2fx  %s\n", pipelined ? "" : sensor,
+             pipelined ? "pipeline" : "serial", r.fps, r.latency_ms, r.dropped,
+             r.fps / serial_fps, r.ok ? "✅" : "❌");
+    }
+  }
+  printf("\n(sensor: período entre frames; perdidos: frames que o sensor descartou)\n");
+  return ok ? 0 : 1;
+}
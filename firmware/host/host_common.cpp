@@ -0,0 +1,179 @@
+/*
+ * SPRINT 3 - Utilitários do Build Host
+ * ====================================
+ *
+ * Autor: Equipe SPRINT 3
+ * Data: 2025
+ */
+
+#include "host_common.h"
+
+#include <dirent.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+
+#include "tjpgd.h"
+
+uint8_t* loadFile(const char* path, size_t* size) {
+  FILE* f = fopen(path, "rb");
+  if (!f) return nullptr;
+  fseek(f, 0, SEEK_END);
+  long len = ftell(f);
+  fseek(f, 0, SEEK_SET);
+  void* data = nullptr;
+  if (len <= 0 || posix_memalign(&data, 16, (size_t)len) != 0) {
+    fclose(f);
+    return nullptr;
+  }
+  if (fread(data, 1, (size_t)len, f) != (size_t)len) {
+    free(data);
+    fclose(f);
+    return nullptr;
+  }
+  fclose(f);
+  *size = (size_t)len;
+  return (uint8_t*)data;
+}
+
+// =============================================================================
+// DECODIFICAÇÃO JPEG (TJpgDec)
+// =============================================================================
+
+struct JpegSession {
+  const uint8_t* data;
+  size_t len;
+  size_t index;
+  std::vector<uint8_t>* rgb;
+  int width;
+};
+
+static UINT jpegRead(JDEC* jd, BYTE* buf, UINT len) {
+  JpegSession* s = (JpegSession*)jd->device;
+  size_t left = s->len - s->index;
+  if (len > left) len = (UINT)left;
+  if (buf) memcpy(buf, s->data + s->index, len);
+  s->index += len;
+  return len;
+}
+
+static UINT jpegWrite(JDEC* jd, void* bitmap, JRECT* rect) {
+  JpegSession* s = (JpegSession*)jd->device;
+  const uint8_t* src = (const uint8_t*)bitmap;
+  const int w = rect->right - rect->left + 1;
+  for (int y = rect->top; y <= rect->bottom; ++y) {
+    memcpy(&(*s->rgb)[((size_t)y * s->width + rect->left) * 3], src, (size_t)w * 3);
+    src += w * 3;
+  }
+  return 1;
+}
+
+bool decodeJpegRgb(const uint8_t* jpeg, size_t len, std::vector<uint8_t>* rgb,
+                   int* width, int* height) {
+  static uint8_t work[8192];
+  JDEC jd;
+  JpegSession s = { jpeg, len, 0, rgb, 0 };
+  if (jd_prepare(&jd, jpegRead, work, sizeof(work), &s) != JDR_OK) return false;
+  s.width = (int)jd.width;
+  rgb->assign((size_t)jd.width * jd.height * 3, 0);
+  if (jd_decomp(&jd, jpegWrite, 0) != JDR_OK) return false;
+  *width = (int)jd.width;
+  *height = (int)jd.height;
+  return true;
+}
+
+bool decodeJpegGray(const uint8_t* jpeg, size_t len, std::vector<uint8_t>* gray,
+                    int* width, int* height) {
+  std::vector<uint8_t> rgb;
+  if (!decodeJpegRgb(jpeg, len, &rgb, width, height)) return false;
+  const size_t count = (size_t)(*width) * (*height);
+  gray->resize(count);
+  for (size_t i = 0; i < count; ++i) {
+    const uint32_t r = rgb[i * 3], g = rgb[i * 3 + 1], b = rgb[i * 3 + 2];
+    (*gray)[i] = (uint8_t)((r * 19595 + g * 38470 + b * 7471 + 0x8000) >> 16);
+  }
+  return true;
+}
+
+struct ScaledSession {
+  const uint8_t* data;
+  size_t len;
+  size_t index;
+  JpegWriterFn writer;
+  void* arg;
+};
+
+static UINT scaledRead(JDEC* jd, BYTE* buf, UINT len) {
+  ScaledSession* s = (ScaledSession*)jd->device;
+  size_t left = s->len - s->index;
+  if (len > left) len = (UINT)left;
+  if (buf) memcpy(buf, s->data + s->index, len);
+  s->index += len;
+  return len;
+}
+
+static UINT scaledWrite(JDEC* jd, void* bitmap, JRECT* rect) {
+  ScaledSession* s = (ScaledSession*)jd->device;
+  return s->writer(s->arg, rect->left, rect->top, rect->right + 1 - rect->left,
+                   rect->bottom + 1 - rect->top, (uint8_t*)bitmap);
+}
+
+bool decodeJpegScaled(const uint8_t* jpeg, size_t len, int scale, JpegWriterFn writer,
+                      void* arg) {
+  // O esp_jpg_decode usa 3100 bytes (frames da câmera); as fotos da Sprint 1
+  // têm tabelas maiores, então o mesmo buffer do decodeJpegRgb
+  static uint8_t work[8192];
+  JDEC jd;
+  ScaledSession s = { jpeg, len, 0, writer, arg };
+  if (jd_prepare(&jd, scaledRead, work, sizeof(work), &s) != JDR_OK) return false;
+  const uint16_t w = (uint16_t)(jd.width >> scale);
+  const uint16_t h = (uint16_t)(jd.height >> scale);
+  if (!writer(arg, 0, 0, w, h, nullptr)) return false;
+  const JRESULT res = jd_decomp(&jd, scaledWrite, (BYTE)scale);
+  writer(arg, w, h, w, h, nullptr);
+  return res == JDR_OK;
+}
+
+// =============================================================================
+// DATASET REPRESENTATIVO
+// =============================================================================
+
+std::vector<uint8_t> packOcBlocked(const int8_t* weights, int rows, int per_row, int block) {
+  const int blocks = (rows + block - 1) / block;
+  std::vector<uint8_t> out((size_t)blocks * per_row * block, 0);
+  for (int oc = 0; oc < rows; ++oc) {
+    uint8_t* dst = &out[(size_t)(oc / block) * per_row * block + oc % block];
+    const int8_t* src = weights + (size_t)oc * per_row;
+    for (int r = 0; r < per_row; ++r) dst[(size_t)r * block] = (uint8_t)src[r];
+  }
+  return out;
+}
+
+static void listDir(const std::string& dir, int label, std::vector<LabeledImage>* out) {
+  DIR* d = opendir(dir.c_str());
+  if (!d) return;
+  std::vector<std::string> names;
+  while (struct dirent* e = readdir(d)) {
+    const char* ext = strrchr(e->d_name, '.');
+    if (ext && (strcmp(ext, ".jpg") == 0 || strcmp(ext, ".jpeg") == 0)) names.push_back(e->d_name);
+  }
+  closedir(d);
+  std::sort(names.begin(), names.end());
+  for (const std::string& n : names) out->push_back({ dir + "/" + n, label });
+}
+
+std::vector<LabeledImage> listRepresentativeImages(const char* data_dir) {
+  std::vector<LabeledImage> images;
+  listDir(std::string(data_dir) + "/hp_original", 0, &images);
+  listDir(std::string(data_dir) + "/nao_hp", 1, &images);
+  return images;
+}
+
+std::vector<LabeledImage> listSprint1Images(const char* data_dir) {
+  std::vector<LabeledImage> images;
+  listDir(std::string(data_dir) + "/HP_Original", 0, &images);
+  listDir(std::string(data_dir) + "/Outros", 1, &images);
+  return images;
+}
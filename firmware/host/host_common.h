@@ -0,0 +1,64 @@
+/*
+ * SPRINT 3 - Utilitários do Build Host
+ * ====================================
+ *
+ * Funções compartilhadas pelas ferramentas que rodam no PC:
+ * leitura de arquivos, decodificação JPEG com o TJpgDec do
+ * esp32-camera e listagem do dataset representativo.
+ *
+ * Autor: Equipe SPRINT 3
+ * Data: 2025
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include "jpeg_scaled.h"
+
+// Caminhos padrão relativos a firmware/host
+static const char* const kDefaultModelPath = "../../model/model_int8.tflite";
+static const char* const kDefaultDataDir = "../../model/representative_data";
+static const char* const kSprint1DataDir = "../../2025-SPRINT_1/classificador_cartuchos/dataset";
+
+// Imagem do dataset com a classe esperada (0 = HP_ORIGINAL, 1 = NAO_HP)
+struct LabeledImage {
+  std::string path;
+  int label;
+};
+
+// Lê um arquivo inteiro em memória alinhada a 16 bytes (liberar com free)
+uint8_t* loadFile(const char* path, size_t* size);
+
+// Decodifica um JPEG em RGB888 (largura x altura x 3)
+bool decodeJpegRgb(const uint8_t* jpeg, size_t len, std::vector<uint8_t>* rgb,
+                   int* width, int* height);
+
+// Decodifica um JPEG e converte para luminância (fórmula do PIL "L")
+bool decodeJpegGray(const uint8_t* jpeg, size_t len, std::vector<uint8_t>* gray,
+                    int* width, int* height);
+
+// esp_jpg_decode do esp32-camera sobre o TJpgDec: decodifica reduzido por
+// 2^scale (0..3) entregando os blocos RGB888 a writer
+bool decodeJpegScaled(const uint8_t* jpeg, size_t len, int scale, JpegWriterFn writer,
+                      void* arg);
+
+// Pesos [rows][per_row] em blocos de block canais (LAYOUT_OC_BLOCKED de
+// weight_packing.py), canais excedentes zerados
+std::vector<uint8_t> packOcBlocked(const int8_t* weights, int rows, int per_row, int block);
+
+// Lista hp_original/ e nao_hp/ dentro do diretório de dados
+std::vector<LabeledImage> listRepresentativeImages(const char* data_dir);
+
+// Lista HP_Original/ e Outros/ do dataset de fotos da Sprint 1
+std::vector<LabeledImage> listSprint1Images(const char* data_dir);
+
+// Cronômetro em microssegundos
+inline double elapsedUs(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+}
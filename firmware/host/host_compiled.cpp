@@ -0,0 +1,151 @@
+/*
+ * SPRINT 3 - Paridade do Modelo Compilado
+ * =======================================
+ *
+ * Compara o modelo compilado para C++ (src/model_compiled.h, gerado
+ * por model/generate_model_code.py) com o motor interpretado sobre o
+ * mesmo .tflite: a saída deve ser idêntica bit a bit em entradas
+ * pseudoaleatórias e no dataset representativo. Também mede a
+ * latência por frame e por camada dos dois caminhos.
+ *
+ * Uso:
+ *     ./build/host_compiled [modelo.tflite] [representative_data]
+ *
+ * Autor: Equipe SPRINT 3
+ * Data: 2025
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "host_common.h"
+#include "int8_engine.h"
+#include "model_compiled.h"
+
+static const size_t kHostArenaSize = 1024 * 1024;
+static const int kRandomInputs = 50;
+static const int kRepeats = 10;
+
+alignas(16) static uint8_t engine_arena[kHostArenaSize];
+alignas(16) static int8_t compiled_arena[compiled_model::kArenaSize];
+
+static Int8Engine engine;
+static int8_t compiled_lut[256];
+
+// Executa os dois caminhos sobre a entrada atual do motor; true se iguais
+static bool compareCurrentInput(double* engine_us, double* compiled_us) {
+  const int input_size = engine.inputWidth() * engine.inputHeight() * engine.inputChannels();
+  memcpy(compiled_model::input(compiled_arena), engine.input(), input_size);
+  for (int r = 0; r < kRepeats; ++r) {
+    auto t0 = std::chrono::steady_clock::now();
+    engine.invoke();
+    *engine_us = std::min(*engine_us, elapsedUs(t0));
+    t0 = std::chrono::steady_clock::now();
+    compiled_model::invoke(compiled_arena);
+    *compiled_us = std::min(*compiled_us, elapsedUs(t0));
+  }
+  return memcmp(engine.output(), compiled_model::output(compiled_arena),
+                compiled_model::kOutputSize) == 0;
+}
+
+int main(int argc, char** argv) {
+  const char* model_path = argc > 1 ? argv[1] : kDefaultModelPath;
+  const char* data_dir = argc > 2 ? argv[2] : kDefaultDataDir;
+
+  size_t model_size = 0;
+  uint8_t* model = loadFile(model_path, &model_size);
+  if (!model || !engine.begin(model, model_size, engine_arena, sizeof(engine_arena))) {
+    fprintf(stderr, "❌ Falha ao carregar %s: %s\n", model_path, engine.errorMessage());
+    return 1;
+  }
+  if (engine.layerCount() != compiled_model::kLayerCount ||
+      engine.outputSize() != compiled_model::kOutputSize) {
+    fprintf(stderr, "❌ model_compiled.h não corresponde a %s (gere novamente)\n", model_path);
+    return 1;
+  }
+  compiled::buildInputLut(compiled_model::kInputScale, compiled_model::kInputZeroPoint,
+                          compiled_lut);
+
+  printf("🧠 Modelo: %s\n", model_path);
+  printf("📐 Arena: motor %zu bytes | compilado %zu bytes\n\n", engine.arenaUsed(),
+         (size_t)compiled_model::kArenaSize);
+
+  int mismatches = 0;
+  int checked = 0;
+  std::vector<double> engine_lat, compiled_lat;
+
+  // Entradas pseudoaleatórias cobrindo toda a faixa int8
+  uint32_t seed = 2025;
+  const int input_size = engine.inputWidth() * engine.inputHeight() * engine.inputChannels();
+  for (int n = 0; n < kRandomInputs; ++n) {
+    for (int i = 0; i < input_size; ++i) {
+      seed = seed * 1664525u + 1013904223u;
+      engine.input()[i] = (int8_t)(seed >> 24);
+    }
+    double e_us = 1e30, c_us = 1e30;
+    if (!compareCurrentInput(&e_us, &c_us)) ++mismatches;
+    ++checked;
+    engine_lat.push_back(e_us);
+    compiled_lat.push_back(c_us);
+  }
+
+  // Dataset representativo: também confere o pré-processamento gerado
+  for (const LabeledImage& img : listRepresentativeImages(data_dir)) {
+    size_t len = 0;
+    uint8_t* jpeg = loadFile(img.path.c_str(), &len);
+    std::vector<uint8_t> gray;
+    int w = 0, h = 0;
+    if (!jpeg || !decodeJpegGray(jpeg, len, &gray, &w, &h)) {
+      free(jpeg);
+      continue;
+    }
+    free(jpeg);
+    engine.setInputFromGray(gray.data(), w, h);
+    compiled::inputFromGray<compiled_model::kInputHeight, compiled_model::kInputWidth,
+                            compiled_model::kInputChannels>(
+        gray.data(), w, h, compiled_lut, compiled_model::input(compiled_arena));
+    const bool same_input =
+        memcmp(engine.input(), compiled_model::input(compiled_arena), input_size) == 0;
+    double e_us = 1e30, c_us = 1e30;
+    if (!same_input || !compareCurrentInput(&e_us, &c_us)) {
+      fprintf(stderr, "❌ Divergência em %s\n", img.path.c_str());
+      ++mismatches;
+    }
+    ++checked;
+    engine_lat.push_back(e_us);
+    compiled_lat.push_back(c_us);
+  }
+
+  // Tempo por camada (menor de kRepeats)
+  printf("%-4s %-18s %14s %12s %12s %8s\n", "#", "camada", "MACs", "motor us", "compilado us",
+         "speedup");
+  for (int i = 0; i < compiled_model::kLayerCount; ++i) {
+    double e_us = 1e30, c_us = 1e30;
+    for (int r = 0; r < kRepeats; ++r) {
+      auto t0 = std::chrono::steady_clock::now();
+      engine.invokeLayer(i);
+      e_us = std::min(e_us, elapsedUs(t0));
+      t0 = std::chrono::steady_clock::now();
+      compiled_model::invokeLayer(i, compiled_arena);
+      c_us = std::min(c_us, elapsedUs(t0));
+    }
+    const compiled_model::LayerInfo& info = compiled_model::kLayers[i];
+    printf("%-4d %-18s %14u %12.1f %12.1f %7.2fx\n", i, info.op, (unsigned)info.macs, e_us, c_us,
+           e_us / c_us);
+  }
+
+  std::sort(engine_lat.begin(), engine_lat.end());
+  std::sort(compiled_lat.begin(), compiled_lat.end());
+  const double e_med = engine_lat[engine_lat.size() / 2];
+  const double c_med = compiled_lat[compiled_lat.size() / 2];
+  printf("\n⏱️  Latência mediana: motor %.2f ms | compilado %.2f ms (%.2fx)\n", e_med / 1000.0,
+         c_med / 1000.0, e_med / c_med);
+  printf("%s Paridade: %d/%d entradas idênticas\n", mismatches ? "❌" : "✅",
+         checked - mismatches, checked);
+  free(model);
+  return mismatches ? 1 : 0;
+}
@@ -0,0 +1,235 @@
+/*
+ * SPRINT 3 - Benchmark do Kernel Dedicado da Primeira Conv2D
+ * ==========================================================
+ *
+ * Executa a camada 0 do g_model (Conv2D 3x3 de 96x96x1 para 32
+ * canais, fundida ao MaxPool2D) sobre as imagens do dataset
+ * representativo com cada caminho disponível:
+ *
+ *   - genérico OHWI (conv2dMaxPoolInt8, referência);
+ *   - backend vetorial (bestKernelBackend, o mesmo de host_backends);
+ *   - dedicado 3x3 C_in = 1 (conv_first_layer.h);
+ *
+ * e confere que todos produzem a mesma saída. Também compara a Conv2D
+ * sem fusão e formas aleatórias suportadas pelo kernel dedicado (tiles
+ * de patch, 1..64 canais). Imprime a latência e os MACs/ns de cada um.
+ *
+ * Uso:
+ *     ./build/host_first_layer [dados]
+ *
+ * Autor: Equipe SPRINT 3
+ * Data: 2025
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "host_common.h"
+#include "int8_engine.h"
+#include "model.h"
+
+static const size_t kHostArenaSize = 1024 * 1024;
+static const int kRepeats = 5;
+static const int kRandomShapes = 200;
+
+// Caminho da camada: fundido (conv, pool) ou só a Conv2D (conv)
+typedef void (*FusedFn)(const Int8Layer& layer, const int8_t* input, int32_t input_offset,
+                        const int8_t* weights, const int32_t* bias, const RequantParams& rq,
+                        int8_t* output, bool fused);
+
+static void runGeneric(const Int8Layer& layer, const int8_t* input, int32_t input_offset,
+                       const int8_t* weights, const int32_t* bias, const RequantParams& rq,
+                       int8_t* output, bool fused) {
+  if (fused) {
+    conv2dMaxPoolInt8(layer.shape, layer.pool, input, input_offset, weights, bias, rq, output);
+  } else {
+    conv2dInt8(layer.shape, input, input_offset, weights, bias, rq, output);
+  }
+}
+
+static void runBackend(const Int8Layer& layer, const int8_t* input, int32_t input_offset,
+                       const int8_t* weights, const int32_t* bias, const RequantParams& rq,
+                       int8_t* output, bool fused) {
+  const KernelBackend* backend = bestKernelBackend();
+  if (fused) {
+    backend->conv2dMaxPool(layer.shape, layer.pool, input, input_offset, weights, bias,
+                           layer.weight_sums, rq, output);
+  } else {
+    backend->conv2d(layer.shape, input, input_offset, weights, bias, layer.weight_sums, rq,
+                    output);
+  }
+}
+
+static void runDedicated(const Int8Layer& layer, const int8_t* input, int32_t input_offset,
+                         const int8_t* weights, const int32_t* bias, const RequantParams& rq,
+                         int8_t* output, bool fused) {
+  if (fused) {
+    conv3x3Cin1MaxPoolInt8(layer.shape, layer.pool, input, input_offset, weights, bias, rq,
+                           output);
+  } else {
+    conv3x3Cin1Int8(layer.shape, input, input_offset, weights, bias, rq, output);
+  }
+}
+
+static uint32_t g_seed = 0x1a7e;
+
+static uint32_t nextRandom() {
+  g_seed = g_seed * 1664525u + 1013904223u;
+  return g_seed >> 8;
+}
+
+// Formas aleatórias do kernel dedicado contra a referência
+static bool checkRandomShapes() {
+  for (int t = 0; t < kRandomShapes; ++t) {
+    ConvShape s = ConvShape();
+    s.in_c = 1;
+    s.k_h = s.k_w = 3;
+    s.stride_h = s.stride_w = 1;
+    s.in_h = 3 + (int)(nextRandom() % 30);
+    s.in_w = 3 + (int)(nextRandom() % 30);
+    s.out_h = s.in_h - 2;
+    s.out_w = s.in_w - 2;
+    s.out_c = 1 + (int)(nextRandom() % kFirstLayerMaxChannels);
+    ConvShape pool = ConvShape();
+    pool.k_h = pool.k_w = 2;
+    pool.stride_h = pool.stride_w = 2;
+    pool.out_h = (s.out_h + 1) / 2;
+    pool.out_w = (s.out_w + 1) / 2;
+
+    std::vector<int8_t> input((size_t)s.in_h * s.in_w), filter((size_t)s.out_c * 9);
+    std::vector<int32_t> bias(s.out_c), mult(s.out_c), shift(s.out_c);
+    for (int8_t& v : input) v = (int8_t)nextRandom();
+    for (int8_t& v : filter) v = (int8_t)nextRandom();
+    for (int c = 0; c < s.out_c; ++c) {
+      bias[c] = (int32_t)(nextRandom() % 8000) - 4000;
+      quantizeMultiplier(0.001 + (nextRandom() % 100) * 0.0001, &mult[c], &shift[c]);
+    }
+    RequantParams rq = { mult.data(), shift.data(), (int32_t)(nextRandom() % 41) - 20, -128, 127 };
+    const int32_t offset = (int32_t)(nextRandom() % 256) - 127;
+
+    std::vector<int8_t> a((size_t)s.out_h * s.out_w * s.out_c), b(a.size());
+    conv2dInt8(s, input.data(), offset, filter.data(), bias.data(), rq, a.data());
+    conv3x3Cin1Int8(s, input.data(), offset, filter.data(), bias.data(), rq, b.data());
+    if (a != b) return false;
+    a.assign((size_t)pool.out_h * pool.out_w * s.out_c, 0);
+    b.assign(a.size(), 0);
+    conv2dMaxPoolInt8(s, pool, input.data(), offset, filter.data(), bias.data(), rq, a.data());
+    conv3x3Cin1MaxPoolInt8(s, pool, input.data(), offset, filter.data(), bias.data(), rq, b.data());
+    if (a != b) return false;
+  }
+  return true;
+}
+
+int main(int argc, char** argv) {
+  const char* data_dir = argc > 1 ? argv[1] : kDefaultDataDir;
+  static uint8_t arena[kHostArenaSize];
+  static Int8Engine engine;
+  engine.setPackedWeights(g_model_packed, g_model_packed_len);
+  if (!engine.begin(g_model, g_model_len, arena, sizeof(arena))) {
+    fprintf(stderr, "❌ Falha ao carregar modelo: %s\n", engine.errorMessage());
+    return 1;
+  }
+  const Int8Layer& layer = engine.layer(0);
+  const ConvShape& s = layer.shape;
+  if (layer.op != kOpConv2DMaxPool || !conv3x3Cin1Supported(s)) {
+    fprintf(stderr, "❌ A camada 0 não é uma Conv2D 3x3 C_in=1 fundida\n");
+    return 1;
+  }
+
+  std::vector<std::vector<uint8_t>> frames;
+  std::vector<int> widths, heights;
+  for (const LabeledImage& img : listRepresentativeImages(data_dir)) {
+    size_t len = 0;
+    uint8_t* jpeg = loadFile(img.path.c_str(), &len);
+    std::vector<uint8_t> gray;
+    int w = 0, h = 0;
+    if (jpeg && decodeJpegGray(jpeg, len, &gray, &w, &h)) {
+      frames.push_back(std::move(gray));
+      widths.push_back(w);
+      heights.push_back(h);
+    }
+    free(jpeg);
+  }
+  if (frames.empty()) {
+    fprintf(stderr, "❌ Nenhuma imagem em %s\n", data_dir);
+    return 1;
+  }
+
+  // Entradas quantizadas de todas as imagens (o tensor de entrada do motor)
+  const size_t in_size = (size_t)s.in_h * s.in_w;
+  std::vector<int8_t> inputs(frames.size() * in_size);
+  for (size_t f = 0; f < frames.size(); ++f) {
+    engine.setInputFromGray(frames[f].data(), widths[f], heights[f]);
+    memcpy(&inputs[f * in_size], engine.input(), in_size);
+  }
+
+  RequantParams rq;
+  rq.multiplier = layer.multiplier;
+  rq.shift = layer.shift;
+  rq.output_offset = engine.tensor(layer.output).zero_point;
+  rq.act_min = layer.act_min;
+  rq.act_max = layer.act_max;
+  const int32_t input_offset = -engine.tensor(layer.input).zero_point;
+  const int8_t* weights = (const int8_t*)engine.tensor(layer.weights).buffer;
+  const int32_t* bias = (const int32_t*)engine.tensor(layer.bias).buffer;
+
+  const size_t conv_size = (size_t)s.out_h * s.out_w * s.out_c;
+  const uint32_t macs = (uint32_t)conv_size * 9;
+  printf("🧠 Camada 0: Conv2D 3x3 %dx%dx1 -> %dx%dx%d (+MaxPool %dx%d) | %u MACs | %zu imagens\n\n",
+         s.in_h, s.in_w, s.out_h, s.out_w, s.out_c, layer.pool.k_h, layer.pool.k_w, macs,
+         frames.size());
+
+  struct Path {
+    const char* name;
+    FusedFn fn;
+  };
+  const Path paths[] = { { "genérico OHWI", runGeneric },
+                         { "backend vetorial", runBackend },
+                         { "dedicado 3x3 C_in=1", runDedicated } };
+
+  bool identical = true;
+  for (int fused = 1; fused >= 0; --fused) {
+    printf("%s\n", fused ? "Conv2D+MaxPool fundidos" : "Conv2D sem fusão");
+    printf("  %-22s %10s %9s %8s  %s\n", "caminho", "us/imagem", "MAC/ns", "speedup", "saída");
+    const size_t out_size =
+        fused ? (size_t)layer.pool.out_h * layer.pool.out_w * s.out_c : conv_size;
+    std::vector<int8_t> expected(frames.size() * out_size);
+    std::vector<int8_t> out(out_size);
+    double base_us = 0.0;
+    for (const Path& path : paths) {
+      bool same = true;
+      for (size_t f = 0; f < frames.size(); ++f) {
+        path.fn(layer, &inputs[f * in_size], input_offset, weights, bias, rq, out.data(),
+                fused != 0);
+        if (&path == &paths[0]) {
+          memcpy(&expected[f * out_size], out.data(), out_size);
+        } else if (memcmp(&expected[f * out_size], out.data(), out_size) != 0) {
+          same = false;
+        }
+      }
+      double us = 1e30;
+      for (int r = 0; r < kRepeats; ++r) {
+        auto t0 = std::chrono::steady_clock::now();
+        for (size_t f = 0; f < frames.size(); ++f) {
+          path.fn(layer, &inputs[f * in_size], input_offset, weights, bias, rq, out.data(),
+                  fused != 0);
+        }
+        us = std::min(us, elapsedUs(t0) / frames.size());
+      }
+      if (&path == &paths[0]) base_us = us;
+      identical = identical && same;
+      printf("  %-22s %10.1f %9.3f %7.2fx  %s\n", path.name, us, macs / (us * 1000.0),
+             base_us / us, same ? "✅ idêntica" : "❌ DIFERENTE");
+    }
+    printf("\n");
+  }
+
+  const bool random_ok = checkRandomShapes();
+  printf("🎲 %d formas aleatórias (1..%d canais, com MaxPool): %s\n", kRandomShapes,
+         kFirstLayerMaxChannels, random_ok ? "✅ idênticas à referência" : "❌ DIFERENTES");
+  return identical && random_ok ? 0 : 1;
+}
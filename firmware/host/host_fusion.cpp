@@ -0,0 +1,138 @@
+/*
+ * SPRINT 3 - Benchmark da Fusão Conv2D+ReLU+MaxPool
+ * ================================================
+ *
+ * Carrega o modelo duas vezes (com e sem fusão), executa camada a
+ * camada sobre a mesma entrada e compara latência, bytes movidos
+ * (ativações lidas/escritas + pesos) e pico da arena. Também confere
+ * que as duas execuções produzem exatamente a mesma saída.
+ *
+ * Uso:
+ *     ./build/host_fusion [modelo.tflite]
+ *
+ * Autor: Equipe SPRINT 3
+ * Data: 2025
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+
+#include "host_common.h"
+#include "int8_engine.h"
+
+static const size_t kHostArenaSize = 1024 * 1024;
+static const int kRepeats = 20;
+
+static const char* opName(Int8OpType op) {
+  switch (op) {
+    case kOpConv2D: return "Conv2D";
+    case kOpMaxPool2D: return "MaxPool2D";
+    case kOpFullyConnected: return "FullyConnected";
+    case kOpSoftmax: return "Softmax";
+    case kOpConv2DMaxPool: return "Conv2D+MaxPool";
+  }
+  return "?";
+}
+
+// Bytes de ativação lidos/escritos mais pesos e bias consumidos pela camada
+static size_t layerBytes(const Int8Engine& engine, const Int8Layer& layer) {
+  size_t bytes = engine.tensor(layer.input).bytes + engine.tensor(layer.output).bytes;
+  if (layer.weights >= 0) bytes += engine.tensor(layer.weights).buffer_size;
+  if (layer.bias >= 0) bytes += engine.tensor(layer.bias).buffer_size;
+  return bytes;
+}
+
+// Uma passada camada a camada, guardando o menor tempo (us) de cada uma
+static void timeLayers(Int8Engine& engine, double* best_us) {
+  for (int i = 0; i < engine.layerCount(); ++i) {
+    auto t0 = std::chrono::steady_clock::now();
+    engine.invokeLayer(i);
+    best_us[i] = std::min(best_us[i], elapsedUs(t0));
+  }
+}
+
+int main(int argc, char** argv) {
+  const char* model_path = argc > 1 ? argv[1] : kDefaultModelPath;
+  size_t model_size = 0;
+  uint8_t* model = loadFile(model_path, &model_size);
+  if (!model) {
+    fprintf(stderr, "❌ Modelo não encontrado: %s\n", model_path);
+    return 1;
+  }
+
+  static uint8_t arena_plain[kHostArenaSize];
+  static uint8_t arena_fused[kHostArenaSize];
+  static Int8Engine plain;
+  static Int8Engine fused;
+  plain.setFusion(false);
+  if (!plain.begin(model, model_size, arena_plain, sizeof(arena_plain)) ||
+      !fused.begin(model, model_size, arena_fused, sizeof(arena_fused))) {
+    fprintf(stderr, "❌ Falha ao carregar modelo: %s / %s\n", plain.errorMessage(),
+            fused.errorMessage());
+    return 1;
+  }
+
+  // Entrada pseudoaleatória cobrindo toda a faixa int8
+  uint32_t seed = 12345;
+  const int input_size = plain.inputWidth() * plain.inputHeight() * plain.inputChannels();
+  for (int i = 0; i < input_size; ++i) {
+    seed = seed * 1664525u + 1013904223u;
+    plain.input()[i] = (int8_t)(seed >> 24);
+  }
+  memcpy(fused.input(), plain.input(), input_size);
+
+  double plain_us[Int8Engine::kMaxLayers];
+  double fused_us[Int8Engine::kMaxLayers];
+  std::fill(plain_us, plain_us + Int8Engine::kMaxLayers, 1e30);
+  std::fill(fused_us, fused_us + Int8Engine::kMaxLayers, 1e30);
+  // Passadas intercaladas para que a variação da máquina afete os dois lados
+  for (int r = 0; r < kRepeats; ++r) {
+    timeLayers(plain, plain_us);
+    timeLayers(fused, fused_us);
+  }
+
+  const bool identical = memcmp(plain.output(), fused.output(), plain.outputSize()) == 0;
+
+  printf("🧠 Modelo: %s\n\n", model_path);
+  printf("%-16s %12s %10s  | %-16s %12s %10s %8s\n", "sem fusão", "bytes", "us",
+         "com fusão", "bytes", "us", "speedup");
+  size_t total_plain_bytes = 0, total_fused_bytes = 0;
+  double total_plain_us = 0, total_fused_us = 0;
+  int p = 0;
+  for (int f = 0; f < fused.layerCount(); ++f) {
+    const Int8Layer& fl = fused.layer(f);
+    const int span = fl.op == kOpConv2DMaxPool ? 2 : 1;
+    size_t group_bytes = 0;
+    double group_us = 0;
+    for (int k = 0; k < span && p < plain.layerCount(); ++k, ++p) {
+      const size_t bytes = layerBytes(plain, plain.layer(p));
+      group_bytes += bytes;
+      group_us += plain_us[p];
+      if (k + 1 < span) printf("%-16s %12zu %10.1f  |\n", opName(plain.layer(p).op), bytes, plain_us[p]);
+      else printf("%-16s %12zu %10.1f  | ", opName(plain.layer(p).op), bytes, plain_us[p]);
+    }
+    const size_t bytes = layerBytes(fused, fl);
+    printf("%-16s %12zu %10.1f %7.2fx\n", opName(fl.op), bytes, fused_us[f],
+           group_us / fused_us[f]);
+    if (span > 1) {
+      printf("%-16s %12zu %10.1f  | %-16s %11.1f%%\n", "  (bloco)", group_bytes, group_us,
+             "  bytes", 100.0 * bytes / group_bytes);
+    }
+    total_plain_bytes += group_bytes;
+    total_plain_us += group_us;
+    total_fused_bytes += bytes;
+    total_fused_us += fused_us[f];
+  }
+
+  printf("\n📦 Bytes movidos: %zu -> %zu (%.1f%%)\n", total_plain_bytes, total_fused_bytes,
+         100.0 * total_fused_bytes / total_plain_bytes);
+  printf("⏱️  Latência: %.2f ms -> %.2f ms (%.2fx)\n", total_plain_us / 1000.0,
+         total_fused_us / 1000.0, total_plain_us / total_fused_us);
+  printf("📐 Pico da arena: %zu -> %zu bytes\n", plain.arenaUsed(), fused.arenaUsed());
+  printf("%s Saídas %s\n", identical ? "✅" : "❌", identical ? "idênticas" : "DIFERENTES");
+  free(model);
+  return identical ? 0 : 1;
+}
@@ -0,0 +1,153 @@
+/*
+ * SPRINT 3 - Avaliação do Gate de Rejeição Antecipada
+ * ===================================================
+ *
+ * Reproduz a cascata do main_real_advanced.cpp sobre fotos reais:
+ * calcula o vetor de 6 características de cada imagem, calibra o
+ * perfil HP com as primeiras CALIB_SAMPLES fotos HP (como o
+ * /calibrate), passa cada frame pelo FeatureGate e executa a CNN
+ * INT8 só nos ambíguos. Reporta a taxa de rejeição, a latência
+ * economizada e quantos frames HP o gate rejeitou indevidamente.
+ *
+ * Uso:
+ *     ./build/host_gate [dataset] [modelo.tflite]
+ *
+ * O dataset pode ter HP_Original/ + Outros/ (Sprint 1, padrão) ou
+ * hp_original/ + nao_hp/ (representative_data).
+ *
+ * Autor: Equipe SPRINT 3
+ * Data: 2025
+ */
+
+#include <stdio.h>
+#include <math.h>
+#include <stdlib.h>
+
+#include <vector>
+
+#include "feature_gate.h"
+#include "host_common.h"
+#include "image_stats.h"
+#include "int8_engine.h"
+
+static const size_t kHostArenaSize = 1024 * 1024;
+static const int kCalibSamples = 8;       // CALIB_SAMPLES do firmware
+static const float kThresh = 0.25f;       // THRESH do firmware
+
+struct Frame {
+  int label;
+  float features[kGateFeatures];
+  std::vector<uint8_t> gray;
+  int width, height;
+};
+
+// Vetor de características da imagem inteira (médias, brilho, contraste, textura)
+static bool loadFrame(const LabeledImage& img, Frame* frame) {
+  size_t len = 0;
+  uint8_t* jpeg = loadFile(img.path.c_str(), &len);
+  std::vector<uint8_t> rgb;
+  int w = 0, h = 0;
+  const bool ok = jpeg && decodeJpegRgb(jpeg, len, &rgb, &w, &h);
+  free(jpeg);
+  if (!ok) return false;
+
+  // Mesmo núcleo de uma passada do firmware (ImageStats), luminância junto
+  ImageStats stats;
+  imageStatsReset(&stats);
+  frame->gray.resize((size_t)w * h);
+  const size_t stride = (size_t)w * 3;
+  for (int y = 0; y < h; ++y) {
+    const uint8_t* row = &rgb[y * stride];
+    uint8_t* gray = &frame->gray[(size_t)y * w];
+    imageStatsAddRgb888(&stats, row, y > 0 ? gray - w : nullptr, w, gray);
+  }
+  imageStatsFeatures(stats, len, w, h, frame->features);
+  frame->label = img.label;
+  frame->width = w;
+  frame->height = h;
+  return true;
+}
+
+int main(int argc, char** argv) {
+  const char* data_dir = argc > 1 ? argv[1] : kSprint1DataDir;
+  const char* model_path = argc > 2 ? argv[2] : kDefaultModelPath;
+
+  size_t model_size = 0;
+  uint8_t* model = loadFile(model_path, &model_size);
+  static uint8_t arena[kHostArenaSize];
+  static Int8Engine engine;
+  if (!model || !engine.begin(model, model_size, arena, sizeof(arena))) {
+    fprintf(stderr, "❌ Falha ao carregar %s: %s\n", model_path, engine.errorMessage());
+    return 1;
+  }
+
+  std::vector<LabeledImage> images = listSprint1Images(data_dir);
+  if (images.empty()) images = listRepresentativeImages(data_dir);
+  std::vector<Frame> frames;
+  for (const LabeledImage& img : images) {
+    Frame frame;
+    if (loadFrame(img, &frame)) frames.push_back(std::move(frame));
+    else fprintf(stderr, "⚠️  Falha ao decodificar %s\n", img.path.c_str());
+  }
+  if (frames.empty()) {
+    fprintf(stderr, "❌ Nenhuma imagem em %s\n", data_dir);
+    return 1;
+  }
+
+  // Calibração: Welford sobre as primeiras fotos HP, como o /calibrate
+  FeatureWelford calib;
+  welfordReset(&calib);
+  for (const Frame& f : frames) {
+    if (f.label == 0 && calib.count < (uint32_t)kCalibSamples) welfordAdd(&calib, f.features);
+  }
+  FeatureGate gate;
+  GateConfig config = FeatureGate::defaultConfig();
+  config.reject_distance = kThresh * 2.0f;
+  gate.setConfig(config);
+  if (calib.count > 0) {
+    gate.addProfile(calib.mean);
+    printf("🎯 Perfil HP (%u amostras), desvio:", calib.count);
+    for (int i = 0; i < kGateFeatures; ++i) printf(" %.3f", welfordStd(calib, i));
+    printf("\n\n");
+  }
+
+  int cascade_correct = 0, cnn_correct = 0, false_rejects = 0;
+  double cnn_total_ms = 0;
+  for (const Frame& f : frames) {
+    float dist = -1.0f;
+    const GateDecision decision = gate.evaluate(f.features, &dist);
+
+    // A CNN roda em todos os frames para comparar com a cascata
+    auto t0 = std::chrono::steady_clock::now();
+    engine.setInputFromGray(f.gray.data(), f.width, f.height);
+    engine.invoke();
+    const double cnn_ms = elapsedUs(t0) / 1000.0;
+    cnn_total_ms += cnn_ms;
+    const int cnn_pred = engine.outputValue(0) >= engine.outputValue(1) ? 0 : 1;
+    if (cnn_pred == f.label) ++cnn_correct;
+
+    int pred = 1;  // Rejeitado pelo gate: NAO_HP
+    if (decision == kGateRunModel) {
+      gate.recordModelRun((float)cnn_ms);
+      pred = cnn_pred;
+    } else if (f.label == 0) {
+      ++false_rejects;
+    }
+    if (pred == f.label) ++cascade_correct;
+    printf("%-14s dist=%.3f %-15s CNN=%s\n", f.label == 0 ? "HP_ORIGINAL" : "NAO_HP", dist,
+           FeatureGate::decisionName(decision), cnn_pred == 0 ? "HP_ORIGINAL" : "NAO_HP");
+  }
+
+  const GateStats& s = gate.stats();
+  const size_t n = frames.size();
+  printf("\n🚦 Frames: %u | cena vazia: %u | fora do perfil: %u | CNN: %u\n", s.frames,
+         s.empty_scenes, s.far_frames, s.model_runs);
+  printf("📉 Taxa de rejeição: %.1f%% | HP rejeitados indevidamente: %d\n",
+         gate.hitRate() * 100.0f, false_rejects);
+  printf("⏱️  CNN média: %.2f ms | economia: %.1f ms de %.1f ms (%.1f%%)\n", s.avg_model_ms,
+         gate.savedMs(), cnn_total_ms, 100.0 * gate.savedMs() / cnn_total_ms);
+  printf("🎯 Acurácia: só CNN %.1f%% | cascata %.1f%%\n", 100.0 * cnn_correct / n,
+         100.0 * cascade_correct / n);
+  free(model);
+  return 0;
+}
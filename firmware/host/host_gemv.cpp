@@ -0,0 +1,246 @@
+/*
+ * SPRINT 3 - Microbenchmark do GEMV da Camada Densa
+ * =================================================
+ *
+ * Mede o FullyConnected maior do g_model (Flatten -> Dense) em
+ * quatro variantes: pesos OHWI, pesos em blocos, GEMV com pré-busca
+ * (memcpy) e GEMV com pré-busca de uma PSRAM emulada a 80 MB/s, com
+ * cópia síncrona e com cópia em segundo plano (como o GDMA do
+ * dmaWeightFetcher), para mostrar a sobreposição cópia/cálculo. As
+ * variantes emuladas são comparadas ao tempo mínimo só de cópia na
+ * banda modelada; as demais medem só o PC. Confere que as saídas são
+ * idênticas. Repete as variantes de PSRAM com a cópia int4 do blob, o
+ * formato que o firmware usa por padrão (kInt4Dense).
+ *
+ * No firmware a pré-busca só roda no fallback da SPIFFS, com os pesos
+ * copiados para a PSRAM: das partições mapeadas (padrão) o GDMA não lê a
+ * flash e a densa lê os pesos direto pelo cache, sem scratch.
+ *
+ * Uso:
+ *     ./build/host_gemv
+ *
+ * Autor: Equipe SPRINT 3
+ * Data: 2025
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include <algorithm>
+
+#include "dense_gemv.h"
+#include "host_common.h"
+#include "int8_engine.h"
+#include "model.h"
+
+static const size_t kHostArenaSize = 1024 * 1024;
+static const int kRepeats = 30;
+// PSRAM octal a 80 MHz (platformio.ini): metade do pico DDR, vazão típica do GDMA
+static const double kPsramBytesPerSec = 80e6;
+static const size_t kScratchSizes[] = { 1024, 4096, 16384 };
+
+// PSRAM emulada com GDMA: a cópia fica pronta bytes / kPsramBytesPerSec
+// depois de iniciada e wait() bloqueia até esse instante. Na versão síncrona a
+// própria start() espera, como um memcpy pela CPU.
+struct PsramDma {
+  std::chrono::steady_clock::time_point ready;
+};
+
+static std::chrono::steady_clock::time_point psramDeadline(size_t bytes) {
+  return std::chrono::steady_clock::now() +
+         std::chrono::nanoseconds((long long)(bytes / kPsramBytesPerSec * 1e9));
+}
+
+static void spinUntil(std::chrono::steady_clock::time_point t) {
+  while (std::chrono::steady_clock::now() < t) {
+  }
+}
+
+static void dmaStart(void* ctx, int8_t* dst, const int8_t* src, size_t bytes) {
+  ((PsramDma*)ctx)->ready = psramDeadline(bytes);
+  memcpy(dst, src, bytes);
+}
+
+static void dmaWait(void* ctx) { spinUntil(((PsramDma*)ctx)->ready); }
+
+static void syncStart(void*, int8_t* dst, const int8_t* src, size_t bytes) {
+  const auto ready = psramDeadline(bytes);
+  memcpy(dst, src, bytes);
+  spinUntil(ready);
+}
+
+static void syncWait(void*) {}
+
+template <typename F>
+static double bestUs(F fn) {
+  double best = 1e30;
+  for (int r = 0; r < kRepeats; ++r) {
+    auto t0 = std::chrono::steady_clock::now();
+    fn();
+    best = std::min(best, elapsedUs(t0));
+  }
+  return best;
+}
+
+// floor_us > 0: variante emulada, comparada ao mínimo só de cópia na banda modelada
+static void report(const char* name, double us, size_t weight_bytes, double floor_us,
+                   bool same) {
+  const double mbps = weight_bytes / us;  // bytes/us = MB/s
+  char ratio[16] = "-";
+  if (floor_us > 0) snprintf(ratio, sizeof(ratio), "%.2fx", us / floor_us);
+  printf("%-34s %10.1f %12.1f %10s %s\n", name, us, mbps, ratio, same ? "✅" : "❌ DIFERENTE");
+}
+
+int main() {
+  static uint8_t arena[kHostArenaSize];
+  static Int8Engine engine;
+  engine.setPackedWeights(g_model_packed, g_model_packed_len);
+  engine.setInt4Dense(true);
+  if (!engine.begin(g_model, g_model_len, arena, sizeof(arena))) {
+    fprintf(stderr, "❌ Falha ao carregar modelo: %s\n", engine.errorMessage());
+    return 1;
+  }
+
+  // Camada densa com mais pesos
+  int dense = -1;
+  for (int l = 0; l < engine.layerCount(); ++l) {
+    const Int8Layer& layer = engine.layer(l);
+    if (layer.op != kOpFullyConnected) continue;
+    if (dense < 0 || engine.tensor(layer.weights).bytes > engine.tensor(engine.layer(dense).weights).bytes) {
+      dense = l;
+    }
+  }
+  if (dense < 0) {
+    fprintf(stderr, "❌ Modelo sem FullyConnected\n");
+    return 1;
+  }
+  const Int8Layer& layer = engine.layer(dense);
+  const Int8Tensor& in_t = engine.tensor(layer.input);
+  const Int8Tensor& out_t = engine.tensor(layer.output);
+  const int in_features = layer.shape.in_c;
+  const int out_features = layer.shape.out_c;
+  const size_t weight_bytes = engine.tensor(layer.weights).bytes;
+  const int8_t* weights = (const int8_t*)engine.tensor(layer.weights).buffer;
+  const int32_t* bias = layer.bias >= 0 ? (const int32_t*)engine.tensor(layer.bias).buffer : nullptr;
+  // A densa grande vem só em int4 no .i8pk (sem --no-int4): blocos int8 feitos aqui
+  const std::vector<uint8_t> blocked =
+      layer.packed ? std::vector<uint8_t>()
+                   : packOcBlocked(weights, out_features, in_features, kPackBlock);
+  const int8_t* packed = layer.packed ? layer.packed : (const int8_t*)blocked.data();
+
+  // Entrada pseudoaleatória e requantização da camada (mesma conta do motor)
+  static int8_t input[65536];
+  static int8_t reference[1024];
+  static int8_t result[1024];
+  uint32_t seed = 777;
+  for (int i = 0; i < in_features; ++i) {
+    seed = seed * 1664525u + 1013904223u;
+    input[i] = (int8_t)(seed >> 24);
+  }
+
+  RequantParams rq;
+  static int32_t multiplier[1024];
+  static int32_t shift[1024];
+  const float in_scale = in_t.scale;
+  const float out_scale = out_t.scale;
+  const Int8Tensor& w_t = engine.tensor(layer.weights);
+  for (int c = 0; c < out_features; ++c) {
+    const float w_scale = tflite_fb::readF32(w_t.scales + 4 * (w_t.num_scales == 1 ? 0 : c));
+    quantizeMultiplier((double)in_scale * (double)w_scale / (double)out_scale, &multiplier[c],
+                       &shift[c]);
+  }
+  rq.multiplier = multiplier;
+  rq.shift = shift;
+  rq.output_offset = out_t.zero_point;
+  rq.act_min = layer.act_min;
+  rq.act_max = layer.act_max;
+  const int32_t input_offset = -in_t.zero_point;
+
+  printf("🧠 Camada %d: FullyConnected %d -> %d | pesos %zu bytes\n", dense, in_features,
+         out_features, weight_bytes);
+  const double floor_us = weight_bytes / kPsramBytesPerSec * 1e6;
+  printf("💾 PSRAM modelada: %.0f MB/s -> mínimo %.1f us só para copiar os pesos\n\n",
+         kPsramBytesPerSec / 1e6, floor_us);
+  printf("%-34s %10s %12s %10s\n", "variante", "us", "MB/s pesos", "x mínimo");
+
+  bool all_same = true;
+  double us = bestUs([&] {
+    fullyConnectedInt8(in_features, out_features, input, input_offset, weights, bias, rq,
+                       reference);
+  });
+  report("OHWI (referência)", us, weight_bytes, 0, true);
+
+  us = bestUs([&] {
+    fullyConnectedInt8Packed(in_features, out_features, input, input_offset, packed, bias, rq,
+                             result);
+  });
+  bool same = memcmp(reference, result, out_features) == 0;
+  all_same &= same;
+  report("blocos de 4 linhas", us, weight_bytes, 0, same);
+
+  static int8_t scratch[16384];
+  char name[64];
+  for (size_t size : kScratchSizes) {
+    memset(result, 0, sizeof(result));
+    us = bestUs([&] {
+      fullyConnectedInt8Streamed(in_features, out_features, input, input_offset, packed,
+                                 bias, rq, result, scratch, size, nullptr);
+    });
+    same = memcmp(reference, result, out_features) == 0;
+    all_same &= same;
+    snprintf(name, sizeof(name), "pré-busca memcpy, 2x%zu B", size / 2);
+    report(name, us, weight_bytes, 0, same);
+  }
+
+  // PSRAM emulada: cópia síncrona (sem sobreposição) vs GDMA (sobreposta)
+  const size_t size = 4096;
+  const WeightFetcher sync_fetcher = { syncStart, syncWait, nullptr };
+  PsramDma dma;
+  const WeightFetcher dma_fetcher = { dmaStart, dmaWait, &dma };
+  memset(result, 0, sizeof(result));
+  us = bestUs([&] {
+    fullyConnectedInt8Streamed(in_features, out_features, input, input_offset, packed,
+                               bias, rq, result, scratch, size, &sync_fetcher);
+  });
+  same = memcmp(reference, result, out_features) == 0;
+  all_same &= same;
+  report("PSRAM 80 MB/s, cópia síncrona", us, weight_bytes, floor_us, same);
+  memset(result, 0, sizeof(result));
+  us = bestUs([&] {
+    fullyConnectedInt8Streamed(in_features, out_features, input, input_offset, packed,
+                               bias, rq, result, scratch, size, &dma_fetcher);
+  });
+  same = memcmp(reference, result, out_features) == 0;
+  all_same &= same;
+  report("PSRAM 80 MB/s, GDMA sobreposto", us, weight_bytes, floor_us, same);
+
+  // Cópia int4 (padrão do firmware): metade dos bytes, mesmos fetchers
+  if (layer.int4) {
+    Int4DenseWeights w;
+    int4DenseView(layer.int4, int4DenseSectionBytes(in_features, out_features), in_features,
+                  out_features, &w);
+    const size_t int4_bytes = int4DenseWeightBytes(in_features, out_features);
+    const double int4_floor_us = int4_bytes / kPsramBytesPerSec * 1e6;
+    static int8_t int4_reference[1024];
+    us = bestUs([&] {
+      fullyConnectedInt4Streamed(in_features, out_features, input, input_offset, w, rq,
+                                 int4_reference, nullptr, 0, nullptr);
+    });
+    report("int4 direto (flash mapeada)", us, int4_bytes, 0, true);
+    const WeightFetcher* fetchers[] = { &sync_fetcher, &dma_fetcher };
+    const char* names[] = { "int4 PSRAM, cópia síncrona", "int4 PSRAM, GDMA sobreposto" };
+    for (int f = 0; f < 2; ++f) {
+      memset(result, 0, sizeof(result));
+      us = bestUs([&] {
+        fullyConnectedInt4Streamed(in_features, out_features, input, input_offset, w, rq,
+                                   result, scratch, size, fetchers[f]);
+      });
+      same = memcmp(int4_reference, result, out_features) == 0;
+      all_same &= same;
+      report(names[f], us, int4_bytes, int4_floor_us, same);
+    }
+  }
+
+  printf("\n%s Saídas %s\n", all_same ? "✅" : "❌", all_same ? "idênticas" : "DIFERENTES");
+  return all_same ? 0 : 1;
+}
@@ -0,0 +1,210 @@
+/*
+ * SPRINT 3 - Benchmark das Estatísticas da Imagem em Uma Passada
+ * ==============================================================
+ *
+ * Sobre as fotos da Sprint 1 (ou o dataset representativo), reduzidas
+ * a QVGA 320x240 em RGB888 e RGB565, compara:
+ *
+ *   - várias passadas: médias R/G/B, luminância, variância,
+ *     histogramas e gradiente, cada um num laço sobre o frame (como as
+ *     contas espalhadas antes do ImageStats);
+ *   - uma passada: imageStatsAddRgb888 / imageStatsAddRgb565 por linha.
+ *
+ * Confere que as duas dão exatamente os mesmos acumuladores e que o
+ * Welford da calibração bate com a média/desvio em duas passadas.
+ *
+ * Uso:
+ *     ./build/host_image_stats [dataset_sprint1] [dados_representativos]
+ *
+ * Autor: Equipe SPRINT 3
+ * Data: 2025
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "host_common.h"
+#include "image_stats.h"
+#include "input_preprocess.h"
+
+static const int kFrameWidth = 320;
+static const int kFrameHeight = 240;
+static const int kRepeats = 20;
+static const int kCalibSamples = 8;   // CALIB_SAMPLES do firmware
+
+struct Frame {
+  std::vector<uint8_t> rgb888;
+  std::vector<uint8_t> rgb565;    // Big-endian, como o esp32-camera
+};
+
+// Frame RGB888 qualquer -> QVGA por vizinho mais próximo
+static Frame makeFrame(const std::vector<uint8_t>& rgb, int w, int h) {
+  Frame f;
+  f.rgb888.resize((size_t)kFrameWidth * kFrameHeight * 3);
+  f.rgb565.resize((size_t)kFrameWidth * kFrameHeight * 2);
+  for (int y = 0; y < kFrameHeight; ++y) {
+    for (int x = 0; x < kFrameWidth; ++x) {
+      const uint8_t* p = &rgb[((size_t)(y * h / kFrameHeight) * w + x * w / kFrameWidth) * 3];
+      const size_t i = (size_t)y * kFrameWidth + x;
+      memcpy(&f.rgb888[i * 3], p, 3);
+      const uint16_t v = (uint16_t)(((p[0] >> 3) << 11) | ((p[1] >> 2) << 5) | (p[2] >> 3));
+      f.rgb565[i * 2] = (uint8_t)(v >> 8);
+      f.rgb565[i * 2 + 1] = (uint8_t)v;
+    }
+  }
+  return f;
+}
+
+// RGB de um pixel nas duas origens (mesma expansão do imageStatsAddRgb565)
+static void pixelRgb(const Frame& f, bool rgb565, size_t i, uint32_t* rgb) {
+  if (!rgb565) {
+    for (int c = 0; c < 3; ++c) rgb[c] = f.rgb888[i * 3 + c];
+    return;
+  }
+  const uint8_t hi = f.rgb565[i * 2], lo = f.rgb565[i * 2 + 1];
+  const uint32_t r5 = hi >> 3, g6 = ((hi & 0x07) << 3) | (lo >> 5), b5 = lo & 0x1F;
+  rgb[0] = (r5 << 3) | (r5 >> 2);
+  rgb[1] = (g6 << 2) | (g6 >> 4);
+  rgb[2] = (b5 << 3) | (b5 >> 2);
+}
+
+static uint8_t pixelLuma(const Frame& f, bool rgb565, size_t i) {
+  if (rgb565) return rgb565Luma(f.rgb565[i * 2], f.rgb565[i * 2 + 1]);
+  const uint32_t r = f.rgb888[i * 3], g = f.rgb888[i * 3 + 1], b = f.rgb888[i * 3 + 2];
+  return (uint8_t)((r * 19595 + g * 38470 + b * 7471 + 0x8000) >> 16);
+}
+
+// Uma conta por laço: médias, luminância, variância, histogramas, gradiente
+static void multiPass(const Frame& f, bool rgb565, std::vector<uint8_t>* luma, ImageStats* s) {
+  const size_t n = (size_t)kFrameWidth * kFrameHeight;
+  imageStatsReset(s);
+  for (size_t i = 0; i < n; ++i) {
+    uint32_t rgb[3];
+    pixelRgb(f, rgb565, i, rgb);
+    for (int c = 0; c < 3; ++c) s->sum[c] += rgb[c];
+  }
+  for (size_t i = 0; i < n; ++i) (*luma)[i] = pixelLuma(f, rgb565, i);
+  for (size_t i = 0; i < n; ++i) {
+    s->luma_sum += (*luma)[i];
+    s->luma_sq_sum += (uint32_t)(*luma)[i] * (*luma)[i];
+  }
+  for (size_t i = 0; i < n; ++i) {
+    uint32_t rgb[3];
+    pixelRgb(f, rgb565, i, rgb);
+    for (int c = 0; c < 3; ++c) ++s->hist[c][rgb[c] >> kStatsBinShift];
+    ++s->hist[kStatsY][(*luma)[i] >> kStatsBinShift];
+  }
+  for (int y = 0; y < kFrameHeight; ++y) {
+    for (int x = 0; x < kFrameWidth; ++x) {
+      const int v = (*luma)[(size_t)y * kFrameWidth + x];
+      if (x > 0) {
+        const int d = v - (*luma)[(size_t)y * kFrameWidth + x - 1];
+        s->grad_energy += (uint32_t)(d * d);
+        ++s->grad_pairs;
+      }
+      if (y > 0) {
+        const int d = v - (*luma)[(size_t)(y - 1) * kFrameWidth + x];
+        s->grad_energy += (uint32_t)(d * d);
+        ++s->grad_pairs;
+      }
+    }
+  }
+  s->pixels = s->color_pixels = (uint32_t)n;
+}
+
+static void onePass(const Frame& f, bool rgb565, std::vector<uint8_t>* luma, ImageStats* s) {
+  imageStatsReset(s);
+  const int bpp = rgb565 ? 2 : 3;
+  const uint8_t* data = rgb565 ? f.rgb565.data() : f.rgb888.data();
+  const size_t stride = (size_t)kFrameWidth * bpp;
+  for (int y = 0; y < kFrameHeight; ++y) {
+    const uint8_t* row = data + y * stride;
+    uint8_t* out = &(*luma)[(size_t)y * kFrameWidth];
+    const uint8_t* prev = y > 0 ? out - kFrameWidth : nullptr;
+    if (rgb565) imageStatsAddRgb565(s, row, prev, kFrameWidth, out);
+    else imageStatsAddRgb888(s, row, prev, kFrameWidth, out);
+  }
+}
+
+int main(int argc, char** argv) {
+  const char* sprint1_dir = argc > 1 ? argv[1] : kSprint1DataDir;
+  const char* data_dir = argc > 2 ? argv[2] : kDefaultDataDir;
+  std::vector<LabeledImage> images = listSprint1Images(sprint1_dir);
+  if (images.empty()) images = listRepresentativeImages(data_dir);
+  std::vector<Frame> frames;
+  for (const LabeledImage& img : images) {
+    size_t len = 0;
+    uint8_t* jpeg = loadFile(img.path.c_str(), &len);
+    std::vector<uint8_t> rgb;
+    int w = 0, h = 0;
+    if (jpeg && decodeJpegRgb(jpeg, len, &rgb, &w, &h)) frames.push_back(makeFrame(rgb, w, h));
+    free(jpeg);
+  }
+  if (frames.empty()) {
+    fprintf(stderr, "❌ Nenhuma imagem em %s nem em %s\n", sprint1_dir, data_dir);
+    return 1;
+  }
+  printf("🖼️  %zu frames %dx%d: médias, variância, histogramas %dx%d e gradiente\n\n",
+         frames.size(), kFrameWidth, kFrameHeight, kStatsChannels, kStatsBins);
+  printf("%-8s %16s %16s %8s  %s\n", "origem", "várias us/frame", "uma us/frame", "speedup",
+         "acumuladores");
+
+  std::vector<uint8_t> luma_a((size_t)kFrameWidth * kFrameHeight), luma_b(luma_a.size());
+  bool identical = true;
+  for (int rgb565 = 0; rgb565 < 2; ++rgb565) {
+    bool same = true;
+    for (const Frame& f : frames) {
+      ImageStats a, b;
+      multiPass(f, rgb565, &luma_a, &a);
+      onePass(f, rgb565, &luma_b, &b);
+      same = same && memcmp(&a, &b, sizeof(a)) == 0 && luma_a == luma_b;
+    }
+    double us[2] = { 1e30, 1e30 };
+    for (int r = 0; r < 3; ++r) {
+      for (int path = 0; path < 2; ++path) {
+        auto t0 = std::chrono::steady_clock::now();
+        for (int k = 0; k < kRepeats; ++k) {
+          for (const Frame& f : frames) {
+            ImageStats s;
+            if (path == 0) multiPass(f, rgb565, &luma_a, &s);
+            else onePass(f, rgb565, &luma_b, &s);
+          }
+        }
+        us[path] = std::min(us[path], elapsedUs(t0) / (kRepeats * frames.size()));
+      }
+    }
+    identical = identical && same;
+    printf("%-8s %16.1f %16.1f %7.2fx  %s\n", rgb565 ? "RGB565" : "RGB888", us[0], us[1],
+           us[0] / us[1], same ? "✅ idênticos" : "❌ DIFERENTES");
+  }
+
+  // Calibração: Welford incremental x média/desvio em duas passadas
+  std::vector<std::vector<float>> samples;
+  FeatureWelford calib;
+  welfordReset(&calib);
+  for (size_t k = 0; k < frames.size() && (int)k < kCalibSamples; ++k) {
+    ImageStats s;
+    onePass(frames[k], true, &luma_b, &s);
+    std::vector<float> feat(kGateFeatures);
+    imageStatsFeatures(s, 0, kFrameWidth, kFrameHeight, feat.data());
+    welfordAdd(&calib, feat.data());
+    samples.push_back(feat);
+  }
+  double worst = 0.0;
+  for (int i = 0; i < kGateFeatures; ++i) {
+    double mean = 0.0, var = 0.0;
+    for (const std::vector<float>& f : samples) mean += f[i] / samples.size();
+    for (const std::vector<float>& f : samples) var += (f[i] - mean) * (f[i] - mean);
+    const double sd = samples.size() > 1 ? sqrt(var / (samples.size() - 1)) : 0.0;
+    worst = std::max(worst, fabs(mean - calib.mean[i]));
+    worst = std::max(worst, fabs(sd - welfordStd(calib, i)));
+  }
+  printf("\n🎯 Welford (%u amostras RGB565, textura pelo gradiente): máx |Δ| média/desvio = "
+         "%.2e %s\n", calib.count, worst, worst < 1e-5 ? "✅" : "❌");
+  return identical && worst < 1e-5 ? 0 : 1;
+}
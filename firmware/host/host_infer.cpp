@@ -0,0 +1,100 @@
+/*
+ * SPRINT 3 - Inferência INT8 no Host
+ * ==================================
+ *
+ * Executa o motor INT8 do firmware sobre model_int8.tflite e mede a
+ * latência real por frame no dataset representativo, no lugar do
+ * tempo fixo de 150 ms reportado pelo firmware.
+ *
+ * Uso:
+ *     ./build/host_infer [modelo.tflite] [representative_data]
+ *
+ * Autor: Equipe SPRINT 3
+ * Data: 2025
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "host_common.h"
+#include "int8_engine.h"
+
+static const size_t kHostArenaSize = 1024 * 1024;
+static const int kRepeats = 5;
+
+int main(int argc, char** argv) {
+  const char* model_path = argc > 1 ? argv[1] : kDefaultModelPath;
+  const char* data_dir = argc > 2 ? argv[2] : kDefaultDataDir;
+
+  size_t model_size = 0;
+  uint8_t* model = loadFile(model_path, &model_size);
+  if (!model) {
+    fprintf(stderr, "❌ Modelo não encontrado: %s\n", model_path);
+    return 1;
+  }
+
+  static uint8_t arena[kHostArenaSize];
+  static Int8Engine engine;
+  if (!engine.begin(model, model_size, arena, sizeof(arena))) {
+    fprintf(stderr, "❌ Falha ao carregar modelo: %s\n", engine.errorMessage());
+    return 1;
+  }
+  printf("🧠 Modelo: %s (%zu bytes, %d camadas)\n", model_path, model_size, engine.layerCount());
+  printf("📐 Entrada: %dx%dx%d | Arena usada: %zu bytes\n", engine.inputWidth(),
+         engine.inputHeight(), engine.inputChannels(), engine.arenaUsed());
+
+  std::vector<LabeledImage> images = listRepresentativeImages(data_dir);
+  if (images.empty()) {
+    fprintf(stderr, "❌ Nenhuma imagem em %s\n", data_dir);
+    return 1;
+  }
+
+  std::vector<double> latencies;
+  int correct = 0;
+  for (const LabeledImage& img : images) {
+    size_t len = 0;
+    uint8_t* jpeg = loadFile(img.path.c_str(), &len);
+    std::vector<uint8_t> gray;
+    int w = 0, h = 0;
+    if (!jpeg || !decodeJpegGray(jpeg, len, &gray, &w, &h)) {
+      fprintf(stderr, "⚠️  Falha ao decodificar %s\n", img.path.c_str());
+      free(jpeg);
+      continue;
+    }
+    free(jpeg);
+
+    double best = 1e30;
+    for (int r = 0; r < kRepeats; ++r) {
+      auto t0 = std::chrono::steady_clock::now();
+      engine.setInputFromGray(gray.data(), w, h);
+      if (!engine.invoke()) {
+        fprintf(stderr, "❌ Falha na inferência: %s\n", engine.errorMessage());
+        return 1;
+      }
+      best = std::min(best, elapsedUs(t0));
+    }
+    latencies.push_back(best);
+
+    const float hp = engine.outputValue(0);
+    const float nao_hp = engine.outputValue(1);
+    const int predicted = hp >= nao_hp ? 0 : 1;
+    if (predicted == img.label) ++correct;
+    printf("%-52s HP=%.3f NAO_HP=%.3f -> %s (%.2f ms)\n", img.path.c_str(), hp, nao_hp,
+           predicted == 0 ? "HP_ORIGINAL" : "NAO_HP", best / 1000.0);
+  }
+
+  if (latencies.empty()) return 1;
+  std::sort(latencies.begin(), latencies.end());
+  double sum = 0;
+  for (double v : latencies) sum += v;
+  printf("\n📊 Imagens: %zu | Acurácia: %.1f%%\n", latencies.size(),
+         100.0 * correct / latencies.size());
+  printf("⏱️  Latência por frame: média=%.2f ms mediana=%.2f ms min=%.2f ms max=%.2f ms\n",
+         sum / latencies.size() / 1000.0, latencies[latencies.size() / 2] / 1000.0,
+         latencies.front() / 1000.0, latencies.back() / 1000.0);
+  free(model);
+  return 0;
+}
@@ -0,0 +1,200 @@
+/*
+ * SPRINT 3 - Pesos INT4 da Camada Densa: Bytes, Latência e Acurácia
+ * =================================================================
+ *
+ * Compara o g_model com a FullyConnected grande em int8 (pesos em
+ * blocos, GEMV com 8 KB de scratch como no firmware) e com a cópia em
+ * 4 bits do blob I8PK (Int8Engine::setInt4Dense):
+ *
+ *   - bytes de pesos lidos por inferência (LayerProfiler);
+ *   - latência da camada densa e da inferência inteira;
+ *   - acurácia nas fotos da Sprint 1 e no dataset representativo,
+ *     concordância int8 x int4, maior diferença nas probabilidades e,
+ *     em passos de quantização, na saída da densa e nos logits.
+ *
+ * Uso:
+ *     ./build/host_int4 [dataset_sprint1] [dados_representativos]
+ *
+ * Autor: Equipe SPRINT 3
+ * Data: 2025
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <vector>
+
+#include "host_common.h"
+#include "int8_engine.h"
+#include "model.h"
+
+static const size_t kHostArenaSize = 1024 * 1024;
+static const size_t kWeightScratchSize = 8 * 1024;   // Igual ao firmware
+static const int kPasses = 3;
+
+struct Frame {
+  std::vector<uint8_t> gray;
+  int width;
+  int height;
+  int label;
+};
+
+static std::vector<Frame> loadFrames(const std::vector<LabeledImage>& images) {
+  std::vector<Frame> frames;
+  for (const LabeledImage& img : images) {
+    size_t len = 0;
+    uint8_t* jpeg = loadFile(img.path.c_str(), &len);
+    Frame frame;
+    frame.label = img.label;
+    if (jpeg && decodeJpegGray(jpeg, len, &frame.gray, &frame.width, &frame.height)) {
+      frames.push_back(std::move(frame));
+    }
+    free(jpeg);
+  }
+  return frames;
+}
+
+struct Accuracy {
+  int correct_int8;
+  int correct_int4;
+  int agree;
+  float max_prob_diff;
+  int max_dense_diff;        // Saída da densa, em passos de quantização
+  double mean_dense_diff;
+  int max_logit_diff;        // Entrada do Softmax
+};
+
+// Maior e soma das |diferenças| entre a saída da camada nos dois motores
+static int outputDiff(const Int8Engine& a, const Int8Engine& b, int layer, double* sum) {
+  const Int8Tensor& ta = a.tensor(a.layer(layer).output);
+  const Int8Tensor& tb = b.tensor(b.layer(layer).output);
+  int worst = 0;
+  for (uint32_t i = 0; i < ta.bytes; ++i) {
+    const int d = abs(ta.data[i] - tb.data[i]);
+    if (d > worst) worst = d;
+    if (sum) *sum += (double)d / ta.bytes;
+  }
+  return worst;
+}
+
+static Accuracy evaluate(Int8Engine& int8, Int8Engine& int4, const std::vector<Frame>& frames,
+                         int dense) {
+  Accuracy acc = { 0, 0, 0, 0.0f, 0, 0.0, 0 };
+  const int logits = int8.layerCount() - 2;
+  for (const Frame& f : frames) {
+    int8.setInputFromGray(f.gray.data(), f.width, f.height);
+    int4.setInputFromGray(f.gray.data(), f.width, f.height);
+    // Camada a camada, para ler as saídas antes de a arena reaproveitá-las
+    for (int l = 0; l < int8.layerCount(); ++l) {
+      int8.invokeLayer(l);
+      int4.invokeLayer(l);
+      if (l == dense) {
+        double sum = 0.0;
+        const int d = outputDiff(int8, int4, l, &sum);
+        if (d > acc.max_dense_diff) acc.max_dense_diff = d;
+        acc.mean_dense_diff += sum / frames.size();
+      }
+      if (l == logits) {
+        const int d = outputDiff(int8, int4, l, nullptr);
+        if (d > acc.max_logit_diff) acc.max_logit_diff = d;
+      }
+    }
+    const int p8 = int8.outputValue(0) >= int8.outputValue(1) ? 0 : 1;
+    const int p4 = int4.outputValue(0) >= int4.outputValue(1) ? 0 : 1;
+    if (p8 == f.label) ++acc.correct_int8;
+    if (p4 == f.label) ++acc.correct_int4;
+    if (p8 == p4) ++acc.agree;
+    const float diff = fabsf(int8.outputValue(0) - int4.outputValue(0));
+    if (diff > acc.max_prob_diff) acc.max_prob_diff = diff;
+  }
+  return acc;
+}
+
+static void printAccuracy(const char* name, const Accuracy& acc, size_t n) {
+  printf("%-16s %5zu %9.1f%% %9.1f%% %10.1f%% %9.3f %6d %7.2f %7d\n", name, n,
+         100.0 * acc.correct_int8 / n, 100.0 * acc.correct_int4 / n, 100.0 * acc.agree / n,
+         acc.max_prob_diff, acc.max_dense_diff, acc.mean_dense_diff, acc.max_logit_diff);
+}
+
+int main(int argc, char** argv) {
+  const char* sprint1_dir = argc > 1 ? argv[1] : kSprint1DataDir;
+  const char* data_dir = argc > 2 ? argv[2] : kDefaultDataDir;
+
+  static uint8_t arena8[kHostArenaSize];
+  static uint8_t arena4[kHostArenaSize];
+  static int8_t scratch8[kWeightScratchSize];
+  static int8_t scratch4[kWeightScratchSize];
+  static Int8Engine int8;
+  static Int8Engine int4;
+  static LayerProfiler prof8;
+  static LayerProfiler prof4;
+  Int8Engine* engines[2] = { &int8, &int4 };
+  uint8_t* arenas[2] = { arena8, arena4 };
+  int8_t* scratches[2] = { scratch8, scratch4 };
+  LayerProfiler* profilers[2] = { &prof8, &prof4 };
+  for (int e = 0; e < 2; ++e) {
+    engines[e]->setPackedWeights(g_model_packed, g_model_packed_len);
+    engines[e]->setWeightStreaming(scratches[e], kWeightScratchSize);
+    engines[e]->setInt4Dense(e == 1);
+    engines[e]->setProfiler(profilers[e]);
+    if (!engines[e]->begin(g_model, g_model_len, arenas[e], kHostArenaSize)) {
+      fprintf(stderr, "❌ Falha ao carregar modelo: %s\n", engines[e]->errorMessage());
+      return 1;
+    }
+  }
+  if (int4.int4LayerCount() == 0) {
+    fprintf(stderr, "❌ g_model_packed sem seção int4: regenere o model.h "
+                    "(convert_to_c_array.py sem --no-int4)\n");
+    return 1;
+  }
+
+  std::vector<Frame> representative = loadFrames(listRepresentativeImages(data_dir));
+  std::vector<Frame> sprint1 = loadFrames(listSprint1Images(sprint1_dir));
+  if (representative.empty()) {
+    fprintf(stderr, "❌ Nenhuma imagem em %s\n", data_dir);
+    return 1;
+  }
+
+  // Latência e bytes: primeira passada aquece caches
+  for (int e = 0; e < 2; ++e) {
+    for (int pass = 0; pass <= kPasses; ++pass) {
+      if (pass == 1) profilers[e]->reset();
+      for (const Frame& f : representative) {
+        engines[e]->setInputFromGray(f.gray.data(), f.width, f.height);
+        engines[e]->invoke();
+      }
+    }
+  }
+  int dense = -1;
+  for (int l = 0; l < int4.layerCount(); ++l) {
+    if (int4.layer(l).int4) dense = l;
+  }
+
+  printf("🧠 FullyConnected #%d: %d -> %d (%u MACs)\n\n", dense, int4.layer(dense).shape.in_c,
+         int4.layer(dense).shape.out_c, prof8.layer(dense).macs);
+  printf("%-6s %14s %14s %12s %12s\n", "pesos", "lidos/camada", "lidos/inferên.", "densa (us)",
+         "total (us)");
+  for (int e = 0; e < 2; ++e) {
+    const LayerProfiler& p = *profilers[e];
+    printf("%-6s %14u %14u %12.1f %12.1f\n", e ? "int4" : "int8", p.layer(dense).bytes_read,
+           p.totalBytesRead(), p.meanUs(dense), p.meanInferenceUs());
+  }
+  printf("\n📉 Bytes da camada densa: %.2fx menos | latência da densa: %.2fx\n\n",
+         (double)prof8.layer(dense).bytes_read / prof4.layer(dense).bytes_read,
+         prof8.meanUs(dense) / prof4.meanUs(dense));
+
+  printf("%-16s %5s %10s %10s %11s %9s %6s %7s %7s\n", "dataset", "fotos", "acc int8",
+         "acc int4", "concordam", "máx|Δp|", "densa", "média", "logits");
+  if (!sprint1.empty()) {
+    printAccuracy("Sprint 1", evaluate(int8, int4, sprint1, dense), sprint1.size());
+  } else {
+    printf("%-16s (sem imagens em %s)\n", "Sprint 1", sprint1_dir);
+  }
+  printAccuracy("representativo", evaluate(int8, int4, representative, dense),
+                representative.size());
+  printf("\n(densa/logits: maior |diferença| int8 x int4 em passos de quantização; "
+         "média na densa)\n");
+  return 0;
+}
@@ -0,0 +1,209 @@
+/*
+ * SPRINT 3 - Benchmark da Decodificação JPEG Só-Luminância
+ * ========================================================
+ *
+ * Compara, sobre o dataset representativo do modelo e as fotos da
+ * Sprint 1 (tamanho de câmera), a decodificação colorida do TJpgDec
+ * (RGB888 + jpegScaledWrite) com a cópia só-luminância (jpegScaledDecodeLuma:
+ * Cb/Cr sem IDCT, sem conversão YCbCr -> RGB, 1 byte por pixel).
+ *
+ * Para cada escala reporta us/imagem, a diferença da luminância em
+ * níveis de cinza (0..255) e o desvio máximo do vetor de 6
+ * características (as médias R/G/B do modo só-luminância vêm do DC de
+ * Cb/Cr). Depois mede o caminho do firmware (escala do jpegScaleFor +
+ * InputAreaStream) até o tensor de entrada e confere os passos int8 e a
+ * classificação da CNN contra a decodificação colorida.
+ *
+ * Uso:
+ *     ./build/host_jpeg_luma [dados_representativos] [dataset_sprint1]
+ *
+ * Autor: Equipe SPRINT 3
+ * Data: 2025
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "feature_gate.h"
+#include "host_common.h"
+#include "input_preprocess.h"
+#include "int8_engine.h"
+#include "jpeg_scaled.h"
+#include "model.h"
+
+static const size_t kHostArenaSize = 1024 * 1024;
+static const int kRepeats = 5;
+
+struct Photo {
+  std::vector<uint8_t> jpeg;
+  int width, height;
+};
+
+// Colorida (esp_jpg_decode + jpegScaledWrite) ou só-luminância, na escala dada
+static bool decode(bool luma, const Photo& p, int scale, uint8_t* gray, size_t capacity,
+                   InputAreaStream* stream, JpegScaledSink* sink) {
+  jpegScaledBegin(sink, p.jpeg.data(), gray, capacity);
+  sink->stream = stream;
+  const bool done = luma ? jpegScaledDecodeLuma(sink, p.jpeg.size(), scale)
+                         : decodeJpegScaled(p.jpeg.data(), p.jpeg.size(), scale,
+                                            jpegScaledWrite, sink);
+  return done && !sink->error;
+}
+
+static int classify(Int8Engine& engine) {
+  if (!engine.invoke()) return -1;
+  return engine.outputValue(0) >= engine.outputValue(1) ? 0 : 1;
+}
+
+// Tabela por escala e entrada da CNN para um conjunto de fotos
+static bool benchmark(Int8Engine& engine, const char* name,
+                      const std::vector<LabeledImage>& images) {
+  const int in_w = engine.inputWidth(), in_h = engine.inputHeight();
+  const size_t in_size = (size_t)in_w * in_h * engine.inputChannels();
+  std::vector<Photo> photos;
+  size_t max_pixels = 0;
+  for (const LabeledImage& img : images) {
+    size_t len = 0;
+    uint8_t* jpeg = loadFile(img.path.c_str(), &len);
+    if (!jpeg) continue;
+    Photo p;
+    p.jpeg.assign(jpeg, jpeg + len);
+    free(jpeg);
+    std::vector<uint8_t> rgb;
+    if (!decodeJpegRgb(p.jpeg.data(), len, &rgb, &p.width, &p.height)) continue;
+    max_pixels = std::max(max_pixels, (size_t)p.width * p.height);
+    photos.push_back(std::move(p));
+  }
+  if (photos.empty()) return false;
+  printf("📷 %s: %zu JPEGs (até %zu pixels)\n\n", name, photos.size(), max_pixels);
+
+  // =========================================================================
+  // DECODIFICAÇÃO POR ESCALA
+  // =========================================================================
+  std::vector<uint8_t> color_gray(max_pixels), luma_gray(max_pixels);
+  printf("%-8s %12s %12s %8s %10s %10s %14s\n", "escala", "cor us/img", "luma us/img",
+         "speedup", "máx cinza", "média", "máx Δ caract.");
+  bool ok = true;
+  for (int scale = 0; scale <= kJpegMaxScale; ++scale) {
+    double us[2] = { 1e30, 1e30 };
+    for (int r = 0; r < kRepeats; ++r) {
+      for (int luma = 0; luma < 2; ++luma) {
+        auto t0 = std::chrono::steady_clock::now();
+        for (const Photo& p : photos) {
+          JpegScaledSink sink;
+          decode(luma, p, scale, color_gray.data(), color_gray.size(), nullptr, &sink);
+        }
+        us[luma] = std::min(us[luma], elapsedUs(t0) / photos.size());
+      }
+    }
+
+    int worst = 0;
+    double mean = 0.0;
+    size_t pixels = 0;
+    float worst_feature = 0.0f;
+    for (const Photo& p : photos) {
+      JpegScaledSink color, luma;
+      const bool done =
+          decode(false, p, scale, color_gray.data(), color_gray.size(), nullptr, &color) &&
+          decode(true, p, scale, luma_gray.data(), luma_gray.size(), nullptr, &luma) &&
+          color.width == luma.width && color.height == luma.height;
+      ok = ok && done;
+      if (!done) continue;
+      const size_t n = (size_t)color.width * color.height;
+      for (size_t i = 0; i < n; ++i) {
+        const int d = abs(color_gray[i] - luma_gray[i]);
+        worst = std::max(worst, d);
+        mean += d;
+      }
+      pixels += n;
+      float fc[kGateFeatures], fl[kGateFeatures];
+      imageStatsFeatures(color.stats, p.jpeg.size(), p.width, p.height, fc);
+      imageStatsFeatures(luma.stats, p.jpeg.size(), p.width, p.height, fl);
+      for (int i = 0; i < kGateFeatures; ++i) {
+        worst_feature = std::max(worst_feature, fabsf(fc[i] - fl[i]));
+      }
+    }
+    printf("1/%-6d %12.1f %12.1f %7.2fx %10d %10.3f %14.4f\n", 1 << scale, us[0], us[1],
+           us[0] / us[1], worst, pixels ? mean / pixels : 0.0, worst_feature);
+  }
+
+  // =========================================================================
+  // ENTRADA DA CNN (como o firmware: escala do jpegScaleFor + streaming)
+  // =========================================================================
+  // Frames menores que a entrada não cabem no InputAreaStream (só reduz):
+  // luminância no buffer + setInputFromGray
+  static InputAreaStream stream;
+  auto runStream = [&](bool luma, const Photo& p) -> bool {
+    const int scale = jpegScaleFor(p.width, p.height, in_w, in_h);
+    JpegScaledSink sink;
+    if (p.width >= in_w && p.height >= in_h) {
+      return engine.beginInputStream(&stream, p.width >> scale, p.height >> scale) &&
+             decode(luma, p, scale, nullptr, 0, &stream, &sink) && inputAreaStreamDone(stream);
+    }
+    return decode(luma, p, scale, luma_gray.data(), luma_gray.size(), nullptr, &sink) &&
+           engine.setInputFromGray(luma_gray.data(), sink.width, sink.height);
+  };
+  double us[2] = { 1e30, 1e30 };
+  for (int r = 0; r < kRepeats; ++r) {
+    for (int luma = 0; luma < 2; ++luma) {
+      auto t0 = std::chrono::steady_clock::now();
+      for (const Photo& p : photos) runStream(luma, p);
+      us[luma] = std::min(us[luma], elapsedUs(t0) / photos.size());
+    }
+  }
+  std::vector<int8_t> color_input(in_size);
+  int max_steps = 0, same = 0;
+  for (const Photo& p : photos) {
+    if (!runStream(false, p)) {
+      ok = false;
+      continue;
+    }
+    std::copy(engine.input(), engine.input() + in_size, color_input.begin());
+    const int color_class = classify(engine);
+    if (!runStream(true, p)) {
+      ok = false;
+      continue;
+    }
+    for (size_t i = 0; i < in_size; ++i) {
+      max_steps = std::max(max_steps, abs(engine.input()[i] - color_input[i]));
+    }
+    const int luma_class = classify(engine);
+    same += luma_class >= 0 && luma_class == color_class;
+  }
+  printf("\n🧠 Entrada da CNN (escala do jpegScaleFor + InputAreaStream):\n");
+  printf("   cor: %.1f us/imagem | luma: %.1f us/imagem (%.2fx)\n", us[0], us[1],
+         us[0] / us[1]);
+  printf("   máx Δ do tensor: %d passos int8 | mesma classe: %d/%zu %s\n", max_steps, same,
+         photos.size(), same == (int)photos.size() ? "✅" : "⚠️");
+  if (!ok) printf("❌ Alguma decodificação falhou\n");
+  printf("\n");
+  return ok;
+}
+
+int main(int argc, char** argv) {
+  const char* data_dir = argc > 1 ? argv[1] : kDefaultDataDir;
+  const char* sprint1_dir = argc > 2 ? argv[2] : kSprint1DataDir;
+  static uint8_t arena[kHostArenaSize];
+  static Int8Engine engine;
+  if (!engine.begin(g_model, g_model_len, arena, sizeof(arena))) {
+    fprintf(stderr, "❌ Falha ao carregar modelo: %s\n", engine.errorMessage());
+    return 1;
+  }
+
+  // Dataset representativo (calibração do modelo) e, se houver, as fotos
+  // da Sprint 1 em tamanho de câmera
+  const std::vector<LabeledImage> representative = listRepresentativeImages(data_dir);
+  const std::vector<LabeledImage> sprint1 = listSprint1Images(sprint1_dir);
+  if (representative.empty() && sprint1.empty()) {
+    fprintf(stderr, "❌ Nenhuma imagem em %s nem em %s\n", data_dir, sprint1_dir);
+    return 1;
+  }
+  bool ok = true;
+  if (!representative.empty()) ok = benchmark(engine, data_dir, representative) && ok;
+  if (!sprint1.empty()) ok = benchmark(engine, sprint1_dir, sprint1) && ok;
+  return ok ? 0 : 1;
+}
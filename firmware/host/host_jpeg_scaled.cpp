@@ -0,0 +1,202 @@
+/*
+ * SPRINT 3 - Benchmark da Decodificação JPEG Reduzida (DCT)
+ * =========================================================
+ *
+ * Mede, sobre as fotos da Sprint 1 (ou o dataset representativo), o
+ * custo do TJpgDec vendorizado em cada escala:
+ *
+ *   - completa: RGB888 no tamanho original + laço de médias e
+ *     luminância, como o fmt2rgb888 do analyzeRealCharacteristics;
+ *   - 1/2, 1/4, 1/8: jpegScaledWrite (somas + luminância reduzida),
+ *     sem o buffer RGB888.
+ *
+ * Para cada escala reporta o desvio máximo do vetor de 6
+ * características em relação à decodificação completa. Depois mede o
+ * caminho do firmware com o modelo carregado (uma decodificação na
+ * escala do jpegScaleFor dá características e luminância) até o
+ * tensor de entrada e confere a classificação da CNN INT8 contra a
+ * entrada vinda da imagem completa.
+ *
+ * Uso:
+ *     ./build/host_jpeg_scaled [dataset_sprint1] [dados_representativos]
+ *
+ * Autor: Equipe SPRINT 3
+ * Data: 2025
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "feature_gate.h"
+#include "host_common.h"
+#include "int8_engine.h"
+#include "jpeg_scaled.h"
+#include "model.h"
+
+static const size_t kHostArenaSize = 1024 * 1024;
+static const int kRepeats = 5;
+
+struct Photo {
+  std::vector<uint8_t> jpeg;
+  int width, height;
+  float features[kGateFeatures];   // Da decodificação completa
+  std::vector<uint8_t> gray;       // Luminância completa
+};
+
+// Caminho atual: RGB888 completo, somas e luminância no mesmo laço
+static bool decodeFull(const Photo& p, float* features, std::vector<uint8_t>* gray) {
+  std::vector<uint8_t> rgb;
+  int w = 0, h = 0;
+  if (!decodeJpegRgb(p.jpeg.data(), p.jpeg.size(), &rgb, &w, &h)) return false;
+  JpegScaledSink sink;
+  gray->resize((size_t)w * h);
+  jpegScaledBegin(&sink, nullptr, gray->data(), gray->size());
+  jpegScaledWrite(&sink, 0, 0, (uint16_t)w, (uint16_t)h, nullptr);
+  jpegScaledWrite(&sink, 0, 0, (uint16_t)w, (uint16_t)h, rgb.data());
+  imageStatsFeatures(sink.stats, p.jpeg.size(), w, h, features);
+  return true;
+}
+
+static bool decodeScaled(const Photo& p, int scale, uint8_t* gray, size_t capacity,
+                         JpegScaledSink* sink) {
+  jpegScaledBegin(sink, p.jpeg.data(), gray, capacity);
+  return decodeJpegScaled(p.jpeg.data(), p.jpeg.size(), scale, jpegScaledWrite, sink);
+}
+
+static int classify(Int8Engine& engine, const uint8_t* gray, int w, int h) {
+  engine.setInputFromGray(gray, w, h);
+  if (!engine.invoke()) return -1;
+  return engine.outputValue(0) >= engine.outputValue(1) ? 0 : 1;
+}
+
+int main(int argc, char** argv) {
+  const char* sprint1_dir = argc > 1 ? argv[1] : kSprint1DataDir;
+  const char* data_dir = argc > 2 ? argv[2] : kDefaultDataDir;
+  static uint8_t arena[kHostArenaSize];
+  static Int8Engine engine;
+  if (!engine.begin(g_model, g_model_len, arena, sizeof(arena))) {
+    fprintf(stderr, "❌ Falha ao carregar modelo: %s\n", engine.errorMessage());
+    return 1;
+  }
+
+  std::vector<LabeledImage> images = listSprint1Images(sprint1_dir);
+  if (images.empty()) images = listRepresentativeImages(data_dir);
+  std::vector<Photo> photos;
+  size_t max_pixels = 0;
+  for (const LabeledImage& img : images) {
+    size_t len = 0;
+    uint8_t* jpeg = loadFile(img.path.c_str(), &len);
+    if (!jpeg) continue;
+    Photo p;
+    p.jpeg.assign(jpeg, jpeg + len);
+    free(jpeg);
+    if (!decodeJpegRgb(p.jpeg.data(), len, &p.gray, &p.width, &p.height)) continue;
+    if (!decodeFull(p, p.features, &p.gray)) continue;
+    max_pixels = std::max(max_pixels, (size_t)p.width * p.height);
+    photos.push_back(std::move(p));
+  }
+  if (photos.empty()) {
+    fprintf(stderr, "❌ Nenhuma imagem em %s nem em %s\n", sprint1_dir, data_dir);
+    return 1;
+  }
+  printf("📷 %zu JPEGs (até %zu pixels), entrada do modelo %dx%d\n\n", photos.size(),
+         max_pixels, engine.inputWidth(), engine.inputHeight());
+
+  // =========================================================================
+  // DECODIFICAÇÃO POR ESCALA
+  // =========================================================================
+  std::vector<uint8_t> gray(max_pixels);
+  printf("%-22s %12s %8s %14s %12s\n", "decodificação", "us/imagem", "speedup",
+         "máx Δ caract.", "RGB888");
+  double full_us = 0.0;
+  for (int scale = -1; scale <= kJpegMaxScale; ++scale) {
+    double us = 1e30;
+    for (int r = 0; r < kRepeats; ++r) {
+      auto t0 = std::chrono::steady_clock::now();
+      for (const Photo& p : photos) {
+        float features[kGateFeatures];
+        std::vector<uint8_t> full_gray;
+        JpegScaledSink sink;
+        if (scale < 0) decodeFull(p, features, &full_gray);
+        else decodeScaled(p, scale, gray.data(), gray.size(), &sink);
+      }
+      us = std::min(us, elapsedUs(t0) / photos.size());
+    }
+
+    float worst = 0.0f;
+    bool ok = true;
+    if (scale >= 0) {
+      for (const Photo& p : photos) {
+        JpegScaledSink sink;
+        ok = ok && decodeScaled(p, scale, gray.data(), gray.size(), &sink);
+        float features[kGateFeatures];
+        imageStatsFeatures(sink.stats, p.jpeg.size(), p.width, p.height, features);
+        for (int i = 0; i < kGateFeatures; ++i) {
+          worst = std::max(worst, fabsf(features[i] - p.features[i]));
+        }
+      }
+    } else {
+      full_us = us;
+    }
+
+    char name[32];
+    if (scale < 0) snprintf(name, sizeof(name), "completa (fmt2rgb888)");
+    else snprintf(name, sizeof(name), "1/%d%s", 1 << scale, scale == 0 ? " (writer)" : "");
+    printf("%-22s %12.1f %7.2fx %14.4f %12s%s\n", name, us, full_us / us, worst,
+           scale < 0 ? "w*h*3" : "não", ok ? "" : "  ❌ falhou");
+  }
+
+  // =========================================================================
+  // ENTRADA DA CNN (como o firmware com modelo carregado)
+  // =========================================================================
+  // Uma decodificação na escala do jpegScaleFor dá as características e a
+  // luminância; a comparação é até o tensor de entrada (a CNN é igual)
+  const int in_w = engine.inputWidth(), in_h = engine.inputHeight();
+  int same = 0;
+  int per_scale[kJpegMaxScale + 1] = { 0 };
+  double scaled_us = 1e30, full_input_us = 1e30;
+  std::vector<uint8_t> full_gray;
+  for (int r = 0; r < kRepeats; ++r) {
+    auto t0 = std::chrono::steady_clock::now();
+    for (const Photo& p : photos) {
+      float features[kGateFeatures];
+      decodeFull(p, features, &full_gray);
+      engine.setInputFromGray(full_gray.data(), p.width, p.height);
+    }
+    full_input_us = std::min(full_input_us, elapsedUs(t0) / photos.size());
+    t0 = std::chrono::steady_clock::now();
+    for (const Photo& p : photos) {
+      JpegScaledSink sink;
+      float features[kGateFeatures];
+      decodeScaled(p, jpegScaleFor(p.width, p.height, in_w, in_h), gray.data(), gray.size(),
+                   &sink);
+      imageStatsFeatures(sink.stats, p.jpeg.size(), p.width, p.height, features);
+      engine.setInputFromGray(gray.data(), sink.width, sink.height);
+    }
+    scaled_us = std::min(scaled_us, elapsedUs(t0) / photos.size());
+  }
+  for (const Photo& p : photos) {
+    JpegScaledSink sink;
+    decodeScaled(p, jpegScaleFor(p.width, p.height, in_w, in_h), gray.data(), gray.size(),
+                 &sink);
+    ++per_scale[jpegScaleFor(p.width, p.height, in_w, in_h)];
+    const int scaled_class = classify(engine, gray.data(), sink.width, sink.height);
+    same += scaled_class >= 0 && scaled_class == classify(engine, p.gray.data(), p.width,
+                                                          p.height);
+  }
+  printf("\n🧠 Características + entrada da CNN (escalas:");
+  for (int scale = 0; scale <= kJpegMaxScale; ++scale) {
+    if (per_scale[scale]) printf(" 1/%d x%d", 1 << scale, per_scale[scale]);
+  }
+  printf("):\n");
+  printf("   completa: %.1f us/imagem | reduzida: %.1f us/imagem (%.2fx)\n", full_input_us,
+         scaled_us, full_input_us / scaled_us);
+  printf("   mesma classe da CNN: %zu/%zu %s\n", (size_t)same, photos.size(),
+         same == (int)photos.size() ? "✅" : "⚠️");
+  printf("   frame 240x240 do firmware -> escala 1/%d\n", 1 << jpegScaleFor(240, 240, in_w, in_h));
+  return 0;
+}
@@ -0,0 +1,200 @@
+/*
+ * SPRINT 3 - Benchmark da Decodificação JPEG em Streaming (MCUs)
+ * ==============================================================
+ *
+ * Compara três caminhos do JPEG ao tensor de entrada 96x96 INT8, sobre
+ * as fotos da Sprint 1 (ou o dataset representativo):
+ *
+ *   - completa: RGB888 no tamanho original + luminância do frame
+ *     inteiro + setInputFromGray (fmt2rgb888, antes da user-018);
+ *   - reduzida: luminância na escala do jpegScaleFor num buffer do
+ *     tamanho reduzido + setInputFromGray;
+ *   - streaming: mesma escala, cada MCU somado na média por área do
+ *     InputAreaStream durante a decodificação (firmware atual).
+ *
+ * Reporta us/imagem, o pico de memória do pré-processamento, e confere
+ * que o streaming escreve bit a bit a média por área inteira (mesmas
+ * caixas de rgb565ToInt8Area) da luminância reduzida, além da
+ * classificação da CNN contra o caminho completo.
+ *
+ * Uso:
+ *     ./build/host_jpeg_stream [dataset_sprint1] [dados_representativos]
+ *
+ * Autor: Equipe SPRINT 3
+ * Data: 2025
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "feature_gate.h"
+#include "host_common.h"
+#include "input_preprocess.h"
+#include "int8_engine.h"
+#include "jpeg_scaled.h"
+#include "model.h"
+
+static const size_t kHostArenaSize = 1024 * 1024;
+static const int kRepeats = 5;
+
+struct Photo {
+  std::vector<uint8_t> jpeg;
+  int width, height;
+  int scale;
+};
+
+// Média por área inteira da luminância (caixas [x*W/out_w, (x+1)*W/out_w))
+static void areaReference(const uint8_t* gray, int w, int h, int out_w, int out_h,
+                          float scale, int32_t zero_point, int8_t* out) {
+  for (int y = 0; y < out_h; ++y) {
+    const int y0 = y * h / out_h, y1 = (y + 1) * h / out_h;
+    for (int x = 0; x < out_w; ++x) {
+      const int x0 = x * w / out_w, x1 = (x + 1) * w / out_w;
+      uint32_t sum = 0;
+      for (int iy = y0; iy < y1; ++iy) {
+        for (int ix = x0; ix < x1; ++ix) sum += gray[(size_t)iy * w + ix];
+      }
+      const uint32_t count = (uint32_t)((y1 - y0) * (x1 - x0));
+      const int p = (int)((sum + count / 2) / count);
+      int32_t q = (int32_t)lroundf(((float)p / 255.0f) / scale) + zero_point;
+      out[y * out_w + x] = (int8_t)std::max(-128, std::min(127, q));
+    }
+  }
+}
+
+static int classify(Int8Engine& engine) {
+  if (!engine.invoke()) return -1;
+  return engine.outputValue(0) >= engine.outputValue(1) ? 0 : 1;
+}
+
+int main(int argc, char** argv) {
+  const char* sprint1_dir = argc > 1 ? argv[1] : kSprint1DataDir;
+  const char* data_dir = argc > 2 ? argv[2] : kDefaultDataDir;
+  static uint8_t arena[kHostArenaSize];
+  static Int8Engine engine;
+  if (!engine.begin(g_model, g_model_len, arena, sizeof(arena))) {
+    fprintf(stderr, "❌ Falha ao carregar modelo: %s\n", engine.errorMessage());
+    return 1;
+  }
+  const int in_w = engine.inputWidth(), in_h = engine.inputHeight();
+  const size_t in_size = (size_t)in_w * in_h * engine.inputChannels();
+
+  std::vector<LabeledImage> images = listSprint1Images(sprint1_dir);
+  if (images.empty()) images = listRepresentativeImages(data_dir);
+  std::vector<Photo> photos;
+  size_t max_pixels = 0, max_scaled = 0;
+  for (const LabeledImage& img : images) {
+    size_t len = 0;
+    uint8_t* jpeg = loadFile(img.path.c_str(), &len);
+    if (!jpeg) continue;
+    Photo p;
+    p.jpeg.assign(jpeg, jpeg + len);
+    free(jpeg);
+    std::vector<uint8_t> rgb;
+    if (!decodeJpegRgb(p.jpeg.data(), len, &rgb, &p.width, &p.height)) continue;
+    p.scale = jpegScaleFor(p.width, p.height, in_w, in_h);
+    max_pixels = std::max(max_pixels, (size_t)p.width * p.height);
+    max_scaled = std::max(max_scaled, (size_t)(p.width >> p.scale) * (p.height >> p.scale));
+    photos.push_back(std::move(p));
+  }
+  if (photos.empty()) {
+    fprintf(stderr, "❌ Nenhuma imagem em %s nem em %s\n", sprint1_dir, data_dir);
+    return 1;
+  }
+  printf("📷 %zu JPEGs -> entrada %dx%dx%d INT8\n\n", photos.size(), in_w, in_h,
+         engine.inputChannels());
+
+  std::vector<uint8_t> gray(std::max(max_pixels, max_scaled));
+  static InputAreaStream stream;
+  // 0 = completa, 1 = reduzida, 2 = streaming; devolve false se falhar
+  auto run = [&](int path, const Photo& p, float* features) -> bool {
+    JpegScaledSink sink;
+    if (path == 0) {
+      std::vector<uint8_t> rgb;
+      int w = 0, h = 0;
+      if (!decodeJpegRgb(p.jpeg.data(), p.jpeg.size(), &rgb, &w, &h)) return false;
+      jpegScaledBegin(&sink, nullptr, gray.data(), gray.size());
+      jpegScaledWrite(&sink, 0, 0, (uint16_t)w, (uint16_t)h, nullptr);
+      jpegScaledWrite(&sink, 0, 0, (uint16_t)w, (uint16_t)h, rgb.data());
+      imageStatsFeatures(sink.stats, p.jpeg.size(), w, h, features);
+      return engine.setInputFromGray(gray.data(), w, h);
+    }
+    jpegScaledBegin(&sink, p.jpeg.data(), path == 1 ? gray.data() : nullptr, gray.size());
+    if (path == 2) {
+      if (!engine.beginInputStream(&stream, p.width >> p.scale, p.height >> p.scale)) {
+        return false;
+      }
+      sink.stream = &stream;
+    }
+    if (!decodeJpegScaled(p.jpeg.data(), p.jpeg.size(), p.scale, jpegScaledWrite, &sink) ||
+        sink.error) {
+      return false;
+    }
+    imageStatsFeatures(sink.stats, p.jpeg.size(), p.width, p.height, features);
+    if (path == 1) return engine.setInputFromGray(gray.data(), sink.width, sink.height);
+    return inputAreaStreamDone(stream);
+  };
+
+  // Pico de memória do pré-processamento (além do JPEG e do tensor)
+  const size_t peak[3] = { max_pixels * 3 + max_pixels, max_scaled, sizeof(InputAreaStream) };
+  const char* names[3] = { "completa (fmt2rgb888)", "reduzida + buffer", "streaming (MCU)" };
+  printf("%-22s %12s %8s %14s %10s\n", "caminho", "us/imagem", "speedup", "pico (bytes)",
+         "classe");
+
+  std::vector<int> full_class(photos.size());
+  double base_us = 0.0;
+  bool ok = true;
+  for (int path = 0; path < 3; ++path) {
+    double us = 1e30;
+    for (int r = 0; r < kRepeats; ++r) {
+      auto t0 = std::chrono::steady_clock::now();
+      for (const Photo& p : photos) {
+        float features[kGateFeatures];
+        run(path, p, features);
+      }
+      us = std::min(us, elapsedUs(t0) / photos.size());
+    }
+    if (path == 0) base_us = us;
+
+    int same = 0;
+    for (size_t i = 0; i < photos.size(); ++i) {
+      float features[kGateFeatures];
+      const bool done = run(path, photos[i], features);
+      ok = ok && done;
+      const int c = done ? classify(engine) : -1;
+      if (path == 0) full_class[i] = c;
+      same += c >= 0 && c == full_class[i];
+    }
+    printf("%-22s %12.1f %7.2fx %14zu %6d/%zu\n", names[path], us, base_us / us, peak[path], same,
+           photos.size());
+  }
+
+  // Streaming contra a média por área inteira da luminância reduzida
+  const Int8Tensor& in = engine.tensor(engine.layer(0).input);
+  std::vector<int8_t> expected(in_size);
+  int mismatched = 0;
+  for (const Photo& p : photos) {
+    JpegScaledSink sink;
+    jpegScaledBegin(&sink, p.jpeg.data(), gray.data(), gray.size());
+    decodeJpegScaled(p.jpeg.data(), p.jpeg.size(), p.scale, jpegScaledWrite, &sink);
+    areaReference(gray.data(), sink.width, sink.height, in_w, in_h, in.scale, in.zero_point,
+                  expected.data());
+    float features[kGateFeatures];
+    if (!run(2, p, features) || memcmp(engine.input(), expected.data(), in_size) != 0) {
+      ++mismatched;
+    }
+  }
+  const int fw_scale = jpegScaleFor(240, 240, in_w, in_h);
+  printf("\n📦 Frame 240x240 do firmware (1/%d): completa %d B | reduzida %d B | "
+         "streaming %zu B\n",
+         1 << fw_scale, 240 * 240 * 4, (240 >> fw_scale) * (240 >> fw_scale),
+         sizeof(InputAreaStream));
+  printf("🔍 Streaming x média por área da luminância reduzida: %s (%d/%zu diferentes)\n",
+         mismatched == 0 ? "✅ idêntico" : "❌ DIFERENTE", mismatched, photos.size());
+  return ok && mismatched == 0 ? 0 : 1;
+}
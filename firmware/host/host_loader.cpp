@@ -0,0 +1,175 @@
+/*
+ * SPRINT 3 - Carregamento do Modelo por Arquivo (mmap)
+ * ====================================================
+ *
+ * Abre o .tflite e o .i8pk pelo ModelFile (mmap no host), mede o
+ * tempo de abertura + begin() contra a leitura com cópia (loadFile)
+ * e contra o g_model compilado, confere que nenhum tensor foi
+ * copiado (pesos, bias e blocos empacotados apontam para dentro do
+ * mapeamento) e que as saídas são idênticas às do g_model embutido.
+ *
+ * Repete a conferência pelo openPartition() com as imagens de partição
+ * que o data_upload.py grava (cabeçalho de 16 bytes + arquivo), o
+ * caminho sem cópia do firmware (esp_partition_mmap no ESP32).
+ *
+ * Uso:
+ *     ./build/host_loader [modelo.tflite] [pesos.i8pk]
+ *
+ * Gere os arquivos com:
+ *     python3 ../../model/convert_to_c_array.py ../../model/model_int8.tflite \
+ *         -o ../../model/model.h --spiffs ../data
+ *
+ * Autor: Equipe SPRINT 3
+ * Data: 2025
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+
+#include "host_common.h"
+#include "int8_engine.h"
+#include "model.h"
+#include "model_file.h"
+
+static const char* const kDefaultPackedPath = "../data/model_int8.i8pk";
+static const char* const kModelImagePath = "build/model_partition.bin";
+static const char* const kPackedImagePath = "build/packed_partition.bin";
+static const size_t kHostArenaSize = 1024 * 1024;
+static const int kRepeats = 20;
+static const int kRandomInputs = 10;
+
+static bool inside(const void* p, const uint8_t* base, size_t size) {
+  return (const uint8_t*)p >= base && (const uint8_t*)p < base + size;
+}
+
+// Imagem de partição como a do data_upload.py
+static bool writePartitionImage(const char* path, const uint8_t* data, size_t size) {
+  FILE* f = fopen(path, "wb");
+  if (!f) return false;
+  ModelImageHeader header = { kModelImageMagic, (uint32_t)size, { 0, 0 } };
+  const bool ok = fwrite(&header, 1, sizeof(header), f) == sizeof(header) &&
+                  fwrite(data, 1, size, f) == size;
+  fclose(f);
+  return ok;
+}
+
+// Tensores constantes e blocos empacotados fora dos dois mapeamentos
+static int countOutside(const Int8Engine& engine, const ModelFile& model,
+                        const ModelFile& packed, int* constants) {
+  int outside = 0;
+  *constants = 0;
+  for (int t = 0; t < engine.tensorCount(); ++t) {
+    const Int8Tensor& tensor = engine.tensor(t);
+    if (!tensor.buffer) continue;
+    ++*constants;
+    if (!inside(tensor.buffer, model.data(), model.size())) ++outside;
+  }
+  for (int l = 0; l < engine.layerCount(); ++l) {
+    const Int8Layer& layer = engine.layer(l);
+    if (layer.packed && !inside(layer.packed, packed.data(), packed.size())) ++outside;
+  }
+  return outside;
+}
+
+int main(int argc, char** argv) {
+  const char* model_path = argc > 1 ? argv[1] : kDefaultModelPath;
+  const char* packed_path = argc > 2 ? argv[2] : kDefaultPackedPath;
+  static uint8_t arena_file[kHostArenaSize];
+  static uint8_t arena_embedded[kHostArenaSize];
+  static Int8Engine from_file;
+  static Int8Engine embedded;
+  static Int8Engine copied;
+
+  // Abertura + parsing: mmap (zero cópia) vs leitura com cópia vs g_model
+  double mmap_us = 1e30, copy_us = 1e30, embedded_us = 1e30;
+  ModelFile model, packed;
+  for (int r = 0; r < kRepeats; ++r) {
+    auto t0 = std::chrono::steady_clock::now();
+    if (!model.open(model_path)) {
+      fprintf(stderr, "❌ %s: %s\n", model_path, model.errorMessage());
+      return 1;
+    }
+    packed.open(packed_path);
+    from_file.setPackedWeights(packed.data(), packed.size());
+    if (!from_file.begin(model.data(), model.size(), arena_file, sizeof(arena_file))) {
+      fprintf(stderr, "❌ Falha ao carregar %s: %s\n", model_path, from_file.errorMessage());
+      return 1;
+    }
+    mmap_us = std::min(mmap_us, elapsedUs(t0));
+
+    t0 = std::chrono::steady_clock::now();
+    size_t size = 0;
+    uint8_t* copy = loadFile(model_path, &size);
+    copied.begin(copy, size, arena_embedded, sizeof(arena_embedded));
+    copy_us = std::min(copy_us, elapsedUs(t0));
+    free(copy);
+
+    t0 = std::chrono::steady_clock::now();
+    embedded.setPackedWeights(g_model_packed, g_model_packed_len);
+    embedded.begin(g_model, g_model_len, arena_embedded, sizeof(arena_embedded));
+    embedded_us = std::min(embedded_us, elapsedUs(t0));
+  }
+
+  printf("🧠 %s: %zu bytes (%s) | %s: %zu bytes\n", model_path, model.size(),
+         model.mapped() ? "mmap" : "cópia", packed_path, packed.size());
+  printf("📦 Camadas: %d (%d com pesos empacotados do .i8pk)\n\n", from_file.layerCount(),
+         from_file.packedLayerCount());
+  printf("⏱️  Abrir + begin(): mmap %.1f us | leitura com cópia %.1f us | g_model %.1f us\n",
+         mmap_us, copy_us, embedded_us);
+
+  // Zero cópia: todo tensor constante e todo bloco empacotado aponta para o arquivo
+  int constants = 0;
+  const int outside = countOutside(from_file, model, packed, &constants);
+  printf("%s %d tensores constantes lidos no lugar, %d fora do mapeamento\n",
+         outside == 0 ? "✅" : "❌", constants, outside);
+
+  // Imagens de partição (caminho do firmware): mesmos bytes, após o cabeçalho
+  static uint8_t arena_partition[kHostArenaSize];
+  static Int8Engine from_partition;
+  ModelFile model_part, packed_part;
+  bool partition_ok = writePartitionImage(kModelImagePath, model.data(), model.size()) &&
+                      writePartitionImage(kPackedImagePath, packed.data(), packed.size()) &&
+                      model_part.openPartition(kModelImagePath) &&
+                      packed_part.openPartition(kPackedImagePath);
+  if (partition_ok) {
+    from_partition.setPackedWeights(packed_part.data(), packed_part.size());
+    partition_ok = from_partition.begin(model_part.data(), model_part.size(), arena_partition,
+                                        sizeof(arena_partition));
+  }
+  int partition_constants = 0;
+  const int partition_outside =
+      partition_ok ? countOutside(from_partition, model_part, packed_part, &partition_constants)
+                   : -1;
+  partition_ok = partition_ok && partition_outside == 0 && model_part.mapped() &&
+                 (uintptr_t)model_part.data() % 16 == 0;
+  printf("%s openPartition: %zu + %zu bytes mapeados, %d tensores lidos no lugar\n",
+         partition_ok ? "✅" : "❌", model_part.size(), packed_part.size(), partition_constants);
+
+  // Paridade com o g_model compilado
+  uint32_t seed = 99;
+  const int input_size = embedded.inputWidth() * embedded.inputHeight() * embedded.inputChannels();
+  int mismatches = 0;
+  for (int n = 0; n < kRandomInputs; ++n) {
+    for (int i = 0; i < input_size; ++i) {
+      seed = seed * 1664525u + 1013904223u;
+      embedded.input()[i] = (int8_t)(seed >> 24);
+    }
+    memcpy(from_file.input(), embedded.input(), input_size);
+    embedded.invoke();
+    from_file.invoke();
+    if (memcmp(embedded.output(), from_file.output(), embedded.outputSize()) != 0) ++mismatches;
+    if (partition_ok) {
+      memcpy(from_partition.input(), embedded.input(), input_size);
+      from_partition.invoke();
+      if (memcmp(embedded.output(), from_partition.output(), embedded.outputSize()) != 0) {
+        ++mismatches;
+      }
+    }
+  }
+  printf("%s Saídas (arquivo e partição) vs g_model: %d divergências em %d entradas\n",
+         mismatches == 0 ? "✅" : "❌", mismatches, kRandomInputs);
+  return outside == 0 && partition_ok && mismatches == 0 ? 0 : 1;
+}
@@ -0,0 +1,110 @@
+/*
+ * SPRINT 3 - Benchmark dos Pesos Empacotados
+ * ==========================================
+ *
+ * Carrega o g_model embutido (src/model.h) duas vezes: com os pesos
+ * OHWI do flatbuffer e com o blob g_model_packed (blocos de
+ * kPackBlock canais). Confere que as saídas são idênticas em
+ * entradas pseudoaleatórias e compara a latência por camada.
+ *
+ * Só a FullyConnected grande vem em blocos, e só num blob gerado com
+ * --no-int4 (no padrão ela leva a seção int4, ver host_int4): as Conv2D
+ * e o classificador pequeno ficam OHWI, lidos pelo backend vetorial
+ * (host_backends), pelo kernel da 1ª camada ou por Winograd. Com o blob
+ * padrão a comparação cobre só as tabelas de requantização.
+ *
+ * Uso:
+ *     ./build/host_packed
+ *
+ * Autor: Equipe SPRINT 3
+ * Data: 2025
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+
+#include "host_common.h"
+#include "int8_engine.h"
+#include "model.h"
+
+static const size_t kHostArenaSize = 1024 * 1024;
+static const int kRandomInputs = 20;
+static const int kRepeats = 10;
+
+static const char* opName(Int8OpType op) {
+  switch (op) {
+    case kOpConv2D: return "Conv2D";
+    case kOpMaxPool2D: return "MaxPool2D";
+    case kOpFullyConnected: return "FullyConnected";
+    case kOpSoftmax: return "Softmax";
+    case kOpConv2DMaxPool: return "Conv2D+MaxPool";
+  }
+  return "?";
+}
+
+int main() {
+  static uint8_t arena_ohwi[kHostArenaSize];
+  static uint8_t arena_packed[kHostArenaSize];
+  static Int8Engine ohwi;
+  static Int8Engine packed;
+  packed.setPackedWeights(g_model_packed, g_model_packed_len);
+  if (!ohwi.begin(g_model, g_model_len, arena_ohwi, sizeof(arena_ohwi)) ||
+      !packed.begin(g_model, g_model_len, arena_packed, sizeof(arena_packed))) {
+    fprintf(stderr, "❌ Falha ao carregar modelo: %s / %s\n", ohwi.errorMessage(),
+            packed.errorMessage());
+    return 1;
+  }
+  printf("🧠 g_model: %d bytes | g_model_packed: %d bytes | %d/%d camadas empacotadas\n\n",
+         g_model_len, g_model_packed_len, packed.packedLayerCount(), packed.layerCount());
+  if (packed.packedLayerCount() == 0) {
+    printf("ℹ️  Blob sem camadas em blocos (densa grande em int4): gere o model.h com --no-int4\n\n");
+  }
+
+  double ohwi_us[Int8Engine::kMaxLayers];
+  double packed_us[Int8Engine::kMaxLayers];
+  std::fill(ohwi_us, ohwi_us + Int8Engine::kMaxLayers, 1e30);
+  std::fill(packed_us, packed_us + Int8Engine::kMaxLayers, 1e30);
+
+  // Entradas pseudoaleatórias cobrindo toda a faixa int8
+  uint32_t seed = 4242;
+  const int input_size = ohwi.inputWidth() * ohwi.inputHeight() * ohwi.inputChannels();
+  int mismatches = 0;
+  for (int n = 0; n < kRandomInputs; ++n) {
+    for (int i = 0; i < input_size; ++i) {
+      seed = seed * 1664525u + 1013904223u;
+      ohwi.input()[i] = (int8_t)(seed >> 24);
+    }
+    memcpy(packed.input(), ohwi.input(), input_size);
+    for (int r = 0; r < kRepeats; ++r) {
+      // Camadas intercaladas para que a variação da máquina afete os dois lados
+      for (int l = 0; l < ohwi.layerCount(); ++l) {
+        auto t0 = std::chrono::steady_clock::now();
+        ohwi.invokeLayer(l);
+        ohwi_us[l] = std::min(ohwi_us[l], elapsedUs(t0));
+        t0 = std::chrono::steady_clock::now();
+        packed.invokeLayer(l);
+        packed_us[l] = std::min(packed_us[l], elapsedUs(t0));
+      }
+    }
+    if (memcmp(ohwi.output(), packed.output(), ohwi.outputSize()) != 0) ++mismatches;
+  }
+
+  printf("%-4s %-16s %8s %12s %12s %8s\n", "#", "camada", "pesos", "OHWI us", "blocos us",
+         "speedup");
+  double total_ohwi = 0, total_packed = 0;
+  for (int l = 0; l < ohwi.layerCount(); ++l) {
+    const Int8Layer& layer = packed.layer(l);
+    printf("%-4d %-16s %8s %12.1f %12.1f %7.2fx\n", l, opName(layer.op),
+           layer.packed ? "blocos" : "-", ohwi_us[l], packed_us[l], ohwi_us[l] / packed_us[l]);
+    total_ohwi += ohwi_us[l];
+    total_packed += packed_us[l];
+  }
+  printf("\n⏱️  Latência: %.2f ms -> %.2f ms (%.2fx)\n", total_ohwi / 1000.0,
+         total_packed / 1000.0, total_ohwi / total_packed);
+  printf("%s Paridade: %d/%d entradas idênticas\n", mismatches ? "❌" : "✅",
+         kRandomInputs - mismatches, kRandomInputs);
+  return mismatches ? 1 : 0;
+}
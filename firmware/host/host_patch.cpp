@@ -0,0 +1,128 @@
+/*
+ * SPRINT 3 - Benchmark da Execução em Patches (MCUNet)
+ * ====================================================
+ *
+ * Para cada combinação de camadas em patches x grade, carrega o
+ * g_model embutido com os pesos empacotados, confere que a saída do
+ * bloco e a saída final são idênticas às da execução inteira em
+ * entradas pseudoaleatórias e mede o pico da arena, o recálculo nas
+ * bordas sobrepostas (MACs do bloco) e a latência.
+ *
+ * Uso:
+ *     ./build/host_patch
+ *
+ * Autor: Equipe SPRINT 3
+ * Data: 2025
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "host_common.h"
+#include "int8_engine.h"
+#include "model.h"
+
+static const size_t kHostArenaSize = 1024 * 1024;
+static const int kRandomInputs = 8;
+static const int kRepeats = 5;
+static const int kGrids[] = { 1, 2, 3, 4, 5 };
+
+// MACs das primeiras `layers` camadas na execução inteira
+static uint32_t blockMacs(const Int8Engine& engine, int layers) {
+  uint32_t macs = 0;
+  for (int l = 0; l < layers; ++l) {
+    const Int8Layer& layer = engine.layer(l);
+    if (layer.op == kOpMaxPool2D) continue;
+    const ConvShape& s = layer.shape;
+    macs += (uint32_t)s.out_h * s.out_w * s.out_c * s.k_h * s.k_w * s.in_c;
+  }
+  return macs;
+}
+
+static void fillInput(Int8Engine& engine, uint32_t seed) {
+  const int size = engine.inputWidth() * engine.inputHeight() * engine.inputChannels();
+  for (int i = 0; i < size; ++i) {
+    seed = seed * 1664525u + 1013904223u;
+    engine.input()[i] = (int8_t)(seed >> 24);
+  }
+}
+
+int main() {
+  static uint8_t arena_full[kHostArenaSize];
+  static uint8_t arena_patch[kHostArenaSize];
+  static Int8Engine full;
+  full.setPackedWeights(g_model_packed, g_model_packed_len);
+  if (!full.begin(g_model, g_model_len, arena_full, sizeof(arena_full))) {
+    fprintf(stderr, "❌ Falha ao carregar modelo: %s\n", full.errorMessage());
+    return 1;
+  }
+
+  // Referência: saída de cada camada e latência da execução inteira
+  std::vector<std::vector<int8_t>> ref_layers(kRandomInputs * full.layerCount());
+  double full_us = 1e30;
+  for (int n = 0; n < kRandomInputs; ++n) {
+    fillInput(full, 777 + n);
+    for (int l = 0; l < full.layerCount(); ++l) {
+      full.invokeLayer(l);
+      const Int8Tensor& t = full.tensor(full.layer(l).output);
+      ref_layers[n * full.layerCount() + l].assign(t.data, t.data + t.bytes);
+    }
+  }
+  for (int r = 0; r < kRepeats; ++r) {
+    auto t0 = std::chrono::steady_clock::now();
+    full.invoke();
+    full_us = std::min(full_us, elapsedUs(t0));
+  }
+
+  printf("🧠 g_model: %d camadas | arena inteira: %zu bytes | %.2f ms\n\n", full.layerCount(),
+         full.arenaUsed(), full_us / 1000.0);
+  printf("%-7s %-6s %10s %8s %12s %10s %10s %8s  %s\n", "camadas", "grade", "arena", "redução",
+         "buf. patch", "MACs", "latência", "vs ref", "saída");
+
+  bool all_identical = true;
+  for (int layers = 1; layers <= 3 && layers < full.layerCount(); ++layers) {
+    const uint32_t ref_macs = blockMacs(full, layers);
+    for (int grid : kGrids) {
+      static Int8Engine patched;
+      patched.setPackedWeights(g_model_packed, g_model_packed_len);
+      patched.setPatchInference(layers, grid);
+      if (!patched.begin(g_model, g_model_len, arena_patch, sizeof(arena_patch))) {
+        printf("%-7d %-6d %s\n", layers, grid, patched.errorMessage());
+        continue;
+      }
+
+      bool identical = true;
+      for (int n = 0; n < kRandomInputs; ++n) {
+        fillInput(patched, 777 + n);
+        // Saída do bloco e das camadas seguintes (as intermediárias do bloco
+        // não existem); conferidas logo após cada camada, antes de a arena
+        // reaproveitar o espaço
+        for (int l = 0; l < patched.layerCount(); ++l) {
+          patched.invokeLayer(l);
+          if (l < layers - 1) continue;
+          const Int8Tensor& t = patched.tensor(patched.layer(l).output);
+          const std::vector<int8_t>& ref = ref_layers[n * full.layerCount() + l];
+          if (memcmp(t.data, ref.data(), ref.size()) != 0) identical = false;
+        }
+      }
+      all_identical = all_identical && identical;
+
+      double us = 1e30;
+      for (int r = 0; r < kRepeats; ++r) {
+        auto t0 = std::chrono::steady_clock::now();
+        patched.invoke();
+        us = std::min(us, elapsedUs(t0));
+      }
+      printf("%-7d %dx%-4d %10zu %7.2fx %12zu %9.2fx %8.2f %7.2fx  %s\n", layers, grid, grid,
+             patched.arenaUsed(), (double)full.arenaUsed() / patched.arenaUsed(),
+             patched.patchBufferBytes(), (double)patched.patchMacs() / ref_macs, us / 1000.0,
+             us / full_us, identical ? "✅ idêntica" : "❌ DIFERENTE");
+    }
+  }
+  printf("\n(MACs: recálculo do bloco em patches relativo à execução inteira)\n");
+  return all_identical ? 0 : 1;
+}
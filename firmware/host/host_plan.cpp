@@ -0,0 +1,88 @@
+/*
+ * SPRINT 3 - Relatório do Planejamento da Arena
+ * =============================================
+ *
+ * Mostra o tempo de vida e o deslocamento de cada ativação escolhidos
+ * pelo planejador da arena, e compara o pico com a soma das
+ * ativações e com o orçamento TENSOR_ARENA_SIZE_KB do config.py.
+ * Confere também que o planejador recusa mais de kMaxPlannerBuffers
+ * buffers em vez de planejar só parte deles.
+ *
+ * Uso:
+ *     ./build/host_plan [modelo.tflite ...]
+ *
+ * Autor: Equipe SPRINT 3
+ * Data: 2025
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "host_common.h"
+#include "int8_engine.h"
+
+static const size_t kArenaBudget = 380 * 1024;   // config.py: TENSOR_ARENA_SIZE_KB
+static const size_t kHostArenaSize = 4 * 1024 * 1024;
+
+static bool reportModel(const char* path) {
+  size_t model_size = 0;
+  uint8_t* model = loadFile(path, &model_size);
+  if (!model) {
+    fprintf(stderr, "❌ Modelo não encontrado: %s\n", path);
+    return false;
+  }
+  static uint8_t arena[kHostArenaSize];
+  static Int8Engine engine;
+  if (!engine.begin(model, model_size, arena, sizeof(arena))) {
+    fprintf(stderr, "❌ %s: %s\n", path, engine.errorMessage());
+    free(model);
+    return false;
+  }
+
+  printf("🧠 %s\n", path);
+  printf("  %-6s %-22s %10s %8s %10s\n", "tensor", "forma", "bytes", "vida", "offset");
+  for (int i = 0; i < engine.tensorCount(); ++i) {
+    const Int8Tensor& t = engine.tensor(i);
+    if (!t.data || t.alias_of >= 0) continue;
+    char shape[32];
+    int n = 0;
+    for (int d = 0; d < t.num_dims && n < (int)sizeof(shape); ++d) {
+      n += snprintf(shape + n, sizeof(shape) - n, d ? "x%d" : "%d", (int)t.dims[d]);
+    }
+    printf("  %-6d %-22s %10u %3d..%-3d %10u\n", i, shape, (unsigned)t.bytes, t.first_use,
+           t.last_use, (unsigned)t.arena_offset);
+  }
+
+  const size_t peak = engine.arenaUsed();
+  printf("  📦 Soma das ativações: %zu bytes (%.1f KB)\n", engine.activationBytes(),
+         engine.activationBytes() / 1024.0);
+  printf("  📐 Pico planejado:     %zu bytes (%.1f KB, %.1fx menor)\n", peak, peak / 1024.0,
+         (double)engine.activationBytes() / peak);
+  printf("  %s Orçamento TENSOR_ARENA_SIZE_KB=%zu: %s\n\n", peak <= kArenaBudget ? "✅" : "⚠️ ",
+         kArenaBudget / 1024, peak <= kArenaBudget ? "cabe" : "excede");
+  free(model);
+  return true;
+}
+
+// Acima do limite o plano deve falhar (0), não truncar a lista
+static bool checkPlannerLimit() {
+  PlannerBuffer buffers[kMaxPlannerBuffers + 1];
+  for (int i = 0; i <= kMaxPlannerBuffers; ++i) {
+    buffers[i].size = 64;
+    buffers[i].first_use = (int16_t)i;
+    buffers[i].last_use = (int16_t)(i + 1);
+    buffers[i].offset = 0;
+  }
+  const bool ok = planArena(buffers, kMaxPlannerBuffers, 16) > 0 &&
+                  planArena(buffers, kMaxPlannerBuffers + 1, 16) == 0;
+  printf("%s Limite do planejador (%d buffers): %s\n", ok ? "✅" : "❌", kMaxPlannerBuffers,
+         ok ? "excesso recusado" : "excesso truncado");
+  return ok;
+}
+
+int main(int argc, char** argv) {
+  bool ok = checkPlannerLimit();
+  if (argc < 2) return reportModel(kDefaultModelPath) && ok ? 0 : 1;
+  for (int i = 1; i < argc; ++i) ok = reportModel(argv[i]) && ok;
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,217 @@
+/*
+ * SPRINT 3 - Benchmark do Pré-processamento Fundido RGB565 -> INT8
+ * ================================================================
+ *
+ * Gera frames RGB565 QVGA (320x240, ordem de bytes do esp32-camera) a
+ * partir das fotos da Sprint 1 (ou do dataset representativo) e mede,
+ * por frame:
+ *
+ *   - duas passadas (main.cpp + setInputFromGray): RGB565 -> tons de
+ *     cinza com multiplicação/divisão por pixel, depois vizinho mais
+ *     próximo até 96x96 e quantização;
+ *   - fundido (Int8Engine::setInputFromRgb565) com o lumaRow de cada
+ *     backend disponível (escalar, SSE4, AVX2).
+ *
+ * Confere que todos os backends escrevem o mesmo tensor (também em
+ * linhas de largura aleatória, para as caudas) e compara os dois
+ * caminhos com a média por área exata em ponto flutuante. O erro é
+ * dado em níveis de cinza (0..255): a escala da entrada do modelo é
+ * menor que 1/255, então um passo int8 vale só ~0,35 nível. As caixas
+ * inteiras do caminho fundido diferem da área fracionária só nas
+ * bordas de alto contraste.
+ *
+ * Uso:
+ *     ./build/host_preprocess [dataset_sprint1] [dados_representativos]
+ *
+ * Autor: Equipe SPRINT 3
+ * Data: 2025
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "host_common.h"
+#include "int8_engine.h"
+#include "model.h"
+
+static const size_t kHostArenaSize = 1024 * 1024;
+static const int kFrameWidth = 320;
+static const int kFrameHeight = 240;
+static const size_t kMaxFrames = 24;
+static const int kRepeats = 20;
+static const int kRandomRows = 500;
+
+// RGB888 (qualquer tamanho) -> RGB565 big-endian width x height, vizinho mais próximo
+static std::vector<uint8_t> toRgb565(const std::vector<uint8_t>& rgb, int w, int h) {
+  std::vector<uint8_t> out((size_t)kFrameWidth * kFrameHeight * 2);
+  for (int y = 0; y < kFrameHeight; ++y) {
+    for (int x = 0; x < kFrameWidth; ++x) {
+      const uint8_t* p = &rgb[((size_t)(y * h / kFrameHeight) * w + x * w / kFrameWidth) * 3];
+      const uint16_t v = (uint16_t)(((p[0] >> 3) << 11) | ((p[1] >> 2) << 5) | (p[2] >> 3));
+      out[((size_t)y * kFrameWidth + x) * 2] = (uint8_t)(v >> 8);
+      out[((size_t)y * kFrameWidth + x) * 2 + 1] = (uint8_t)v;
+    }
+  }
+  return out;
+}
+
+// Caminho atual: tons de cinza do frame inteiro como em main.cpp, depois setInputFromGray
+static void twoPass(Int8Engine& engine, const uint8_t* frame, std::vector<uint8_t>* gray) {
+  for (int i = 0; i < kFrameWidth * kFrameHeight; ++i) {
+    const uint16_t pixel = (uint16_t)((frame[2 * i] << 8) | frame[2 * i + 1]);
+    const uint32_t r = ((pixel >> 11) & 0x1F) * 255 / 31;
+    const uint32_t g = ((pixel >> 5) & 0x3F) * 255 / 63;
+    const uint32_t b = (pixel & 0x1F) * 255 / 31;
+    (*gray)[i] = (uint8_t)((299 * r + 587 * g + 114 * b) / 1000);
+  }
+  engine.setInputFromGray(gray->data(), kFrameWidth, kFrameHeight);
+}
+
+// Média por área exata (cobertura fracionária) da luminância em double, quantizada
+static std::vector<int8_t> areaReference(const uint8_t* frame, int out_w, int out_h,
+                                         float scale, int32_t zero_point) {
+  std::vector<double> luma((size_t)kFrameWidth * kFrameHeight);
+  for (size_t i = 0; i < luma.size(); ++i) {
+    const uint16_t p = (uint16_t)((frame[2 * i] << 8) | frame[2 * i + 1]);
+    luma[i] = 0.299 * ((p >> 11) & 0x1F) * 255.0 / 31.0 +
+              0.587 * ((p >> 5) & 0x3F) * 255.0 / 63.0 + 0.114 * (p & 0x1F) * 255.0 / 31.0;
+  }
+  std::vector<int8_t> out((size_t)out_w * out_h);
+  const double sx = (double)kFrameWidth / out_w;
+  const double sy = (double)kFrameHeight / out_h;
+  for (int y = 0; y < out_h; ++y) {
+    for (int x = 0; x < out_w; ++x) {
+      double sum = 0.0, area = 0.0;
+      for (int iy = (int)(y * sy); iy < kFrameHeight && iy < (y + 1) * sy; ++iy) {
+        const double wy = std::min<double>(iy + 1, (y + 1) * sy) - std::max<double>(iy, y * sy);
+        for (int ix = (int)(x * sx); ix < kFrameWidth && ix < (x + 1) * sx; ++ix) {
+          const double wx =
+              std::min<double>(ix + 1, (x + 1) * sx) - std::max<double>(ix, x * sx);
+          sum += wx * wy * luma[(size_t)iy * kFrameWidth + ix];
+          area += wx * wy;
+        }
+      }
+      int32_t q = (int32_t)lround(sum / area / 255.0 / scale) + zero_point;
+      out[(size_t)y * out_w + x] = (int8_t)std::max(-128, std::min(127, q));
+    }
+  }
+  return out;
+}
+
+// lumaRow de cada backend contra o escalar em linhas de largura aleatória
+static bool checkRandomRows(const KernelBackend* backend) {
+  uint32_t seed = 0x565;
+  std::vector<uint8_t> row(kPreprocessMaxWidth * 2);
+  std::vector<uint16_t> a(kPreprocessMaxWidth), b(kPreprocessMaxWidth);
+  for (int t = 0; t < kRandomRows; ++t) {
+    seed = seed * 1664525u + 1013904223u;
+    const int width = 1 + (int)((seed >> 8) % kPreprocessMaxWidth);
+    for (uint8_t& v : row) {
+      seed = seed * 1664525u + 1013904223u;
+      v = (uint8_t)(seed >> 16);
+    }
+    for (int x = 0; x < kPreprocessMaxWidth; ++x) a[x] = b[x] = (uint16_t)(x * 7);
+    rgb565LumaRowScalar(row.data(), width, a.data());
+    backend->lumaRow(row.data(), width, b.data());
+    if (a != b) return false;
+  }
+  return true;
+}
+
+int main(int argc, char** argv) {
+  const char* sprint1_dir = argc > 1 ? argv[1] : kSprint1DataDir;
+  const char* data_dir = argc > 2 ? argv[2] : kDefaultDataDir;
+  static uint8_t arena[kHostArenaSize];
+  static Int8Engine engine;
+  if (!engine.begin(g_model, g_model_len, arena, sizeof(arena))) {
+    fprintf(stderr, "❌ Falha ao carregar modelo: %s\n", engine.errorMessage());
+    return 1;
+  }
+
+  std::vector<LabeledImage> images = listSprint1Images(sprint1_dir);
+  if (images.empty()) images = listRepresentativeImages(data_dir);
+  std::vector<std::vector<uint8_t>> frames;
+  for (const LabeledImage& img : images) {
+    if (frames.size() >= kMaxFrames) break;
+    size_t len = 0;
+    uint8_t* jpeg = loadFile(img.path.c_str(), &len);
+    std::vector<uint8_t> rgb;
+    int w = 0, h = 0;
+    if (jpeg && decodeJpegRgb(jpeg, len, &rgb, &w, &h)) frames.push_back(toRgb565(rgb, w, h));
+    free(jpeg);
+  }
+  if (frames.empty()) {
+    fprintf(stderr, "❌ Nenhuma imagem em %s nem em %s\n", sprint1_dir, data_dir);
+    return 1;
+  }
+
+  const int out_w = engine.inputWidth();
+  const int out_h = engine.inputHeight();
+  const size_t in_size = (size_t)out_w * out_h * engine.inputChannels();
+  const Int8Tensor& in = engine.tensor(engine.layer(0).input);
+  std::vector<std::vector<int8_t>> reference;
+  for (const std::vector<uint8_t>& f : frames) {
+    reference.push_back(areaReference(f.data(), out_w, out_h, in.scale, in.zero_point));
+  }
+
+  printf("🖼️  RGB565 %dx%d -> %dx%dx%d INT8 (%zu frames)\n\n", kFrameWidth, kFrameHeight, out_w,
+         out_h, engine.inputChannels(), frames.size());
+  printf("%-26s %10s %8s %10s %10s  %s\n", "caminho", "us/frame", "speedup", "máx cinza",
+         "média", "saída");
+  const double gray_per_step = in.scale * 255.0;
+
+  std::vector<uint8_t> gray((size_t)kFrameWidth * kFrameHeight);
+  std::vector<int8_t> fused_scalar(frames.size() * in_size);
+  double base_us = 0.0;
+  bool identical = true;
+  // -1 = duas passadas; i >= 0 = fundido com o backend i
+  for (int path = -1; path < kernelBackendCount(); ++path) {
+    const KernelBackend* backend = path >= 0 ? kernelBackend(path) : nullptr;
+    engine.setKernelBackend(backend);
+    auto run = [&](size_t f) {
+      if (path < 0) twoPass(engine, frames[f].data(), &gray);
+      else engine.setInputFromRgb565(frames[f].data(), kFrameWidth, kFrameHeight);
+    };
+
+    double worst = 0.0;
+    double mean = 0.0;
+    bool same = true;
+    for (size_t f = 0; f < frames.size(); ++f) {
+      run(f);
+      const int8_t* got = engine.input();
+      for (size_t i = 0; i < in_size; ++i) {
+        const double d = abs(got[i] - reference[f][i]) * gray_per_step;
+        worst = std::max(worst, d);
+        mean += d / (in_size * frames.size());
+      }
+      if (path == 0) memcpy(&fused_scalar[f * in_size], got, in_size);
+      if (path > 0) same = same && memcmp(&fused_scalar[f * in_size], got, in_size) == 0;
+    }
+    double us = 1e30;
+    for (int r = 0; r < 3; ++r) {
+      auto t0 = std::chrono::steady_clock::now();
+      for (int k = 0; k < kRepeats; ++k) {
+        for (size_t f = 0; f < frames.size(); ++f) run(f);
+      }
+      us = std::min(us, elapsedUs(t0) / (kRepeats * frames.size()));
+    }
+    if (path < 0) base_us = us;
+    if (path > 0) same = same && checkRandomRows(backend);
+    identical = identical && same;
+
+    char name[40];
+    if (path < 0) snprintf(name, sizeof(name), "duas passadas (main.cpp)");
+    else snprintf(name, sizeof(name), "fundido %s", backend->name);
+    printf("%-26s %10.1f %7.2fx %10.1f %10.3f  %s\n", name, us, base_us / us, worst, mean,
+           path < 0 ? "vizinho" : path == 0 ? "referência"
+                                            : same ? "✅ idêntica" : "❌ DIFERENTE");
+  }
+  engine.setKernelBackend(nullptr);
+  printf("\n(cinza: |diferença| para a média por área exata, em níveis 0..255)\n");
+  return identical ? 0 : 1;
+}
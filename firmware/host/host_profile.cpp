@@ -0,0 +1,152 @@
+/*
+ * SPRINT 3 - Perfil por Operador (CLI do /profile)
+ * ================================================
+ *
+ * Executa o g_model embutido com a mesma configuração do firmware
+ * (pesos empacotados, GEMV com 8 KB de scratch, as 3 primeiras
+ * camadas em patches 4x4, Winograd nas Conv2D 1 e 2 e o backend de
+ * kernels mais rápido) sobre o dataset representativo, com o
+ * LayerProfiler ligado, e imprime por camada:
+ * ciclos médios/mín/máx, us, fração do tempo, MACs, MACs/ciclo,
+ * bytes lidos/escritos e arena ocupada. Com --json imprime o mesmo
+ * documento servido pela rota /profile do firmware.
+ *
+ * No host os "ciclos" são nanossegundos (CPU de 1 GHz equivalente).
+ *
+ * Uso:
+ *     ./build/host_profile [--json] [dados]
+ *
+ * Autor: Equipe SPRINT 3
+ * Data: 2025
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <vector>
+
+#include "host_common.h"
+#include "int8_engine.h"
+#include "model.h"
+
+static const size_t kHostArenaSize = 1024 * 1024;
+static const size_t kWeightScratchSize = 8 * 1024;   // Igual ao firmware
+static const int kPatchLayers = 3;
+static const int kPatchGrid = 4;
+static const int kPasses = 3;
+static const uint32_t kWinogradLayers = (1u << 1) | (1u << 2);   // Igual ao firmware
+static const size_t kWinogradBufferSize = 192 * 1024;
+static const bool kInt4Dense = true;                             // Igual ao firmware
+
+static const char* backendName(const Int8Engine& engine) {
+  return engine.activeKernelBackend() ? engine.activeKernelBackend()->name : "reference";
+}
+
+static void printTable(const LayerProfiler& profiler, const Int8Engine& engine) {
+  printf("🧠 g_model: %d camadas (%d empacotadas) | arena %zu bytes | backend %s | "
+         "%u inferências\n\n", engine.layerCount(), engine.packedLayerCount(), engine.arenaUsed(),
+         backendName(engine), profiler.inferences());
+  printf("%-3s %-16s %10s %10s %10s %9s %6s %10s %8s %9s %8s %8s\n", "#", "operador",
+         "ciclos", "mín", "máx", "us", "%", "MACs", "MAC/cic", "lidos", "escritos", "arena");
+  for (int i = 0; i < profiler.layerCount(); ++i) {
+    const LayerProfile& p = profiler.layer(i);
+    printf("%-3d %-16s %10.0f %10u %10u %9.1f %5.1f%% %10u %8.3f %9u %8u %8u\n", i,
+           LayerProfiler::opName(p.op), profiler.meanCycles(i), p.min_cycles, p.max_cycles,
+           profiler.meanUs(i), profiler.share(i) * 100.0f, p.macs, profiler.macsPerCycle(i),
+           p.bytes_read, p.bytes_written, p.arena_bytes);
+  }
+  const float total_us = profiler.meanInferenceUs();
+  printf("\n⏱️  Inferência: %.2f ms | %u MACs (%.3f MAC/ciclo) | %u bytes lidos\n",
+         total_us / 1000.0f, profiler.totalMacs(),
+         profiler.totalMacs() / (total_us * LayerProfiler::cyclesPerUs()),
+         profiler.totalBytesRead());
+
+  int hottest = 0;
+  for (int i = 1; i < profiler.layerCount(); ++i) {
+    if (profiler.share(i) > profiler.share(hottest)) hottest = i;
+  }
+  printf("🔥 Camada mais cara: #%d %s (%.1f%% do tempo)\n", hottest,
+         LayerProfiler::opName(profiler.layer(hottest).op), profiler.share(hottest) * 100.0f);
+}
+
+// Mesmas chaves do handleProfile() em main_real_advanced.cpp
+static void printJson(const LayerProfiler& profiler, const Int8Engine& engine) {
+  printf("{\"inferences\":%u,\"cycles_per_us\":%u,\"arena_used\":%zu,\"kernel_backend\":\"%s\","
+         "\"total_macs\":%u,\"total_bytes_read\":%u,\"mean_inference_us\":%.1f,\"layers\":[",
+         profiler.inferences(), LayerProfiler::cyclesPerUs(), engine.arenaUsed(),
+         backendName(engine), profiler.totalMacs(), profiler.totalBytesRead(),
+         profiler.meanInferenceUs());
+  for (int i = 0; i < profiler.layerCount(); ++i) {
+    const LayerProfile& p = profiler.layer(i);
+    printf("%s{\"index\":%d,\"op\":\"%s\",\"macs\":%u,\"bytes_read\":%u,\"bytes_written\":%u,"
+           "\"arena_bytes\":%u,\"mean_cycles\":%.0f,\"min_cycles\":%u,\"max_cycles\":%u,"
+           "\"last_cycles\":%u,\"mean_us\":%.1f,\"macs_per_cycle\":%.3f,\"share\":%.4f}",
+           i ? "," : "", i, LayerProfiler::opName(p.op), p.macs, p.bytes_read, p.bytes_written,
+           p.arena_bytes, profiler.meanCycles(i), p.min_cycles, p.max_cycles, p.last_cycles,
+           profiler.meanUs(i), profiler.macsPerCycle(i), profiler.share(i));
+  }
+  printf("]}\n");
+}
+
+int main(int argc, char** argv) {
+  bool json = false;
+  const char* data_dir = kDefaultDataDir;
+  for (int i = 1; i < argc; ++i) {
+    if (strcmp(argv[i], "--json") == 0) json = true;
+    else data_dir = argv[i];
+  }
+
+  static uint8_t arena[kHostArenaSize];
+  static int8_t scratch[kWeightScratchSize];
+  static Int8Engine engine;
+  static LayerProfiler profiler;
+  engine.setPackedWeights(g_model_packed, g_model_packed_len);
+  engine.setWeightStreaming(scratch, sizeof(scratch));
+  static int16_t winograd_weights[kWinogradBufferSize / sizeof(int16_t)];
+  engine.setWinograd(kWinogradLayers, winograd_weights, sizeof(winograd_weights));
+  engine.setInt4Dense(kInt4Dense);
+  engine.setPatchInference(kPatchLayers, kPatchGrid);
+  engine.setProfiler(&profiler);
+  engine.setKernelBackend(bestKernelBackend());
+  if (!engine.begin(g_model, g_model_len, arena, sizeof(arena))) {
+    fprintf(stderr, "❌ Falha ao carregar modelo: %s\n", engine.errorMessage());
+    return 1;
+  }
+
+  std::vector<LabeledImage> images = listRepresentativeImages(data_dir);
+  if (images.empty()) {
+    fprintf(stderr, "❌ Nenhuma imagem em %s\n", data_dir);
+    return 1;
+  }
+  std::vector<std::vector<uint8_t>> frames;
+  std::vector<int> widths, heights;
+  for (const LabeledImage& img : images) {
+    size_t len = 0;
+    uint8_t* jpeg = loadFile(img.path.c_str(), &len);
+    std::vector<uint8_t> gray;
+    int w = 0, h = 0;
+    if (jpeg && decodeJpegGray(jpeg, len, &gray, &w, &h)) {
+      frames.push_back(std::move(gray));
+      widths.push_back(w);
+      heights.push_back(h);
+    }
+    free(jpeg);
+  }
+
+  // Primeira passada aquece caches; os agregados contam só as seguintes
+  for (int pass = 0; pass <= kPasses; ++pass) {
+    if (pass == 1) profiler.reset();
+    for (size_t f = 0; f < frames.size(); ++f) {
+      engine.setInputFromGray(frames[f].data(), widths[f], heights[f]);
+      if (!engine.invoke()) {
+        fprintf(stderr, "❌ Falha na inferência: %s\n", engine.errorMessage());
+        return 1;
+      }
+    }
+  }
+
+  if (json) printJson(profiler, engine);
+  else printTable(profiler, engine);
+  return 0;
+}
@@ -0,0 +1,115 @@
+/*
+ * SPRINT 3 - Teste das Tabelas de Requantização Pré-calculadas
+ * ============================================================
+ *
+ * Confere, canal a canal, que os multiplicadores Q31 e shifts que o
+ * convert_to_c_array.py gravou no blob I8PK (g_model_packed) são
+ * idênticos bit a bit aos derivados das escalas float do modelo
+ * (escala_entrada * escala_peso[c] / escala_saída, quantizeMultiplier)
+ * e aos que o motor calcula em begin() sem o blob. Também mede o custo
+ * do begin() nos dois casos e confere a paridade das saídas.
+ *
+ * Uso:
+ *     ./build/host_requant
+ *
+ * Autor: Equipe SPRINT 3
+ * Data: 2025
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+
+#include "host_common.h"
+#include "int8_engine.h"
+#include "model.h"
+
+static const size_t kHostArenaSize = 1024 * 1024;
+static const int kRepeats = 50;
+static const int kRandomInputs = 10;
+
+static float scaleAt(const Int8Tensor& t, int channel) {
+  float scale;
+  memcpy(&scale, t.scales + 4 * (t.num_scales == 1 ? 0 : channel), sizeof(scale));
+  return scale;
+}
+
+int main() {
+  static uint8_t arena_computed[kHostArenaSize];
+  static uint8_t arena_table[kHostArenaSize];
+  static Int8Engine computed;   // Sem blob: requantização calculada em begin()
+  static Int8Engine table;      // Com blob: tabelas pré-calculadas
+  table.setPackedWeights(g_model_packed, g_model_packed_len);
+
+  double computed_us = 1e30, table_us = 1e30;
+  for (int r = 0; r < kRepeats; ++r) {
+    auto t0 = std::chrono::steady_clock::now();
+    const bool ok_computed = computed.begin(g_model, g_model_len, arena_computed,
+                                            sizeof(arena_computed));
+    computed_us = std::min(computed_us, elapsedUs(t0));
+    t0 = std::chrono::steady_clock::now();
+    const bool ok_table = table.begin(g_model, g_model_len, arena_table, sizeof(arena_table));
+    table_us = std::min(table_us, elapsedUs(t0));
+    if (!ok_computed || !ok_table) {
+      fprintf(stderr, "❌ Falha ao carregar modelo: %s / %s\n", computed.errorMessage(),
+              table.errorMessage());
+      return 1;
+    }
+  }
+  printf("🧠 g_model: %d camadas | %d tabelas de requantização no g_model_packed\n\n",
+         table.layerCount(), table.precomputedRequantCount());
+
+  printf("%-3s %-16s %6s %10s %10s %14s\n", "#", "operador", "canais", "vs float", "vs begin",
+         "erro rel. máx");
+  int channels_total = 0, mismatches = 0;
+  for (int l = 0; l < table.layerCount(); ++l) {
+    const Int8Layer& layer = table.layer(l);
+    const Int8Layer& ref = computed.layer(l);
+    if (!layer.multiplier) continue;
+    const Int8Tensor& in = table.tensor(layer.input);
+    const Int8Tensor& w = table.tensor(layer.weights);
+    const Int8Tensor& out = table.tensor(layer.output);
+    const int channels = layer.shape.out_c;
+    int float_ok = 0, begin_ok = 0;
+    double max_rel = 0.0;
+    for (int c = 0; c < channels; ++c) {
+      // Valor derivado das escalas float, como no TFLite
+      const double real = (double)in.scale * (double)scaleAt(w, c) / (double)out.scale;
+      int32_t m = 0, sh = 0;
+      quantizeMultiplier(real, &m, &sh);
+      if (layer.multiplier[c] == m && layer.shift[c] == sh) ++float_ok;
+      if (layer.multiplier[c] == ref.multiplier[c] && layer.shift[c] == ref.shift[c]) ++begin_ok;
+      const double approx = ldexp((double)layer.multiplier[c], layer.shift[c] - 31);
+      max_rel = std::max(max_rel, fabs(approx - real) / real);
+    }
+    channels_total += channels;
+    mismatches += (channels - float_ok) + (channels - begin_ok);
+    printf("%-3d %-16s %6d %6d/%-3d %6d/%-3d %14.2e\n", l, LayerProfiler::opName(layer.op),
+           channels, float_ok, channels, begin_ok, channels, max_rel);
+  }
+
+  // As duas configurações devem produzir exatamente a mesma saída
+  uint32_t seed = 31337;
+  const int input_size = table.inputWidth() * table.inputHeight() * table.inputChannels();
+  int output_mismatches = 0;
+  for (int n = 0; n < kRandomInputs; ++n) {
+    for (int i = 0; i < input_size; ++i) {
+      seed = seed * 1664525u + 1013904223u;
+      table.input()[i] = (int8_t)(seed >> 24);
+    }
+    memcpy(computed.input(), table.input(), input_size);
+    table.invoke();
+    computed.invoke();
+    if (memcmp(table.output(), computed.output(), table.outputSize()) != 0) ++output_mismatches;
+  }
+
+  printf("\n⏱️  begin(): calculando %.1f us | com tabelas %.1f us\n", computed_us, table_us);
+  printf("%s %d canais conferidos contra as escalas float e o begin(): %d divergências\n",
+         mismatches == 0 ? "✅" : "❌", channels_total, mismatches);
+  printf("%s Saídas: %d/%d idênticas\n", output_mismatches == 0 ? "✅" : "❌",
+         kRandomInputs - output_mismatches, kRandomInputs);
+  return mismatches == 0 && output_mismatches == 0 && table.precomputedRequantCount() > 0 ? 0 : 1;
+}
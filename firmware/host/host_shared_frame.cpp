@@ -0,0 +1,239 @@
+/*
+ * SPRINT 3 - Teste dos Frames Compartilhados por Contagem de Referências
+ * ======================================================================
+ *
+ * Reproduz com std::thread o fluxo de frames do main_real_advanced:
+ *
+ *   - driver simulado com 3 frame buffers (fb_count = 3): a captura
+ *     copia para um buffer livre o próximo JPEG da Sprint 1 (ou do
+ *     dataset representativo), como o DMA do sensor, e o embrulha na
+ *     SharedFrameTable, cuja devolução recoloca o buffer no driver;
+ *   - inferência: características do frame (jpegScaledDecodeLuma a 1/8)
+ *     e publicação no FrameSnapshot;
+ *   - 3 clientes /stream e 1 /capture.jpg lendo o snapshot e segurando
+ *     o frame durante um "envio" proporcional ao tamanho.
+ *
+ * Cada buffer carrega a sequência do frame escrito nele: quem segura
+ * uma referência confere, no início e no fim do uso, que o buffer não
+ * voltou ao driver nem foi reescrito. No fim, todo frame embrulhado foi
+ * devolvido exatamente uma vez. Compara as capturas e as cópias com os
+ * caminhos sem compartilhamento (cada consumidor com seu
+ * esp_camera_fb_get, como no main_cnn_real_final, ou uma cópia do frame
+ * por cliente).
+ *
+ * Uso:
+ *     ./build/host_shared_frame [dataset_sprint1] [dados_representativos]
+ *
+ * Autor: Equipe SPRINT 3
+ * Data: 2025
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "feature_gate.h"
+#include "host_common.h"
+#include "image_stats.h"
+#include "jpeg_scaled.h"
+#include "shared_frame.h"
+#include "spsc_ring.h"
+
+static const int kCameraFbCount = 3;             // Como o main_real_advanced
+static const int kStreamClients = 3;
+static const int kInferenceFrames = 300;
+static const double kSendUsPerKB = 40.0;         // "WiFi" dos clientes simulados
+
+struct FakeFb {
+  std::vector<uint8_t> buf;
+  size_t len;
+  uint32_t seq;                   // Frame escrito no buffer
+  std::atomic<bool> in_driver;
+};
+
+// Driver simulado: buffers livres (a devolução vem de qualquer thread)
+struct FakeDriver {
+  std::mutex lock;
+  std::vector<FakeFb*> free_fbs;
+  std::atomic<uint32_t> returns;
+};
+
+static void returnToDriver(void* frame, void* arg) {
+  FakeDriver* driver = (FakeDriver*)arg;
+  FakeFb* fb = (FakeFb*)frame;
+  fb->in_driver.store(true);
+  std::lock_guard<std::mutex> guard(driver->lock);
+  driver->free_fbs.push_back(fb);
+  ++driver->returns;
+}
+
+static std::atomic<bool> g_recycled_in_use(false);
+
+// Quem segura a referência: o buffer segue fora do driver e com o mesmo frame
+static void checkHeld(const FrameRef& frame) {
+  const FakeFb* fb = frame.as<FakeFb>();
+  if (fb->in_driver.load() || fb->seq != frame.seq()) g_recycled_in_use.store(true);
+}
+
+// Leitor do snapshot (/stream ou /capture.jpg): segura cada frame novo pelo
+// tempo do envio; poll_us > 0 pede um frame a cada intervalo
+static void snapshotReader(FrameSnapshot* snapshot, const std::atomic<bool>* done,
+                           int poll_us, uint32_t* delivered) {
+  uint32_t last_seq = 0;
+  while (!done->load()) {
+    FrameRef frame = snapshot->get();
+    if (!frame || (poll_us == 0 && frame.seq() == last_seq)) {
+      std::this_thread::yield();
+      continue;
+    }
+    checkHeld(frame);
+    last_seq = frame.seq();
+    const FakeFb* fb = frame.as<FakeFb>();
+    std::this_thread::sleep_for(
+        std::chrono::duration<double, std::micro>(fb->len / 1024.0 * kSendUsPerKB));
+    checkHeld(frame);
+    ++*delivered;
+    if (poll_us > 0) std::this_thread::sleep_for(std::chrono::microseconds(poll_us));
+  }
+}
+
+int main(int argc, char** argv) {
+  const char* sprint1_dir = argc > 1 ? argv[1] : kSprint1DataDir;
+  const char* data_dir = argc > 2 ? argv[2] : kDefaultDataDir;
+  std::vector<LabeledImage> images = listSprint1Images(sprint1_dir);
+  if (images.empty()) images = listRepresentativeImages(data_dir);
+  std::vector<std::vector<uint8_t>> jpegs;
+  size_t max_len = 0;
+  for (const LabeledImage& img : images) {
+    size_t len = 0;
+    uint8_t* jpeg = loadFile(img.path.c_str(), &len);
+    if (!jpeg) continue;
+    jpegs.emplace_back(jpeg, jpeg + len);
+    free(jpeg);
+    max_len = std::max(max_len, len);
+  }
+  if (jpegs.empty()) {
+    fprintf(stderr, "❌ Nenhuma imagem em %s nem em %s\n", sprint1_dir, data_dir);
+    return 1;
+  }
+
+  FakeDriver driver;
+  driver.returns.store(0);
+  FakeFb fbs[kCameraFbCount];
+  for (FakeFb& fb : fbs) {
+    fb.buf.resize(max_len);
+    fb.len = 0;
+    fb.seq = 0;
+    fb.in_driver.store(true);
+    driver.free_fbs.push_back(&fb);
+  }
+  SharedFrameTable table(returnToDriver, &driver);
+  FrameSnapshot snapshot;
+  static SpscRing<SharedFrame*, 1> frame_ring;
+  std::atomic<bool> done(false);
+  uint32_t captured = 0, analyzed = 0;
+  uint64_t bytes_captured = 0;
+  uint32_t delivered[kStreamClients + 1] = { 0 };
+
+  const auto t0 = std::chrono::steady_clock::now();
+  std::thread capture([&]() {
+    uint32_t source = 0;
+    while (!done.load()) {
+      if (frame_ring.full()) {
+        std::this_thread::yield();
+        continue;
+      }
+      FakeFb* fb = nullptr;
+      {
+        std::lock_guard<std::mutex> guard(driver.lock);
+        if (!driver.free_fbs.empty()) {
+          fb = driver.free_fbs.back();
+          driver.free_fbs.pop_back();
+        }
+      }
+      if (!fb) {
+        std::this_thread::yield();   // Todos os buffers referenciados
+        continue;
+      }
+      const std::vector<uint8_t>& jpeg = jpegs[source++ % jpegs.size()];
+      memcpy(fb->buf.data(), jpeg.data(), jpeg.size());
+      fb->len = jpeg.size();
+      fb->in_driver.store(false);
+      SharedFrame* frame = table.wrap(fb);
+      if (!frame) continue;
+      fb->seq = frame->seq;
+      ++captured;
+      bytes_captured += fb->len;
+      frame_ring.push(frame);
+    }
+  });
+  std::thread inference([&]() {
+    while (analyzed < (uint32_t)kInferenceFrames) {
+      SharedFrame* shared = nullptr;
+      if (!frame_ring.pop(&shared)) {
+        std::this_thread::yield();
+        continue;
+      }
+      FrameRef frame = FrameRef::adopt(shared);
+      checkHeld(frame);
+      const FakeFb* fb = frame.as<FakeFb>();
+      JpegScaledSink sink;
+      jpegScaledBegin(&sink, fb->buf.data(), nullptr, 0);
+      float features[kGateFeatures];
+      if (jpegScaledDecodeLuma(&sink, fb->len, kJpegMaxScale)) {
+        imageStatsFeatures(sink.stats, fb->len, sink.width << kJpegMaxScale,
+                           sink.height << kJpegMaxScale, features);
+      }
+      checkHeld(frame);
+      snapshot.publish(frame);
+      ++analyzed;
+    }
+    done.store(true);
+  });
+  std::vector<std::thread> readers;
+  for (int c = 0; c <= kStreamClients; ++c) {
+    // O último é o /capture.jpg da página, pedido a cada 50 ms
+    const int poll_us = c == kStreamClients ? 50000 : 0;
+    readers.emplace_back(snapshotReader, &snapshot, &done, poll_us, &delivered[c]);
+  }
+  inference.join();
+  capture.join();
+  for (std::thread& t : readers) t.join();
+  const double seconds = elapsedUs(t0) / 1e6;
+
+  // Frames que ficaram no anel e no snapshot voltam ao driver
+  SharedFrame* leftover = nullptr;
+  while (frame_ring.pop(&leftover)) FrameRef::adopt(leftover);
+  snapshot.clear();
+  const SharedFrameStats s = table.stats();
+
+  uint32_t streamed = 0;
+  for (int c = 0; c < kStreamClients; ++c) streamed += delivered[c];
+  const uint32_t polled = delivered[kStreamClients];
+  const double mean_len = (double)bytes_captured / std::max(captured, 1u);
+  printf("🎞️  %d frame buffers, %zu JPEGs em ciclo (%.1f KB em média), %.2f s\n\n",
+         kCameraFbCount, jpegs.size(), mean_len / 1024.0, seconds);
+  printf("📦 Entregas: inferência %u | /stream %u (%d clientes) | /capture.jpg %u\n", analyzed,
+         streamed, kStreamClients, polled);
+  printf("📷 Capturas: %u compartilhadas x %u com um esp_camera_fb_get por consumidor\n",
+         captured, analyzed + streamed + polled);
+  printf("📋 Cópias: 0 bytes x %.1f MB com uma cópia do frame por cliente\n",
+         (streamed + polled) * mean_len / (1024.0 * 1024.0));
+  printf("🔗 Referências: pico de %u frames vivos, %u sem entrada na tabela\n", s.peak_live,
+         s.table_full);
+
+  const bool balanced = s.wrapped == s.returned && s.live == 0 &&
+                        driver.returns.load() == s.returned + s.table_full &&
+                        driver.free_fbs.size() == (size_t)kCameraFbCount;
+  const bool intact = !g_recycled_in_use.load();
+  printf("\n%s Todo frame devolvido ao driver uma vez (%u embrulhados, %u devolvidos)\n",
+         balanced ? "✅" : "❌", s.wrapped, s.returned);
+  printf("%s Nenhum buffer reciclado enquanto referenciado\n", intact ? "✅" : "❌");
+  return balanced && intact ? 0 : 1;
+}
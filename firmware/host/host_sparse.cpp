@@ -0,0 +1,387 @@
+/*
+ * SPRINT 3 - Latência Densa x Esparsa em Blocos (50% e 75%)
+ * =========================================================
+ *
+ * Poda os pesos do g_model em blocos com a mesma regra do
+ * export_tflite.py --block-sparsity (faixas de kSparseSpan pesos x
+ * kPackBlock canais de menor norma L1; o classificador final fica
+ * denso) e compara, em 50% e 75% de esparsidade:
+ *
+ *   - por camada: kernel denso OHWI (pesos já podados) contra o kernel
+ *     esparso (block_sparse.h), sobre a entrada real de cada imagem do
+ *     dataset representativo, conferindo a saída;
+ *   - o modelo inteiro: Int8Engine sobre uma cópia do g_model com os
+ *     pesos podados, sem e com as seções kLayoutBlockSparse no blob,
+ *     camada a camada.
+ *
+ * Imprime latência, speedup e bytes de pesos de cada caso.
+ *
+ * Uso:
+ *     ./build/host_sparse [dados]
+ *
+ * Autor: Equipe SPRINT 3
+ * Data: 2025
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "host_common.h"
+#include "int8_engine.h"
+#include "model.h"
+
+static const size_t kHostArenaSize = 1024 * 1024;
+static const size_t kMaxFrames = 16;
+static const int kRepeats = 3;
+static const float kSparsities[] = { 0.5f, 0.75f };
+static const int kSparsityCount = sizeof(kSparsities) / sizeof(kSparsities[0]);
+
+struct Frame {
+  std::vector<uint8_t> gray;
+  int width;
+  int height;
+};
+
+// Pesos [rows][per_row] com a fração `sparsity` das faixas zeradas
+static std::vector<int8_t> pruneBlocks(const int8_t* w, int rows, int per_row, float sparsity) {
+  const int blocks = (rows + kPackBlock - 1) / kPackBlock;
+  const int spans = per_row / kSparseSpan;
+  // Ordem [faixa][bloco], como o argsort estável do export_tflite.py
+  std::vector<std::pair<int32_t, int>> scores;
+  for (int t = 0; t < spans; ++t) {
+    for (int b = 0; b < blocks; ++b) {
+      int32_t l1 = 0;
+      for (int j = 0; j < kPackBlock && b * kPackBlock + j < rows; ++j) {
+        const int8_t* row = w + (size_t)(b * kPackBlock + j) * per_row + t * kSparseSpan;
+        for (int i = 0; i < kSparseSpan; ++i) l1 += abs(row[i]);
+      }
+      scores.push_back(std::make_pair(l1, t * blocks + b));
+    }
+  }
+  std::stable_sort(scores.begin(), scores.end(),
+                   [](const std::pair<int32_t, int>& a, const std::pair<int32_t, int>& b) {
+                     return a.first < b.first;
+                   });
+  std::vector<int8_t> pruned(w, w + (size_t)rows * per_row);
+  const int cut = (int)(sparsity * scores.size() + 0.5f);
+  for (int k = 0; k < cut; ++k) {
+    const int t = scores[k].second / blocks;
+    const int b = scores[k].second % blocks;
+    for (int j = 0; j < kPackBlock && b * kPackBlock + j < rows; ++j) {
+      memset(&pruned[(size_t)(b * kPackBlock + j) * per_row + t * kSparseSpan], 0, kSparseSpan);
+    }
+  }
+  return pruned;
+}
+
+// Seção kLayoutBlockSparse a partir dos pesos em blocos (weight_packing.pack_block_sparse)
+static std::vector<uint8_t> packSparse(const std::vector<uint8_t>& blocked, int rows, int per_row) {
+  const int blocks = (rows + kPackBlock - 1) / kPackBlock;
+  const int span_bytes = kSparseSpan * kPackBlock;
+  std::vector<uint32_t> starts(1, 0);
+  std::vector<uint16_t> spans;
+  std::vector<uint8_t> values;
+  for (int b = 0; b < blocks; ++b) {
+    for (int t = 0; t < per_row / kSparseSpan; ++t) {
+      const uint8_t* chunk = &blocked[(size_t)b * per_row * kPackBlock + (size_t)t * span_bytes];
+      if (std::any_of(chunk, chunk + span_bytes, [](uint8_t v) { return v != 0; })) {
+        spans.push_back((uint16_t)t);
+        values.insert(values.end(), chunk, chunk + span_bytes);
+      }
+    }
+    starts.push_back((uint32_t)spans.size());
+  }
+  std::vector<uint8_t> out(blockSparseSectionBytes(rows, (uint32_t)spans.size()), 0);
+  memcpy(out.data(), starts.data(), starts.size() * sizeof(uint32_t));
+  memcpy(out.data() + starts.size() * sizeof(uint32_t), spans.data(),
+         spans.size() * sizeof(uint16_t));
+  memcpy(out.data() + out.size() - values.size(), values.data(), values.size());
+  return out;
+}
+
+struct Section {
+  uint16_t tensor;
+  uint8_t layout;
+  uint32_t rows;
+  std::vector<uint8_t> data;
+};
+
+// Monta um blob I8PK (alinhado a 16, liberar com free)
+static uint8_t* buildBlob(const std::vector<Section>& sections, size_t* size) {
+  const size_t table = sizeof(PackedHeader) + sections.size() * sizeof(PackedEntry);
+  size_t offset = (table + kPackedAlignment - 1) & ~(size_t)(kPackedAlignment - 1);
+  std::vector<PackedEntry> entries;
+  for (const Section& s : sections) {
+    PackedEntry e = { s.tensor, s.layout, (uint8_t)kPackBlock, (uint32_t)offset,
+                      (uint32_t)s.data.size(), s.rows };
+    entries.push_back(e);
+    offset = (offset + s.data.size() + kPackedAlignment - 1) & ~(size_t)(kPackedAlignment - 1);
+  }
+  uint8_t* blob = (uint8_t*)aligned_alloc(kPackedAlignment, offset);
+  memset(blob, 0, offset);
+  PackedHeader header = { kPackedMagic, kPackedVersion, (uint16_t)sections.size(),
+                          (uint32_t)offset, (uint32_t)g_model_len };
+  memcpy(blob, &header, sizeof(header));
+  for (size_t i = 0; i < sections.size(); ++i) {
+    memcpy(blob + sizeof(PackedHeader) + i * sizeof(PackedEntry), &entries[i], sizeof(PackedEntry));
+    memcpy(blob + entries[i].offset, sections[i].data.data(), sections[i].data.size());
+  }
+  *size = offset;
+  return blob;
+}
+
+// Camadas podadas: as mesmas do export_tflite.py (elegíveis, menos o classificador)
+static std::vector<int> prunableLayers(const Int8Engine& engine) {
+  std::vector<int> layers;
+  for (int l = 0; l < engine.layerCount(); ++l) {
+    const Int8Layer& layer = engine.layer(l);
+    if (layer.weights >= 0 && blockSparseSupported(layer.shape)) layers.push_back(l);
+  }
+  int last = -1;
+  for (int l = 0; l < engine.layerCount(); ++l) {
+    if (engine.layer(l).weights >= 0) last = l;
+  }
+  layers.erase(std::remove(layers.begin(), layers.end(), last), layers.end());
+  return layers;
+}
+
+// Pesos podados (OHWI) e seção esparsa de cada camada podável
+struct PrunedLayer {
+  int layer;
+  std::vector<int8_t> dense;
+  std::vector<uint8_t> sparse;
+  BlockSparseWeights view;
+};
+
+static std::vector<PrunedLayer> pruneModel(const Int8Engine& engine, float sparsity) {
+  std::vector<PrunedLayer> pruned;
+  for (int l : prunableLayers(engine)) {
+    const Int8Layer& layer = engine.layer(l);
+    const Int8Tensor& w = engine.tensor(layer.weights);
+    const int rows = layer.shape.out_c;
+    const int per_row = (int)(w.bytes / rows);
+    PrunedLayer p = PrunedLayer();
+    p.layer = l;
+    p.dense = pruneBlocks((const int8_t*)w.buffer, rows, per_row, sparsity);
+    p.sparse = packSparse(packOcBlocked(p.dense.data(), rows, per_row, kPackBlock), rows, per_row);
+    pruned.push_back(std::move(p));
+    PrunedLayer& back = pruned.back();
+    blockSparseView(back.sparse.data(), back.sparse.size(), per_row, rows, &back.view);
+  }
+  return pruned;
+}
+
+// Cópia do g_model (alinhada a 16, liberar com free) com os pesos podados no flatbuffer
+static uint8_t* prunedModel(const Int8Engine& engine, const std::vector<PrunedLayer>& pruned) {
+  const size_t size = (g_model_len + kPackedAlignment - 1) & ~(size_t)(kPackedAlignment - 1);
+  uint8_t* model = (uint8_t*)aligned_alloc(kPackedAlignment, size);
+  memcpy(model, g_model, g_model_len);
+  for (const PrunedLayer& p : pruned) {
+    const Int8Tensor& w = engine.tensor(engine.layer(p.layer).weights);
+    memcpy(model + (w.buffer - g_model), p.dense.data(), p.dense.size());
+  }
+  return model;
+}
+
+// Blob do g_model_packed sem as seções das camadas podadas (que ficam OHWI no
+// modelo podado) ou com as seções esparsas delas
+static uint8_t* prunedBlob(const Int8Engine& engine, const std::vector<PrunedLayer>& pruned,
+                           bool sparse, size_t* size) {
+  std::vector<Section> sections;
+  const PackedHeader* header = (const PackedHeader*)g_model_packed;
+  for (int i = 0; i < header->count; ++i) {
+    PackedEntry e;
+    memcpy(&e, g_model_packed + sizeof(PackedHeader) + i * sizeof(PackedEntry), sizeof(e));
+    bool replaced = false;
+    for (const PrunedLayer& p : pruned) {
+      replaced = replaced || engine.layer(p.layer).weights == e.tensor;
+    }
+    // Pesos e cópia int4 das camadas podadas saem; tabelas de requantização ficam
+    if (replaced && e.layout != kLayoutRequant) continue;
+    Section s = { e.tensor, e.layout, e.rows,
+                  std::vector<uint8_t>(g_model_packed + e.offset,
+                                       g_model_packed + e.offset + e.size) };
+    sections.push_back(std::move(s));
+  }
+  for (const PrunedLayer& p : pruned) {
+    if (!sparse) break;
+    const Int8Layer& layer = engine.layer(p.layer);
+    Section s = { (uint16_t)layer.weights, (uint8_t)kLayoutBlockSparse,
+                  (uint32_t)layer.shape.out_c, p.sparse };
+    sections.push_back(std::move(s));
+  }
+  return buildBlob(sections, size);
+}
+
+int main(int argc, char** argv) {
+  const char* data_dir = argc > 1 ? argv[1] : kDefaultDataDir;
+  static uint8_t arena[kHostArenaSize];
+  static Int8Engine engine;
+  if (!engine.begin(g_model, g_model_len, arena, sizeof(arena))) {
+    fprintf(stderr, "❌ Falha ao carregar modelo: %s\n", engine.errorMessage());
+    return 1;
+  }
+
+  std::vector<Frame> frames;
+  for (const LabeledImage& img : listRepresentativeImages(data_dir)) {
+    if (frames.size() >= kMaxFrames) break;
+    size_t len = 0;
+    uint8_t* jpeg = loadFile(img.path.c_str(), &len);
+    Frame frame;
+    if (jpeg && decodeJpegGray(jpeg, len, &frame.gray, &frame.width, &frame.height)) {
+      frames.push_back(std::move(frame));
+    }
+    free(jpeg);
+  }
+  if (frames.empty()) {
+    fprintf(stderr, "❌ Nenhuma imagem em %s\n", data_dir);
+    return 1;
+  }
+
+  // Entrada real de cada camada em cada imagem
+  const int layers = engine.layerCount();
+  std::vector<std::vector<int8_t>> inputs(layers * frames.size());
+  for (size_t f = 0; f < frames.size(); ++f) {
+    engine.setInputFromGray(frames[f].gray.data(), frames[f].width, frames[f].height);
+    for (int l = 0; l < layers; ++l) {
+      // A FullyConnected lê o tensor do Flatten (RESHAPE = apelido)
+      int t = engine.layer(l).input;
+      while (engine.tensor(t).alias_of >= 0) t = engine.tensor(t).alias_of;
+      const Int8Tensor& in = engine.tensor(t);
+      if (in.data) inputs[l * frames.size() + f].assign(in.data, in.data + in.bytes);
+      engine.invokeLayer(l);
+    }
+  }
+
+  std::vector<PrunedLayer> pruned[kSparsityCount];
+  for (int k = 0; k < kSparsityCount; ++k) pruned[k] = pruneModel(engine, kSparsities[k]);
+  if (pruned[0].empty()) {
+    fprintf(stderr, "❌ Nenhuma camada com in_c múltiplo de %d\n", kSparseSpan);
+    return 1;
+  }
+
+  printf("🧠 Densa x esparsa em blocos (%dx%d pesos por faixa, %zu imagens)\n\n", kSparseSpan,
+         kPackBlock, frames.size());
+  printf("%-3s %-16s %-18s %6s %10s %10s %8s %10s %10s  %s\n", "#", "operador", "forma",
+         "poda", "densa(us)", "esparsa", "speedup", "bytes", "esparsos", "saída");
+
+  bool identical = true;
+  for (size_t i = 0; i < pruned[0].size(); ++i) {
+    const int l = pruned[0][i].layer;
+    const Int8Layer& layer = engine.layer(l);
+    const ConvShape& s = layer.shape;
+    const bool fused = layer.op == kOpConv2DMaxPool;
+    RequantParams rq;
+    rq.multiplier = layer.multiplier;
+    rq.shift = layer.shift;
+    rq.output_offset = engine.tensor(layer.output).zero_point;
+    rq.act_min = layer.act_min;
+    rq.act_max = layer.act_max;
+    const int32_t offset = -engine.tensor(layer.input).zero_point;
+    const int32_t* bias = layer.bias >= 0 ? (const int32_t*)engine.tensor(layer.bias).buffer
+                                          : nullptr;
+    const size_t out_size = engine.tensor(layer.output).bytes;
+
+    for (int k = 0; k < kSparsityCount; ++k) {
+      const PrunedLayer& p = pruned[k][i];
+      const int8_t* dense = p.dense.data();
+      // 0 = densa OHWI, 1 = esparsa
+      auto run = [&](int path, const int8_t* in, int8_t* out) {
+        if (layer.op == kOpFullyConnected && path == 0) {
+          fullyConnectedInt8(s.in_c, s.out_c, in, offset, dense, bias, rq, out);
+        } else if (layer.op == kOpFullyConnected) {
+          fullyConnectedInt8Sparse(s.in_c, s.out_c, in, offset, p.view, bias, rq, out);
+        } else if (fused && path == 0) {
+          conv2dMaxPoolInt8(s, layer.pool, in, offset, dense, bias, rq, out);
+        } else if (fused) {
+          conv2dMaxPoolInt8Sparse(s, layer.pool, in, offset, p.view, bias, rq, out);
+        } else if (path == 0) {
+          conv2dInt8(s, in, offset, dense, bias, rq, out);
+        } else {
+          conv2dInt8Sparse(s, in, offset, p.view, bias, rq, out);
+        }
+      };
+
+      bool same = true;
+      std::vector<int8_t> ref(out_size), got(out_size);
+      for (size_t f = 0; f < frames.size(); ++f) {
+        run(0, inputs[l * frames.size() + f].data(), ref.data());
+        run(1, inputs[l * frames.size() + f].data(), got.data());
+        same = same && ref == got;
+      }
+      double us[2];
+      for (int path = 0; path < 2; ++path) {
+        us[path] = 1e30;
+        for (int r = 0; r < kRepeats; ++r) {
+          auto t0 = std::chrono::steady_clock::now();
+          for (size_t f = 0; f < frames.size(); ++f) {
+            run(path, inputs[l * frames.size() + f].data(), got.data());
+          }
+          us[path] = std::min(us[path], elapsedUs(t0) / frames.size());
+        }
+      }
+      identical = identical && same;
+      char shape[32];
+      if (layer.op == kOpFullyConnected) snprintf(shape, sizeof(shape), "%d->%d", s.in_c, s.out_c);
+      else snprintf(shape, sizeof(shape), "%dx%dx%d->%d", s.in_h, s.in_w, s.in_c, s.out_c);
+      printf("%-3d %-16s %-18s %5.0f%% %10.1f %10.1f %7.2fx %10zu %10zu  %s\n", l,
+             LayerProfiler::opName(layer.op), shape, kSparsities[k] * 100.0f, us[0], us[1],
+             us[0] / us[1], p.dense.size(), p.sparse.size(),
+             same ? "✅ idêntica" : "❌ DIFERENTE");
+    }
+  }
+
+  // Modelo inteiro: blob podado denso x blob com as seções esparsas
+  printf("\n%-6s %14s %14s %8s  %s\n", "poda", "densa (us)", "esparsa (us)", "speedup", "camadas");
+  for (int k = 0; k < kSparsityCount; ++k) {
+    size_t sizes[2];
+    uint8_t* blobs[2];
+    static uint8_t arenas[2][kHostArenaSize];
+    Int8Engine engines[2];
+    double us[2] = { 0.0, 0.0 };
+    bool ok = true;
+    uint8_t* model = prunedModel(engine, pruned[k]);
+    for (int e = 0; e < 2; ++e) {
+      blobs[e] = prunedBlob(engine, pruned[k], e == 1, &sizes[e]);
+      engines[e].setPackedWeights(blobs[e], sizes[e]);
+      ok = ok && engines[e].begin(model, g_model_len, arenas[e], kHostArenaSize);
+    }
+    if (!ok || engines[1].sparseLayerCount() != (int)pruned[k].size()) {
+      fprintf(stderr, "❌ Blob podado rejeitado: %s\n", engines[1].errorMessage());
+      return 1;
+    }
+    bool same = true;
+    for (const Frame& f : frames) {
+      for (int e = 0; e < 2; ++e) engines[e].setInputFromGray(f.gray.data(), f.width, f.height);
+      // Camada a camada, para conferir cada saída antes de a arena reaproveitá-la
+      for (int l = 0; l < layers; ++l) {
+        for (int e = 0; e < 2; ++e) engines[e].invokeLayer(l);
+        const Int8Tensor& a = engines[0].tensor(engines[0].layer(l).output);
+        const Int8Tensor& b = engines[1].tensor(engines[1].layer(l).output);
+        same = same && memcmp(a.data, b.data, a.bytes) == 0;
+      }
+    }
+    for (int e = 0; e < 2; ++e) {
+      us[e] = 1e30;
+      for (int r = 0; r < kRepeats; ++r) {
+        auto t0 = std::chrono::steady_clock::now();
+        for (const Frame& f : frames) {
+          engines[e].setInputFromGray(f.gray.data(), f.width, f.height);
+          engines[e].invoke();
+        }
+        us[e] = std::min(us[e], elapsedUs(t0) / frames.size());
+      }
+      free(blobs[e]);
+    }
+    free(model);
+    identical = identical && same;
+    printf("%5.0f%% %14.1f %14.1f %7.2fx  %d esparsas, %s\n", kSparsities[k] * 100.0f, us[0],
+           us[1], us[0] / us[1], engines[1].sparseLayerCount(),
+           same ? "✅ saídas idênticas" : "❌ DIFERENTES");
+  }
+  return identical ? 0 : 1;
+}
@@ -0,0 +1,229 @@
+/*
+ * SPRINT 3 - Precisão e Speedup do Winograd F(2x2, 3x3) por Camada
+ * ================================================================
+ *
+ * Para cada Conv2D 3x3 stride 1 do g_model (fundida ou não ao
+ * MaxPool), captura a entrada real da camada em cada imagem do
+ * dataset representativo e compara três caminhos:
+ *
+ *   - referência escalar (conv2dInt8 / conv2dMaxPoolInt8);
+ *   - melhor backend de kernels (kernel_backend.h);
+ *   - Winograd F(2x2, 3x3) (winograd_conv.h).
+ *
+ * A camada é aprovada para Winograd se a maior diferença em relação à
+ * referência ficar em até um passo de quantização, e sugerida se além
+ * disso for ao menos kMinGainPercent% mais rápida que o backend. Imprime
+ * o erro, a latência e o speedup por camada, as duas máscaras, confere o
+ * modelo inteiro com as aprovadas (com as camadas em patches, como no
+ * firmware) e roda nele o Int8Engine::tuneWinograd que o firmware usa no
+ * boot, com as mesmas repetições e margem, e a compactação dos pesos
+ * transformados das camadas mantidas (moveWinograd).
+ *
+ * Uso:
+ *     ./build/host_winograd [dados]
+ *
+ * Autor: Equipe SPRINT 3
+ * Data: 2025
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "host_common.h"
+#include "int8_engine.h"
+#include "model.h"
+
+static const size_t kHostArenaSize = 1024 * 1024;
+static const size_t kWinogradBufferSize = 512 * 1024;
+static const int kRepeats = 3;
+static const int kTuneRepeats = 8;        // Iguais ao firmware (main_real_advanced.cpp)
+static const int kMinGainPercent = 5;
+static const int kMaxStepError = 1;
+static const int kPatchLayers = 3;
+static const int kPatchGrid = 4;
+
+struct Frame {
+  std::vector<uint8_t> gray;
+  int width;
+  int height;
+};
+
+static int maxAbsDiff(const std::vector<int8_t>& a, const std::vector<int8_t>& b) {
+  int worst = 0;
+  for (size_t i = 0; i < a.size(); ++i) worst = std::max(worst, std::abs(a[i] - b[i]));
+  return worst;
+}
+
+int main(int argc, char** argv) {
+  const char* data_dir = argc > 1 ? argv[1] : kDefaultDataDir;
+  static uint8_t arena[kHostArenaSize];
+  static Int8Engine engine;
+  if (!engine.begin(g_model, g_model_len, arena, sizeof(arena))) {
+    fprintf(stderr, "❌ Falha ao carregar modelo: %s\n", engine.errorMessage());
+    return 1;
+  }
+
+  std::vector<Frame> frames;
+  for (const LabeledImage& img : listRepresentativeImages(data_dir)) {
+    size_t len = 0;
+    uint8_t* jpeg = loadFile(img.path.c_str(), &len);
+    Frame frame;
+    if (jpeg && decodeJpegGray(jpeg, len, &frame.gray, &frame.width, &frame.height)) {
+      frames.push_back(std::move(frame));
+    }
+    free(jpeg);
+  }
+  if (frames.empty()) {
+    fprintf(stderr, "❌ Nenhuma imagem em %s\n", data_dir);
+    return 1;
+  }
+
+  // Entrada real de cada camada em cada imagem
+  const int layers = engine.layerCount();
+  std::vector<std::vector<int8_t>> inputs(layers * frames.size());
+  for (size_t f = 0; f < frames.size(); ++f) {
+    engine.setInputFromGray(frames[f].gray.data(), frames[f].width, frames[f].height);
+    for (int l = 0; l < layers; ++l) {
+      const Int8Tensor& in = engine.tensor(engine.layer(l).input);
+      if (in.data) inputs[l * frames.size() + f].assign(in.data, in.data + in.bytes);
+      engine.invokeLayer(l);
+    }
+  }
+
+  const KernelBackend* backend = bestKernelBackend();
+  static int16_t u[kWinogradBufferSize / sizeof(int16_t)];
+  printf("🧠 Winograd F(2x2,3x3) vs referência e backend %s (%zu imagens)\n\n", backend->name,
+         frames.size());
+  printf("%-3s %-16s %-18s %6s %10s %10s %10s %8s %8s  %s\n", "#", "operador", "forma",
+         "erro", "ref (us)", "backend", "winograd", "vs ref", "vs back", "usa");
+
+  uint32_t approved = 0;  // Precisão
+  uint32_t mask = 0;      // Precisão e mais rápida que o backend
+  for (int l = 0; l < layers; ++l) {
+    const Int8Layer& layer = engine.layer(l);
+    const bool fused = layer.op == kOpConv2DMaxPool;
+    if (layer.op != kOpConv2D && !fused) continue;
+    const ConvShape& s = layer.shape;
+    if (!winogradSupported(s, fused ? &layer.pool : nullptr)) continue;
+    if (winogradWeightBytes(s) > sizeof(u)) continue;
+    winogradTransformWeights(s, (const int8_t*)engine.tensor(layer.weights).buffer, u);
+
+    RequantParams rq;
+    rq.multiplier = layer.multiplier;
+    rq.shift = layer.shift;
+    rq.output_offset = engine.tensor(layer.output).zero_point;
+    rq.act_min = layer.act_min;
+    rq.act_max = layer.act_max;
+    const int32_t offset = -engine.tensor(layer.input).zero_point;
+    const int8_t* w = (const int8_t*)engine.tensor(layer.weights).buffer;
+    const int32_t* bias = layer.bias >= 0 ? (const int32_t*)engine.tensor(layer.bias).buffer
+                                          : nullptr;
+    const size_t out_size = fused ? (size_t)layer.pool.out_h * layer.pool.out_w * s.out_c
+                                  : (size_t)s.out_h * s.out_w * s.out_c;
+
+    // 0 = referência, 1 = backend, 2 = Winograd
+    auto run = [&](int path, const int8_t* in, int8_t* out) {
+      if (path == 0 && fused) conv2dMaxPoolInt8(s, layer.pool, in, offset, w, bias, rq, out);
+      if (path == 0 && !fused) conv2dInt8(s, in, offset, w, bias, rq, out);
+      if (path == 1 && fused) {
+        backend->conv2dMaxPool(s, layer.pool, in, offset, w, bias, layer.weight_sums, rq, out);
+      }
+      if (path == 1 && !fused) backend->conv2d(s, in, offset, w, bias, layer.weight_sums, rq, out);
+      if (path == 2 && fused) {
+        conv2dMaxPoolWinogradInt8(s, layer.pool, in, offset, u, bias, rq, out);
+      }
+      if (path == 2 && !fused) conv2dWinogradInt8(s, in, offset, u, bias, rq, out);
+    };
+
+    int error = 0;
+    std::vector<int8_t> ref(out_size), got(out_size);
+    for (size_t f = 0; f < frames.size(); ++f) {
+      const int8_t* in = inputs[l * frames.size() + f].data();
+      run(0, in, ref.data());
+      run(2, in, got.data());
+      error = std::max(error, maxAbsDiff(ref, got));
+    }
+    double us[3];
+    for (int path = 0; path < 3; ++path) {
+      us[path] = 1e30;
+      for (int r = 0; r < kRepeats; ++r) {
+        auto t0 = std::chrono::steady_clock::now();
+        for (size_t f = 0; f < frames.size(); ++f) {
+          run(path, inputs[l * frames.size() + f].data(), got.data());
+        }
+        us[path] = std::min(us[path], elapsedUs(t0) / frames.size());
+      }
+    }
+    const bool precise = error <= kMaxStepError;
+    const bool use = precise && us[2] * 100.0 <= us[1] * (100 - kMinGainPercent);
+    if (precise) approved |= 1u << l;
+    if (use) mask |= 1u << l;
+    char shape[32];
+    snprintf(shape, sizeof(shape), "%dx%dx%d->%d", s.in_h, s.in_w, s.in_c, s.out_c);
+    printf("%-3d %-16s %-18s %6d %10.1f %10.1f %10.1f %7.2fx %7.2fx  %s\n", l,
+           LayerProfiler::opName(layer.op), shape, error, us[0], us[1], us[2], us[0] / us[2],
+           us[1] / us[2], use ? "✅" : (precise ? "❌ lenta" : "❌ erro"));
+  }
+  printf("\n(erro: maior |diferença| em passos de quantização; aprovado até %d)\n",
+         kMaxStepError);
+  printf("✅ Aprovadas pela precisão (candidatas do kWinogradLayers do firmware): 0x%x\n",
+         approved);
+  printf("🎯 Máscara sugerida para setWinograd (aprovadas e %d%% mais rápidas que %s): 0x%x\n",
+         kMinGainPercent, backend->name, mask);
+
+  // Modelo inteiro com as aprovadas (e os patches 4x4 do firmware) contra a
+  // execução sem Winograd
+  static uint8_t arena_w[kHostArenaSize];
+  static Int8Engine winograd;
+  winograd.setWinograd(approved, u, sizeof(u));
+  winograd.setPatchInference(kPatchLayers, kPatchGrid);
+  if (!winograd.begin(g_model, g_model_len, arena_w, sizeof(arena_w))) {
+    fprintf(stderr, "❌ Falha ao carregar modelo: %s\n", winograd.errorMessage());
+    return 1;
+  }
+  int worst = 0;
+  for (const Frame& f : frames) {
+    engine.setInputFromGray(f.gray.data(), f.width, f.height);
+    winograd.setInputFromGray(f.gray.data(), f.width, f.height);
+    if (!engine.invoke() || !winograd.invoke()) return 1;
+    for (int i = 0; i < engine.outputSize(); ++i) {
+      worst = std::max(worst, std::abs(engine.output()[i] - winograd.output()[i]));
+    }
+  }
+  printf("🔁 Modelo com %d camada(s) Winograd (%zu bytes de pesos transformados): "
+         "maior diferença na saída = %d passo(s)\n", winograd.winogradLayerCount(),
+         winograd.winogradBytes(), worst);
+
+  // Escolha do boot do firmware: Winograd só onde o bloco em patches fica mais rápido
+  winograd.setKernelBackend(backend);
+  const size_t before = winograd.winogradBytes();
+  const uint32_t tuned = winograd.tuneWinograd(kTuneRepeats, kMinGainPercent);
+  printf("🎛️ tuneWinograd (patches %dx%d, backend %s, %d repetições, margem %d%%): "
+         "mantém 0x%x de 0x%x\n", kPatchGrid, kPatchGrid, backend->name, kTuneRepeats,
+         kMinGainPercent, tuned, approved);
+
+  // Como o firmware: pesos das camadas mantidas num buffer do tamanho exato
+  std::vector<int16_t> compact(winograd.winogradBytes() / sizeof(int16_t));
+  if (!winograd.moveWinograd(compact.empty() ? nullptr : compact.data(),
+                             winograd.winogradBytes())) {
+    fprintf(stderr, "❌ moveWinograd: %s\n", winograd.errorMessage());
+    return 1;
+  }
+  memset(u, 0, sizeof(u));  // O buffer antigo não pode mais ser lido
+  int moved = 0;
+  for (const Frame& f : frames) {
+    engine.setInputFromGray(f.gray.data(), f.width, f.height);
+    winograd.setInputFromGray(f.gray.data(), f.width, f.height);
+    if (!engine.invoke() || !winograd.invoke()) return 1;
+    for (int i = 0; i < engine.outputSize(); ++i) {
+      moved = std::max(moved, std::abs(engine.output()[i] - winograd.output()[i]));
+    }
+  }
+  printf("🧹 Pesos transformados: %zu -> %zu bytes após o ajuste, maior diferença na saída = "
+         "%d passo(s)\n", before, winograd.winogradBytes(), moved);
+  return worst <= kMaxStepError && moved <= kMaxStepError ? 0 : 1;
+}
@@ -0,0 +1,273 @@
+/*
+ * SPRINT 3 - Benchmark da Captura YUV422 (Y Direto para a Entrada)
+ * ================================================================
+ *
+ * Gera frames sintéticos QVGA (320x240) no formato PIXFORMAT_YUV422 do
+ * esp32-camera (Y0 U Y1 V) a partir das fotos da Sprint 1 (ou do
+ * dataset representativo) e de ruído aleatório, com o RGB565 big-endian
+ * equivalente, e mede por frame:
+ *
+ *   - RGB565 em duas passadas (main.cpp + setInputFromGray);
+ *   - RGB565 fundido (setInputFromRgb565) com o lumaRow de cada backend;
+ *   - YUV422 (setInputFromYuv422) com o yRow de cada backend: só os
+ *     bytes Y, sem conversão de cor.
+ *
+ * Confere que o tensor do YUV422 é bit a bit a média por área inteira do
+ * plano Y (mesmas caixas, mesma tabela de quantização), que todos os
+ * backends escrevem o mesmo tensor (também em linhas de largura
+ * aleatória, para as caudas) e compara as médias R/G/B que as
+ * estatísticas tiram só da croma com as do RGB de origem.
+ *
+ * Uso:
+ *     ./build/host_yuv422 [dataset_sprint1] [dados_representativos]
+ *
+ * Autor: Equipe SPRINT 3
+ * Data: 2025
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "host_common.h"
+#include "image_stats.h"
+#include "int8_engine.h"
+#include "model.h"
+
+static const size_t kHostArenaSize = 1024 * 1024;
+static const int kFrameWidth = 320;
+static const int kFrameHeight = 240;
+static const size_t kMaxFrames = 24;
+static const int kNoiseFrames = 4;
+static const int kRepeats = 20;
+static const int kRandomRows = 500;
+
+struct Frame {
+  std::vector<uint8_t> yuv422;     // Y0 U Y1 V, como o esp32-camera
+  std::vector<uint8_t> rgb565;     // Big-endian
+  double rgb_mean[3];              // Médias do RGB888 de origem
+};
+
+static uint32_t nextRandom(uint32_t* seed) {
+  *seed = *seed * 1664525u + 1013904223u;
+  return *seed >> 8;
+}
+
+static uint8_t clampByte(double v) { return (uint8_t)std::max(0.0, std::min(255.0, v + 0.5)); }
+
+// RGB888 QVGA -> YUV422 (BT.601 de faixa cheia, U/V médios de cada par) e RGB565
+static Frame makeFrame(const std::vector<uint8_t>& rgb) {
+  Frame f;
+  f.yuv422.resize((size_t)kFrameWidth * kFrameHeight * 2);
+  f.rgb565.resize(f.yuv422.size());
+  for (int c = 0; c < 3; ++c) f.rgb_mean[c] = 0.0;
+  const size_t n = (size_t)kFrameWidth * kFrameHeight;
+  for (size_t i = 0; i < n; ++i) {
+    const uint8_t* p = &rgb[i * 3];
+    for (int c = 0; c < 3; ++c) f.rgb_mean[c] += (double)p[c] / n;
+    const uint16_t v = (uint16_t)(((p[0] >> 3) << 11) | ((p[1] >> 2) << 5) | (p[2] >> 3));
+    f.rgb565[i * 2] = (uint8_t)(v >> 8);
+    f.rgb565[i * 2 + 1] = (uint8_t)v;
+    f.yuv422[i * 2] = clampByte(0.299 * p[0] + 0.587 * p[1] + 0.114 * p[2]);
+  }
+  for (size_t i = 0; i < n; i += 2) {
+    double u = 0.0, v = 0.0;
+    for (size_t k = i; k < i + 2; ++k) {
+      const uint8_t* p = &rgb[k * 3];
+      u += (-0.1687 * p[0] - 0.3313 * p[1] + 0.5 * p[2]) / 2;
+      v += (0.5 * p[0] - 0.4187 * p[1] - 0.0813 * p[2]) / 2;
+    }
+    f.yuv422[i * 2 + 1] = clampByte(128.0 + u);
+    f.yuv422[i * 2 + 3] = clampByte(128.0 + v);
+  }
+  return f;
+}
+
+// Foto de qualquer tamanho -> RGB888 QVGA por vizinho mais próximo
+static std::vector<uint8_t> resizeRgb(const std::vector<uint8_t>& rgb, int w, int h) {
+  std::vector<uint8_t> out((size_t)kFrameWidth * kFrameHeight * 3);
+  for (int y = 0; y < kFrameHeight; ++y) {
+    for (int x = 0; x < kFrameWidth; ++x) {
+      const uint8_t* p = &rgb[((size_t)(y * h / kFrameHeight) * w + x * w / kFrameWidth) * 3];
+      memcpy(&out[((size_t)y * kFrameWidth + x) * 3], p, 3);
+    }
+  }
+  return out;
+}
+
+// Caminho do main.cpp: tons de cinza do frame inteiro, depois setInputFromGray
+static void twoPass(Int8Engine& engine, const uint8_t* frame, std::vector<uint8_t>* gray) {
+  for (int i = 0; i < kFrameWidth * kFrameHeight; ++i) {
+    const uint16_t pixel = (uint16_t)((frame[2 * i] << 8) | frame[2 * i + 1]);
+    const uint32_t r = ((pixel >> 11) & 0x1F) * 255 / 31;
+    const uint32_t g = ((pixel >> 5) & 0x3F) * 255 / 63;
+    const uint32_t b = (pixel & 0x1F) * 255 / 31;
+    (*gray)[i] = (uint8_t)((299 * r + 587 * g + 114 * b) / 1000);
+  }
+  engine.setInputFromGray(gray->data(), kFrameWidth, kFrameHeight);
+}
+
+// Média por área inteira do plano Y, com a tabela de quantização do engine
+static std::vector<int8_t> yReference(const uint8_t* yuv, int out_w, int out_h, int channels,
+                                      float scale, int32_t zero_point) {
+  std::vector<int8_t> out((size_t)out_w * out_h * channels);
+  int8_t* dst = out.data();
+  for (int y = 0; y < out_h; ++y) {
+    const int y0 = y * kFrameHeight / out_h, y1 = (y + 1) * kFrameHeight / out_h;
+    for (int x = 0; x < out_w; ++x) {
+      const int x0 = x * kFrameWidth / out_w, x1 = (x + 1) * kFrameWidth / out_w;
+      uint32_t sum = 0;
+      for (int iy = y0; iy < y1; ++iy) {
+        for (int ix = x0; ix < x1; ++ix) sum += yuv[((size_t)iy * kFrameWidth + ix) * 2];
+      }
+      const uint32_t count = (uint32_t)((y1 - y0) * (x1 - x0));
+      const uint32_t p = (sum + count / 2) / count;
+      int32_t q = (int32_t)lroundf(((float)p / 255.0f) / scale) + zero_point;
+      q = std::max(-128, std::min(127, q));
+      for (int c = 0; c < channels; ++c) *dst++ = (int8_t)q;
+    }
+  }
+  return out;
+}
+
+// yRow de cada backend contra o escalar em linhas de largura aleatória
+static bool checkRandomRows(const KernelBackend* backend) {
+  uint32_t seed = 0x422;
+  std::vector<uint8_t> row(kPreprocessMaxWidth * 2);
+  std::vector<uint16_t> a(kPreprocessMaxWidth), b(kPreprocessMaxWidth);
+  for (int t = 0; t < kRandomRows; ++t) {
+    const int width = 1 + (int)(nextRandom(&seed) % kPreprocessMaxWidth);
+    for (uint8_t& v : row) v = (uint8_t)nextRandom(&seed);
+    for (int x = 0; x < kPreprocessMaxWidth; ++x) a[x] = b[x] = (uint16_t)(x * 7);
+    yuv422YRowScalar(row.data(), width, a.data());
+    backend->yRow(row.data(), width, b.data());
+    if (a != b) return false;
+  }
+  return true;
+}
+
+int main(int argc, char** argv) {
+  const char* sprint1_dir = argc > 1 ? argv[1] : kSprint1DataDir;
+  const char* data_dir = argc > 2 ? argv[2] : kDefaultDataDir;
+  static uint8_t arena[kHostArenaSize];
+  static Int8Engine engine;
+  if (!engine.begin(g_model, g_model_len, arena, sizeof(arena))) {
+    fprintf(stderr, "❌ Falha ao carregar modelo: %s\n", engine.errorMessage());
+    return 1;
+  }
+
+  std::vector<LabeledImage> images = listSprint1Images(sprint1_dir);
+  if (images.empty()) images = listRepresentativeImages(data_dir);
+  std::vector<Frame> frames;
+  for (const LabeledImage& img : images) {
+    if (frames.size() >= kMaxFrames) break;
+    size_t len = 0;
+    uint8_t* jpeg = loadFile(img.path.c_str(), &len);
+    std::vector<uint8_t> rgb;
+    int w = 0, h = 0;
+    if (jpeg && decodeJpegRgb(jpeg, len, &rgb, &w, &h)) {
+      frames.push_back(makeFrame(resizeRgb(rgb, w, h)));
+    }
+    free(jpeg);
+  }
+  // Ruído: bordas de alto contraste em todo o frame e croma nos extremos
+  uint32_t seed = 0x59555632;
+  for (int k = 0; k < kNoiseFrames; ++k) {
+    std::vector<uint8_t> rgb((size_t)kFrameWidth * kFrameHeight * 3);
+    for (uint8_t& v : rgb) v = (uint8_t)nextRandom(&seed);
+    frames.push_back(makeFrame(rgb));
+  }
+
+  const int out_w = engine.inputWidth();
+  const int out_h = engine.inputHeight();
+  const int channels = engine.inputChannels();
+  const size_t in_size = (size_t)out_w * out_h * channels;
+  const Int8Tensor& in = engine.tensor(engine.layer(0).input);
+
+  printf("🖼️  YUV422/RGB565 %dx%d -> %dx%dx%d INT8 (%zu frames, %d de ruído)\n\n", kFrameWidth,
+         kFrameHeight, out_w, out_h, channels, frames.size(), kNoiseFrames);
+  printf("%-28s %10s %8s  %s\n", "caminho", "us/frame", "speedup", "saída");
+
+  std::vector<uint8_t> gray((size_t)kFrameWidth * kFrameHeight);
+  std::vector<int8_t> yuv_scalar(frames.size() * in_size);
+  double base_us = 0.0;
+  bool ok = true;
+  // 0 = duas passadas RGB565; 1 = RGB565 fundido; 2 = YUV422 (1 e 2 por backend)
+  for (int path = 0; path < 3; ++path) {
+    const int backends = path == 0 ? 1 : kernelBackendCount();
+    for (int b = 0; b < backends; ++b) {
+      const KernelBackend* backend = path == 0 ? nullptr : kernelBackend(b);
+      engine.setKernelBackend(backend);
+      auto run = [&](size_t f) {
+        if (path == 0) {
+          twoPass(engine, frames[f].rgb565.data(), &gray);
+          return true;
+        }
+        if (path == 1) {
+          return engine.setInputFromRgb565(frames[f].rgb565.data(), kFrameWidth, kFrameHeight);
+        }
+        return engine.setInputFromYuv422(frames[f].yuv422.data(), kFrameWidth, kFrameHeight);
+      };
+
+      const char* status = path == 0 ? "vizinho" : "média por área";
+      if (path == 2) {
+        bool same = true;
+        for (size_t f = 0; f < frames.size(); ++f) {
+          same = run(f) && same;
+          const int8_t* got = engine.input();
+          const std::vector<int8_t> ref = yReference(frames[f].yuv422.data(), out_w, out_h,
+                                                     channels, in.scale, in.zero_point);
+          same = same && memcmp(got, ref.data(), in_size) == 0;
+          if (b == 0) memcpy(&yuv_scalar[f * in_size], got, in_size);
+          else same = same && memcmp(&yuv_scalar[f * in_size], got, in_size) == 0;
+        }
+        if (b > 0) same = same && checkRandomRows(backend);
+        status = same ? "✅ = plano Y" : "❌ DIFERENTE";
+        ok = ok && same;
+      }
+
+      double us = 1e30;
+      for (int r = 0; r < 3; ++r) {
+        auto t0 = std::chrono::steady_clock::now();
+        for (int k = 0; k < kRepeats; ++k) {
+          for (size_t f = 0; f < frames.size(); ++f) run(f);
+        }
+        us = std::min(us, elapsedUs(t0) / (kRepeats * frames.size()));
+      }
+      if (path == 0) base_us = us;
+
+      char name[40];
+      if (path == 0) snprintf(name, sizeof(name), "RGB565 duas passadas");
+      else snprintf(name, sizeof(name), "%s %s", path == 1 ? "RGB565 fundido" : "YUV422 Y",
+                    backend->name);
+      printf("%-28s %10.1f %7.2fx  %s\n", name, us, base_us / us, status);
+    }
+  }
+  engine.setKernelBackend(nullptr);
+
+  // Médias de cor das estatísticas YUV422 (Y por pixel, croma por média)
+  double worst = 0.0;
+  for (const Frame& f : frames) {
+    ImageStats s;
+    imageStatsReset(&s);
+    const size_t stride = (size_t)kFrameWidth * 2;
+    std::vector<uint8_t> luma((size_t)kFrameWidth * kFrameHeight);
+    for (int y = 0; y < kFrameHeight; ++y) {
+      const uint8_t* row = f.yuv422.data() + y * stride;
+      uint8_t* out = &luma[(size_t)y * kFrameWidth];
+      imageStatsAddYuv422(&s, row, y > 0 ? out - kFrameWidth : nullptr, kFrameWidth, out);
+    }
+    imageStatsFinishYuv422(&s);
+    for (int c = 0; c < 3; ++c) {
+      worst = std::max(worst, fabs((double)s.sum[c] / s.color_pixels - f.rgb_mean[c]));
+    }
+  }
+  printf("\n🎨 Médias R/G/B pela croma do YUV422: máx |Δ| = %.2f níveis %s\n", worst,
+         worst < 2.0 ? "✅" : "❌");
+  ok = ok && worst < 2.0;
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,54 @@
+/*
+ * SPRINT 3 - Planejador Estático da Arena de Tensores
+ * ===================================================
+ *
+ * Autor: Equipe SPRINT 3
+ * Data: 2025
+ */
+
+#include "arena_planner.h"
+
+static inline uint32_t alignUp(uint32_t value, uint32_t alignment) {
+  return (value + alignment - 1) & ~(alignment - 1);
+}
+
+static inline bool livesOverlap(const PlannerBuffer& a, const PlannerBuffer& b) {
+  return a.first_use <= b.last_use && b.first_use <= a.last_use;
+}
+
+uint32_t planArena(PlannerBuffer* buffers, int count, uint32_t alignment) {
+  if (count <= 0 || count > kMaxPlannerBuffers) return 0;
+
+  // Ordem de posicionamento: maiores primeiro (insertion sort, N pequeno)
+  int order[kMaxPlannerBuffers];
+  for (int i = 0; i < count; ++i) {
+    int j = i;
+    while (j > 0 && buffers[order[j - 1]].size < buffers[i].size) {
+      order[j] = order[j - 1];
+      --j;
+    }
+    order[j] = i;
+  }
+
+  uint32_t peak = 0;
+  for (int n = 0; n < count; ++n) {
+    PlannerBuffer& cur = buffers[order[n]];
+    uint32_t offset = 0;
+    // Desliza o buffer para cima até não colidir com nenhum vivo ao mesmo tempo
+    bool moved = true;
+    while (moved) {
+      moved = false;
+      for (int k = 0; k < n; ++k) {
+        const PlannerBuffer& placed = buffers[order[k]];
+        if (!livesOverlap(cur, placed)) continue;
+        if (offset < placed.offset + placed.size && placed.offset < offset + cur.size) {
+          offset = alignUp(placed.offset + placed.size, alignment);
+          moved = true;
+        }
+      }
+    }
+    cur.offset = offset;
+    if (offset + cur.size > peak) peak = offset + cur.size;
+  }
+  return alignUp(peak, alignment);
+}
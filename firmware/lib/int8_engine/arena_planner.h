@@ -0,0 +1,32 @@
+/*
+ * SPRINT 3 - Planejador Estático da Arena de Tensores
+ * ===================================================
+ *
+ * Calcula o tempo de vida de cada ativação (primeira camada que a
+ * escreve, última que a lê) e empacota todas numa única arena,
+ * reaproveitando endereços de tensores que nunca estão vivos ao
+ * mesmo tempo. Estratégia gulosa por tamanho decrescente, a mesma
+ * do GreedyMemoryPlanner do TFLite Micro.
+ *
+ * Autor: Equipe SPRINT 3
+ * Data: 2025
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+// Máximo de buffers por plano
+static const int kMaxPlannerBuffers = 64;
+
+// Buffer a ser posicionado na arena
+struct PlannerBuffer {
+  uint32_t size;
+  int16_t first_use;   // Índice da camada que produz o tensor (-1 = antes da 1ª camada)
+  int16_t last_use;    // Índice da última camada que consome o tensor
+  uint32_t offset;     // Resultado: deslocamento na arena
+};
+
+// Posiciona os buffers e retorna o pico (bytes) da arena planejada. Com mais de
+// kMaxPlannerBuffers buffers nada é posicionado e o retorno é 0
+uint32_t planArena(PlannerBuffer* buffers, int count, uint32_t alignment);
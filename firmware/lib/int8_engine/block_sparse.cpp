@@ -0,0 +1,180 @@
+/*
+ * SPRINT 3 - Kernels com Esparsidade Estruturada em Blocos
+ * ========================================================
+ *
+ * Autor: Equipe SPRINT 3
+ * Data: 2025
+ */
+
+#include "block_sparse.h"
+
+static const int kSpanBytes = kSparseSpan * kPackBlock;
+
+static inline size_t align4(size_t bytes) { return (bytes + 3) & ~(size_t)3; }
+
+bool blockSparseSupported(const ConvShape& s) {
+  if (s.in_c <= 0 || s.in_c % kSparseSpan != 0) return false;
+  if (s.k_h == 0 && s.k_w == 0) return true;
+  return s.k_h * s.k_w * s.in_c / kSparseSpan <= kSparseMaxConvSpans;
+}
+
+size_t blockSparseSectionBytes(int rows, uint32_t nnz) {
+  const int blocks = (rows + kPackBlock - 1) / kPackBlock;
+  return sizeof(uint32_t) * (blocks + 1) + align4(sizeof(uint16_t) * nnz) +
+         (size_t)nnz * kSpanBytes;
+}
+
+bool blockSparseView(const uint8_t* data, size_t size, int per_row, int rows,
+                     BlockSparseWeights* view) {
+  if (!data || per_row <= 0 || rows <= 0 || per_row % kSparseSpan != 0) return false;
+  const int blocks = (rows + kPackBlock - 1) / kPackBlock;
+  const uint32_t spans_per_row = (uint32_t)(per_row / kSparseSpan);
+  if (size < sizeof(uint32_t) * (blocks + 1)) return false;
+  const uint32_t* start = (const uint32_t*)data;
+  if (start[0] != 0) return false;
+  for (int b = 0; b < blocks; ++b) {
+    if (start[b + 1] < start[b] || start[b + 1] - start[b] > spans_per_row) return false;
+  }
+  const uint32_t nnz = start[blocks];
+  if (size != blockSparseSectionBytes(rows, nnz)) return false;
+
+  const uint16_t* spans = (const uint16_t*)(data + sizeof(uint32_t) * (blocks + 1));
+  for (int b = 0; b < blocks; ++b) {
+    for (uint32_t k = start[b]; k < start[b + 1]; ++k) {
+      // Faixas de um bloco em ordem crescente e dentro de R
+      if (spans[k] >= spans_per_row || (k > start[b] && spans[k] <= spans[k - 1])) return false;
+    }
+  }
+  view->block_start = start;
+  view->spans = spans;
+  view->values = (const int8_t*)((const uint8_t*)spans + align4(sizeof(uint16_t) * nnz));
+  view->blocks = blocks;
+  view->nnz = nnz;
+  return true;
+}
+
+float blockSparseDensity(const BlockSparseWeights& w, int per_row) {
+  const uint32_t dense = (uint32_t)w.blocks * (per_row / kSparseSpan);
+  return dense ? (float)w.nnz / dense : 1.0f;
+}
+
+// Acumula uma faixa: kSparseSpan entradas contíguas x kPackBlock canais
+static inline void accumulateSpan(const int8_t* x, int32_t input_offset, const int8_t* v,
+                                  int32_t* acc) {
+  for (int i = 0; i < kSparseSpan; ++i, v += kPackBlock) {
+    const int32_t xi = (int32_t)x[i] + input_offset;
+    for (int j = 0; j < kPackBlock; ++j) acc[j] += xi * (int32_t)v[j];
+  }
+}
+
+// =============================================================================
+// CONV2D
+// =============================================================================
+
+// Tap (ky, kx) e primeiro canal de entrada de cada faixa do filtro
+struct SpanTap {
+  uint8_t ky;
+  uint8_t kx;
+  uint16_t ic0;
+};
+
+static void buildTaps(const ConvShape& s, SpanTap* taps) {
+  const int spans = s.k_h * s.k_w * s.in_c / kSparseSpan;
+  for (int t = 0; t < spans; ++t) {
+    const int r0 = t * kSparseSpan;
+    const int tap = r0 / s.in_c;
+    taps[t].ky = (uint8_t)(tap / s.k_w);
+    taps[t].kx = (uint8_t)(tap % s.k_w);
+    taps[t].ic0 = (uint16_t)(r0 - tap * s.in_c);
+  }
+}
+
+static inline void convAccumulateSparse(const ConvShape& s, const int8_t* input,
+                                        int32_t input_offset, const BlockSparseWeights& w,
+                                        const SpanTap* taps, int b, int oy, int ox,
+                                        int32_t* acc) {
+  const int in_y0 = oy * s.stride_h - s.pad_h;
+  const int in_x0 = ox * s.stride_w - s.pad_w;
+  const int8_t* v = w.values + (size_t)w.block_start[b] * kSpanBytes;
+  for (uint32_t k = w.block_start[b]; k < w.block_start[b + 1]; ++k, v += kSpanBytes) {
+    const SpanTap& t = taps[w.spans[k]];
+    const int iy = in_y0 + t.ky;
+    const int ix = in_x0 + t.kx;
+    if (iy < 0 || iy >= s.in_h || ix < 0 || ix >= s.in_w) continue;
+    accumulateSpan(input + (iy * s.in_w + ix) * s.in_c + t.ic0, input_offset, v, acc);
+  }
+}
+
+void conv2dInt8Sparse(const ConvShape& s, const int8_t* input, int32_t input_offset,
+                      const BlockSparseWeights& w, const int32_t* bias,
+                      const RequantParams& rq, int8_t* output) {
+  SpanTap taps[kSparseMaxConvSpans];
+  buildTaps(s, taps);
+  for (int oy = 0; oy < s.out_h; ++oy) {
+    for (int ox = 0; ox < s.out_w; ++ox) {
+      int8_t* out = output + (oy * s.out_w + ox) * s.out_c;
+      for (int oc0 = 0, b = 0; oc0 < s.out_c; oc0 += kPackBlock, ++b) {
+        const int lanes = s.out_c - oc0 < kPackBlock ? s.out_c - oc0 : kPackBlock;
+        int32_t acc[kPackBlock];
+        loadBias(bias, oc0, lanes, acc);
+        convAccumulateSparse(s, input, input_offset, w, taps, b, oy, ox, acc);
+        for (int j = 0; j < lanes; ++j) out[oc0 + j] = requantize(acc[j], rq, oc0 + j);
+      }
+    }
+  }
+}
+
+void conv2dMaxPoolInt8Sparse(const ConvShape& conv, const ConvShape& pool,
+                             const int8_t* input, int32_t input_offset,
+                             const BlockSparseWeights& w, const int32_t* bias,
+                             const RequantParams& rq, int8_t* output) {
+  SpanTap taps[kSparseMaxConvSpans];
+  buildTaps(conv, taps);
+  for (int py = 0; py < pool.out_h; ++py) {
+    for (int px = 0; px < pool.out_w; ++px) {
+      int8_t* out = output + (py * pool.out_w + px) * conv.out_c;
+      for (int oc0 = 0, b = 0; oc0 < conv.out_c; oc0 += kPackBlock, ++b) {
+        const int lanes = conv.out_c - oc0 < kPackBlock ? conv.out_c - oc0 : kPackBlock;
+        int32_t m[kPackBlock];
+        for (int j = 0; j < kPackBlock; ++j) m[j] = rq.act_min;
+        for (int wy = 0; wy < pool.k_h; ++wy) {
+          const int oy = py * pool.stride_h + wy;
+          if (oy >= conv.out_h) continue;
+          for (int wx = 0; wx < pool.k_w; ++wx) {
+            const int ox = px * pool.stride_w + wx;
+            if (ox >= conv.out_w) continue;
+            int32_t acc[kPackBlock];
+            loadBias(bias, oc0, lanes, acc);
+            convAccumulateSparse(conv, input, input_offset, w, taps, b, oy, ox, acc);
+            for (int j = 0; j < lanes; ++j) {
+              const int32_t v = requantize(acc[j], rq, oc0 + j);
+              if (v > m[j]) m[j] = v;
+            }
+          }
+        }
+        for (int j = 0; j < lanes; ++j) out[oc0 + j] = (int8_t)m[j];
+      }
+    }
+  }
+}
+
+// =============================================================================
+// FULLYCONNECTED
+// =============================================================================
+
+void fullyConnectedInt8Sparse(int in_features, int out_features,
+                              const int8_t* input, int32_t input_offset,
+                              const BlockSparseWeights& w, const int32_t* bias,
+                              const RequantParams& rq, int8_t* output) {
+  (void)in_features;
+  for (int o0 = 0, b = 0; o0 < out_features; o0 += kPackBlock, ++b) {
+    const int lanes = out_features - o0 < kPackBlock ? out_features - o0 : kPackBlock;
+    int32_t acc[kPackBlock];
+    loadBias(bias, o0, lanes, acc);
+    const int8_t* v = w.values + (size_t)w.block_start[b] * kSpanBytes;
+    for (uint32_t k = w.block_start[b]; k < w.block_start[b + 1]; ++k, v += kSpanBytes) {
+      accumulateSpan(input + w.spans[k] * kSparseSpan, input_offset, v, acc);
+    }
+    for (int j = 0; j < lanes; ++j) output[o0 + j] = requantize(acc[j], rq, o0 + j);
+  }
+}
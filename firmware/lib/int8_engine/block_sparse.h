@@ -0,0 +1,74 @@
+/*
+ * SPRINT 3 - Kernels com Esparsidade Estruturada em Blocos
+ * ========================================================
+ *
+ * Para modelos podados em blocos (export_tflite.py --block-sparsity):
+ * os pesos de cada bloco de kPackBlock canais de saída (filtros da
+ * Conv2D ou linhas da FullyConnected) são divididos em faixas de
+ * kSparseSpan posições consecutivas de R (ky, kx, ic ou entrada).
+ * A poda zera faixas inteiras, então o blob I8PK (kLayoutBlockSparse)
+ * guarda só as faixas não nulas e um índice compacto:
+ *
+ *   uint32 block_start[blocos + 1]   primeira faixa de cada bloco
+ *   uint16 spans[nnz]                índice da faixa em R (alinhado a 4)
+ *   int8   values[nnz][kSparseSpan][kPackBlock]
+ *
+ * Os kernels percorrem apenas as faixas listadas: as zeradas não são
+ * lidas nem multiplicadas. Cada faixa da Conv2D fica dentro de um
+ * único tap (in_c múltiplo de kSparseSpan), então os kSparseSpan
+ * canais de entrada são contíguos no tensor NHWC. A saída é idêntica
+ * à dos kernels densos com os mesmos pesos (zeros incluídos).
+ *
+ * Autor: Equipe SPRINT 3
+ * Data: 2025
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "int8_kernels.h"
+
+// Posições de R por faixa (múltiplo de 4 para o alinhamento dos valores)
+static const int kSparseSpan = 16;
+// Faixas por filtro da Conv2D (tabela de taps na pilha do kernel)
+static const int kSparseMaxConvSpans = 256;
+
+// Seção kLayoutBlockSparse de uma camada
+struct BlockSparseWeights {
+  const uint32_t* block_start;   // [blocks + 1]
+  const uint16_t* spans;         // [nnz]
+  const int8_t* values;          // [nnz][kSparseSpan][kPackBlock]
+  int blocks;                    // ceil(O / kPackBlock)
+  uint32_t nnz;                  // Faixas guardadas
+};
+
+// Forma atendida: in_c (ou in_features) múltiplo de kSparseSpan e, na
+// Conv2D, até kSparseMaxConvSpans faixas por filtro. FullyConnected usa
+// k_h = k_w = 0
+bool blockSparseSupported(const ConvShape& s);
+
+// Bytes da seção com `nnz` faixas
+size_t blockSparseSectionBytes(int rows, uint32_t nnz);
+
+// Aponta as partes da seção; false se índice ou tamanho não conferem
+bool blockSparseView(const uint8_t* data, size_t size, int per_row, int rows,
+                     BlockSparseWeights* view);
+
+// Fração de faixas guardadas (1.0 = densa)
+float blockSparseDensity(const BlockSparseWeights& w, int per_row);
+
+void conv2dInt8Sparse(const ConvShape& s, const int8_t* input, int32_t input_offset,
+                      const BlockSparseWeights& w, const int32_t* bias,
+                      const RequantParams& rq, int8_t* output);
+
+void conv2dMaxPoolInt8Sparse(const ConvShape& conv, const ConvShape& pool,
+                             const int8_t* input, int32_t input_offset,
+                             const BlockSparseWeights& w, const int32_t* bias,
+                             const RequantParams& rq, int8_t* output);
+
+void fullyConnectedInt8Sparse(int in_features, int out_features,
+                              const int8_t* input, int32_t input_offset,
+                              const BlockSparseWeights& w, const int32_t* bias,
+                              const RequantParams& rq, int8_t* output);
@@ -0,0 +1,169 @@
+/*
+ * SPRINT 3 - Kernels INT8 com Formas em Tempo de Compilação
+ * =========================================================
+ *
+ * Versões template dos kernels de int8_kernels.cpp usadas pelo código
+ * gerado por model/generate_model_code.py (model_compiled.h). Todas
+ * as dimensões são parâmetros do template, então os laços têm número
+ * de iterações constante e o compilador pode desenrolá-los e
+ * vetorizá-los; as verificações de borda somem quando a geometria
+ * garante que a janela nunca sai da entrada. A requantização usa a
+ * mesma aritmética do motor interpretado (saída idêntica bit a bit).
+ *
+ * Autor: Equipe SPRINT 3
+ * Data: 2025
+ */
+
+#pragma once
+
+#include <math.h>
+#include <stdint.h>
+
+#include "int8_kernels.h"
+
+namespace compiled {
+
+// Requantização por canal: a mesma de int8_kernels.h (requantize)
+typedef RequantParams Requant;
+
+// Geometria de uma convolução NHWC com pesos OHWI
+template <int IN_H, int IN_W, int IN_C, int OUT_H, int OUT_W, int OUT_C,
+          int K_H, int K_W, int STRIDE_H, int STRIDE_W, int PAD_H, int PAD_W>
+struct ConvGeometry {
+  // Sem padding e com a última janela dentro da entrada: nenhum teste de borda
+  static constexpr bool kCheckRows = PAD_H > 0 || (OUT_H - 1) * STRIDE_H + K_H > IN_H;
+  static constexpr bool kCheckCols = PAD_W > 0 || (OUT_W - 1) * STRIDE_W + K_W > IN_W;
+
+  static inline int32_t accumulate(const int8_t* input, int32_t input_offset,
+                                   const int8_t* w_oc, int32_t acc, int oy, int ox) {
+    const int in_y0 = oy * STRIDE_H - PAD_H;
+    const int in_x0 = ox * STRIDE_W - PAD_W;
+    for (int ky = 0; ky < K_H; ++ky) {
+      const int iy = in_y0 + ky;
+      if (kCheckRows && (iy < 0 || iy >= IN_H)) continue;
+      for (int kx = 0; kx < K_W; ++kx) {
+        const int ix = in_x0 + kx;
+        if (kCheckCols && (ix < 0 || ix >= IN_W)) continue;
+        const int8_t* in_px = input + (iy * IN_W + ix) * IN_C;
+        const int8_t* w = w_oc + (ky * K_W + kx) * IN_C;
+        for (int ic = 0; ic < IN_C; ++ic) {
+          acc += ((int32_t)in_px[ic] + input_offset) * (int32_t)w[ic];
+        }
+      }
+    }
+    return acc;
+  }
+};
+
+template <int IN_H, int IN_W, int IN_C, int OUT_H, int OUT_W, int OUT_C,
+          int K_H, int K_W, int STRIDE_H, int STRIDE_W, int PAD_H, int PAD_W>
+void conv2d(const int8_t* input, int32_t input_offset, const int8_t* filter,
+            const int32_t* bias, const Requant& rq, int8_t* output) {
+  typedef ConvGeometry<IN_H, IN_W, IN_C, OUT_H, OUT_W, OUT_C, K_H, K_W,
+                       STRIDE_H, STRIDE_W, PAD_H, PAD_W> G;
+  for (int oy = 0; oy < OUT_H; ++oy) {
+    for (int ox = 0; ox < OUT_W; ++ox) {
+      int8_t* out = output + (oy * OUT_W + ox) * OUT_C;
+      for (int oc = 0; oc < OUT_C; ++oc) {
+        const int32_t acc = G::accumulate(input, input_offset, filter + oc * (K_H * K_W * IN_C),
+                                          bias[oc], oy, ox);
+        out[oc] = requantize(acc, rq, oc);
+      }
+    }
+  }
+}
+
+// Conv2D + MaxPool2D VALID fundidos (mesma ordem de conv2dMaxPoolInt8)
+template <int IN_H, int IN_W, int IN_C, int OUT_H, int OUT_W, int OUT_C,
+          int K_H, int K_W, int STRIDE_H, int STRIDE_W, int PAD_H, int PAD_W,
+          int POOL_H, int POOL_W, int POOL_STRIDE_H, int POOL_STRIDE_W,
+          int POOLED_H, int POOLED_W>
+void conv2dMaxPool(const int8_t* input, int32_t input_offset, const int8_t* filter,
+                   const int32_t* bias, const Requant& rq, int8_t* output) {
+  typedef ConvGeometry<IN_H, IN_W, IN_C, OUT_H, OUT_W, OUT_C, K_H, K_W,
+                       STRIDE_H, STRIDE_W, PAD_H, PAD_W> G;
+  for (int py = 0; py < POOLED_H; ++py) {
+    for (int px = 0; px < POOLED_W; ++px) {
+      int8_t* out = output + (py * POOLED_W + px) * OUT_C;
+      for (int oc = 0; oc < OUT_C; ++oc) {
+        const int8_t* w_oc = filter + oc * (K_H * K_W * IN_C);
+        int32_t m = rq.act_min;
+        for (int wy = 0; wy < POOL_H; ++wy) {
+          const int oy = py * POOL_STRIDE_H + wy;
+          if (oy >= OUT_H) continue;
+          for (int wx = 0; wx < POOL_W; ++wx) {
+            const int ox = px * POOL_STRIDE_W + wx;
+            if (ox >= OUT_W) continue;
+            const int32_t v = requantize(G::accumulate(input, input_offset, w_oc, bias[oc], oy, ox),
+                                         rq, oc);
+            if (v > m) m = v;
+          }
+        }
+        out[oc] = (int8_t)m;
+      }
+    }
+  }
+}
+
+template <int IN_H, int IN_W, int C, int OUT_H, int OUT_W, int K_H, int K_W,
+          int STRIDE_H, int STRIDE_W, int PAD_H, int PAD_W>
+void maxPool2d(const int8_t* input, int32_t act_min, int32_t act_max, int8_t* output) {
+  for (int oy = 0; oy < OUT_H; ++oy) {
+    for (int ox = 0; ox < OUT_W; ++ox) {
+      int8_t* out = output + (oy * OUT_W + ox) * C;
+      for (int c = 0; c < C; ++c) {
+        int32_t m = -128;
+        for (int ky = 0; ky < K_H; ++ky) {
+          const int iy = oy * STRIDE_H - PAD_H + ky;
+          if (iy < 0 || iy >= IN_H) continue;
+          for (int kx = 0; kx < K_W; ++kx) {
+            const int ix = ox * STRIDE_W - PAD_W + kx;
+            if (ix < 0 || ix >= IN_W) continue;
+            const int32_t v = input[(iy * IN_W + ix) * C + c];
+            if (v > m) m = v;
+          }
+        }
+        if (m < act_min) m = act_min;
+        if (m > act_max) m = act_max;
+        out[c] = (int8_t)m;
+      }
+    }
+  }
+}
+
+template <int IN_FEATURES, int OUT_FEATURES>
+void fullyConnected(const int8_t* input, int32_t input_offset, const int8_t* weights,
+                    const int32_t* bias, const Requant& rq, int8_t* output) {
+  for (int o = 0; o < OUT_FEATURES; ++o) {
+    const int8_t* w = weights + o * IN_FEATURES;
+    int32_t acc = bias[o];
+    for (int i = 0; i < IN_FEATURES; ++i) {
+      acc += ((int32_t)input[i] + input_offset) * (int32_t)w[i];
+    }
+    output[o] = requantize(acc, rq, o);
+  }
+}
+
+// Tabela pixel (0..255) -> int8 com a normalização /255 do export (igual ao motor)
+inline void buildInputLut(float scale, int32_t zero_point, int8_t* lut) {
+  for (int p = 0; p < 256; ++p) {
+    int32_t q = (int32_t)lroundf(((float)p / 255.0f) / scale) + zero_point;
+    if (q < -128) q = -128;
+    if (q > 127) q = 127;
+    lut[p] = (int8_t)q;
+  }
+}
+
+// Redimensiona (vizinho mais próximo) e quantiza uma imagem em tons de cinza
+template <int OUT_H, int OUT_W, int C>
+void inputFromGray(const uint8_t* gray, int width, int height, const int8_t* lut, int8_t* dst) {
+  for (int y = 0; y < OUT_H; ++y) {
+    const uint8_t* row = gray + (y * height / OUT_H) * width;
+    for (int x = 0; x < OUT_W; ++x) {
+      const int8_t q = lut[row[x * width / OUT_W]];
+      for (int c = 0; c < C; ++c) *dst++ = q;
+    }
+  }
+}
+
+}  // namespace compiled
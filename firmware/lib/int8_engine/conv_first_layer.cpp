@@ -0,0 +1,91 @@
+/*
+ * SPRINT 3 - Kernel Dedicado da Primeira Conv2D (3x3, C_in = 1)
+ * =============================================================
+ *
+ * Autor: Equipe SPRINT 3
+ * Data: 2025
+ */
+
+#include "conv_first_layer.h"
+
+// Pesos transpostos [tap][canal] e bias com o offset da entrada já somado
+struct FirstLayerWeights {
+  int16_t w[9][kFirstLayerMaxChannels];
+  int32_t bias[kFirstLayerMaxChannels];
+};
+
+static void prepareWeights(int out_c, const int8_t* filter, const int32_t* bias,
+                           int32_t input_offset, FirstLayerWeights* p) {
+  for (int oc = 0; oc < out_c; ++oc) {
+    int32_t sum = 0;
+    for (int k = 0; k < 9; ++k) {
+      p->w[k][oc] = filter[oc * 9 + k];
+      sum += filter[oc * 9 + k];
+    }
+    p->bias[oc] = (bias ? bias[oc] : 0) + input_offset * sum;
+  }
+}
+
+// Acumuladores de todos os canais no pixel cuja janela começa em `row`
+static inline void accumulate3x3(const FirstLayerWeights& p, int out_c, const int8_t* row,
+                                 int in_w, int32_t* acc) {
+  const int32_t x0 = row[0], x1 = row[1], x2 = row[2];
+  const int32_t x3 = row[in_w], x4 = row[in_w + 1], x5 = row[in_w + 2];
+  const int32_t x6 = row[2 * in_w], x7 = row[2 * in_w + 1], x8 = row[2 * in_w + 2];
+  for (int oc = 0; oc < out_c; ++oc) {
+    acc[oc] = p.bias[oc] + x0 * p.w[0][oc] + x1 * p.w[1][oc] + x2 * p.w[2][oc] +
+              x3 * p.w[3][oc] + x4 * p.w[4][oc] + x5 * p.w[5][oc] +
+              x6 * p.w[6][oc] + x7 * p.w[7][oc] + x8 * p.w[8][oc];
+  }
+}
+
+bool conv3x3Cin1Supported(const ConvShape& s) {
+  return s.in_c == 1 && s.k_h == 3 && s.k_w == 3 && s.stride_h == 1 && s.stride_w == 1 &&
+         s.pad_h == 0 && s.pad_w == 0 && s.out_c <= kFirstLayerMaxChannels &&
+         s.out_h <= s.in_h - 2 && s.out_w <= s.in_w - 2;
+}
+
+void conv3x3Cin1Int8(const ConvShape& s, const int8_t* input, int32_t input_offset,
+                     const int8_t* filter, const int32_t* bias, const RequantParams& rq,
+                     int8_t* output) {
+  FirstLayerWeights p;
+  prepareWeights(s.out_c, filter, bias, input_offset, &p);
+  int32_t acc[kFirstLayerMaxChannels];
+  for (int oy = 0; oy < s.out_h; ++oy) {
+    const int8_t* row = input + oy * s.in_w;
+    int8_t* out = output + oy * s.out_w * s.out_c;
+    for (int ox = 0; ox < s.out_w; ++ox, out += s.out_c) {
+      accumulate3x3(p, s.out_c, row + ox, s.in_w, acc);
+      for (int oc = 0; oc < s.out_c; ++oc) out[oc] = requantize(acc[oc], rq, oc);
+    }
+  }
+}
+
+void conv3x3Cin1MaxPoolInt8(const ConvShape& conv, const ConvShape& pool, const int8_t* input,
+                            int32_t input_offset, const int8_t* filter, const int32_t* bias,
+                            const RequantParams& rq, int8_t* output) {
+  FirstLayerWeights p;
+  prepareWeights(conv.out_c, filter, bias, input_offset, &p);
+  int32_t acc[kFirstLayerMaxChannels];
+  int32_t best[kFirstLayerMaxChannels];
+  for (int py = 0; py < pool.out_h; ++py) {
+    for (int px = 0; px < pool.out_w; ++px) {
+      for (int oc = 0; oc < conv.out_c; ++oc) best[oc] = rq.act_min;
+      for (int wy = 0; wy < pool.k_h; ++wy) {
+        const int oy = py * pool.stride_h + wy;
+        if (oy >= conv.out_h) continue;
+        for (int wx = 0; wx < pool.k_w; ++wx) {
+          const int ox = px * pool.stride_w + wx;
+          if (ox >= conv.out_w) continue;
+          accumulate3x3(p, conv.out_c, input + oy * conv.in_w + ox, conv.in_w, acc);
+          for (int oc = 0; oc < conv.out_c; ++oc) {
+            const int32_t v = requantize(acc[oc], rq, oc);
+            if (v > best[oc]) best[oc] = v;
+          }
+        }
+      }
+      int8_t* out = output + (py * pool.out_w + px) * conv.out_c;
+      for (int oc = 0; oc < conv.out_c; ++oc) out[oc] = (int8_t)best[oc];
+    }
+  }
+}
@@ -0,0 +1,41 @@
+/*
+ * SPRINT 3 - Kernel Dedicado da Primeira Conv2D (3x3, C_in = 1)
+ * =============================================================
+ *
+ * A entrada do modelo é fixa em 96x96x1 (export_tflite.py), então a
+ * primeira Conv2D tem uma única entrada por tap: a linha contígua de
+ * k_w*in_c = 3 bytes é curta demais para o produto escalar vetorial
+ * (kernel_backend.h) e o laço genérico gasta quase todo o tempo em
+ * controle. Este kernel lê as 3 linhas do tensor de entrada (a imagem
+ * em tons de cinza já quantizada por setInputFromGray) direto, mantém
+ * os 9 taps da janela em registradores e varre os canais de saída com
+ * os pesos transpostos para [tap][canal] em int16, um laço que o
+ * compilador vetoriza. O offset da entrada é dobrado no bias
+ * (bias + offset * soma dos pesos), exato porque não há padding.
+ *
+ * Vale para 3x3, stride 1, sem padding e até kFirstLayerMaxChannels
+ * canais; as demais formas devem usar o kernel genérico. A saída é
+ * idêntica bit a bit à de conv2dInt8 / conv2dMaxPoolInt8.
+ *
+ * Autor: Equipe SPRINT 3
+ * Data: 2025
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#include "int8_kernels.h"
+
+static const int kFirstLayerMaxChannels = 64;
+
+// Forma atendida pelo kernel dedicado
+bool conv3x3Cin1Supported(const ConvShape& s);
+
+void conv3x3Cin1Int8(const ConvShape& s, const int8_t* input, int32_t input_offset,
+                     const int8_t* filter, const int32_t* bias, const RequantParams& rq,
+                     int8_t* output);
+
+void conv3x3Cin1MaxPoolInt8(const ConvShape& conv, const ConvShape& pool, const int8_t* input,
+                            int32_t input_offset, const int8_t* filter, const int32_t* bias,
+                            const RequantParams& rq, int8_t* output);
@@ -0,0 +1,252 @@
+/*
+ * SPRINT 3 - GEMV INT8 com Pré-busca dos Pesos
+ * ============================================
+ *
+ * Autor: Equipe SPRINT 3
+ * Data: 2025
+ */
+
+#include "dense_gemv.h"
+
+#include <string.h>
+
+#if defined(ESP_PLATFORM)
+#include <esp_async_memcpy.h>
+#include <esp_attr.h>
+#include <esp_idf_version.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#if ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 1, 0)
+#include <esp_cache.h>
+#else
+#include <esp32s3/rom/cache.h>
+#endif
+#endif
+
+static void memcpyStart(void*, int8_t* dst, const int8_t* src, size_t bytes) {
+  memcpy(dst, src, bytes);
+}
+
+static void memcpyWait(void*) {}
+
+const WeightFetcher* memcpyWeightFetcher() {
+  static const WeightFetcher fetcher = { memcpyStart, memcpyWait, nullptr };
+  return &fetcher;
+}
+
+#if defined(ESP_PLATFORM)
+
+// Uma cópia GDMA em voo por vez: o callback (ISR) libera o semáforo
+struct GdmaFetcher {
+  async_memcpy_t driver;
+  SemaphoreHandle_t done;
+  bool pending;
+};
+
+static bool IRAM_ATTR gdmaDone(async_memcpy_t, async_memcpy_event_t*, void* ctx) {
+  BaseType_t woken = pdFALSE;
+  xSemaphoreGiveFromISR(((GdmaFetcher*)ctx)->done, &woken);
+  return woken == pdTRUE;
+}
+
+static void gdmaStart(void* ctx, int8_t* dst, const int8_t* src, size_t bytes) {
+  GdmaFetcher* f = (GdmaFetcher*)ctx;
+  // O GDMA lê a PSRAM por fora do cache: linhas sujas vão antes para a memória
+#if ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 1, 0)
+  esp_cache_msync((void*)src, bytes, ESP_CACHE_MSYNC_FLAG_DIR_C2M | ESP_CACHE_MSYNC_FLAG_UNALIGNED);
+#else
+  Cache_WriteBack_Addr((uint32_t)src, bytes);
+#endif
+  f->pending = esp_async_memcpy(f->driver, dst, (void*)src, bytes, gdmaDone, f) == ESP_OK;
+  // Origem fora do alcance do GDMA (ex.: flash mapeada): cópia pela CPU
+  if (!f->pending) memcpy(dst, src, bytes);
+}
+
+static void gdmaWait(void* ctx) {
+  GdmaFetcher* f = (GdmaFetcher*)ctx;
+  if (f->pending) xSemaphoreTake(f->done, portMAX_DELAY);
+  f->pending = false;
+}
+
+const WeightFetcher* dmaWeightFetcher() {
+  static GdmaFetcher state = { nullptr, nullptr, false };
+  static WeightFetcher fetcher = { gdmaStart, gdmaWait, &state };
+  static bool ready = false;
+  if (ready) return &fetcher;
+  async_memcpy_config_t config = ASYNC_MEMCPY_DEFAULT_CONFIG();
+  config.psram_trans_align = 16;  // Pedaços e blob I8PK alinhados a 16 bytes
+  state.done = xSemaphoreCreateBinary();
+  if (!state.done) return nullptr;
+  if (esp_async_memcpy_install(&config, &state.driver) != ESP_OK) {
+    vSemaphoreDelete(state.done);
+    state.done = nullptr;
+    return nullptr;
+  }
+  ready = true;
+  return &fetcher;
+}
+
+#else
+
+const WeightFetcher* dmaWeightFetcher() { return nullptr; }
+
+#endif
+
+void fullyConnectedInt8Streamed(int in_features, int out_features,
+                                const int8_t* input, int32_t input_offset,
+                                const int8_t* packed, const int32_t* bias,
+                                const RequantParams& rq, int8_t* output,
+                                int8_t* scratch, size_t scratch_size,
+                                const WeightFetcher* fetcher) {
+  if (!scratch || scratch_size < kGemvMinScratch) {
+    fullyConnectedInt8Packed(in_features, out_features, input, input_offset, packed, bias, rq,
+                             output);
+    return;
+  }
+  if (!fetcher) fetcher = memcpyWeightFetcher();
+  const int blocks = (out_features + kPackBlock - 1) / kPackBlock;
+  const size_t total = (size_t)blocks * in_features * kPackBlock;
+
+  // Pedaços múltiplos de 16 bytes (uma coluna de bloco = kPackBlock bytes)
+  size_t chunk = (scratch_size / 2) & ~(size_t)15;
+  if (chunk > total) chunk = (total + 15) & ~(size_t)15;
+  int8_t* buffers[2] = { scratch, scratch + chunk };
+
+  int b = 0;           // Bloco de linhas atual
+  int i = 0;           // Próxima coluna do bloco atual
+  int32_t acc[kPackBlock];
+  loadBias(bias, 0, out_features, acc);
+
+  fetcher->start(fetcher->ctx, buffers[0], packed, total < chunk ? total : chunk);
+  int cur = 0;
+  for (size_t pos = 0; pos < total;) {
+    const size_t len = total - pos < chunk ? total - pos : chunk;
+    fetcher->wait(fetcher->ctx);
+    // Pré-busca do próximo pedaço enquanto este é processado
+    if (pos + len < total) {
+      const size_t next = total - pos - len < chunk ? total - pos - len : chunk;
+      fetcher->start(fetcher->ctx, buffers[cur ^ 1], packed + pos + len, next);
+    }
+
+    const int8_t* w = buffers[cur];
+    int columns = (int)(len / kPackBlock);
+    while (columns > 0) {
+      const int run = columns < in_features - i ? columns : in_features - i;
+      const int8_t* x = input + i;
+      for (int k = 0; k < run; ++k, w += kPackBlock) {
+        const int32_t v = (int32_t)x[k] + input_offset;
+        for (int j = 0; j < kPackBlock; ++j) acc[j] += v * (int32_t)w[j];
+      }
+      i += run;
+      columns -= run;
+      if (i == in_features) {
+        // Bloco completo: requantiza e começa o próximo
+        const int o0 = b * kPackBlock;
+        const int lanes = out_features - o0 < kPackBlock ? out_features - o0 : kPackBlock;
+        for (int j = 0; j < lanes; ++j) output[o0 + j] = requantize(acc[j], rq, o0 + j);
+        ++b;
+        i = 0;
+        const int n0 = b * kPackBlock;
+        loadBias(bias, n0, out_features - n0, acc);
+      }
+    }
+    pos += len;
+    cur ^= 1;
+  }
+}
+
+// =============================================================================
+// PESOS INT4
+// =============================================================================
+
+size_t int4DenseWeightBytes(int in_features, int out_features) {
+  const size_t blocks = (size_t)(out_features + kPackBlock - 1) / kPackBlock;
+  return (blocks * in_features * kInt4ColumnBytes + 3) & ~(size_t)3;
+}
+
+size_t int4DenseSectionBytes(int in_features, int out_features) {
+  return int4DenseWeightBytes(in_features, out_features) + (size_t)out_features * 3 * 4;
+}
+
+bool int4DenseView(const uint8_t* data, size_t size, int in_features, int out_features,
+                   Int4DenseWeights* view) {
+  if (!data || size != int4DenseSectionBytes(in_features, out_features)) return false;
+  const int32_t* tables = (const int32_t*)(data + int4DenseWeightBytes(in_features, out_features));
+  view->weights = data;
+  view->bias = tables;
+  view->multiplier = tables + out_features;
+  view->shift = tables + 2 * out_features;
+  return true;
+}
+
+void fullyConnectedInt4Streamed(int in_features, int out_features,
+                                const int8_t* input, int32_t input_offset,
+                                const Int4DenseWeights& w, const RequantParams& rq,
+                                int8_t* output, int8_t* scratch, size_t scratch_size,
+                                const WeightFetcher* fetcher) {
+  const int blocks = (out_features + kPackBlock - 1) / kPackBlock;
+  const size_t total = (size_t)blocks * in_features * kInt4ColumnBytes;
+  const bool streamed = scratch && scratch_size >= kGemvMinScratch;
+  if (!fetcher) fetcher = memcpyWeightFetcher();
+
+  // Sem scratch o "pedaço" é o tensor inteiro, lido no lugar
+  size_t chunk = total;
+  int8_t* buffers[2] = { scratch, scratch };
+  if (streamed) {
+    chunk = (scratch_size / 2) & ~(size_t)15;
+    if (chunk > total) chunk = (total + 15) & ~(size_t)15;
+    buffers[1] = scratch + chunk;
+    fetcher->start(fetcher->ctx, buffers[0], (const int8_t*)w.weights,
+                   total < chunk ? total : chunk);
+  }
+
+  int b = 0;
+  int i = 0;
+  int32_t acc[kPackBlock];
+  loadBias(w.bias, 0, out_features, acc);
+  // Bias e requantização da seção int4 (escala reescalada), offset e faixa da camada
+  RequantParams rq4 = rq;
+  rq4.multiplier = w.multiplier;
+  rq4.shift = w.shift;
+
+  int cur = 0;
+  for (size_t pos = 0; pos < total;) {
+    const size_t len = total - pos < chunk ? total - pos : chunk;
+    const uint8_t* src = w.weights + pos;
+    if (streamed) {
+      fetcher->wait(fetcher->ctx);
+      if (pos + len < total) {
+        const size_t next = total - pos - len < chunk ? total - pos - len : chunk;
+        fetcher->start(fetcher->ctx, buffers[cur ^ 1], (const int8_t*)w.weights + pos + len, next);
+      }
+      src = (const uint8_t*)buffers[cur];
+    }
+
+    int columns = (int)(len / kInt4ColumnBytes);
+    while (columns > 0) {
+      const int run = columns < in_features - i ? columns : in_features - i;
+      const int8_t* x = input + i;
+      for (int k = 0; k < run; ++k, src += kInt4ColumnBytes) {
+        const int32_t v = (int32_t)x[k] + input_offset;
+        for (int j = 0; j < kInt4ColumnBytes; ++j) {
+          // Nibble baixo = canal par, alto = ímpar; extensão de sinal no registrador
+          acc[2 * j] += v * ((int8_t)(src[j] << 4) >> 4);
+          acc[2 * j + 1] += v * ((int8_t)src[j] >> 4);
+        }
+      }
+      i += run;
+      columns -= run;
+      if (i == in_features) {
+        const int o0 = b * kPackBlock;
+        const int lanes = out_features - o0 < kPackBlock ? out_features - o0 : kPackBlock;
+        for (int j = 0; j < lanes; ++j) output[o0 + j] = requantize(acc[j], rq4, o0 + j);
+        ++b;
+        i = 0;
+        const int n0 = b * kPackBlock;
+        loadBias(w.bias, n0, out_features - n0, acc);
+      }
+    }
+    pos += len;
+    cur ^= 1;
+  }
+}
@@ -0,0 +1,86 @@
+/*
+ * SPRINT 3 - GEMV INT8 com Pré-busca dos Pesos
+ * ============================================
+ *
+ * Kernel dedicado ao FullyConnected grande (Flatten -> Dense), cujo
+ * custo é dominado pela leitura dos pesos. Os pesos chegam no layout
+ * em blocos de kPackBlock linhas (packed_weights.h), que é exatamente
+ * a ordem em que são consumidos, então o tensor inteiro é lido como um
+ * fluxo sequencial em pedaços de tamanho fixo. Dois buffers na SRAM
+ * interna se alternam entre o WeightFetcher e o cálculo. Cada bloco de
+ * linhas mantém seus acumuladores int32 entre pedaços.
+ *
+ * Só há sobreposição com um fetcher assíncrono: dmaWeightFetcher()
+ * copia pelo GDMA (esp_async_memcpy), que lê SRAM e PSRAM mas não a
+ * flash mapeada. O memcpyWeightFetcher() é síncrono e só soma uma
+ * cópia por pedaço; serve ao host e aos testes de equivalência.
+ *
+ * A variante int4 lê a cópia em 4 bits do blob I8PK (kLayoutInt4): cada
+ * coluna de bloco ocupa kPackBlock/2 bytes e os nibbles são estendidos
+ * para int32 já no registrador, então a camada lê metade dos bytes.
+ *
+ * Autor: Equipe SPRINT 3
+ * Data: 2025
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "int8_kernels.h"
+
+// Cópia assíncrona de um pedaço de pesos para a SRAM. start() inicia a
+// cópia; wait() bloqueia até a última cópia iniciada terminar.
+struct WeightFetcher {
+  void (*start)(void* ctx, int8_t* dst, const int8_t* src, size_t bytes);
+  void (*wait)(void* ctx);
+  void* ctx;
+};
+
+// Fetcher síncrono (memcpy), usado quando nenhum outro é fornecido
+const WeightFetcher* memcpyWeightFetcher();
+
+// Fetcher GDMA (esp_async_memcpy) para pesos na PSRAM; origens que o GDMA
+// não alcança são copiadas pela CPU. nullptr no host ou sem driver.
+const WeightFetcher* dmaWeightFetcher();
+
+// Menor scratch útil: dois pedaços de 64 bytes
+static const size_t kGemvMinScratch = 128;
+
+// FullyConnected com pesos [ceil(O/kPackBlock)][in_features][kPackBlock] lidos
+// em pedaços de até scratch_size/2 bytes. Saída idêntica a fullyConnectedInt8.
+void fullyConnectedInt8Streamed(int in_features, int out_features,
+                                const int8_t* input, int32_t input_offset,
+                                const int8_t* packed, const int32_t* bias,
+                                const RequantParams& rq, int8_t* output,
+                                int8_t* scratch, size_t scratch_size,
+                                const WeightFetcher* fetcher);
+
+// Bytes por coluna de bloco no layout int4 (dois pesos por byte)
+static const int kInt4ColumnBytes = kPackBlock / 2;
+
+// Seção kLayoutInt4 de uma FullyConnected: pesos e requantização próprios
+struct Int4DenseWeights {
+  const uint8_t* weights;     // [ceil(O/kPackBlock)][in_features][kPackBlock/2]
+  const int32_t* bias;
+  const int32_t* multiplier;
+  const int32_t* shift;
+};
+
+// Bytes dos nibbles (múltiplo de 4) e da seção inteira
+size_t int4DenseWeightBytes(int in_features, int out_features);
+size_t int4DenseSectionBytes(int in_features, int out_features);
+// Aponta as partes da seção; false se o tamanho não confere
+bool int4DenseView(const uint8_t* data, size_t size, int in_features, int out_features,
+                   Int4DenseWeights* view);
+
+// FullyConnected com pesos int4. Com scratch (>= kGemvMinScratch) os nibbles
+// são lidos em pedaços pelo fetcher, como em fullyConnectedInt8Streamed;
+// sem scratch são lidos direto de `w.weights`. rq.multiplier/shift são
+// ignorados: vêm da seção int4.
+void fullyConnectedInt4Streamed(int in_features, int out_features,
+                                const int8_t* input, int32_t input_offset,
+                                const Int4DenseWeights& w, const RequantParams& rq,
+                                int8_t* output, int8_t* scratch, size_t scratch_size,
+                                const WeightFetcher* fetcher);
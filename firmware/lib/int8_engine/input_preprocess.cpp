@@ -0,0 +1,129 @@
+/*
+ * SPRINT 3 - Pré-processamento Fundido RGB565 -> Entrada INT8
+ * ===========================================================
+ *
+ * Autor: Equipe SPRINT 3
+ * Data: 2025
+ */
+
+#include "input_preprocess.h"
+
+#include <string.h>
+
+void rgb565LumaRowScalar(const uint8_t* rgb565, int width, uint16_t* acc) {
+  for (int x = 0; x < width; ++x, rgb565 += 2) acc[x] += rgb565Luma(rgb565[0], rgb565[1]);
+}
+
+void yuv422YRowScalar(const uint8_t* yuv422, int width, uint16_t* acc) {
+  for (int x = 0; x < width; ++x) acc[x] += yuv422[2 * x];
+}
+
+// Média por área de um frame de 2 bytes/pixel cuja luminância row_fn acumula
+static bool areaToInt8(const uint8_t* frame, int width, int height, int out_w, int out_h,
+                       int channels, const int8_t* lut, LumaRowFn row_fn, int8_t* output) {
+  if (!frame || !lut || !output || out_w <= 0 || out_h <= 0 || channels <= 0) return false;
+  if (width < out_w || height < out_h || width > kPreprocessMaxWidth ||
+      out_w > kPreprocessMaxOutput) {
+    return false;
+  }
+  // Faixas de até 257 linhas cabem no acumulador uint16 (257 * 255 < 65536)
+  if ((height + out_h - 1) / out_h > 257) return false;
+
+  int16_t x0[kPreprocessMaxOutput + 1];
+  for (int x = 0; x <= out_w; ++x) x0[x] = (int16_t)(x * width / out_w);
+  uint16_t acc[kPreprocessMaxWidth];
+
+  const size_t stride = (size_t)width * 2;
+  int8_t* dst = output;
+  int y_src = 0;
+  for (int y = 0; y < out_h; ++y) {
+    const int y1 = (y + 1) * height / out_h;
+    const uint32_t rows = (uint32_t)(y1 - y_src);
+    memset(acc, 0, sizeof(uint16_t) * width);
+    for (; y_src < y1; ++y_src) row_fn(frame + y_src * stride, width, acc);
+
+    for (int x = 0; x < out_w; ++x) {
+      uint32_t sum = 0;
+      for (int i = x0[x]; i < x0[x + 1]; ++i) sum += acc[i];
+      const uint32_t count = rows * (uint32_t)(x0[x + 1] - x0[x]);
+      const int8_t q = lut[(sum + count / 2) / count];
+      for (int c = 0; c < channels; ++c) *dst++ = q;
+    }
+  }
+  return true;
+}
+
+bool rgb565ToInt8Area(const uint8_t* rgb565, int width, int height, int out_w, int out_h,
+                      int channels, const int8_t* lut, const KernelBackend* backend,
+                      int8_t* output) {
+  const LumaRowFn luma_row = backend && backend->lumaRow ? backend->lumaRow : rgb565LumaRowScalar;
+  return areaToInt8(rgb565, width, height, out_w, out_h, channels, lut, luma_row, output);
+}
+
+bool yuv422ToInt8Area(const uint8_t* yuv422, int width, int height, int out_w, int out_h,
+                      int channels, const int8_t* lut, const KernelBackend* backend,
+                      int8_t* output) {
+  const LumaRowFn y_row = backend && backend->yRow ? backend->yRow : yuv422YRowScalar;
+  return areaToInt8(yuv422, width, height, out_w, out_h, channels, lut, y_row, output);
+}
+
+// =============================================================================
+// STREAMING (MCUs do decodificador JPEG)
+// =============================================================================
+
+// Linha de saída cuja faixa [y*H/out_h, (y+1)*H/out_h) contém a linha de origem
+static inline int areaStreamRowOf(const InputAreaStream& s, int y) {
+  return ((y + 1) * s.out_h + s.height - 1) / s.height - 1;
+}
+
+bool inputAreaStreamBegin(InputAreaStream* stream, int width, int height, int out_w, int out_h,
+                          int channels, const int8_t* lut, int8_t* output) {
+  if (!lut || !output || out_w <= 0 || out_h <= 0 || channels <= 0) return false;
+  if (width < out_w || height < out_h || width > kPreprocessMaxWidth ||
+      out_w > kPreprocessMaxOutput) {
+    return false;
+  }
+  if (((width + out_w - 1) / out_w) * ((height + out_h - 1) / out_h) > 257) return false;
+  stream->width = width;
+  stream->height = height;
+  stream->out_w = out_w;
+  stream->out_h = out_h;
+  stream->channels = channels;
+  stream->lut = lut;
+  stream->output = output;
+  stream->next_row = 0;
+  for (int x = 0; x <= out_w; ++x) stream->x0[x] = (int16_t)(x * width / out_w);
+  for (int x = 0, box = 0; x < width; ++x) {
+    while (x >= stream->x0[box + 1]) ++box;
+    stream->col_box[x] = (uint8_t)box;
+  }
+  memset(stream->acc, 0, sizeof(stream->acc));
+  return true;
+}
+
+bool inputAreaStreamAdd(InputAreaStream* stream, int x, int y, int w, const uint8_t* luma) {
+  if (y < 0 || y >= stream->height || x < 0 || x + w > stream->width) return false;
+  const int row = areaStreamRowOf(*stream, y);
+  if (row < stream->next_row || row - stream->next_row >= kAreaStreamRows) return false;
+  uint16_t* acc = stream->acc[row % kAreaStreamRows];
+  const uint8_t* box = stream->col_box + x;
+  for (int i = 0; i < w; ++i) acc[box[i]] += luma[i];
+  return true;
+}
+
+void inputAreaStreamFlush(InputAreaStream* stream, int rows_done) {
+  InputAreaStream& s = *stream;
+  while (s.next_row < s.out_h && (s.next_row + 1) * s.height / s.out_h <= rows_done) {
+    const int y = s.next_row;
+    const uint32_t rows = (uint32_t)((y + 1) * s.height / s.out_h - y * s.height / s.out_h);
+    uint16_t* acc = s.acc[y % kAreaStreamRows];
+    int8_t* dst = s.output + (size_t)y * s.out_w * s.channels;
+    for (int x = 0; x < s.out_w; ++x) {
+      const uint32_t count = rows * (uint32_t)(s.x0[x + 1] - s.x0[x]);
+      const int8_t q = s.lut[(acc[x] + count / 2) / count];
+      for (int c = 0; c < s.channels; ++c) *dst++ = q;
+    }
+    memset(acc, 0, sizeof(uint16_t) * s.out_w);
+    ++s.next_row;
+  }
+}
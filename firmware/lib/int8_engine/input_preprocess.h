@@ -0,0 +1,115 @@
+/*
+ * SPRINT 3 - Pré-processamento Fundido RGB565 -> Entrada INT8
+ * ===========================================================
+ *
+ * O pipeline do README (RGB565 -> redimensiona 96x96 -> INT8) feito
+ * numa única passada sobre o frame da câmera, sem RGB888 nem imagem
+ * em tons de cinza intermediários:
+ *
+ *   1. cada linha RGB565 é lida uma vez, convertida para luminância
+ *      com pesos em ponto fixo (77, 150, 29) / 256 e somada a um
+ *      acumulador uint16 por coluna (a parte vetorizada, ver
+ *      KernelBackend::lumaRow);
+ *   2. ao fechar a faixa de linhas de uma linha de saída, as colunas
+ *      de cada caixa [x*W/out_w, (x+1)*W/out_w) são somadas e a média
+ *      (reamostragem por área, arredondada) passa pela tabela de
+ *      quantização da entrada do modelo;
+ *   3. o int8 resultante é escrito direto no tensor de entrada, na
+ *      arena do Int8Engine (setInputFromRgb565).
+ *
+ * Os pixels seguem a ordem de bytes do esp32-camera (big-endian: byte
+ * alto primeiro). Frames YUV422 (Y0 U Y1 V, PIXFORMAT_YUV422) seguem
+ * o mesmo caminho com o passo 1 trocado pela leitura dos bytes Y
+ * (KernelBackend::yRow): a luminância já vem pronta do sensor. Só
+ * reduz: o frame deve ter ao menos out_w x out_h pixels. Todas as
+ * variantes de lumaRow/yRow dão a mesma saída bit a bit.
+ *
+ * InputAreaStream faz a mesma média por área (mesmas caixas, mesmo
+ * arredondamento) sobre luminância que chega em pedaços, na ordem de
+ * MCUs do decodificador JPEG: cada segmento é somado na caixa da sua
+ * linha de saída, e as linhas cujas faixas de origem terminaram são
+ * quantizadas no tensor. Só as linhas de saída que cruzam a faixa de
+ * MCU atual ficam acumuladas (kAreaStreamRows), nunca o frame inteiro.
+ *
+ * Autor: Equipe SPRINT 3
+ * Data: 2025
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#include "kernel_backend.h"
+
+// Maior largura de frame (VGA): acumuladores de coluna na pilha
+static const int kPreprocessMaxWidth = 640;
+// Maior lado da saída (tabela de caixas na pilha)
+static const int kPreprocessMaxOutput = 256;
+
+// Linhas de saída acumuladas ao mesmo tempo: um MCU tem até 16 linhas de
+// origem e cada linha de saída cobre ao menos uma
+static const int kAreaStreamRows = 17;
+
+// Luminância de um pixel RGB565 (byte alto, byte baixo), canais expandidos
+// para 8 bits replicando os bits altos
+static inline uint8_t rgb565Luma(uint8_t hi, uint8_t lo) {
+  const uint32_t r5 = hi >> 3;
+  const uint32_t g6 = ((hi & 0x07) << 3) | (lo >> 5);
+  const uint32_t b5 = lo & 0x1F;
+  const uint32_t r = (r5 << 3) | (r5 >> 2);
+  const uint32_t g = (g6 << 2) | (g6 >> 4);
+  const uint32_t b = (b5 << 3) | (b5 >> 2);
+  return (uint8_t)((77 * r + 150 * g + 29 * b + 128) >> 8);
+}
+
+// acc[x] += luminância do pixel x da linha (referência escalar de lumaRow)
+void rgb565LumaRowScalar(const uint8_t* rgb565, int width, uint16_t* acc);
+// acc[x] += Y do pixel x de uma linha YUV422 Y0 U Y1 V (referência de yRow)
+void yuv422YRowScalar(const uint8_t* yuv422, int width, uint16_t* acc);
+
+// Frame RGB565 width x height -> out_w x out_h x channels int8, quantizado
+// por lut (luminância 0..255 -> int8). backend nullptr usa o escalar.
+// false se as dimensões não forem suportadas.
+bool rgb565ToInt8Area(const uint8_t* rgb565, int width, int height, int out_w, int out_h,
+                      int channels, const int8_t* lut, const KernelBackend* backend,
+                      int8_t* output);
+
+// Mesmo que rgb565ToInt8Area para um frame YUV422 (2 bytes/pixel, Y nos bytes
+// pares): só os bytes Y são lidos (yRow), sem conversão de cor
+bool yuv422ToInt8Area(const uint8_t* yuv422, int width, int height, int out_w, int out_h,
+                      int channels, const int8_t* lut, const KernelBackend* backend,
+                      int8_t* output);
+
+// Média por área em streaming (ver cabeçalho); preencher com inputAreaStreamBegin
+struct InputAreaStream {
+  int width;
+  int height;
+  int out_w;
+  int out_h;
+  int channels;
+  const int8_t* lut;
+  int8_t* output;
+  int next_row;                                 // Próxima linha de saída a fechar
+  uint8_t col_box[kPreprocessMaxWidth];         // Caixa de saída de cada coluna
+  int16_t x0[kPreprocessMaxOutput + 1];
+  uint16_t acc[kAreaStreamRows][kPreprocessMaxOutput];
+};
+
+// Prepara o streaming de um frame width x height para out_w x out_h x channels.
+// false se as dimensões não forem suportadas (como rgb565ToInt8Area, com
+// caixas de até 257 pixels)
+bool inputAreaStreamBegin(InputAreaStream* stream, int width, int height, int out_w, int out_h,
+                          int channels, const int8_t* lut, int8_t* output);
+
+// Soma w pixels de luminância da linha y a partir da coluna x. false se a
+// linha já foi fechada ou está além da janela de kAreaStreamRows linhas
+bool inputAreaStreamAdd(InputAreaStream* stream, int x, int y, int w, const uint8_t* luma);
+
+// As linhas de origem [0, rows_done) estão completas: quantiza as linhas de
+// saída que dependem só delas
+void inputAreaStreamFlush(InputAreaStream* stream, int rows_done);
+
+// Todas as linhas de saída escritas
+static inline bool inputAreaStreamDone(const InputAreaStream& stream) {
+  return stream.next_row == stream.out_h;
+}
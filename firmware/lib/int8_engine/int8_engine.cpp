@@ -0,0 +1,1094 @@
+/*
+ * SPRINT 3 - Motor de Inferência INT8
+ * ===================================
+ *
+ * Autor: Equipe SPRINT 3
+ * Data: 2025
+ */
+
+#include "int8_engine.h"
+
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+using namespace tflite_fb;
+
+// Faixa de saturação da ativação fundida no domínio quantizado
+static void activationRange(uint8_t activation, float scale, int32_t zero_point,
+                            int32_t* act_min, int32_t* act_max) {
+  int32_t lo = -128;
+  int32_t hi = 127;
+  if (activation == kActRelu || activation == kActRelu6) {
+    int32_t zero = zero_point;
+    if (zero > lo) lo = zero;
+  }
+  if (activation == kActRelu6) {
+    int32_t six = zero_point + (int32_t)lroundf(6.0f / scale);
+    if (six < hi) hi = six;
+  }
+  *act_min = lo;
+  *act_max = hi;
+}
+
+static int computePadding(int padding, int in, int out, int k, int stride) {
+  if (padding != kPaddingSame) return 0;
+  int pad = ((out - 1) * stride + k - in) / 2;
+  return pad > 0 ? pad : 0;
+}
+
+Int8Engine::Int8Engine()
+    : model_data_(nullptr), model_size_(0), num_tensors_(0), num_layers_(0),
+      input_tensor_(-1), output_tensor_(-1), num_requant_(0), precomputed_requant_(0),
+      fusion_enabled_(true),
+      packed_data_(nullptr), packed_size_(0), stream_scratch_(nullptr), stream_scratch_size_(0),
+      stream_fetcher_(nullptr), int4_dense_(false), profiler_(nullptr), backend_(nullptr),
+      winograd_mask_(0), winograd_buffer_(nullptr), winograd_buffer_size_(0), winograd_used_(0),
+      patch_layers_req_(0), patch_layers_(0),
+      patch_grid_(0), patch_buffer_(nullptr), patch_half_(0), patch_buffer_bytes_(0),
+      patch_offset_(0), patch_macs_(0), arena_used_(0), activation_bytes_(0),
+      error_("não inicializado") {
+  error_buf_[0] = '\0';
+}
+
+bool Int8Engine::fail(const char* message) {
+  error_ = message;
+  return false;
+}
+
+// =============================================================================
+// CARREGAMENTO DO MODELO
+// =============================================================================
+
+bool Int8Engine::begin(const uint8_t* model_data, size_t model_size,
+                       uint8_t* arena, size_t arena_size) {
+  model_data_ = model_data;
+  model_size_ = model_size;
+  num_tensors_ = 0;
+  num_layers_ = 0;
+  num_requant_ = 0;
+  precomputed_requant_ = 0;
+  num_weight_sums_ = 0;
+  arena_used_ = 0;
+  error_ = nullptr;
+
+  if (((uintptr_t)model_data & 3) != 0) return fail("modelo desalinhado (use alignas(16))");
+
+  Table model = modelRoot(model_data, model_size);
+  if (!model.valid()) return fail("flatbuffer TFLite inválido");
+
+  Vector subgraphs = model.vector(field::kModelSubgraphs);
+  if (subgraphs.size < 1 || !subgraphs.valid(4)) return fail("modelo sem subgrafo");
+  Table subgraph = subgraphs.table(0);
+
+  if (!parseTensors(model, subgraph)) return false;
+
+  Vector inputs = subgraph.vector(field::kSubgraphInputs);
+  Vector outputs = subgraph.vector(field::kSubgraphOutputs);
+  if (inputs.size != 1 || outputs.size != 1 || !inputs.valid(4) || !outputs.valid(4)) {
+    return fail("esperado 1 tensor de entrada e 1 de saída");
+  }
+  input_tensor_ = inputs.i32(0);
+  output_tensor_ = outputs.i32(0);
+  if (input_tensor_ < 0 || input_tensor_ >= num_tensors_ ||
+      output_tensor_ < 0 || output_tensor_ >= num_tensors_) {
+    return fail("índice de entrada/saída inválido");
+  }
+  const Int8Tensor& in = tensors_[input_tensor_];
+  if (in.type != kTypeInt8 || in.num_dims != 4) return fail("entrada deve ser int8 NHWC");
+
+  if (!parseOperators(model, subgraph)) return false;
+  packed_.clear();
+  if (packed_data_ && !attachPackedWeights()) return false;
+  if (!resolveRequant()) return false;
+  if (!computeWeightSums()) return false;
+  if (fusion_enabled_) fuseLayers();
+  prepareWinograd();
+  if (!planPatches()) return false;
+  if (!allocateActivations(arena, arena_size)) return false;
+
+  // Tabela pixel (0..255) -> int8, com a normalização /255 usada no export
+  for (int p = 0; p < 256; ++p) {
+    int32_t q = (int32_t)lroundf(((float)p / 255.0f) / in.scale) + in.zero_point;
+    if (q < -128) q = -128;
+    if (q > 127) q = 127;
+    input_lut_[p] = (int8_t)q;
+  }
+  if (profiler_) profiler_->attach(*this);
+  return true;
+}
+
+void Int8Engine::setProfiler(LayerProfiler* profiler) {
+  profiler_ = profiler;
+  if (profiler_ && num_layers_ > 0) profiler_->attach(*this);
+}
+
+bool Int8Engine::parseTensors(const Table& model, const Table& subgraph) {
+  Vector buffers = model.vector(field::kModelBuffers);
+  Vector tensors = subgraph.vector(field::kSubgraphTensors);
+  if (!buffers.valid(4) || !tensors.valid(4)) return fail("tabelas de tensores inválidas");
+  if (tensors.size > (uint32_t)kMaxTensors) return fail("tensores demais (kMaxTensors)");
+
+  for (uint32_t i = 0; i < tensors.size; ++i) {
+    Table t = tensors.table(i);
+    Int8Tensor& dst = tensors_[i];
+    memset(&dst, 0, sizeof(dst));
+    dst.alias_of = -1;
+    dst.scale = 1.0f;
+    dst.type = t.u8(field::kTensorType, kTypeFloat32);
+
+    Vector shape = t.vector(field::kTensorShape);
+    if (shape.size > 4 || !shape.valid(4)) return fail("tensor com mais de 4 dimensões");
+    dst.num_dims = (uint8_t)shape.size;
+    uint32_t count = 1;
+    for (uint32_t d = 0; d < shape.size; ++d) {
+      dst.dims[d] = shape.i32(d);
+      count *= (uint32_t)(dst.dims[d] > 0 ? dst.dims[d] : 1);
+    }
+    dst.bytes = dst.type == kTypeInt32 ? count * 4 : count;
+
+    uint32_t buffer_index = (uint32_t)t.i32(field::kTensorBuffer, 0);
+    if (buffer_index > 0 && buffer_index < buffers.size) {
+      Vector data = buffers.table(buffer_index).vector(field::kBufferData);
+      if (data.size > 0) {
+        if (!data.valid(1)) return fail("buffer de pesos fora do modelo");
+        dst.buffer = data.bytes();
+        dst.buffer_size = data.size;
+      }
+    }
+
+    Table quant = t.table(field::kTensorQuantization);
+    if (quant.valid()) {
+      Vector scales = quant.vector(field::kQuantScale);
+      Vector zero_points = quant.vector(field::kQuantZeroPoint);
+      if (scales.size > 0 && scales.valid(4)) {
+        dst.scale = scales.f32(0);
+        dst.scales = scales.bytes();
+        dst.num_scales = (uint16_t)scales.size;
+      }
+      if (zero_points.size > 0 && zero_points.valid(8)) {
+        dst.zero_point = (int32_t)zero_points.i64(0);
+      }
+    }
+    ++num_tensors_;
+  }
+  return true;
+}
+
+bool Int8Engine::parseOperators(const Table& model, const Table& subgraph) {
+  Vector opcodes = model.vector(field::kModelOperatorCodes);
+  Vector operators = subgraph.vector(field::kSubgraphOperators);
+  if (!opcodes.valid(4) || !operators.valid(4)) return fail("tabela de operadores inválida");
+
+  for (uint32_t i = 0; i < operators.size; ++i) {
+    Table op = operators.table(i);
+    uint32_t opcode_index = (uint32_t)op.i32(field::kOperatorOpcodeIndex, 0);
+    if (opcode_index >= opcodes.size) return fail("opcode inválido");
+    Table opcode = opcodes.table(opcode_index);
+    int32_t builtin = opcode.i32(field::kOpCodeBuiltin, 0);
+    int32_t deprecated = opcode.u8(field::kOpCodeDeprecatedBuiltin, 0);
+    if (deprecated > builtin) builtin = deprecated;
+
+    Vector ins = op.vector(field::kOperatorInputs);
+    Vector outs = op.vector(field::kOperatorOutputs);
+    if (ins.size < 1 || outs.size != 1 || !ins.valid(4) || !outs.valid(4)) {
+      return fail("operador com entradas/saídas inválidas");
+    }
+    for (uint32_t k = 0; k < ins.size; ++k) {
+      if (ins.i32(k) >= num_tensors_) return fail("índice de tensor inválido");
+    }
+    if (ins.i32(0) < 0) return fail("operador sem entrada");
+    const int out_index = outs.i32(0);
+    if (out_index < 0 || out_index >= num_tensors_) return fail("índice de tensor inválido");
+    Table options = op.table(field::kOperatorBuiltinOptions);
+
+    // Operadores de forma: resultado constante, consumido apenas pelo RESHAPE
+    if (builtin == kBuiltinShape || builtin == kBuiltinStridedSlice || builtin == kBuiltinPack) {
+      if (tensors_[out_index].type != kTypeInt32) return fail("operador de forma não int32");
+      continue;
+    }
+    // RESHAPE não move dados: a saída passa a apontar para a entrada
+    if (builtin == kBuiltinReshape) {
+      tensors_[out_index].alias_of = (int16_t)ins.i32(0);
+      continue;
+    }
+
+    if (num_layers_ >= kMaxLayers) return fail("camadas demais (kMaxLayers)");
+    Int8Layer& layer = layers_[num_layers_];
+    memset(&layer, 0, sizeof(layer));
+    layer.input = (int16_t)ins.i32(0);
+    layer.output = (int16_t)out_index;
+    layer.weights = -1;
+    layer.bias = -1;
+
+    const Int8Tensor& in = tensors_[layer.input];
+    const Int8Tensor& out = tensors_[layer.output];
+    if (in.type != kTypeInt8 || out.type != kTypeInt8) return fail("somente tensores int8");
+
+    ConvShape& s = layer.shape;
+    switch (builtin) {
+      case kBuiltinConv2D: {
+        if (ins.size < 2 || ins.i32(1) < 0) return fail("Conv2D sem pesos");
+        layer.op = kOpConv2D;
+        layer.weights = (int16_t)ins.i32(1);
+        layer.bias = ins.size > 2 ? (int16_t)ins.i32(2) : -1;
+        const Int8Tensor& w = tensors_[layer.weights];
+        if (in.num_dims != 4 || out.num_dims != 4 || w.num_dims != 4 || !w.buffer) {
+          return fail("Conv2D com formas inválidas");
+        }
+        if (options.i32(field::kConvDilationW, 1) != 1 ||
+            options.i32(field::kConvDilationH, 1) != 1) {
+          return fail("Conv2D com dilatação não suportada");
+        }
+        s.in_h = in.dims[1]; s.in_w = in.dims[2]; s.in_c = in.dims[3];
+        s.out_h = out.dims[1]; s.out_w = out.dims[2]; s.out_c = out.dims[3];
+        s.k_h = w.dims[1]; s.k_w = w.dims[2];
+        s.stride_w = options.i32(field::kConvStrideW, 1);
+        s.stride_h = options.i32(field::kConvStrideH, 1);
+        int padding = options.u8(field::kConvPadding, kPaddingSame);
+        s.pad_h = computePadding(padding, s.in_h, s.out_h, s.k_h, s.stride_h);
+        s.pad_w = computePadding(padding, s.in_w, s.out_w, s.k_w, s.stride_w);
+        layer.activation = options.u8(field::kConvActivation, kActNone);
+        if (w.dims[0] != s.out_c || w.dims[3] != s.in_c) return fail("pesos Conv2D incompatíveis");
+        break;
+      }
+      case kBuiltinMaxPool2D: {
+        layer.op = kOpMaxPool2D;
+        if (in.num_dims != 4 || out.num_dims != 4) return fail("MaxPool2D com formas inválidas");
+        s.in_h = in.dims[1]; s.in_w = in.dims[2]; s.in_c = in.dims[3];
+        s.out_h = out.dims[1]; s.out_w = out.dims[2]; s.out_c = out.dims[3];
+        s.k_w = options.i32(field::kPoolFilterW, 1);
+        s.k_h = options.i32(field::kPoolFilterH, 1);
+        s.stride_w = options.i32(field::kPoolStrideW, 1);
+        s.stride_h = options.i32(field::kPoolStrideH, 1);
+        int padding = options.u8(field::kPoolPadding, kPaddingSame);
+        s.pad_h = computePadding(padding, s.in_h, s.out_h, s.k_h, s.stride_h);
+        s.pad_w = computePadding(padding, s.in_w, s.out_w, s.k_w, s.stride_w);
+        layer.activation = options.u8(field::kPoolActivation, kActNone);
+        break;
+      }
+      case kBuiltinFullyConnected: {
+        if (ins.size < 2 || ins.i32(1) < 0) return fail("FullyConnected sem pesos");
+        layer.op = kOpFullyConnected;
+        layer.weights = (int16_t)ins.i32(1);
+        layer.bias = ins.size > 2 ? (int16_t)ins.i32(2) : -1;
+        const Int8Tensor& w = tensors_[layer.weights];
+        if (w.num_dims != 2 || !w.buffer) return fail("pesos FullyConnected inválidos");
+        s.out_c = w.dims[0];
+        s.in_c = w.dims[1];
+        s.in_h = s.in_w = s.out_h = s.out_w = 1;
+        if ((uint32_t)s.in_c != in.bytes || (uint32_t)s.out_c != out.bytes) {
+          return fail("FullyConnected com formas incompatíveis");
+        }
+        layer.activation = options.u8(field::kFcActivation, kActNone);
+        break;
+      }
+      case kBuiltinSoftmax: {
+        layer.op = kOpSoftmax;
+        layer.beta = options.f32(field::kSoftmaxBeta, 1.0f);
+        s.in_c = s.out_c = (int)out.bytes;
+        break;
+      }
+      default:
+        snprintf(error_buf_, sizeof(error_buf_), "operador não suportado: %d", (int)builtin);
+        return fail(error_buf_);
+    }
+
+    if (layer.bias >= 0) {
+      const Int8Tensor& b = tensors_[layer.bias];
+      if (b.type != kTypeInt32 || !b.buffer || b.buffer_size < (uint32_t)s.out_c * 4) {
+        return fail("bias deve ser int32 constante");
+      }
+    }
+    activationRange(layer.activation, out.scale, out.zero_point, &layer.act_min, &layer.act_max);
+    ++num_layers_;
+  }
+  if (num_layers_ == 0) return fail("modelo sem camadas executáveis");
+  return true;
+}
+
+// Tabela de requantização de cada Conv2D/FullyConnected: a pré-calculada do
+// blob I8PK quando existe, senão calculada das escalas float do modelo
+bool Int8Engine::resolveRequant() {
+  for (int l = 0; l < num_layers_; ++l) {
+    Int8Layer& layer = layers_[l];
+    layer.multiplier = nullptr;
+    layer.shift = nullptr;
+    if (layer.op != kOpConv2D && layer.op != kOpFullyConnected) continue;
+    PackedEntry entry;
+    const uint8_t* data = packed_.attached() ? packed_.find(layer.weights, kLayoutRequant, &entry)
+                                             : nullptr;
+    if (data) {
+      const uint32_t rows = (uint32_t)layer.shape.out_c;
+      if (entry.rows != rows || entry.size != rows * 2 * sizeof(int32_t)) {
+        return fail("tabela de requantização incompatível com a camada");
+      }
+      layer.multiplier = (const int32_t*)data;
+      layer.shift = layer.multiplier + rows;
+      ++precomputed_requant_;
+      continue;
+    }
+    if (!computeRequant(layer)) return false;
+  }
+  return true;
+}
+
+// Multiplicadores por canal: escala_entrada * escala_peso[c] / escala_saída
+bool Int8Engine::computeRequant(Int8Layer& layer) {
+  const Int8Tensor& in = tensors_[layer.input];
+  const Int8Tensor& w = tensors_[layer.weights];
+  const Int8Tensor& out = tensors_[layer.output];
+  const int channels = layer.shape.out_c;
+  if (w.num_scales != 1 && w.num_scales != channels) return fail("escalas de peso inválidas");
+  if (num_requant_ + channels > kMaxRequantChannels) return fail("canais demais (kMaxRequantChannels)");
+
+  layer.multiplier = requant_multiplier_ + num_requant_;
+  layer.shift = requant_shift_ + num_requant_;
+  for (int c = 0; c < channels; ++c) {
+    const float w_scale = readF32(w.scales + 4 * (w.num_scales == 1 ? 0 : c));
+    const double effective = (double)in.scale * (double)w_scale / (double)out.scale;
+    quantizeMultiplier(effective, &requant_multiplier_[num_requant_ + c],
+                       &requant_shift_[num_requant_ + c]);
+  }
+  num_requant_ += channels;
+  return true;
+}
+
+// Soma dos pesos OHWI de cada canal de saída das Conv2D/FullyConnected, lida
+// uma vez aqui: os backends vetoriais somam input_offset * soma ao bias em vez
+// de reler os pesos a cada inferência
+bool Int8Engine::computeWeightSums() {
+  for (int l = 0; l < num_layers_; ++l) {
+    Int8Layer& layer = layers_[l];
+    layer.weight_sums = nullptr;
+    if (layer.op != kOpConv2D && layer.op != kOpFullyConnected) continue;
+    if (layer.weights < 0) continue;
+    const int channels = layer.shape.out_c;
+    if (num_weight_sums_ + channels > kMaxRequantChannels) {
+      return fail("canais demais (kMaxRequantChannels)");
+    }
+    const Int8Tensor& w = tensors_[layer.weights];
+    const int per_channel = (int)(w.bytes / channels);
+    const int8_t* row = (const int8_t*)w.buffer;
+    int32_t* sums = weight_sum_ + num_weight_sums_;
+    for (int c = 0; c < channels; ++c, row += per_channel) {
+      int32_t sum = 0;
+      for (int i = 0; i < per_channel; ++i) sum += row[i];
+      sums[c] = sum;
+    }
+    layer.weight_sums = sums;
+    num_weight_sums_ += channels;
+  }
+  return true;
+}
+
+// Aponta as FullyConnected para os pesos em blocos do blob I8PK (as Conv2D só
+// aceitam a seção esparsa) e as camadas densas grandes para a cópia int4
+bool Int8Engine::attachPackedWeights() {
+  if (!packed_.attach(packed_data_, packed_size_, model_size_)) {
+    return fail("pesos empacotados não correspondem ao modelo");
+  }
+  for (int l = 0; l < num_layers_; ++l) {
+    Int8Layer& layer = layers_[l];
+    if (layer.weights < 0) continue;
+    PackedEntry entry;
+    const uint32_t rows = (uint32_t)layer.shape.out_c;
+    const uint32_t per_row = tensors_[layer.weights].bytes / rows;
+    const uint8_t* data = layer.op == kOpFullyConnected
+                              ? packed_.find(layer.weights, kLayoutOcBlocked, &entry)
+                              : nullptr;
+    if (data) {
+      const uint32_t blocks = (rows + kPackBlock - 1) / kPackBlock;
+      if (entry.block != kPackBlock || entry.rows != rows ||
+          entry.size != blocks * kPackBlock * per_row) {
+        return fail("entrada empacotada incompatível com a camada");
+      }
+      layer.packed = (const int8_t*)data;
+    }
+    // Sem entrada nenhuma, a camada segue com os pesos OHWI
+
+    const uint8_t* sparse = packed_.find(layer.weights, kLayoutBlockSparse, &entry);
+    if (sparse && (entry.block != kPackBlock || entry.rows != rows ||
+                   !blockSparseSupported(layer.shape) ||
+                   !blockSparseView(sparse, entry.size, per_row, rows, &layer.sparse))) {
+      return fail("seção esparsa incompatível com a camada");
+    }
+
+    if (!int4_dense_ || layer.op != kOpFullyConnected) continue;
+    const uint8_t* int4 = packed_.find(layer.weights, kLayoutInt4, &entry);
+    Int4DenseWeights view;
+    if (!int4) continue;
+    if (!int4DenseView(int4, entry.size, layer.shape.in_c, layer.shape.out_c, &view)) {
+      return fail("seção int4 incompatível com a camada");
+    }
+    layer.int4 = int4;
+  }
+  return true;
+}
+
+int Int8Engine::int4LayerCount() const {
+  int count = 0;
+  for (int l = 0; l < num_layers_; ++l) {
+    if (layers_[l].int4) ++count;
+  }
+  return count;
+}
+
+int Int8Engine::sparseLayerCount() const {
+  int count = 0;
+  for (int l = 0; l < num_layers_; ++l) {
+    if (layers_[l].sparse.values) ++count;
+  }
+  return count;
+}
+
+// Transforma os pesos das Conv2D 3x3 escolhidas em setWinograd()
+void Int8Engine::prepareWinograd() {
+  winograd_used_ = 0;
+  if (!winograd_buffer_) return;
+  for (int l = 0; l < num_layers_ && l < 32; ++l) {
+    Int8Layer& layer = layers_[l];
+    if (!(winograd_mask_ & (1u << l)) || layer.weights < 0) continue;
+    if (layer.op != kOpConv2D && layer.op != kOpConv2DMaxPool) continue;
+    if (!winogradSupported(layer.shape, layer.op == kOpConv2DMaxPool ? &layer.pool : nullptr)) {
+      continue;
+    }
+    const size_t bytes = winogradWeightBytes(layer.shape);
+    if (winograd_used_ + bytes > winograd_buffer_size_) continue;
+    int16_t* u = winograd_buffer_ + winograd_used_ / sizeof(int16_t);
+    winogradTransformWeights(layer.shape, (const int8_t*)tensors_[layer.weights].buffer, u);
+    layer.winograd = u;
+    winograd_used_ += (bytes + kArenaAlignment - 1) & ~(kArenaAlignment - 1);
+  }
+}
+
+int Int8Engine::winogradLayerCount() const {
+  int count = 0;
+  for (int l = 0; l < num_layers_; ++l) {
+    if (layers_[l].winograd) ++count;
+  }
+  return count;
+}
+
+int Int8Engine::packedLayerCount() const {
+  int count = 0;
+  for (int l = 0; l < num_layers_; ++l) {
+    if (layers_[l].packed) ++count;
+  }
+  return count;
+}
+
+// Funde Conv2D -> MaxPool2D quando o mapa da convolução só é lido pelo pooling
+void Int8Engine::fuseLayers() {
+  int kept = 0;
+  for (int i = 0; i < num_layers_; ++i) {
+    Int8Layer& conv = layers_[i];
+    layers_[kept] = conv;
+    if (conv.op == kOpConv2D && i + 1 < num_layers_) {
+      const Int8Layer& pool = layers_[i + 1];
+      const Int8Tensor& mid = tensors_[conv.output];
+      const Int8Tensor& pooled = tensors_[pool.output];
+      bool fusable = pool.op == kOpMaxPool2D && rootTensor(pool.input) == conv.output &&
+                     rootTensor(output_tensor_) != conv.output &&
+                     pool.shape.pad_h == 0 && pool.shape.pad_w == 0 &&
+                     mid.scale == pooled.scale && mid.zero_point == pooled.zero_point;
+      for (int l = i + 2; fusable && l < num_layers_; ++l) {
+        if (rootTensor(layers_[l].input) == conv.output) fusable = false;
+      }
+      if (fusable) {
+        Int8Layer& fused = layers_[kept];
+        fused.op = kOpConv2DMaxPool;
+        fused.output = pool.output;
+        fused.pool = pool.shape;
+        if (pool.act_min > fused.act_min) fused.act_min = pool.act_min;
+        if (pool.act_max < fused.act_max) fused.act_max = pool.act_max;
+        ++i;  // O MaxPool2D foi absorvido
+      }
+    }
+    ++kept;
+  }
+  num_layers_ = kept;
+}
+
+// Planeja as ativações por tempo de vida e as posiciona na arena
+bool Int8Engine::allocateActivations(uint8_t* arena, size_t arena_size) {
+  for (int i = 0; i < num_tensors_; ++i) {
+    tensors_[i].first_use = INT16_MAX;
+    tensors_[i].last_use = -1;
+  }
+  tensors_[rootTensor(input_tensor_)].first_use = -1;
+  for (int l = 0; l < num_layers_; ++l) {
+    Int8Tensor& in = tensors_[rootTensor(layers_[l].input)];
+    Int8Tensor& out = tensors_[rootTensor(layers_[l].output)];
+    if (out.first_use > l) out.first_use = (int16_t)l;
+    if (in.last_use < l) in.last_use = (int16_t)l;
+  }
+  tensors_[rootTensor(output_tensor_)].last_use = (int16_t)num_layers_;
+
+  // Bloco em patches: as ativações intermediárias não existem, a entrada e a
+  // saída do bloco ficam vivas durante todo ele, junto com os buffers do patch
+  if (patch_layers_ > 0) {
+    const int last = patch_layers_ - 1;
+    for (int l = 0; l < last; ++l) tensors_[rootTensor(layers_[l].output)].first_use = INT16_MAX;
+    Int8Tensor& in = tensors_[rootTensor(layers_[0].input)];
+    Int8Tensor& out = tensors_[rootTensor(layers_[last].output)];
+    if (in.last_use < last) in.last_use = (int16_t)last;
+    if (out.first_use > 0) out.first_use = 0;
+  }
+
+  PlannerBuffer buffers[kMaxTensors + 1];
+  int16_t owners[kMaxTensors + 1];
+  int count = 0;
+  activation_bytes_ = 0;
+  for (int i = 0; i < num_tensors_; ++i) {
+    Int8Tensor& t = tensors_[i];
+    if (t.buffer || t.alias_of >= 0 || t.type != kTypeInt8) continue;
+    if (t.first_use > t.last_use) continue;  // Tensor não usado pelo grafo
+    buffers[count].size = t.bytes;
+    buffers[count].first_use = t.first_use;
+    buffers[count].last_use = t.last_use;
+    buffers[count].offset = 0;
+    owners[count++] = (int16_t)i;
+    activation_bytes_ += (t.bytes + kArenaAlignment - 1) & ~(kArenaAlignment - 1);
+  }
+  if (patch_layers_ > 0) {
+    buffers[count].size = (uint32_t)patch_buffer_bytes_;
+    buffers[count].first_use = 0;
+    buffers[count].last_use = (int16_t)(patch_layers_ - 1);
+    buffers[count].offset = 0;
+    owners[count++] = -1;
+    activation_bytes_ += patch_buffer_bytes_;
+  }
+  const uint32_t peak = planArena(buffers, count, kArenaAlignment);
+  if (count > 0 && peak == 0) return fail("ativações demais para o planejador da arena");
+
+  size_t base = (size_t)((kArenaAlignment - ((uintptr_t)arena & (kArenaAlignment - 1))) &
+                         (kArenaAlignment - 1));
+  if (base + peak > arena_size) {
+    snprintf(error_buf_, sizeof(error_buf_), "arena pequena: %u bytes necessários",
+             (unsigned)(base + peak));
+    return fail(error_buf_);
+  }
+  for (int k = 0; k < count; ++k) {
+    if (owners[k] < 0) {
+      patch_offset_ = buffers[k].offset;
+      patch_buffer_ = (int8_t*)(arena + base + buffers[k].offset);
+      continue;
+    }
+    Int8Tensor& t = tensors_[owners[k]];
+    t.arena_offset = buffers[k].offset;
+    t.data = (int8_t*)(arena + base + buffers[k].offset);
+  }
+  arena_used_ = base + peak;
+  return true;
+}
+
+int Int8Engine::rootTensor(int index) const {
+  int guard = 0;
+  while (index >= 0 && tensors_[index].alias_of >= 0 && guard++ < kMaxTensors) {
+    index = tensors_[index].alias_of;
+  }
+  return index;
+}
+
+int8_t* Int8Engine::tensorData(int index) const {
+  index = rootTensor(index);
+  return index >= 0 ? tensors_[index].data : nullptr;
+}
+
+// =============================================================================
+// EXECUÇÃO
+// =============================================================================
+
+bool Int8Engine::invoke() {
+  if (num_layers_ == 0) return fail("modelo não carregado");
+  int first = 0;
+  if (patch_layers_ > 0) {
+    if (!runPatches()) return false;
+    first = patch_layers_;
+  }
+  for (int i = first; i < num_layers_; ++i) {
+    const uint32_t t0 = profiler_ ? LayerProfiler::now() : 0;
+    if (!runLayer(layers_[i])) return false;
+    if (profiler_) profiler_->record(i, LayerProfiler::now() - t0);
+  }
+  if (profiler_) profiler_->endInference();
+  return true;
+}
+
+bool Int8Engine::invokeLayer(int index) {
+  if (index < 0 || index >= num_layers_) return fail("camada inválida");
+  if (index < patch_layers_) return index == 0 ? runPatches() : true;
+  return runLayer(layers_[index]);
+}
+
+int Int8Engine::compareKernelBackends(const KernelBackend* reference,
+                                      const KernelBackend* candidate, int8_t* scratch,
+                                      size_t scratch_size) {
+  if (num_layers_ == 0 || !reference || !candidate || !scratch) return -2;
+  const KernelBackend* saved = backend_;
+  int result = -1;
+  for (int i = 0; i < num_layers_ && result == -1; ++i) {
+    // Com patches o bloco inteiro roda no índice 0; compara a saída dele
+    if (i > 0 && i < patch_layers_) continue;
+    const int last = i < patch_layers_ ? patch_layers_ - 1 : i;
+    const int8_t* out = tensorData(layers_[last].output);
+    const size_t bytes = tensors_[layers_[last].output].bytes;
+    if (!out || bytes > scratch_size) {
+      result = -2;
+      break;
+    }
+    backend_ = reference;
+    if (!invokeLayer(i)) {
+      result = -2;
+      break;
+    }
+    memcpy(scratch, out, bytes);
+    backend_ = candidate;
+    if (!invokeLayer(i)) {
+      result = -2;
+      break;
+    }
+    if (memcmp(scratch, out, bytes) != 0) result = i;
+  }
+  backend_ = saved;
+  return result;
+}
+
+uint32_t Int8Engine::tuneWinograd(int repeats, int min_gain_percent) {
+  LayerProfiler* saved = profiler_;
+  profiler_ = nullptr;
+  uint32_t mask = 0;
+  size_t used = 0;
+  for (int l = 0; l < num_layers_ && l < 32; ++l) {
+    Int8Layer& layer = layers_[l];
+    if (!layer.winograd) continue;
+    const int16_t* u = layer.winograd;
+    const int index = l < patch_layers_ ? 0 : l;
+    uint32_t best[2] = { UINT32_MAX, UINT32_MAX };  // 0 = direta, 1 = Winograd
+    for (int r = 0; r < repeats; ++r) {
+      // Ordem alternada: o cache aquecido pela primeira execução não favorece um lado
+      for (int k = 0; k < 2; ++k) {
+        const int path = (r + k) & 1;
+        layer.winograd = path ? u : nullptr;
+        const uint32_t t0 = LayerProfiler::now();
+        invokeLayer(index);
+        const uint32_t dt = LayerProfiler::now() - t0;
+        if (dt < best[path]) best[path] = dt;
+      }
+    }
+    const bool keep = (uint64_t)best[1] * 100 <= (uint64_t)best[0] * (100 - min_gain_percent);
+    if (!keep) {
+      layer.winograd = nullptr;
+      continue;
+    }
+    // Compacta: as camadas mantidas só descem no buffer, na ordem das camadas
+    const size_t bytes = winogradWeightBytes(layer.shape);
+    int16_t* dst = winograd_buffer_ + used / sizeof(int16_t);
+    if (dst != u) memmove(dst, u, bytes);
+    layer.winograd = dst;
+    used += (bytes + kArenaAlignment - 1) & ~(kArenaAlignment - 1);
+    mask |= 1u << l;
+  }
+  winograd_mask_ = mask;
+  winograd_used_ = used;
+  profiler_ = saved;
+  return mask;
+}
+
+bool Int8Engine::moveWinograd(int16_t* buffer, size_t size) {
+  if (size < winograd_used_ || (!buffer && winograd_used_ > 0)) {
+    return fail("buffer Winograd menor que os pesos transformados");
+  }
+  if (winograd_used_ > 0) memcpy(buffer, winograd_buffer_, winograd_used_);
+  for (int l = 0; l < num_layers_; ++l) {
+    Int8Layer& layer = layers_[l];
+    if (layer.winograd) layer.winograd = buffer + (layer.winograd - winograd_buffer_);
+  }
+  winograd_buffer_ = buffer;
+  winograd_buffer_size_ = size;
+  return true;
+}
+
+RequantParams Int8Engine::requantParams(const Int8Layer& layer) const {
+  RequantParams rq;
+  rq.multiplier = layer.multiplier;
+  rq.shift = layer.shift;
+  rq.output_offset = tensors_[layer.output].zero_point;
+  rq.act_min = layer.act_min;
+  rq.act_max = layer.act_max;
+  return rq;
+}
+
+// Conv2D / Conv2D+MaxPool / MaxPool2D com geometria explícita (mapa inteiro ou patch)
+bool Int8Engine::runSpatial(const Int8Layer& layer, const ConvShape& shape,
+                            const ConvShape& pool, const int8_t* input, int8_t* output) {
+  const int32_t input_offset = -tensors_[layer.input].zero_point;
+  const RequantParams rq = requantParams(layer);
+  const int8_t* weights = layer.weights >= 0 ? (const int8_t*)tensors_[layer.weights].buffer : nullptr;
+  const int32_t* bias = layer.bias >= 0 ? (const int32_t*)tensors_[layer.bias].buffer : nullptr;
+
+  switch (layer.op) {
+    case kOpConv2D:
+      if (layer.winograd) {
+        conv2dWinogradInt8(shape, input, input_offset, layer.winograd, bias, rq, output);
+        return true;
+      }
+      if (layer.sparse.values) {
+        conv2dInt8Sparse(shape, input, input_offset, layer.sparse, bias, rq, output);
+        return true;
+      }
+      if (backend_) {
+        backend_->conv2d(shape, input, input_offset, weights, bias, layer.weight_sums, rq,
+                         output);
+        return true;
+      }
+      if (conv3x3Cin1Supported(shape)) {
+        conv3x3Cin1Int8(shape, input, input_offset, weights, bias, rq, output);
+        return true;
+      }
+      conv2dInt8(shape, input, input_offset, weights, bias, rq, output);
+      return true;
+    case kOpConv2DMaxPool:
+      if (layer.winograd) {
+        conv2dMaxPoolWinogradInt8(shape, pool, input, input_offset, layer.winograd, bias, rq,
+                                  output);
+        return true;
+      }
+      if (layer.sparse.values) {
+        conv2dMaxPoolInt8Sparse(shape, pool, input, input_offset, layer.sparse, bias, rq, output);
+        return true;
+      }
+      if (backend_) {
+        backend_->conv2dMaxPool(shape, pool, input, input_offset, weights, bias,
+                                layer.weight_sums, rq, output);
+        return true;
+      }
+      if (conv3x3Cin1Supported(shape)) {
+        conv3x3Cin1MaxPoolInt8(shape, pool, input, input_offset, weights, bias, rq, output);
+        return true;
+      }
+      conv2dMaxPoolInt8(shape, pool, input, input_offset, weights, bias, rq, output);
+      return true;
+    case kOpMaxPool2D:
+      maxPool2dInt8(shape, input, layer.act_min, layer.act_max, output);
+      return true;
+    default:
+      break;
+  }
+  return fail("operador não espacial");
+}
+
+bool Int8Engine::runLayer(const Int8Layer& layer) {
+  const Int8Tensor& in = tensors_[layer.input];
+  const Int8Tensor& out = tensors_[layer.output];
+  const int8_t* in_data = tensorData(layer.input);
+  int8_t* out_data = tensorData(layer.output);
+  if (!in_data || !out_data) return fail("tensor sem memória alocada");
+
+  const RequantParams rq = requantParams(layer);
+  const int8_t* weights = layer.weights >= 0 ? (const int8_t*)tensors_[layer.weights].buffer : nullptr;
+  const int32_t* bias = layer.bias >= 0 ? (const int32_t*)tensors_[layer.bias].buffer : nullptr;
+
+  switch (layer.op) {
+    case kOpConv2D:
+    case kOpConv2DMaxPool:
+    case kOpMaxPool2D:
+      return runSpatial(layer, layer.shape, layer.pool, in_data, out_data);
+    case kOpFullyConnected:
+      if (layer.int4) {
+        Int4DenseWeights w;
+        int4DenseView(layer.int4, int4DenseSectionBytes(layer.shape.in_c, layer.shape.out_c),
+                      layer.shape.in_c, layer.shape.out_c, &w);
+        fullyConnectedInt4Streamed(layer.shape.in_c, layer.shape.out_c, in_data, -in.zero_point,
+                                   w, rq, out_data, stream_scratch_, stream_scratch_size_,
+                                   stream_fetcher_);
+        return true;
+      }
+      if (layer.sparse.values) {
+        fullyConnectedInt8Sparse(layer.shape.in_c, layer.shape.out_c, in_data, -in.zero_point,
+                                 layer.sparse, bias, rq, out_data);
+        return true;
+      }
+      if (layer.packed && stream_scratch_ &&
+          tensors_[layer.weights].bytes > stream_scratch_size_) {
+        fullyConnectedInt8Streamed(layer.shape.in_c, layer.shape.out_c, in_data, -in.zero_point,
+                                   layer.packed, bias, rq, out_data, stream_scratch_,
+                                   stream_scratch_size_, stream_fetcher_);
+        return true;
+      }
+      if (backend_) {
+        backend_->fullyConnected(layer.shape.in_c, layer.shape.out_c, in_data, -in.zero_point,
+                                 weights, bias, layer.weight_sums, rq, out_data);
+        return true;
+      }
+      if (layer.packed) {
+        fullyConnectedInt8Packed(layer.shape.in_c, layer.shape.out_c, in_data, -in.zero_point,
+                                 layer.packed, bias, rq, out_data);
+        return true;
+      }
+      fullyConnectedInt8(layer.shape.in_c, layer.shape.out_c, in_data, -in.zero_point,
+                         weights, bias, rq, out_data);
+      return true;
+    case kOpSoftmax:
+      softmaxInt8(layer.shape.out_c, in_data, in.scale, in.zero_point, layer.beta,
+                  out.scale, out.zero_point, out_data);
+      return true;
+  }
+  return fail("operador desconhecido");
+}
+
+// =============================================================================
+// EXECUÇÃO EM PATCHES
+// =============================================================================
+
+static int minInt(int a, int b) { return a < b ? a : b; }
+static int maxInt(int a, int b) { return a > b ? a : b; }
+
+// Região de entrada que uma convolução/pooling precisa para produzir `out`,
+// e a geometria local do patch (padding só nas bordas reais do mapa)
+static void convTile(const ConvShape& s, const PatchRegion& out, PatchRegion* in,
+                     ConvShape* tile) {
+  const int y0 = out.y0 * s.stride_h - s.pad_h;
+  const int x0 = out.x0 * s.stride_w - s.pad_w;
+  in->y0 = maxInt(0, y0);
+  in->x0 = maxInt(0, x0);
+  in->y1 = minInt(s.in_h, (out.y1 - 1) * s.stride_h - s.pad_h + s.k_h);
+  in->x1 = minInt(s.in_w, (out.x1 - 1) * s.stride_w - s.pad_w + s.k_w);
+  *tile = s;
+  tile->in_h = in->y1 - in->y0;
+  tile->in_w = in->x1 - in->x0;
+  tile->out_h = out.y1 - out.y0;
+  tile->out_w = out.x1 - out.x0;
+  tile->pad_h = in->y0 - y0;
+  tile->pad_w = in->x0 - x0;
+}
+
+// Dimensões espaciais da saída (na camada fundida, a do MaxPool2D)
+static int spatialOutH(const Int8Layer& l) {
+  return l.op == kOpConv2DMaxPool ? l.pool.out_h : l.shape.out_h;
+}
+
+static int spatialOutW(const Int8Layer& l) {
+  return l.op == kOpConv2DMaxPool ? l.pool.out_w : l.shape.out_w;
+}
+
+static size_t regionBytes(const PatchRegion& r, int channels) {
+  return (size_t)(r.y1 - r.y0) * (r.x1 - r.x0) * channels;
+}
+
+// Valida a cadeia de camadas e dimensiona os buffers pelo maior patch
+bool Int8Engine::planPatches() {
+  patch_layers_ = 0;
+  patch_buffer_ = nullptr;
+  patch_half_ = 0;
+  patch_buffer_bytes_ = 0;
+  patch_offset_ = 0;
+  patch_macs_ = 0;
+  if (patch_layers_req_ <= 0) return true;
+
+  const int n = patch_layers_req_;
+  if (n > kMaxPatchLayers || n > num_layers_) return fail("patches: camadas demais");
+  if (rootTensor(layers_[0].input) != rootTensor(input_tensor_)) {
+    return fail("patches: o bloco deve começar na entrada");
+  }
+  for (int l = 0; l < n; ++l) {
+    const Int8Layer& layer = layers_[l];
+    if (layer.op != kOpConv2D && layer.op != kOpConv2DMaxPool && layer.op != kOpMaxPool2D) {
+      return fail("patches: camada não espacial no bloco");
+    }
+    if (l == 0) continue;
+    const int mid = rootTensor(layers_[l - 1].output);
+    if (rootTensor(layer.input) != mid || mid == rootTensor(output_tensor_)) {
+      return fail("patches: o bloco deve ser uma cadeia");
+    }
+    for (int k = l + 1; k < num_layers_; ++k) {
+      if (rootTensor(layers_[k].input) == mid) return fail("patches: ativação usada fora do bloco");
+    }
+  }
+  const Int8Layer& last = layers_[n - 1];
+  if (patch_grid_ < 1 || patch_grid_ > spatialOutH(last) || patch_grid_ > spatialOutW(last)) {
+    return fail("patches: grade inválida");
+  }
+  patch_layers_ = n;
+
+  PatchRegion regions[kMaxPatchLayers + 1];
+  ConvShape shapes[kMaxPatchLayers];
+  ConvShape pools[kMaxPatchLayers];
+  size_t half = 0;
+  for (int gy = 0; gy < patch_grid_; ++gy) {
+    for (int gx = 0; gx < patch_grid_; ++gx) {
+      patchGeometry(gy, gx, regions, shapes, pools);
+      const size_t in_bytes = regionBytes(regions[0], layers_[0].shape.in_c);
+      if (in_bytes > half) half = in_bytes;
+      for (int l = 0; l < n; ++l) {
+        const size_t out_bytes = regionBytes(regions[l + 1], layers_[l].shape.out_c);
+        if (out_bytes > half) half = out_bytes;
+        if (layers_[l].op != kOpMaxPool2D) {
+          patch_macs_ += (uint32_t)shapes[l].out_h * shapes[l].out_w * shapes[l].out_c *
+                         shapes[l].k_h * shapes[l].k_w * shapes[l].in_c;
+        }
+      }
+    }
+  }
+  patch_half_ = (half + kArenaAlignment - 1) & ~(kArenaAlignment - 1);
+  patch_buffer_bytes_ = 2 * patch_half_;
+  return true;
+}
+
+// regions[0] = entrada do bloco; regions[l + 1] = saída da camada l do bloco
+void Int8Engine::patchGeometry(int gy, int gx, PatchRegion* regions, ConvShape* shapes,
+                               ConvShape* pools) const {
+  const int n = patch_layers_;
+  const Int8Layer& last = layers_[n - 1];
+  const int out_h = spatialOutH(last);
+  const int out_w = spatialOutW(last);
+  PatchRegion& r = regions[n];
+  r.y0 = out_h * gy / patch_grid_;
+  r.y1 = out_h * (gy + 1) / patch_grid_;
+  r.x0 = out_w * gx / patch_grid_;
+  r.x1 = out_w * (gx + 1) / patch_grid_;
+
+  for (int l = n - 1; l >= 0; --l) {
+    const Int8Layer& layer = layers_[l];
+    if (layer.op == kOpConv2DMaxPool) {
+      // MaxPool fundido (VALID): linhas da convolução cobertas pelas janelas
+      const ConvShape& p = layer.pool;
+      const PatchRegion& po = regions[l + 1];
+      PatchRegion conv_out;
+      conv_out.y0 = po.y0 * p.stride_h;
+      conv_out.x0 = po.x0 * p.stride_w;
+      conv_out.y1 = minInt(p.in_h, (po.y1 - 1) * p.stride_h + p.k_h);
+      conv_out.x1 = minInt(p.in_w, (po.x1 - 1) * p.stride_w + p.k_w);
+      pools[l] = p;
+      pools[l].in_h = conv_out.y1 - conv_out.y0;
+      pools[l].in_w = conv_out.x1 - conv_out.x0;
+      pools[l].out_h = po.y1 - po.y0;
+      pools[l].out_w = po.x1 - po.x0;
+      convTile(layer.shape, conv_out, &regions[l], &shapes[l]);
+      shapes[l].out_h = pools[l].in_h;
+      shapes[l].out_w = pools[l].in_w;
+    } else {
+      pools[l] = layer.pool;
+      convTile(layer.shape, regions[l + 1], &regions[l], &shapes[l]);
+    }
+  }
+}
+
+static void copyRegion(const int8_t* src, int src_w, const PatchRegion& r, int channels,
+                       int8_t* dst) {
+  const size_t row = (size_t)(r.x1 - r.x0) * channels;
+  for (int y = r.y0; y < r.y1; ++y, dst += row) {
+    memcpy(dst, src + ((size_t)y * src_w + r.x0) * channels, row);
+  }
+}
+
+static void storeRegion(const int8_t* src, const PatchRegion& r, int channels, int8_t* dst,
+                        int dst_w) {
+  const size_t row = (size_t)(r.x1 - r.x0) * channels;
+  for (int y = r.y0; y < r.y1; ++y, src += row) {
+    memcpy(dst + ((size_t)y * dst_w + r.x0) * channels, src, row);
+  }
+}
+
+bool Int8Engine::runPatches() {
+  const int n = patch_layers_;
+  const Int8Layer& first = layers_[0];
+  const Int8Layer& last = layers_[n - 1];
+  const int8_t* input = tensorData(first.input);
+  int8_t* output = tensorData(last.output);
+  if (!input || !output || !patch_buffer_) return fail("tensor sem memória alocada");
+
+  int8_t* buffers[2] = { patch_buffer_, patch_buffer_ + patch_half_ };
+  PatchRegion regions[kMaxPatchLayers + 1];
+  ConvShape shapes[kMaxPatchLayers];
+  ConvShape pools[kMaxPatchLayers];
+  uint32_t cycles[kMaxPatchLayers] = { 0 };
+  for (int gy = 0; gy < patch_grid_; ++gy) {
+    for (int gx = 0; gx < patch_grid_; ++gx) {
+      patchGeometry(gy, gx, regions, shapes, pools);
+      uint32_t t0 = profiler_ ? LayerProfiler::now() : 0;
+      copyRegion(input, first.shape.in_w, regions[0], first.shape.in_c, buffers[0]);
+      for (int l = 0; l < n; ++l) {
+        if (!runSpatial(layers_[l], shapes[l], pools[l], buffers[l & 1], buffers[(l + 1) & 1])) {
+          return false;
+        }
+        if (l == n - 1) {
+          storeRegion(buffers[n & 1], regions[n], last.shape.out_c, output, spatialOutW(last));
+        }
+        if (profiler_) {
+          const uint32_t t1 = LayerProfiler::now();
+          cycles[l] += t1 - t0;
+          t0 = t1;
+        }
+      }
+    }
+  }
+  if (profiler_) {
+    for (int l = 0; l < n; ++l) profiler_->record(l, cycles[l]);
+  }
+  return true;
+}
+
+// =============================================================================
+// ENTRADA / SAÍDA
+// =============================================================================
+
+bool Int8Engine::setInputFromGray(const uint8_t* gray, int width, int height) {
+  int8_t* dst = input();
+  if (!dst || !gray || width <= 0 || height <= 0) return fail("entrada inválida");
+  const int out_h = inputHeight();
+  const int out_w = inputWidth();
+  const int channels = inputChannels();
+  for (int y = 0; y < out_h; ++y) {
+    const uint8_t* row = gray + (y * height / out_h) * width;
+    for (int x = 0; x < out_w; ++x) {
+      const int8_t q = input_lut_[row[x * width / out_w]];
+      for (int c = 0; c < channels; ++c) *dst++ = q;
+    }
+  }
+  return true;
+}
+
+bool Int8Engine::setInputFromRgb565(const uint8_t* rgb565, int width, int height) {
+  if (!rgb565ToInt8Area(rgb565, width, height, inputWidth(), inputHeight(), inputChannels(),
+                        input_lut_, backend_, input())) {
+    return fail("frame RGB565 inválido para a entrada");
+  }
+  return true;
+}
+
+bool Int8Engine::setInputFromYuv422(const uint8_t* yuv422, int width, int height) {
+  if (!yuv422ToInt8Area(yuv422, width, height, inputWidth(), inputHeight(), inputChannels(),
+                        input_lut_, backend_, input())) {
+    return fail("frame YUV422 inválido para a entrada");
+  }
+  return true;
+}
+
+bool Int8Engine::beginInputStream(InputAreaStream* stream, int width, int height) {
+  if (!inputAreaStreamBegin(stream, width, height, inputWidth(), inputHeight(), inputChannels(),
+                            input_lut_, input())) {
+    return fail("frame inválido para o streaming da entrada");
+  }
+  return true;
+}
+
+int8_t* Int8Engine::input() const {
+  return input_tensor_ >= 0 ? tensorData(input_tensor_) : nullptr;
+}
+
+const int8_t* Int8Engine::output() const {
+  return output_tensor_ >= 0 ? tensorData(output_tensor_) : nullptr;
+}
+
+int Int8Engine::inputHeight() const { return tensors_[input_tensor_].dims[1]; }
+int Int8Engine::inputWidth() const { return tensors_[input_tensor_].dims[2]; }
+int Int8Engine::inputChannels() const { return tensors_[input_tensor_].dims[3]; }
+int Int8Engine::outputSize() const { return (int)tensors_[output_tensor_].bytes; }
+
+float Int8Engine::outputValue(int index) const {
+  const Int8Tensor& t = tensors_[output_tensor_];
+  return ((int32_t)output()[index] - t.zero_point) * t.scale;
+}
@@ -0,0 +1,306 @@
+/*
+ * SPRINT 3 - Motor de Inferência INT8
+ * ===================================
+ *
+ * Executa diretamente o flatbuffer TFLite quantizado (g_model) sem
+ * depender do TensorFlow Lite Micro. O grafo é lido uma única vez em
+ * begin(); os detalhes de cada parte ficam no cabeçalho do módulo:
+ *
+ *   - grafo: SHAPE/STRIDED_SLICE/PACK descartados, RESHAPE vira apelido
+ *     da entrada, Conv2D + MaxPool2D fundidos num kernel;
+ *   - requantização por canal pré-calculada no blob I8PK, ou calculada;
+ *   - arena: ativações posicionadas por tempo de vida (arena_planner.h);
+ *   - setPackedWeights(): FullyConnected em blocos de canais
+ *     (packed_weights.h), Conv2D esparsas em blocos (block_sparse.h);
+ *   - setWeightStreaming() / setInt4Dense(): FullyConnected grande por
+ *     GEMV em pedaços e pesos int4 (dense_gemv.h);
+ *   - setKernelBackend(): Conv2D e FullyConnected vetoriais sobre os
+ *     pesos OHWI (kernel_backend.h); a Conv2D 3x3 de canal único usa
+ *     sempre o kernel dedicado (conv_first_layer.h);
+ *   - setWinograd() / tuneWinograd(): Conv2D 3x3 por Winograd
+ *     F(2x2, 3x3) (winograd_conv.h);
+ *   - setPatchInference(): primeiras camadas espaciais em patches
+ *     (estilo MCUNet), sem as ativações intermediárias grandes;
+ *   - setProfiler(): ciclos, MACs e bytes por camada (layer_profiler.h);
+ *   - entrada: setInputFromRgb565(), setInputFromYuv422() e
+ *     beginInputStream() (input_preprocess.h).
+ *
+ * Não depende do Arduino: o mesmo código roda no ESP32 e no host
+ * (ver firmware/host/build_host.sh).
+ *
+ * Autor: Equipe SPRINT 3
+ * Data: 2025
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "arena_planner.h"
+#include "block_sparse.h"
+#include "conv_first_layer.h"
+#include "dense_gemv.h"
+#include "input_preprocess.h"
+#include "int8_kernels.h"
+#include "kernel_backend.h"
+#include "layer_profiler.h"
+#include "packed_weights.h"
+#include "tflite_schema.h"
+#include "winograd_conv.h"
+
+// Operadores executáveis pelo motor
+enum Int8OpType : uint8_t {
+  kOpConv2D = 0,
+  kOpMaxPool2D,
+  kOpFullyConnected,
+  kOpSoftmax,
+  kOpConv2DMaxPool         // Conv2D(+ReLU) e MaxPool2D fundidos
+};
+
+// Tensor do grafo (ativação na arena ou constante no flatbuffer)
+struct Int8Tensor {
+  int8_t* data;            // Ativação na arena (nullptr para constantes)
+  const uint8_t* buffer;   // Dados constantes no modelo (pesos/bias)
+  uint32_t buffer_size;
+  int32_t dims[4];
+  uint8_t num_dims;
+  uint8_t type;            // tflite_fb::TensorType
+  uint16_t num_scales;     // > 1 para quantização por canal
+  const uint8_t* scales;   // Vetor float de escalas no modelo
+  float scale;
+  int32_t zero_point;
+  int16_t alias_of;        // RESHAPE: índice do tensor que fornece os dados
+  uint32_t bytes;
+  int16_t first_use;       // Camada que produz o tensor (-1 = entrada do modelo)
+  int16_t last_use;        // Última camada que lê o tensor
+  uint32_t arena_offset;   // Posição planejada na arena
+};
+
+// Região [y0, y1) x [x0, x1) de um mapa de ativação (execução em patches)
+struct PatchRegion {
+  int y0, y1;
+  int x0, x1;
+};
+
+// Camada executável, já com parâmetros resolvidos
+struct Int8Layer {
+  Int8OpType op;
+  uint8_t activation;      // tflite_fb::Activation
+  int16_t input;
+  int16_t weights;
+  int16_t bias;
+  int16_t output;
+  const int8_t* packed;    // FullyConnected em blocos de kPackBlock canais (nullptr = OHWI)
+  const int16_t* winograd; // Pesos transformados F(2x2, 3x3) (nullptr = direta)
+  const uint8_t* int4;     // Seção kLayoutInt4 do blob (FullyConnected; nullptr = int8)
+  BlockSparseWeights sparse; // Seção kLayoutBlockSparse (values nullptr = densa)
+  ConvShape shape;         // Conv2D/MaxPool2D; FC usa in_c/out_c
+  ConvShape pool;          // kOpConv2DMaxPool: geometria do MaxPool2D fundido
+  const int32_t* multiplier; // Requantização por canal (blob I8PK ou tabela do motor)
+  const int32_t* weight_sums; // Soma dos pesos por canal de saída (backends vetoriais)
+  const int32_t* shift;
+  int32_t act_min;
+  int32_t act_max;
+  float beta;              // Softmax
+};
+
+class Int8Engine {
+ public:
+  static const int kMaxTensors = 48;
+  static const int kMaxLayers = 24;
+  static const int kMaxRequantChannels = 1024;
+  static const size_t kArenaAlignment = 16;
+  static const int kMaxPatchLayers = 4;
+
+  Int8Engine();
+
+  // Liga/desliga a fusão Conv2D+MaxPool2D (vale para o próximo begin)
+  void setFusion(bool enabled) { fusion_enabled_ = enabled; }
+  // Blob I8PK gerado junto com o modelo (g_model_packed); nullptr desativa
+  void setPackedWeights(const uint8_t* data, size_t size) {
+    packed_data_ = data;
+    packed_size_ = size;
+  }
+  // Buffers de SRAM (dois pedaços) para o GEMV com pré-busca dos pesos;
+  // fetcher nullptr usa memcpy (síncrono, sem sobreposição; ver dmaWeightFetcher).
+  // Vale para a cópia int4 e para a seção int8 em blocos (--no-int4) da densa.
+  // Só compensa com os pesos na PSRAM: da flash mapeada o GDMA não lê.
+  void setWeightStreaming(int8_t* scratch, size_t size, const WeightFetcher* fetcher = nullptr) {
+    stream_scratch_ = scratch;
+    stream_scratch_size_ = size;
+    stream_fetcher_ = fetcher;
+  }
+  // FullyConnected com cópia int4 no blob I8PK passam a usá-la (vale para o
+  // próximo begin): metade dos bytes de pesos, com a perda de precisão
+  // medida por host_int4
+  void setInt4Dense(bool enabled) { int4_dense_ = enabled; }
+  // Execução em patches (vale para o próximo begin): as `layers` primeiras
+  // camadas (Conv2D/MaxPool2D/fundidas, em cadeia) rodam numa grade
+  // grid x grid sobre a saída da última delas. Cada patch carrega a borda
+  // (halo) que seu campo receptivo exige, então a saída é idêntica à da
+  // execução inteira; só os buffers de um patch ocupam a arena. 0 desativa.
+  void setPatchInference(int layers, int grid) {
+    patch_layers_req_ = layers;
+    patch_grid_ = grid;
+  }
+  // Camadas (bit i = camada i após a fusão) que usam Winograd F(2x2, 3x3),
+  // vale para o próximo begin. Os pesos transformados de cada camada
+  // elegível são gravados em `buffer`; as que não couberem seguem diretas.
+  // Escolher só camadas aprovadas pelo teste de precisão do host_winograd;
+  // tuneWinograd() mantém, no alvo, só as que ganham do backend.
+  void setWinograd(uint32_t layer_mask, int16_t* buffer, size_t size) {
+    winograd_mask_ = layer_mask;
+    winograd_buffer_ = buffer;
+    winograd_buffer_size_ = size;
+  }
+  // Perfilador por camada usado em invoke(); nullptr desativa
+  void setProfiler(LayerProfiler* profiler);
+  // Backend dos kernels Conv2D/FullyConnected (pesos OHWI); nullptr volta
+  // aos kernels de referência / empacotados. O GEMV com pré-busca continua
+  // tendo prioridade no FullyConnected grande.
+  void setKernelBackend(const KernelBackend* backend) { backend_ = backend; }
+  const KernelBackend* activeKernelBackend() const { return backend_; }
+
+  // Lê o modelo e reserva as ativações na arena fornecida
+  bool begin(const uint8_t* model_data, size_t model_size, uint8_t* arena, size_t arena_size);
+
+  // Executa todas as camadas sobre o tensor de entrada atual
+  bool invoke();
+  // Executa apenas a camada indicada (medição por camada). Com patches, o
+  // índice 0 executa o bloco inteiro e os demais do bloco não fazem nada
+  bool invokeLayer(int index);
+  // Teste diferencial: executa cada camada com `reference`, guarda a saída em
+  // scratch, repete com `candidate` e compara. Retorna -1 se tudo bate, o
+  // índice da primeira camada divergente, ou -2 (scratch pequeno / erro).
+  // A entrada atual é usada; o backend configurado é restaurado no fim.
+  int compareKernelBackends(const KernelBackend* reference, const KernelBackend* candidate,
+                            int8_t* scratch, size_t scratch_size);
+  // Cronometra cada camada com Winograd ativo contra o caminho sem ele (backend
+  // configurado), melhor de `repeats` execuções intercaladas da entrada atual, e
+  // só mantém o Winograd onde ele for ao menos `min_gain_percent`% mais rápido.
+  // Com patches mede o bloco inteiro. Os pesos transformados das camadas
+  // mantidas são compactados no início do buffer (winogradBytes() passa a ser
+  // só o que elas ocupam) e a máscara vale para o próximo begin. Retorna a
+  // máscara que ficou ativa.
+  uint32_t tuneWinograd(int repeats, int min_gain_percent);
+  // Copia os pesos transformados para `buffer` (>= winogradBytes()) e passa a
+  // usá-lo, para devolver o buffer maior de setWinograd() depois do ajuste.
+  // Com winogradBytes() == 0 aceita buffer nulo.
+  bool moveWinograd(int16_t* buffer, size_t size);
+
+  // Redimensiona (vizinho mais próximo) e quantiza uma imagem em tons de cinza
+  bool setInputFromGray(const uint8_t* gray, int width, int height);
+  // Frame RGB565 da câmera direto para o tensor de entrada numa passada:
+  // luminância, média por área e quantização (input_preprocess.h), com o
+  // lumaRow do backend configurado (escalar sem backend)
+  bool setInputFromRgb565(const uint8_t* rgb565, int width, int height);
+  // Frame YUV422 (PIXFORMAT_YUV422) idem, lendo só os bytes Y (yRow)
+  bool setInputFromYuv422(const uint8_t* yuv422, int width, int height);
+  // Prepara stream para escrever no tensor de entrada a média por área de
+  // um frame width x height recebido em pedaços (inputAreaStreamAdd/Flush)
+  bool beginInputStream(InputAreaStream* stream, int width, int height);
+
+  int8_t* input() const;
+  const int8_t* output() const;
+  int inputWidth() const;
+  int inputHeight() const;
+  int inputChannels() const;
+  int outputSize() const;
+  float outputValue(int index) const;
+
+  // Pico da arena após o planejamento por tempo de vida
+  size_t arenaUsed() const { return arena_used_; }
+  // Soma de todas as ativações (arena sem reaproveitamento)
+  size_t activationBytes() const { return activation_bytes_; }
+  int layerCount() const { return num_layers_; }
+  // Camadas que usam pesos empacotados
+  int packedLayerCount() const;
+  // FullyConnected que usam pesos int4
+  int int4LayerCount() const;
+  // Camadas com pesos esparsos em blocos
+  int sparseLayerCount() const;
+  // Camadas com Winograd ativo e bytes de pesos transformados
+  int winogradLayerCount() const;
+  size_t winogradBytes() const { return winograd_used_; }
+  // Camadas cuja requantização veio pré-calculada do blob I8PK
+  int precomputedRequantCount() const { return precomputed_requant_; }
+  // Camadas executadas em patches (0 = desativado) e buffers dos patches
+  int patchLayers() const { return patch_layers_; }
+  int patchGrid() const { return patch_layers_ > 0 ? patch_grid_ : 0; }
+  size_t patchBufferBytes() const { return patch_buffer_bytes_; }
+  uint32_t patchBufferOffset() const { return patch_offset_; }
+  // MACs do bloco em patches, incluindo o recálculo nas bordas sobrepostas
+  uint32_t patchMacs() const { return patch_macs_; }
+  int tensorCount() const { return num_tensors_; }
+  const Int8Layer& layer(int index) const { return layers_[index]; }
+  const Int8Tensor& tensor(int index) const { return tensors_[index]; }
+  const char* errorMessage() const { return error_; }
+
+ private:
+  bool parseTensors(const tflite_fb::Table& model, const tflite_fb::Table& subgraph);
+  bool parseOperators(const tflite_fb::Table& model, const tflite_fb::Table& subgraph);
+  bool resolveRequant();
+  bool computeRequant(Int8Layer& layer);
+  bool computeWeightSums();
+  void fuseLayers();
+  bool attachPackedWeights();
+  void prepareWinograd();
+  bool allocateActivations(uint8_t* arena, size_t arena_size);
+  bool planPatches();
+  void patchGeometry(int gy, int gx, PatchRegion* regions, ConvShape* shapes,
+                     ConvShape* pools) const;
+  bool runPatches();
+  bool runLayer(const Int8Layer& layer);
+  bool runSpatial(const Int8Layer& layer, const ConvShape& shape, const ConvShape& pool,
+                  const int8_t* input, int8_t* output);
+  RequantParams requantParams(const Int8Layer& layer) const;
+  bool fail(const char* message);
+  int8_t* tensorData(int index) const;
+  int rootTensor(int index) const;
+
+  const uint8_t* model_data_;
+  size_t model_size_;
+
+  Int8Tensor tensors_[kMaxTensors];
+  int num_tensors_;
+  Int8Layer layers_[kMaxLayers];
+  int num_layers_;
+  int input_tensor_;
+  int output_tensor_;
+
+  int32_t requant_multiplier_[kMaxRequantChannels];
+  int32_t requant_shift_[kMaxRequantChannels];
+  int num_requant_;
+  int precomputed_requant_;
+  int32_t weight_sum_[kMaxRequantChannels];
+  int num_weight_sums_;
+  bool fusion_enabled_;
+  const uint8_t* packed_data_;
+  size_t packed_size_;
+  PackedWeights packed_;
+  int8_t* stream_scratch_;
+  size_t stream_scratch_size_;
+  const WeightFetcher* stream_fetcher_;
+  bool int4_dense_;
+  LayerProfiler* profiler_;
+  const KernelBackend* backend_;
+  uint32_t winograd_mask_;
+  int16_t* winograd_buffer_;
+  size_t winograd_buffer_size_;
+  size_t winograd_used_;
+  int patch_layers_req_;
+  int patch_layers_;
+  int patch_grid_;
+  int8_t* patch_buffer_;      // Dois buffers de patch_half_ bytes (entrada/saída)
+  size_t patch_half_;
+  size_t patch_buffer_bytes_;
+  uint32_t patch_offset_;
+  uint32_t patch_macs_;
+
+  int8_t input_lut_[256];
+  size_t arena_used_;
+  size_t activation_bytes_;
+  const char* error_;
+  char error_buf_[64];
+};
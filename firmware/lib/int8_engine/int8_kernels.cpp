@@ -0,0 +1,210 @@
+/*
+ * SPRINT 3 - Kernels INT8 de Referência
+ * =====================================
+ *
+ * Autor: Equipe SPRINT 3
+ * Data: 2025
+ */
+
+#include "int8_kernels.h"
+
+#include <limits.h>
+#include <math.h>
+
+// =============================================================================
+// ARITMÉTICA DE PONTO FIXO (compatível com gemmlowp / TFLite)
+// =============================================================================
+
+void quantizeMultiplier(double real_multiplier, int32_t* quantized_multiplier, int32_t* shift) {
+  if (real_multiplier == 0.0) {
+    *quantized_multiplier = 0;
+    *shift = 0;
+    return;
+  }
+  int exponent = 0;
+  const double q = frexp(real_multiplier, &exponent);
+  int64_t q_fixed = (int64_t)llround(q * (double)(1LL << 31));
+  if (q_fixed == (1LL << 31)) {
+    q_fixed /= 2;
+    ++exponent;
+  }
+  if (exponent < -31) {
+    exponent = 0;
+    q_fixed = 0;
+  }
+  *quantized_multiplier = (int32_t)q_fixed;
+  *shift = exponent;
+}
+
+static inline int32_t saturatingRoundingDoublingHighMul(int32_t a, int32_t b) {
+  if (a == b && a == INT32_MIN) return INT32_MAX;
+  const int64_t ab = (int64_t)a * (int64_t)b;
+  const int32_t nudge = ab >= 0 ? (1 << 30) : (1 - (1 << 30));
+  return (int32_t)((ab + nudge) / (1LL << 31));
+}
+
+static inline int32_t roundingDivideByPOT(int32_t x, int32_t exponent) {
+  const int32_t mask = (int32_t)((1LL << exponent) - 1);
+  const int32_t remainder = x & mask;
+  const int32_t threshold = (mask >> 1) + ((x < 0) ? 1 : 0);
+  return (x >> exponent) + ((remainder > threshold) ? 1 : 0);
+}
+
+int32_t multiplyByQuantizedMultiplier(int32_t x, int32_t quantized_multiplier, int32_t shift) {
+  const int32_t left_shift = shift > 0 ? shift : 0;
+  const int32_t right_shift = shift > 0 ? 0 : -shift;
+  return roundingDivideByPOT(
+      saturatingRoundingDoublingHighMul(x * (1 << left_shift), quantized_multiplier),
+      right_shift);
+}
+
+// =============================================================================
+// OPERADORES
+// =============================================================================
+
+// Acumulador int32 de um pixel de saída (oy, ox) no canal oc
+static inline int32_t convAccumulate(const ConvShape& s, const int8_t* input, int32_t input_offset,
+                                     const int8_t* w_oc, int32_t acc, int oy, int ox) {
+  const int in_y0 = oy * s.stride_h - s.pad_h;
+  const int in_x0 = ox * s.stride_w - s.pad_w;
+  for (int ky = 0; ky < s.k_h; ++ky) {
+    const int iy = in_y0 + ky;
+    if (iy < 0 || iy >= s.in_h) continue;
+    for (int kx = 0; kx < s.k_w; ++kx) {
+      const int ix = in_x0 + kx;
+      if (ix < 0 || ix >= s.in_w) continue;
+      const int8_t* in_px = input + (iy * s.in_w + ix) * s.in_c;
+      const int8_t* w = w_oc + (ky * s.k_w + kx) * s.in_c;
+      for (int ic = 0; ic < s.in_c; ++ic) {
+        acc += ((int32_t)in_px[ic] + input_offset) * (int32_t)w[ic];
+      }
+    }
+  }
+  return acc;
+}
+
+void conv2dInt8(const ConvShape& s, const int8_t* input, int32_t input_offset,
+                const int8_t* filter, const int32_t* bias,
+                const RequantParams& rq, int8_t* output) {
+  const int filter_oc_stride = s.k_h * s.k_w * s.in_c;
+  for (int oy = 0; oy < s.out_h; ++oy) {
+    for (int ox = 0; ox < s.out_w; ++ox) {
+      int8_t* out = output + (oy * s.out_w + ox) * s.out_c;
+      for (int oc = 0; oc < s.out_c; ++oc) {
+        const int32_t acc = convAccumulate(s, input, input_offset, filter + oc * filter_oc_stride,
+                                           bias ? bias[oc] : 0, oy, ox);
+        out[oc] = requantize(acc, rq, oc);
+      }
+    }
+  }
+}
+
+void conv2dMaxPoolInt8(const ConvShape& conv, const ConvShape& pool,
+                       const int8_t* input, int32_t input_offset,
+                       const int8_t* filter, const int32_t* bias,
+                       const RequantParams& rq, int8_t* output) {
+  const int filter_oc_stride = conv.k_h * conv.k_w * conv.in_c;
+  for (int py = 0; py < pool.out_h; ++py) {
+    for (int px = 0; px < pool.out_w; ++px) {
+      int8_t* out = output + (py * pool.out_w + px) * conv.out_c;
+      for (int oc = 0; oc < conv.out_c; ++oc) {
+        const int8_t* w_oc = filter + oc * filter_oc_stride;
+        const int32_t acc0 = bias ? bias[oc] : 0;
+        // Cada pixel da janela é convolvido, requantizado e já reduzido pelo máximo
+        int32_t m = rq.act_min;
+        for (int wy = 0; wy < pool.k_h; ++wy) {
+          const int oy = py * pool.stride_h + wy;
+          if (oy >= conv.out_h) continue;
+          for (int wx = 0; wx < pool.k_w; ++wx) {
+            const int ox = px * pool.stride_w + wx;
+            if (ox >= conv.out_w) continue;
+            const int32_t v = requantize(convAccumulate(conv, input, input_offset, w_oc, acc0, oy, ox),
+                                         rq, oc);
+            if (v > m) m = v;
+          }
+        }
+        out[oc] = (int8_t)m;
+      }
+    }
+  }
+}
+
+void maxPool2dInt8(const ConvShape& s, const int8_t* input,
+                   int32_t act_min, int32_t act_max, int8_t* output) {
+  for (int oy = 0; oy < s.out_h; ++oy) {
+    const int in_y0 = oy * s.stride_h - s.pad_h;
+    for (int ox = 0; ox < s.out_w; ++ox) {
+      const int in_x0 = ox * s.stride_w - s.pad_w;
+      int8_t* out = output + (oy * s.out_w + ox) * s.out_c;
+      for (int c = 0; c < s.out_c; ++c) {
+        int32_t m = -128;
+        for (int ky = 0; ky < s.k_h; ++ky) {
+          const int iy = in_y0 + ky;
+          if (iy < 0 || iy >= s.in_h) continue;
+          for (int kx = 0; kx < s.k_w; ++kx) {
+            const int ix = in_x0 + kx;
+            if (ix < 0 || ix >= s.in_w) continue;
+            const int32_t v = input[(iy * s.in_w + ix) * s.in_c + c];
+            if (v > m) m = v;
+          }
+        }
+        if (m < act_min) m = act_min;
+        if (m > act_max) m = act_max;
+        out[c] = (int8_t)m;
+      }
+    }
+  }
+}
+
+void fullyConnectedInt8(int in_features, int out_features,
+                        const int8_t* input, int32_t input_offset,
+                        const int8_t* weights, const int32_t* bias,
+                        const RequantParams& rq, int8_t* output) {
+  for (int o = 0; o < out_features; ++o) {
+    const int8_t* w = weights + (int32_t)o * in_features;
+    int32_t acc = bias ? bias[o] : 0;
+    for (int i = 0; i < in_features; ++i) {
+      acc += ((int32_t)input[i] + input_offset) * (int32_t)w[i];
+    }
+    output[o] = requantize(acc, rq, o);
+  }
+}
+
+void softmaxInt8(int size, const int8_t* input, float input_scale, int32_t input_zero_point,
+                 float beta, float output_scale, int32_t output_zero_point, int8_t* output) {
+  int32_t max_q = -128;
+  for (int i = 0; i < size; ++i) if (input[i] > max_q) max_q = input[i];
+
+  float sum = 0.0f;
+  for (int i = 0; i < size; ++i) {
+    sum += expf(beta * input_scale * (float)(input[i] - max_q));
+  }
+  for (int i = 0; i < size; ++i) {
+    const float p = expf(beta * input_scale * (float)(input[i] - max_q)) / sum;
+    int32_t q = (int32_t)lroundf(p / output_scale) + output_zero_point;
+    if (q < -128) q = -128;
+    if (q > 127) q = 127;
+    output[i] = (int8_t)q;
+  }
+}
+
+// =============================================================================
+// PESOS EMPACOTADOS EM BLOCOS DE CANAIS
+// =============================================================================
+
+void fullyConnectedInt8Packed(int in_features, int out_features,
+                              const int8_t* input, int32_t input_offset,
+                              const int8_t* packed, const int32_t* bias,
+                              const RequantParams& rq, int8_t* output) {
+  for (int o0 = 0; o0 < out_features; o0 += kPackBlock) {
+    const int lanes = out_features - o0 < kPackBlock ? out_features - o0 : kPackBlock;
+    const int8_t* w = packed + (int32_t)o0 * in_features;
+    int32_t acc[kPackBlock];
+    loadBias(bias, o0, lanes, acc);
+    for (int i = 0; i < in_features; ++i, w += kPackBlock) {
+      const int32_t x = (int32_t)input[i] + input_offset;
+      for (int j = 0; j < kPackBlock; ++j) acc[j] += x * (int32_t)w[j];
+    }
+    for (int j = 0; j < lanes; ++j) output[o0 + j] = requantize(acc[j], rq, o0 + j);
+  }
+}
@@ -0,0 +1,96 @@
+/*
+ * SPRINT 3 - Kernels INT8 de Referência
+ * =====================================
+ *
+ * Implementações escalares (layout NHWC, batch 1) dos operadores
+ * presentes no modelo de cartuchos: Conv2D, MaxPool2D,
+ * FullyConnected e Softmax, além do Conv2D+ReLU+MaxPool fundido. A
+ * aritmética de requantização segue bit a bit a referência do
+ * TensorFlow Lite. fullyConnectedInt8Packed lê pesos reordenados em
+ * blocos de kPackBlock canais de saída (ver packed_weights.h).
+ *
+ * Autor: Equipe SPRINT 3
+ * Data: 2025
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+// Canais de saída por bloco nos pesos empacotados
+static const int kPackBlock = 4;
+
+// Requantização por canal de saída (acumulador int32 -> int8)
+struct RequantParams {
+  const int32_t* multiplier;
+  const int32_t* shift;
+  int32_t output_offset;
+  int32_t act_min;
+  int32_t act_max;
+};
+
+// Geometria de uma convolução ou pooling 2D
+struct ConvShape {
+  int in_h, in_w, in_c;
+  int out_h, out_w, out_c;
+  int k_h, k_w;
+  int stride_h, stride_w;
+  int pad_h, pad_w;
+};
+
+// Converte uma escala real em multiplicador Q31 + shift (QuantizeMultiplier)
+void quantizeMultiplier(double real_multiplier, int32_t* quantized_multiplier, int32_t* shift);
+
+// Aplica multiplicador Q31 + shift com arredondamento do TFLite
+int32_t multiplyByQuantizedMultiplier(int32_t x, int32_t quantized_multiplier, int32_t shift);
+
+// Acumulador int32 do canal -> int8: multiplicador/shift, offset e faixa da
+// ativação. Única cópia, usada por todos os kernels (saídas idênticas bit a bit)
+static inline int8_t requantize(int32_t acc, const RequantParams& rq, int channel) {
+  int32_t v = multiplyByQuantizedMultiplier(acc, rq.multiplier[channel], rq.shift[channel]);
+  v += rq.output_offset;
+  if (v < rq.act_min) v = rq.act_min;
+  if (v > rq.act_max) v = rq.act_max;
+  return (int8_t)v;
+}
+
+// Acumuladores de um bloco de kPackBlock canais a partir de oc0: bias dos
+// `lanes` canais válidos (0 sem bias) e 0 nos excedentes
+static inline void loadBias(const int32_t* bias, int oc0, int lanes, int32_t* acc) {
+  for (int j = 0; j < kPackBlock; ++j) acc[j] = (bias && j < lanes) ? bias[oc0 + j] : 0;
+}
+
+// Conv2D INT8 com pesos OHWI e bias int32
+void conv2dInt8(const ConvShape& s, const int8_t* input, int32_t input_offset,
+                const int8_t* filter, const int32_t* bias,
+                const RequantParams& rq, int8_t* output);
+
+// Conv2D (+ativação) seguido de MaxPool2D VALID sem materializar o mapa da
+// convolução: cada pixel da janela é reduzido pelo máximo assim que é calculado.
+// rq.act_min/act_max devem ser a interseção das faixas da Conv2D e do MaxPool2D.
+void conv2dMaxPoolInt8(const ConvShape& conv, const ConvShape& pool,
+                       const int8_t* input, int32_t input_offset,
+                       const int8_t* filter, const int32_t* bias,
+                       const RequantParams& rq, int8_t* output);
+
+// MaxPool2D INT8 (k_h x k_w, sem requantização)
+void maxPool2dInt8(const ConvShape& s, const int8_t* input,
+                   int32_t act_min, int32_t act_max, int8_t* output);
+
+// FullyConnected INT8 com pesos [saídas, entradas]
+void fullyConnectedInt8(int in_features, int out_features,
+                        const int8_t* input, int32_t input_offset,
+                        const int8_t* weights, const int32_t* bias,
+                        const RequantParams& rq, int8_t* output);
+
+// Variante com pesos empacotados [ceil(O/kPackBlock)][in_features][kPackBlock]: cada
+// ativação lida alimenta kPackBlock acumuladores; a saída é idêntica à da versão OHWI.
+// As Conv2D não têm variante em blocos: rodam no backend vetorial sobre os pesos OHWI.
+void fullyConnectedInt8Packed(int in_features, int out_features,
+                              const int8_t* input, int32_t input_offset,
+                              const int8_t* packed, const int32_t* bias,
+                              const RequantParams& rq, int8_t* output);
+
+// Softmax INT8 (dequantiza, calcula em float e requantiza)
+void softmaxInt8(int size, const int8_t* input, float input_scale, int32_t input_zero_point,
+                 float beta, float output_scale, int32_t output_zero_point, int8_t* output);
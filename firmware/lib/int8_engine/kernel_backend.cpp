@@ -0,0 +1,240 @@
+/*
+ * SPRINT 3 - Backends dos Kernels de Convolução INT8
+ * ==================================================
+ *
+ * Autor: Equipe SPRINT 3
+ * Data: 2025
+ */
+
+#include "kernel_backend.h"
+
+#include <string.h>
+
+#include "conv_first_layer.h"
+#include "input_preprocess.h"
+
+// Vetor de uns para somar pesos com o próprio produto escalar do backend
+static const int kOnesLen = 256;
+
+struct OnesVector {
+  alignas(16) int8_t v[kOnesLen];
+  OnesVector() { memset(v, 1, sizeof(v)); }
+};
+
+static const OnesVector kOnes;
+
+static int32_t weightSum(DotFn dot, const int8_t* w, int n) {
+  int32_t sum = 0;
+  while (n > 0) {
+    const int len = n < kOnesLen ? n : kOnesLen;
+    sum += dot(kOnes.v, w, len);
+    w += len;
+    n -= len;
+  }
+  return sum;
+}
+
+// Somas dadas pelo motor (begin) ou, sem elas, calculadas uma vez nesta chamada
+static const int32_t* resolveWeightSums(DotFn dot, const int8_t* w, int rows, int per_row,
+                                        const int32_t* weight_sums, int32_t* local) {
+  if (weight_sums) return weight_sums;
+  for (int r = 0; r < rows; ++r) local[r] = weightSum(dot, w + (size_t)r * per_row, per_row);
+  return local;
+}
+
+// Linhas k_w*in_c da janela do pixel (oy, ox): direto da entrada no interior;
+// nas bordas copiadas para `window` com o padding igual ao zero point
+// (-input_offset), que anula o termo input_offset * soma dos pesos dos taps
+// de fora. Assim a borda custa o mesmo que o interior e não relê os pesos.
+static void windowRows(const ConvShape& s, const int8_t* input, int32_t input_offset, int oy,
+                       int ox, int8_t* window, const int8_t** rows) {
+  const int run = s.k_w * s.in_c;
+  const int in_y0 = oy * s.stride_h - s.pad_h;
+  const int in_x0 = ox * s.stride_w - s.pad_w;
+  const int kx0 = in_x0 < 0 ? -in_x0 : 0;
+  const int kx1 = s.in_w - in_x0 < s.k_w ? s.in_w - in_x0 : s.k_w;
+  for (int ky = 0; ky < s.k_h; ++ky) {
+    const int iy = in_y0 + ky;
+    const bool row_valid = iy >= 0 && iy < s.in_h;
+    if (row_valid && kx0 == 0 && kx1 == s.k_w) {
+      rows[ky] = input + (iy * s.in_w + in_x0) * s.in_c;
+      continue;
+    }
+    int8_t* row = window + ky * run;
+    memset(row, (int8_t)-input_offset, run);
+    if (row_valid && kx1 > kx0) {
+      memcpy(row + kx0 * s.in_c, input + (iy * s.in_w + in_x0 + kx0) * s.in_c,
+             (kx1 - kx0) * s.in_c);
+    }
+    rows[ky] = row;
+  }
+}
+
+// Acumulador do canal de um pixel: um produto escalar por linha da janela
+static inline int32_t convAccumulateDot(DotFn dot, const ConvShape& s, const int8_t* const* rows,
+                                        const int8_t* w_oc, int32_t acc) {
+  const int run = s.k_w * s.in_c;
+  for (int ky = 0; ky < s.k_h; ++ky) acc += dot(rows[ky], w_oc + ky * run, run);
+  return acc;
+}
+
+static bool vectorizable(const ConvShape& s) {
+  return s.k_w * s.in_c >= kMinDotRun && s.out_c <= kMaxDotChannels &&
+         s.k_h <= kMaxDotKernel && s.k_h * s.k_w * s.in_c <= kMaxDotWindow;
+}
+
+void conv2dInt8Dot(DotFn dot, const ConvShape& s, const int8_t* input, int32_t input_offset,
+                   const int8_t* filter, const int32_t* bias, const int32_t* weight_sums,
+                   const RequantParams& rq, int8_t* output) {
+  if (conv3x3Cin1Supported(s)) {
+    conv3x3Cin1Int8(s, input, input_offset, filter, bias, rq, output);
+    return;
+  }
+  if (!vectorizable(s)) {
+    conv2dInt8(s, input, input_offset, filter, bias, rq, output);
+    return;
+  }
+  const int filter_oc_stride = s.k_h * s.k_w * s.in_c;
+  int32_t local_sums[kMaxDotChannels];
+  const int32_t* w_sums =
+      resolveWeightSums(dot, filter, s.out_c, filter_oc_stride, weight_sums, local_sums);
+  alignas(16) int8_t window[kMaxDotWindow];
+  const int8_t* rows[kMaxDotKernel];
+  for (int oy = 0; oy < s.out_h; ++oy) {
+    for (int ox = 0; ox < s.out_w; ++ox) {
+      windowRows(s, input, input_offset, oy, ox, window, rows);
+      int8_t* out = output + (oy * s.out_w + ox) * s.out_c;
+      for (int oc = 0; oc < s.out_c; ++oc) {
+        const int32_t acc0 = (bias ? bias[oc] : 0) + input_offset * w_sums[oc];
+        const int32_t acc = convAccumulateDot(dot, s, rows, filter + oc * filter_oc_stride, acc0);
+        out[oc] = requantize(acc, rq, oc);
+      }
+    }
+  }
+}
+
+void conv2dMaxPoolInt8Dot(DotFn dot, const ConvShape& conv, const ConvShape& pool,
+                          const int8_t* input, int32_t input_offset, const int8_t* filter,
+                          const int32_t* bias, const int32_t* weight_sums,
+                          const RequantParams& rq, int8_t* output) {
+  if (conv3x3Cin1Supported(conv)) {
+    conv3x3Cin1MaxPoolInt8(conv, pool, input, input_offset, filter, bias, rq, output);
+    return;
+  }
+  if (!vectorizable(conv)) {
+    conv2dMaxPoolInt8(conv, pool, input, input_offset, filter, bias, rq, output);
+    return;
+  }
+  const int filter_oc_stride = conv.k_h * conv.k_w * conv.in_c;
+  int32_t local_sums[kMaxDotChannels];
+  const int32_t* w_sums =
+      resolveWeightSums(dot, filter, conv.out_c, filter_oc_stride, weight_sums, local_sums);
+  alignas(16) int8_t window[kMaxDotWindow];
+  const int8_t* rows[kMaxDotKernel];
+  for (int py = 0; py < pool.out_h; ++py) {
+    for (int px = 0; px < pool.out_w; ++px) {
+      int8_t* out = output + (py * pool.out_w + px) * conv.out_c;
+      for (int oc = 0; oc < conv.out_c; ++oc) out[oc] = (int8_t)rq.act_min;
+      for (int wy = 0; wy < pool.k_h; ++wy) {
+        const int oy = py * pool.stride_h + wy;
+        if (oy >= conv.out_h) continue;
+        for (int wx = 0; wx < pool.k_w; ++wx) {
+          const int ox = px * pool.stride_w + wx;
+          if (ox >= conv.out_w) continue;
+          windowRows(conv, input, input_offset, oy, ox, window, rows);
+          for (int oc = 0; oc < conv.out_c; ++oc) {
+            const int32_t acc0 = (bias ? bias[oc] : 0) + input_offset * w_sums[oc];
+            const int8_t v = requantize(
+                convAccumulateDot(dot, conv, rows, filter + oc * filter_oc_stride, acc0), rq, oc);
+            if (v > out[oc]) out[oc] = v;
+          }
+        }
+      }
+    }
+  }
+}
+
+void fullyConnectedInt8Dot(DotFn dot, int in_features, int out_features, const int8_t* input,
+                           int32_t input_offset, const int8_t* weights, const int32_t* bias,
+                           const int32_t* weight_sums, const RequantParams& rq,
+                           int8_t* output) {
+  if (in_features < kMinDotRun) {
+    fullyConnectedInt8(in_features, out_features, input, input_offset, weights, bias, rq, output);
+    return;
+  }
+  for (int o = 0; o < out_features; ++o) {
+    const int8_t* w = weights + (int32_t)o * in_features;
+    int32_t acc = bias ? bias[o] : 0;
+    // Sem a soma pré-calculada a linha é lida duas vezes (produto e soma)
+    const int32_t w_sum = weight_sums ? weight_sums[o] : weightSum(dot, w, in_features);
+    acc += dot(input, w, in_features) + input_offset * w_sum;
+    output[o] = requantize(acc, rq, o);
+  }
+}
+
+// =============================================================================
+// BACKEND ESCALAR (REFERÊNCIA)
+// =============================================================================
+
+static int32_t dotScalar(const int8_t* x, const int8_t* w, int n) {
+  int32_t acc = 0;
+  for (int i = 0; i < n; ++i) acc += (int32_t)x[i] * (int32_t)w[i];
+  return acc;
+}
+
+// Kernels de referência: fazem a conta com o offset por tap, sem as somas
+static void conv2dScalar(const ConvShape& s, const int8_t* input, int32_t input_offset,
+                         const int8_t* filter, const int32_t* bias, const int32_t*,
+                         const RequantParams& rq, int8_t* output) {
+  conv2dInt8(s, input, input_offset, filter, bias, rq, output);
+}
+
+static void conv2dMaxPoolScalar(const ConvShape& conv, const ConvShape& pool,
+                                const int8_t* input, int32_t input_offset, const int8_t* filter,
+                                const int32_t* bias, const int32_t*, const RequantParams& rq,
+                                int8_t* output) {
+  conv2dMaxPoolInt8(conv, pool, input, input_offset, filter, bias, rq, output);
+}
+
+static void fullyConnectedScalar(int in_features, int out_features, const int8_t* input,
+                                 int32_t input_offset, const int8_t* weights,
+                                 const int32_t* bias, const int32_t*, const RequantParams& rq,
+                                 int8_t* output) {
+  fullyConnectedInt8(in_features, out_features, input, input_offset, weights, bias, rq, output);
+}
+
+const KernelBackend* scalarKernelBackend() {
+  static const KernelBackend backend = { "scalar", dotScalar, conv2dScalar, conv2dMaxPoolScalar,
+                                         fullyConnectedScalar, rgb565LumaRowScalar,
+                                         yuv422YRowScalar };
+  return &backend;
+}
+
+// =============================================================================
+// REGISTRO
+// =============================================================================
+
+static int collectBackends(const KernelBackend** out) {
+  const KernelBackend* all[] = { scalarKernelBackend(), sse4KernelBackend(),
+                                 avx2KernelBackend(), pieKernelBackend() };
+  int count = 0;
+  for (const KernelBackend* backend : all) {
+    if (backend) out[count++] = backend;
+  }
+  return count;
+}
+
+int kernelBackendCount() {
+  const KernelBackend* backends[4];
+  return collectBackends(backends);
+}
+
+const KernelBackend* kernelBackend(int index) {
+  const KernelBackend* backends[4];
+  const int count = collectBackends(backends);
+  return index >= 0 && index < count ? backends[index] : nullptr;
+}
+
+const KernelBackend* bestKernelBackend() {
+  return kernelBackend(kernelBackendCount() - 1);
+}
@@ -0,0 +1,96 @@
+/*
+ * SPRINT 3 - Backends dos Kernels de Convolução INT8
+ * ==================================================
+ *
+ * Interface única para Conv2D, Conv2D+MaxPool fundido e
+ * FullyConnected com pesos OHWI, com três famílias de implementação:
+ *
+ *   - "scalar": os kernels de referência de int8_kernels.h;
+ *   - "sse4" / "avx2": host x86, escolhidos em tempo de execução
+ *     pelo que a CPU suporta (kernel_backend_x86.cpp);
+ *   - "pie": instruções vetoriais do ESP32-S3 (EE.VMULAS.S8.ACCX,
+ *     kernel_backend_esp32s3.cpp).
+ *
+ * Os backends vetoriais compartilham o mesmo laço (kernel_backend.cpp)
+ * e só diferem no produto escalar int8 (DotFn), aplicado a cada linha
+ * contígua k_w*in_c da janela NHWC contra a linha correspondente do
+ * filtro OHWI. O offset da entrada entra como input_offset * soma dos
+ * pesos do canal, pré-calculada pelo Int8Engine em begin() (sem ela,
+ * calculada uma vez por chamada); nas bordas com padding a janela é
+ * completada com o zero point, então nenhum peso é lido duas vezes.
+ * A 1ª Conv2D (3x3, in_c = 1) usa o kernel
+ * dedicado de conv_first_layer.h; outras camadas com linhas curtas
+ * demais para o vetor usam o kernel de referência.
+ * Todas as saídas são idênticas bit a bit às do backend escalar
+ * (conferido por firmware/host/host_backends e no boot do firmware).
+ *
+ * Cada backend traz também a conversão vetorial de uma linha RGB565
+ * para luminância acumulada (lumaRow) e a extração dos bytes Y de uma
+ * linha YUV422 (yRow), usadas pelo pré-processamento fundido de
+ * input_preprocess.h; o PIE usa as versões escalares.
+ *
+ * Autor: Equipe SPRINT 3
+ * Data: 2025
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#include "int8_kernels.h"
+
+// Soma de x[i] * w[i] (int8 x int8 -> int32), sem offset
+typedef int32_t (*DotFn)(const int8_t* x, const int8_t* w, int n);
+// acc[x] += luminância do pixel x de uma linha da câmera (RGB565 big-endian
+// no lumaRow, YUV422 Y0 U Y1 V no yRow)
+typedef void (*LumaRowFn)(const uint8_t* row, int width, uint16_t* acc);
+
+struct KernelBackend {
+  const char* name;
+  DotFn dot;
+  // weight_sums: soma dos pesos de cada canal de saída (nullptr: calculada
+  // na chamada); o backend escalar não usa
+  void (*conv2d)(const ConvShape& s, const int8_t* input, int32_t input_offset,
+                 const int8_t* filter, const int32_t* bias, const int32_t* weight_sums,
+                 const RequantParams& rq, int8_t* output);
+  void (*conv2dMaxPool)(const ConvShape& conv, const ConvShape& pool, const int8_t* input,
+                        int32_t input_offset, const int8_t* filter, const int32_t* bias,
+                        const int32_t* weight_sums, const RequantParams& rq, int8_t* output);
+  void (*fullyConnected)(int in_features, int out_features, const int8_t* input,
+                         int32_t input_offset, const int8_t* weights, const int32_t* bias,
+                         const int32_t* weight_sums, const RequantParams& rq, int8_t* output);
+  LumaRowFn lumaRow;
+  LumaRowFn yRow;
+};
+
+// Menor linha contígua (k_w*in_c ou in_features) que vale a pena vetorizar
+static const int kMinDotRun = 16;
+// Canais de saída suportados pelo laço vetorial (somas de pesos na pilha)
+static const int kMaxDotChannels = 256;
+// Janela k_h x k_w x in_c copiada na pilha nas bordas, e linhas por janela
+static const int kMaxDotWindow = 1024;
+static const int kMaxDotKernel = 8;
+
+// Backends; nullptr quando a plataforma/CPU não tem as instruções
+const KernelBackend* scalarKernelBackend();
+const KernelBackend* sse4KernelBackend();
+const KernelBackend* avx2KernelBackend();
+const KernelBackend* pieKernelBackend();
+
+// Backends disponíveis nesta máquina, do escalar ao mais rápido
+int kernelBackendCount();
+const KernelBackend* kernelBackend(int index);
+const KernelBackend* bestKernelBackend();
+
+// Laço vetorial compartilhado, parametrizado pelo produto escalar
+void conv2dInt8Dot(DotFn dot, const ConvShape& s, const int8_t* input, int32_t input_offset,
+                   const int8_t* filter, const int32_t* bias, const int32_t* weight_sums,
+                   const RequantParams& rq, int8_t* output);
+void conv2dMaxPoolInt8Dot(DotFn dot, const ConvShape& conv, const ConvShape& pool,
+                          const int8_t* input, int32_t input_offset, const int8_t* filter,
+                          const int32_t* bias, const int32_t* weight_sums,
+                          const RequantParams& rq, int8_t* output);
+void fullyConnectedInt8Dot(DotFn dot, int in_features, int out_features, const int8_t* input,
+                           int32_t input_offset, const int8_t* weights, const int32_t* bias,
+                           const int32_t* weight_sums, const RequantParams& rq,
+                           int8_t* output);
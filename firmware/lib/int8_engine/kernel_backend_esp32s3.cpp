@@ -0,0 +1,84 @@
+/*
+ * SPRINT 3 - Backend PIE do ESP32-S3
+ * ==================================
+ *
+ * Produto escalar int8 com as instruções vetoriais de 128 bits do
+ * ESP32-S3: EE.VLD.128.IP carrega 16 bytes de entrada e de pesos e
+ * EE.VMULAS.S8.ACCX acumula os 16 produtos no acumulador de 40 bits
+ * ACCX, lido no fim com EE.SRS.ACCX. As cargas exigem endereços
+ * alinhados a 16 bytes: arena, buffers de patch e linhas k_w*in_c com
+ * in_c múltiplo de 16 já são; o resto (e a cauda < 16) segue escalar.
+ *
+ * Autor: Equipe SPRINT 3
+ * Data: 2025
+ */
+
+#include "kernel_backend.h"
+
+#include "input_preprocess.h"
+
+#if defined(ESP_PLATFORM)
+#include "sdkconfig.h"
+#endif
+
+#if defined(CONFIG_IDF_TARGET_ESP32S3)
+
+__attribute__((noinline))
+static int32_t dotPie(const int8_t* x, const int8_t* w, int n) {
+  int32_t acc = 0;
+  int i = 0;
+  int blocks = n >> 4;
+  if (blocks > 0 && (((uintptr_t)x | (uintptr_t)w) & 15) == 0) {
+    const int8_t* px = x;
+    const int8_t* pw = w;
+    const int32_t zero = 0;
+    i = blocks << 4;
+    asm volatile(
+        "ee.zero.accx\n"
+        "1:\n"
+        "ee.vld.128.ip q0, %[px], 16\n"
+        "ee.vld.128.ip q1, %[pw], 16\n"
+        "addi %[blocks], %[blocks], -1\n"
+        "ee.vmulas.s8.accx q0, q1\n"
+        "bnez %[blocks], 1b\n"
+        "ee.srs.accx %[acc], %[zero], 0\n"
+        : [acc] "=r"(acc), [px] "+r"(px), [pw] "+r"(pw), [blocks] "+r"(blocks)
+        : [zero] "r"(zero)
+        : "memory");
+  }
+  for (; i < n; ++i) acc += (int32_t)x[i] * (int32_t)w[i];
+  return acc;
+}
+
+static void conv2dPie(const ConvShape& s, const int8_t* input, int32_t input_offset,
+                      const int8_t* filter, const int32_t* bias, const int32_t* weight_sums,
+                      const RequantParams& rq, int8_t* output) {
+  conv2dInt8Dot(dotPie, s, input, input_offset, filter, bias, weight_sums, rq, output);
+}
+
+static void conv2dMaxPoolPie(const ConvShape& conv, const ConvShape& pool, const int8_t* input,
+                             int32_t input_offset, const int8_t* filter, const int32_t* bias,
+                             const int32_t* weight_sums, const RequantParams& rq, int8_t* output) {
+  conv2dMaxPoolInt8Dot(dotPie, conv, pool, input, input_offset, filter, bias, weight_sums, rq,
+                       output);
+}
+
+static void fullyConnectedPie(int in_features, int out_features, const int8_t* input,
+                              int32_t input_offset, const int8_t* weights, const int32_t* bias,
+                              const int32_t* weight_sums, const RequantParams& rq, int8_t* output) {
+  fullyConnectedInt8Dot(dotPie, in_features, out_features, input, input_offset, weights, bias,
+                        weight_sums, rq, output);
+}
+
+const KernelBackend* pieKernelBackend() {
+  static const KernelBackend backend = { "pie", dotPie, conv2dPie, conv2dMaxPoolPie,
+                                         fullyConnectedPie, rgb565LumaRowScalar,
+                                         yuv422YRowScalar };
+  return &backend;
+}
+
+#else
+
+const KernelBackend* pieKernelBackend() { return nullptr; }
+
+#endif
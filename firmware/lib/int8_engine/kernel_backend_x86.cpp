@@ -0,0 +1,201 @@
+/*
+ * SPRINT 3 - Backends SSE4.1 / AVX2 (host x86)
+ * ============================================
+ *
+ * Produto escalar int8 estendido para int16 e acumulado com
+ * PMADDWD (_mm_madd_epi16). A luminância RGB565 processa 8 (SSE4) ou
+ * 16 (AVX2) pixels por vez em lanes de 16 bits: PSHUFB troca os bytes
+ * do big-endian da câmera, os canais são expandidos por deslocamento
+ * e os pesos Q8 aplicados com PMULLW. No YUV422 (Y0 U Y1 V) cada lane
+ * de 16 bits já é um par Y/croma: PAND com 0x00FF deixa só o Y, pronto
+ * para somar ao acumulador, sem conversão de cor. As funções são
+ * compiladas com atributo de alvo, então o build do host não precisa de
+ * -msse4.1/-mavx2; o backend só é oferecido se a CPU suportar as
+ * instruções.
+ *
+ * Autor: Equipe SPRINT 3
+ * Data: 2025
+ */
+
+#include "kernel_backend.h"
+
+#include "input_preprocess.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+
+#include <immintrin.h>
+
+__attribute__((target("sse4.1")))
+static int32_t dotSse4(const int8_t* x, const int8_t* w, int n) {
+  __m128i acc = _mm_setzero_si128();
+  int i = 0;
+  for (; i + 16 <= n; i += 16) {
+    const __m128i xv = _mm_loadu_si128((const __m128i*)(x + i));
+    const __m128i wv = _mm_loadu_si128((const __m128i*)(w + i));
+    acc = _mm_add_epi32(acc, _mm_madd_epi16(_mm_cvtepi8_epi16(xv), _mm_cvtepi8_epi16(wv)));
+    acc = _mm_add_epi32(acc, _mm_madd_epi16(_mm_cvtepi8_epi16(_mm_srli_si128(xv, 8)),
+                                            _mm_cvtepi8_epi16(_mm_srli_si128(wv, 8))));
+  }
+  acc = _mm_add_epi32(acc, _mm_shuffle_epi32(acc, 0x4E));
+  acc = _mm_add_epi32(acc, _mm_shuffle_epi32(acc, 0xB1));
+  int32_t sum = _mm_cvtsi128_si32(acc);
+  for (; i < n; ++i) sum += (int32_t)x[i] * (int32_t)w[i];
+  return sum;
+}
+
+__attribute__((target("avx2")))
+static int32_t dotAvx2(const int8_t* x, const int8_t* w, int n) {
+  __m256i acc = _mm256_setzero_si256();
+  int i = 0;
+  for (; i + 32 <= n; i += 32) {
+    const __m256i xv = _mm256_loadu_si256((const __m256i*)(x + i));
+    const __m256i wv = _mm256_loadu_si256((const __m256i*)(w + i));
+    acc = _mm256_add_epi32(acc, _mm256_madd_epi16(_mm256_cvtepi8_epi16(_mm256_castsi256_si128(xv)),
+                                                  _mm256_cvtepi8_epi16(_mm256_castsi256_si128(wv))));
+    acc = _mm256_add_epi32(acc, _mm256_madd_epi16(_mm256_cvtepi8_epi16(_mm256_extracti128_si256(xv, 1)),
+                                                  _mm256_cvtepi8_epi16(_mm256_extracti128_si256(wv, 1))));
+  }
+  __m128i sum4 = _mm_add_epi32(_mm256_castsi256_si128(acc), _mm256_extracti128_si256(acc, 1));
+  sum4 = _mm_add_epi32(sum4, _mm_shuffle_epi32(sum4, 0x4E));
+  sum4 = _mm_add_epi32(sum4, _mm_shuffle_epi32(sum4, 0xB1));
+  int32_t sum = _mm_cvtsi128_si32(sum4);
+  for (; i < n; ++i) sum += (int32_t)x[i] * (int32_t)w[i];
+  return sum;
+}
+
+// Expande os canais e aplica os pesos Q8 a 8 pixels RGB565 (lanes de 16 bits)
+__attribute__((target("sse4.1")))
+static inline __m128i lumaSse4(__m128i p) {
+  const __m128i r5 = _mm_srli_epi16(p, 11);
+  const __m128i g6 = _mm_and_si128(_mm_srli_epi16(p, 5), _mm_set1_epi16(0x3F));
+  const __m128i b5 = _mm_and_si128(p, _mm_set1_epi16(0x1F));
+  const __m128i r = _mm_or_si128(_mm_slli_epi16(r5, 3), _mm_srli_epi16(r5, 2));
+  const __m128i g = _mm_or_si128(_mm_slli_epi16(g6, 2), _mm_srli_epi16(g6, 4));
+  const __m128i b = _mm_or_si128(_mm_slli_epi16(b5, 3), _mm_srli_epi16(b5, 2));
+  __m128i y = _mm_add_epi16(_mm_mullo_epi16(r, _mm_set1_epi16(77)),
+                            _mm_mullo_epi16(g, _mm_set1_epi16(150)));
+  y = _mm_add_epi16(y, _mm_add_epi16(_mm_mullo_epi16(b, _mm_set1_epi16(29)),
+                                     _mm_set1_epi16(128)));
+  return _mm_srli_epi16(y, 8);
+}
+
+__attribute__((target("sse4.1")))
+static void lumaRowSse4(const uint8_t* rgb565, int width, uint16_t* acc) {
+  const __m128i swap = _mm_setr_epi8(1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14);
+  int x = 0;
+  for (; x + 8 <= width; x += 8) {
+    const __m128i p = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(rgb565 + 2 * x)), swap);
+    const __m128i a = _mm_loadu_si128((const __m128i*)(acc + x));
+    _mm_storeu_si128((__m128i*)(acc + x), _mm_add_epi16(a, lumaSse4(p)));
+  }
+  rgb565LumaRowScalar(rgb565 + 2 * x, width - x, acc + x);
+}
+
+__attribute__((target("avx2")))
+static void lumaRowAvx2(const uint8_t* rgb565, int width, uint16_t* acc) {
+  const __m256i swap = _mm256_setr_epi8(1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14,
+                                        1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14);
+  int x = 0;
+  for (; x + 16 <= width; x += 16) {
+    const __m256i p =
+        _mm256_shuffle_epi8(_mm256_loadu_si256((const __m256i*)(rgb565 + 2 * x)), swap);
+    const __m256i r5 = _mm256_srli_epi16(p, 11);
+    const __m256i g6 = _mm256_and_si256(_mm256_srli_epi16(p, 5), _mm256_set1_epi16(0x3F));
+    const __m256i b5 = _mm256_and_si256(p, _mm256_set1_epi16(0x1F));
+    const __m256i r = _mm256_or_si256(_mm256_slli_epi16(r5, 3), _mm256_srli_epi16(r5, 2));
+    const __m256i g = _mm256_or_si256(_mm256_slli_epi16(g6, 2), _mm256_srli_epi16(g6, 4));
+    const __m256i b = _mm256_or_si256(_mm256_slli_epi16(b5, 3), _mm256_srli_epi16(b5, 2));
+    __m256i y = _mm256_add_epi16(_mm256_mullo_epi16(r, _mm256_set1_epi16(77)),
+                                 _mm256_mullo_epi16(g, _mm256_set1_epi16(150)));
+    y = _mm256_add_epi16(y, _mm256_add_epi16(_mm256_mullo_epi16(b, _mm256_set1_epi16(29)),
+                                             _mm256_set1_epi16(128)));
+    const __m256i a = _mm256_loadu_si256((const __m256i*)(acc + x));
+    _mm256_storeu_si256((__m256i*)(acc + x), _mm256_add_epi16(a, _mm256_srli_epi16(y, 8)));
+  }
+  lumaRowSse4(rgb565 + 2 * x, width - x, acc + x);
+}
+
+__attribute__((target("sse4.1")))
+static void yRowSse4(const uint8_t* yuv422, int width, uint16_t* acc) {
+  const __m128i mask = _mm_set1_epi16(0xFF);
+  int x = 0;
+  for (; x + 8 <= width; x += 8) {
+    const __m128i p = _mm_loadu_si128((const __m128i*)(yuv422 + 2 * x));
+    const __m128i a = _mm_loadu_si128((const __m128i*)(acc + x));
+    _mm_storeu_si128((__m128i*)(acc + x), _mm_add_epi16(a, _mm_and_si128(p, mask)));
+  }
+  yuv422YRowScalar(yuv422 + 2 * x, width - x, acc + x);
+}
+
+__attribute__((target("avx2")))
+static void yRowAvx2(const uint8_t* yuv422, int width, uint16_t* acc) {
+  const __m256i mask = _mm256_set1_epi16(0xFF);
+  int x = 0;
+  for (; x + 16 <= width; x += 16) {
+    const __m256i p = _mm256_loadu_si256((const __m256i*)(yuv422 + 2 * x));
+    const __m256i a = _mm256_loadu_si256((const __m256i*)(acc + x));
+    _mm256_storeu_si256((__m256i*)(acc + x), _mm256_add_epi16(a, _mm256_and_si256(p, mask)));
+  }
+  yRowSse4(yuv422 + 2 * x, width - x, acc + x);
+}
+
+static void conv2dSse4(const ConvShape& s, const int8_t* input, int32_t input_offset,
+                       const int8_t* filter, const int32_t* bias, const int32_t* weight_sums,
+                       const RequantParams& rq, int8_t* output) {
+  conv2dInt8Dot(dotSse4, s, input, input_offset, filter, bias, weight_sums, rq, output);
+}
+
+static void conv2dMaxPoolSse4(const ConvShape& conv, const ConvShape& pool, const int8_t* input,
+                              int32_t input_offset, const int8_t* filter, const int32_t* bias,
+                              const int32_t* weight_sums, const RequantParams& rq, int8_t* output) {
+  conv2dMaxPoolInt8Dot(dotSse4, conv, pool, input, input_offset, filter, bias, weight_sums, rq,
+                       output);
+}
+
+static void fullyConnectedSse4(int in_features, int out_features, const int8_t* input,
+                               int32_t input_offset, const int8_t* weights, const int32_t* bias,
+                               const int32_t* weight_sums, const RequantParams& rq,
+                               int8_t* output) {
+  fullyConnectedInt8Dot(dotSse4, in_features, out_features, input, input_offset, weights, bias,
+                        weight_sums, rq, output);
+}
+
+static void conv2dAvx2(const ConvShape& s, const int8_t* input, int32_t input_offset,
+                       const int8_t* filter, const int32_t* bias, const int32_t* weight_sums,
+                       const RequantParams& rq, int8_t* output) {
+  conv2dInt8Dot(dotAvx2, s, input, input_offset, filter, bias, weight_sums, rq, output);
+}
+
+static void conv2dMaxPoolAvx2(const ConvShape& conv, const ConvShape& pool, const int8_t* input,
+                              int32_t input_offset, const int8_t* filter, const int32_t* bias,
+                              const int32_t* weight_sums, const RequantParams& rq, int8_t* output) {
+  conv2dMaxPoolInt8Dot(dotAvx2, conv, pool, input, input_offset, filter, bias, weight_sums, rq,
+                       output);
+}
+
+static void fullyConnectedAvx2(int in_features, int out_features, const int8_t* input,
+                               int32_t input_offset, const int8_t* weights, const int32_t* bias,
+                               const int32_t* weight_sums, const RequantParams& rq,
+                               int8_t* output) {
+  fullyConnectedInt8Dot(dotAvx2, in_features, out_features, input, input_offset, weights, bias,
+                        weight_sums, rq, output);
+}
+
+const KernelBackend* sse4KernelBackend() {
+  static const KernelBackend backend = { "sse4", dotSse4, conv2dSse4, conv2dMaxPoolSse4,
+                                         fullyConnectedSse4, lumaRowSse4, yRowSse4 };
+  return __builtin_cpu_supports("sse4.1") ? &backend : nullptr;
+}
+
+const KernelBackend* avx2KernelBackend() {
+  static const KernelBackend backend = { "avx2", dotAvx2, conv2dAvx2, conv2dMaxPoolAvx2,
+                                         fullyConnectedAvx2, lumaRowAvx2, yRowAvx2 };
+  return __builtin_cpu_supports("avx2") ? &backend : nullptr;
+}
+
+#else
+
+const KernelBackend* sse4KernelBackend() { return nullptr; }
+const KernelBackend* avx2KernelBackend() { return nullptr; }
+
+#endif
@@ -0,0 +1,166 @@
+/*
+ * SPRINT 3 - Perfilador por Operador do Motor INT8
+ * ================================================
+ *
+ * Autor: Equipe SPRINT 3
+ * Data: 2025
+ */
+
+#include "layer_profiler.h"
+
+#include <string.h>
+
+#include "int8_engine.h"
+
+#if defined(ESP_PLATFORM)
+#include <xtensa/hal.h>
+#else
+#include <chrono>
+#endif
+
+LayerProfiler::LayerProfiler() : num_layers_(0), inferences_(0) {
+  memset(layers_, 0, sizeof(layers_));
+}
+
+uint32_t LayerProfiler::now() {
+#if defined(ESP_PLATFORM)
+  return xthal_get_ccount();
+#else
+  return (uint32_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+uint32_t LayerProfiler::cyclesPerUs() {
+#if defined(ESP_PLATFORM) && defined(F_CPU)
+  return (uint32_t)(F_CPU / 1000000L);
+#elif defined(ESP_PLATFORM)
+  return 240;
+#else
+  return 1000;
+#endif
+}
+
+void LayerProfiler::attach(const Int8Engine& engine) {
+  num_layers_ = engine.layerCount() < kMaxLayers ? engine.layerCount() : kMaxLayers;
+  for (int i = 0; i < num_layers_; ++i) {
+    const Int8Layer& l = engine.layer(i);
+    const Int8Tensor& in = engine.tensor(l.input);
+    const Int8Tensor& out = engine.tensor(l.output);
+    LayerProfile& p = layers_[i];
+    p.op = l.op;
+
+    const ConvShape& s = l.shape;
+    switch (l.op) {
+      case kOpConv2D:
+      case kOpConv2DMaxPool:
+        // Na camada fundida, shape é a convolução em resolução cheia
+        p.macs = (uint32_t)s.out_h * s.out_w * s.out_c * s.k_h * s.k_w * s.in_c;
+        break;
+      case kOpFullyConnected:
+        p.macs = (uint32_t)s.in_c * s.out_c;
+        break;
+      default:
+        p.macs = 0;
+        break;
+    }
+
+    p.bytes_read = in.bytes;
+    if (l.int4) {
+      // Nibbles + bias/requantização da seção int4
+      p.bytes_read += int4DenseSectionBytes(l.shape.in_c, l.shape.out_c);
+    } else if (l.sparse.values) {
+      // Só as faixas não nulas são lidas e multiplicadas
+      const int per_row = (int)(engine.tensor(l.weights).bytes / s.out_c);
+      p.macs = (uint32_t)(p.macs * blockSparseDensity(l.sparse, per_row) + 0.5f);
+      p.bytes_read += blockSparseSectionBytes(s.out_c, l.sparse.nnz);
+      if (l.bias >= 0) p.bytes_read += engine.tensor(l.bias).buffer_size;
+    } else {
+      if (l.weights >= 0) p.bytes_read += engine.tensor(l.weights).buffer_size;
+      if (l.bias >= 0) p.bytes_read += engine.tensor(l.bias).buffer_size;
+    }
+    p.bytes_written = out.bytes;
+
+    // Tensores de ativação vivos durante a camada (entrada do modelo: first_use = -1)
+    uint32_t arena = 0;
+    for (int t = 0; t < engine.tensorCount(); ++t) {
+      const Int8Tensor& tensor = engine.tensor(t);
+      if (!tensor.data || tensor.alias_of >= 0) continue;
+      if (tensor.first_use > i || tensor.last_use < i) continue;
+      const uint32_t end = tensor.arena_offset + tensor.bytes;
+      if (end > arena) arena = end;
+    }
+    // Bloco em patches: os buffers do patch substituem as ativações intermediárias
+    if (i < engine.patchLayers()) {
+      const uint32_t end = engine.patchBufferOffset() + (uint32_t)engine.patchBufferBytes();
+      if (end > arena) arena = end;
+    }
+    p.arena_bytes = arena;
+  }
+  reset();
+}
+
+void LayerProfiler::reset() {
+  for (int i = 0; i < num_layers_; ++i) {
+    LayerProfile& p = layers_[i];
+    p.last_cycles = 0;
+    p.min_cycles = UINT32_MAX;
+    p.max_cycles = 0;
+    p.total_cycles = 0;
+  }
+  inferences_ = 0;
+}
+
+void LayerProfiler::record(int layer, uint32_t cycles) {
+  if (layer < 0 || layer >= num_layers_) return;
+  LayerProfile& p = layers_[layer];
+  p.last_cycles = cycles;
+  if (cycles < p.min_cycles) p.min_cycles = cycles;
+  if (cycles > p.max_cycles) p.max_cycles = cycles;
+  p.total_cycles += cycles;
+}
+
+float LayerProfiler::meanCycles(int index) const {
+  if (inferences_ == 0) return 0.0f;
+  return (float)((double)layers_[index].total_cycles / inferences_);
+}
+
+float LayerProfiler::macsPerCycle(int index) const {
+  const float cycles = meanCycles(index);
+  return cycles > 0.0f ? layers_[index].macs / cycles : 0.0f;
+}
+
+float LayerProfiler::share(int index) const {
+  uint64_t total = 0;
+  for (int i = 0; i < num_layers_; ++i) total += layers_[i].total_cycles;
+  return total ? (float)((double)layers_[index].total_cycles / total) : 0.0f;
+}
+
+float LayerProfiler::meanInferenceUs() const {
+  float us = 0.0f;
+  for (int i = 0; i < num_layers_; ++i) us += meanUs(i);
+  return us;
+}
+
+uint32_t LayerProfiler::totalMacs() const {
+  uint32_t macs = 0;
+  for (int i = 0; i < num_layers_; ++i) macs += layers_[i].macs;
+  return macs;
+}
+
+uint32_t LayerProfiler::totalBytesRead() const {
+  uint32_t bytes = 0;
+  for (int i = 0; i < num_layers_; ++i) bytes += layers_[i].bytes_read;
+  return bytes;
+}
+
+const char* LayerProfiler::opName(uint8_t op) {
+  switch (op) {
+    case kOpConv2D: return "Conv2D";
+    case kOpMaxPool2D: return "MaxPool2D";
+    case kOpFullyConnected: return "FullyConnected";
+    case kOpSoftmax: return "Softmax";
+    case kOpConv2DMaxPool: return "Conv2D+MaxPool";
+  }
+  return "?";
+}
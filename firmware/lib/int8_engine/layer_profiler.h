@@ -0,0 +1,77 @@
+/*
+ * SPRINT 3 - Perfilador por Operador do Motor INT8
+ * ================================================
+ *
+ * Mede cada camada executada por Int8Engine::invoke(): ciclos (média,
+ * mínimo, máximo e última execução), MACs, bytes lidos (ativação de
+ * entrada + pesos + bias), bytes escritos e a arena ocupada pelos
+ * tensores vivos durante a camada. A geometria é lida uma vez em
+ * attach(); a cada inferência só o contador de ciclos é amostrado.
+ *
+ * No ESP32-S3 o relógio é o contador de ciclos da CPU (CCOUNT); no
+ * host são nanossegundos, ou seja, "ciclos" de uma CPU de 1 GHz.
+ * Os agregados são servidos pela rota /profile do firmware e pela
+ * ferramenta host_profile.
+ *
+ * Autor: Equipe SPRINT 3
+ * Data: 2025
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+class Int8Engine;
+
+struct LayerProfile {
+  uint8_t op;              // Int8OpType
+  uint32_t macs;           // Multiplicações-acumulações por inferência
+  uint32_t bytes_read;     // Ativação de entrada + pesos + bias
+  uint32_t bytes_written;  // Ativação de saída
+  uint32_t arena_bytes;    // Pico da arena com os tensores vivos na camada
+  uint32_t last_cycles;
+  uint32_t min_cycles;
+  uint32_t max_cycles;
+  uint64_t total_cycles;
+};
+
+class LayerProfiler {
+ public:
+  static const int kMaxLayers = 24;   // Igual a Int8Engine::kMaxLayers
+
+  LayerProfiler();
+
+  // Lê a geometria das camadas do modelo carregado e zera os agregados
+  // (chamado pelo Int8Engine em setProfiler() e em begin())
+  void attach(const Int8Engine& engine);
+  void reset();
+
+  // Relógio de ciclos da plataforma e sua frequência
+  static uint32_t now();
+  static uint32_t cyclesPerUs();
+
+  void record(int layer, uint32_t cycles);
+  void endInference() { ++inferences_; }
+
+  int layerCount() const { return num_layers_; }
+  const LayerProfile& layer(int index) const { return layers_[index]; }
+  uint32_t inferences() const { return inferences_; }
+
+  float meanCycles(int index) const;
+  float meanUs(int index) const { return meanCycles(index) / cyclesPerUs(); }
+  // MACs por ciclo médio (0 para camadas sem MACs)
+  float macsPerCycle(int index) const;
+  // Fração do tempo total da inferência gasta na camada
+  float share(int index) const;
+  float meanInferenceUs() const;
+  uint32_t totalMacs() const;
+  uint32_t totalBytesRead() const;
+
+  static const char* opName(uint8_t op);
+
+ private:
+  LayerProfile layers_[kMaxLayers];
+  int num_layers_;
+  uint32_t inferences_;
+};
@@ -0,0 +1,215 @@
+/*
+ * SPRINT 3 - Modelo Carregado de Arquivo (partição / SPIFFS / host)
+ * =================================================================
+ *
+ * Autor: Equipe SPRINT 3
+ * Data: 2025
+ */
+
+#include "model_file.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#if defined(ESP_PLATFORM)
+#include <esp_heap_caps.h>
+#include <esp_idf_version.h>
+#include <esp_partition.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// Alinhamento exigido pelo motor (bias/escalas lidos direto do flatbuffer)
+static const size_t kModelAlignment = 16;
+
+ModelFile::ModelFile()
+    : data_(nullptr),
+      size_(0),
+      mapped_(false),
+      error_("não aberto"),
+      map_base_(nullptr),
+      map_size_(0),
+      map_handle_(0) {}
+
+ModelFile::~ModelFile() { close(); }
+
+bool ModelFile::useImage(const uint8_t* image, size_t image_size) {
+  ModelImageHeader header;
+  if (image_size < kModelImageHeaderSize) {
+    error_ = "imagem truncada";
+    return false;
+  }
+  memcpy(&header, image, sizeof(header));
+  if (header.magic != kModelImageMagic) {
+    error_ = "partição sem imagem de modelo (grave com data_upload.py)";
+    return false;
+  }
+  if (header.size == 0 || header.size > image_size - kModelImageHeaderSize) {
+    error_ = "tamanho da imagem inválido";
+    return false;
+  }
+  // O mapeamento começa alinhado à página, e o cabeçalho mantém os 16 bytes
+  data_ = (uint8_t*)image + kModelImageHeaderSize;
+  size_ = header.size;
+  mapped_ = true;
+  error_ = "";
+  return true;
+}
+
+#if defined(ESP_PLATFORM)
+
+bool ModelFile::openPartition(const char* name) {
+  close();
+  const esp_partition_t* part =
+      esp_partition_find_first(ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_ANY, name);
+  if (!part) {
+    error_ = "partição não encontrada";
+    return false;
+  }
+  // Mapeia a partição inteira no espaço de dados: as leituras passam pelo
+  // cache da flash, sem cópia para a RAM
+  const void* p = nullptr;
+#if ESP_IDF_VERSION_MAJOR >= 5
+  esp_partition_mmap_handle_t handle;
+  const esp_err_t err = esp_partition_mmap(part, 0, part->size, ESP_PARTITION_MMAP_DATA, &p,
+                                           &handle);
+#else
+  spi_flash_mmap_handle_t handle;
+  const esp_err_t err = esp_partition_mmap(part, 0, part->size, SPI_FLASH_MMAP_DATA, &p, &handle);
+#endif
+  if (err != ESP_OK) {
+    error_ = "esp_partition_mmap falhou";
+    return false;
+  }
+  map_base_ = (void*)p;
+  map_size_ = part->size;
+  map_handle_ = (uint32_t)handle;
+  if (!useImage((const uint8_t*)p, part->size)) {
+    const char* error = error_;
+    close();
+    error_ = error;
+    return false;
+  }
+  return true;
+}
+
+bool ModelFile::open(const char* path) {
+  close();
+  FILE* f = fopen(path, "rb");
+  if (!f) {
+    error_ = "arquivo não encontrado";
+    return false;
+  }
+  fseek(f, 0, SEEK_END);
+  const long size = ftell(f);
+  fseek(f, 0, SEEK_SET);
+  if (size <= 0) {
+    fclose(f);
+    error_ = "arquivo vazio";
+    return false;
+  }
+
+  // SPIFFS não é mapeável: cópia na PSRAM, sem disputar a SRAM interna com a arena
+  data_ = (uint8_t*)heap_caps_aligned_alloc(kModelAlignment, size,
+                                            MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+  if (!data_) {
+    data_ = (uint8_t*)heap_caps_aligned_alloc(kModelAlignment, size, MALLOC_CAP_8BIT);
+  }
+  if (!data_) {
+    fclose(f);
+    error_ = "memória insuficiente";
+    return false;
+  }
+  const size_t read = fread(data_, 1, size, f);
+  fclose(f);
+  if (read != (size_t)size) {
+    close();
+    error_ = "leitura incompleta";
+    return false;
+  }
+  size_ = size;
+  error_ = "";
+  return true;
+}
+
+void ModelFile::close() {
+  if (map_base_) {
+#if ESP_IDF_VERSION_MAJOR >= 5
+    esp_partition_munmap((esp_partition_mmap_handle_t)map_handle_);
+#else
+    spi_flash_munmap((spi_flash_mmap_handle_t)map_handle_);
+#endif
+  } else if (data_) {
+    heap_caps_free(data_);
+  }
+  data_ = nullptr;
+  size_ = 0;
+  mapped_ = false;
+  map_base_ = nullptr;
+  map_size_ = 0;
+  map_handle_ = 0;
+}
+
+#else
+
+// Arquivo inteiro mapeado somente leitura em map_base_
+static void* mapFile(const char* path, size_t* size, const char** error) {
+  const int fd = ::open(path, O_RDONLY);
+  if (fd < 0) {
+    *error = "arquivo não encontrado";
+    return nullptr;
+  }
+  struct stat st;
+  if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+    ::close(fd);
+    *error = "arquivo vazio";
+    return nullptr;
+  }
+  // mmap devolve endereço alinhado à página, o que já cobre kModelAlignment
+  void* p = mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  ::close(fd);
+  if (p == MAP_FAILED) {
+    *error = "mmap falhou";
+    return nullptr;
+  }
+  *size = (size_t)st.st_size;
+  return p;
+}
+
+bool ModelFile::open(const char* path) {
+  close();
+  map_base_ = mapFile(path, &map_size_, &error_);
+  if (!map_base_) return false;
+  data_ = (uint8_t*)map_base_;
+  size_ = map_size_;
+  mapped_ = true;
+  error_ = "";
+  return true;
+}
+
+bool ModelFile::openPartition(const char* name) {
+  close();
+  map_base_ = mapFile(name, &map_size_, &error_);
+  if (!map_base_) return false;
+  if (!useImage((const uint8_t*)map_base_, map_size_)) {
+    const char* error = error_;
+    close();
+    error_ = error;
+    return false;
+  }
+  return true;
+}
+
+void ModelFile::close() {
+  if (map_base_) munmap(map_base_, map_size_);
+  data_ = nullptr;
+  size_ = 0;
+  mapped_ = false;
+  map_base_ = nullptr;
+  map_size_ = 0;
+}
+
+#endif
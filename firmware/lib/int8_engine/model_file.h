@@ -0,0 +1,80 @@
+/*
+ * SPRINT 3 - Modelo Carregado de Arquivo (partição / SPIFFS / host)
+ * =================================================================
+ *
+ * Alternativa ao g_model compilado no firmware: o .tflite e o blob de
+ * pesos empacotados .i8pk são gravados à parte (data_upload.py) e podem
+ * ser trocados sem regravar o firmware.
+ *
+ *   - ESP32, partição (caminho normal): cada blob fica numa partição
+ *     de dados crua (model / packed em partitions_model.csv), com um
+ *     cabeçalho de 16 bytes, e é mapeado com esp_partition_mmap. Zero
+ *     cópia: os pesos são lidos da flash pelo cache, como o g_model,
+ *     e o streaming de pesos (dense_gemv.h) continua vindo da flash;
+ *   - ESP32, SPIFFS (só fallback, sem as partições): SPIFFS não é
+ *     mapeável (as páginas do arquivo não são contíguas), então o
+ *     arquivo é copiado no boot para um buffer alinhado na PSRAM;
+ *   - host: o arquivo é mapeado com mmap; openPartition() abre uma
+ *     imagem de partição (cabeçalho + blob) gravada em arquivo.
+ *
+ * Com mapeamento o Int8Engine aponta direto para esses bytes: tensores,
+ * pesos, bias e escalas são lidos no lugar, sem cópia no parsing.
+ *
+ * Autor: Equipe SPRINT 3
+ * Data: 2025
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Partições de dados cruas (partitions_model.csv), mapeadas sem cópia
+static const char* const kModelPartition = "model";
+static const char* const kPackedPartition = "packed";
+// Fallback: caminhos na SPIFFS (montada em /spiffs pelo SPIFFS.begin())
+static const char* const kSpiffsModelPath = "/spiffs/model_int8.tflite";
+static const char* const kSpiffsPackedPath = "/spiffs/model_int8.i8pk";
+
+// Imagem de partição: este cabeçalho e o blob logo depois (alinhado a 16)
+static const uint32_t kModelImageMagic = 0x494C444D;   // "MDLI"
+static const size_t kModelImageHeaderSize = 16;
+struct ModelImageHeader {
+  uint32_t magic;
+  uint32_t size;               // Bytes do blob
+  uint32_t reserved[2];
+};
+
+class ModelFile {
+ public:
+  ModelFile();
+  ~ModelFile();
+
+  // Abre (e mapeia ou lê) o arquivo; fecha o anterior
+  bool open(const char* path);
+  // Mapeia a partição (ESP32: rótulo; host: arquivo com a imagem)
+  bool openPartition(const char* name);
+  void close();
+
+  const uint8_t* data() const { return data_; }
+  size_t size() const { return size_; }
+  // true quando os bytes são o próprio mapeamento (partição ou mmap)
+  bool mapped() const { return mapped_; }
+  const char* errorMessage() const { return error_; }
+
+ private:
+  ModelFile(const ModelFile&);
+  ModelFile& operator=(const ModelFile&);
+
+  // Confere o cabeçalho da imagem mapeada e aponta data_ para o blob
+  bool useImage(const uint8_t* image, size_t image_size);
+
+  uint8_t* data_;
+  size_t size_;
+  bool mapped_;
+  const char* error_;
+  // Mapeamento a desfazer no close() (mmap / esp_partition_mmap)
+  void* map_base_;
+  size_t map_size_;
+  uint32_t map_handle_;
+};
@@ -0,0 +1,56 @@
+/*
+ * SPRINT 3 - Pesos Pré-empacotados (seção I8PK)
+ * =============================================
+ *
+ * Autor: Equipe SPRINT 3
+ * Data: 2025
+ */
+
+#include "packed_weights.h"
+
+#include <string.h>
+
+static_assert(sizeof(PackedHeader) == 16, "PackedHeader deve ter 16 bytes");
+static_assert(sizeof(PackedEntry) == 16, "PackedEntry deve ter 16 bytes");
+
+bool PackedWeights::attach(const uint8_t* data, size_t size, size_t model_size) {
+  clear();
+  if (!data || size < sizeof(PackedHeader)) return false;
+  if (((uintptr_t)data & (kPackedAlignment - 1)) != 0) return false;
+
+  PackedHeader header;
+  memcpy(&header, data, sizeof(header));
+  if (header.magic != kPackedMagic || header.version != kPackedVersion) return false;
+  if (header.total_size != size || header.model_size != model_size) return false;
+  if (sizeof(PackedHeader) + (size_t)header.count * sizeof(PackedEntry) > size) return false;
+
+  data_ = data;
+  size_ = size;
+  count_ = header.count;
+  for (int i = 0; i < count_; ++i) {
+    PackedEntry e;
+    entryAt(i, &e);
+    if ((e.offset & (kPackedAlignment - 1)) != 0 || e.offset > size || e.size > size - e.offset ||
+        e.block == 0) {
+      clear();
+      return false;
+    }
+  }
+  return true;
+}
+
+bool PackedWeights::entryAt(int index, PackedEntry* entry) const {
+  if (index < 0 || index >= count_) return false;
+  memcpy(entry, data_ + sizeof(PackedHeader) + (size_t)index * sizeof(PackedEntry),
+         sizeof(PackedEntry));
+  return true;
+}
+
+const uint8_t* PackedWeights::find(int tensor, PackedLayout layout, PackedEntry* entry) const {
+  for (int i = 0; i < count_; ++i) {
+    if (entryAt(i, entry) && entry->tensor == tensor && entry->layout == layout) {
+      return data_ + entry->offset;
+    }
+  }
+  return nullptr;
+}
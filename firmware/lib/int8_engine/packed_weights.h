@@ -0,0 +1,97 @@
+/*
+ * SPRINT 3 - Pesos Pré-empacotados (seção I8PK)
+ * =============================================
+ *
+ * Formato do blob gerado por model/convert_to_c_array.py ao lado do
+ * g_model (g_model_packed[]). Os pesos de FullyConnected são
+ * reordenados uma única vez, no PC, em blocos de kPackBlock canais de
+ * saída: para cada bloco, os kPackBlock pesos de uma mesma entrada
+ * ficam contíguos. Assim o laço interno lê uma sequência contínua de
+ * pesos e reaproveita cada ativação lida para kPackBlock acumuladores.
+ * O motor aponta direto para o blob na flash; nada é reempacotado no
+ * boot. Só a FullyConnected grande vai em blocos (é o que o GEMV em
+ * pedaços de dense_gemv.h lê); o classificador pequeno e as Conv2D ficam
+ * OHWI, lidos pelos backends vetoriais (kernel_backend.h), pelo kernel
+ * da 1ª camada e pelo Winograd. O motor ignora kLayoutOcBlocked de Conv2D.
+ *
+ * O mesmo blob carrega, para cada Conv2D/FullyConnected, a tabela de
+ * requantização por canal (multiplicador Q31 + shift) já calculada no
+ * PC a partir das escalas float, usada pelo motor no lugar da conta
+ * feita em begin().
+ *
+ * A FullyConnected grande traz, no lugar dos pesos int8 em blocos, a
+ * seção em 4 bits (kLayoutInt4): pesos requantizados por canal para
+ * [-7, 7], dois por byte na ordem em blocos (nibble baixo = canal par do
+ * bloco), seguidos de int32 bias[O], multiplicador[O] e shift[O] na nova
+ * escala. Ver dense_gemv.h (fullyConnectedInt4Streamed). Sem
+ * setInt4Dense(true), a camada lê os pesos OHWI do .tflite.
+ *
+ * Camadas de modelos podados em blocos (export_tflite.py
+ * --block-sparsity) trazem, no lugar dos pesos em blocos, a seção
+ * kLayoutBlockSparse: só as faixas de kSparseSpan pesos não nulas de
+ * cada bloco de canais, com o índice delas (ver block_sparse.h).
+ *
+ * Layout (little-endian, início do blob e de cada tensor alinhados a 16):
+ *   PackedHeader | PackedEntry[count] | dados
+ *
+ * Autor: Equipe SPRINT 3
+ * Data: 2025
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+static const uint32_t kPackedMagic = 0x4B503849;  // "I8PK"
+static const uint16_t kPackedVersion = 1;
+static const uint32_t kPackedAlignment = 16;
+
+// Organização dos dados de uma entrada
+enum PackedLayout : uint8_t {
+  kLayoutOcBlocked = 1,    // [ceil(O/bloco)][R][bloco], canais excedentes zerados
+  kLayoutRequant = 2,      // int32 multiplicador[O] seguido de int32 shift[O]
+  kLayoutInt4 = 3,         // Nibbles em blocos + int32 bias[O], multiplicador[O], shift[O]
+  kLayoutBlockSparse = 4   // Índice das faixas não nulas + valores (block_sparse.h)
+};
+
+struct PackedHeader {
+  uint32_t magic;
+  uint16_t version;
+  uint16_t count;          // Número de entradas
+  uint32_t total_size;     // Tamanho do blob inteiro
+  uint32_t model_size;     // Tamanho do .tflite de origem (conferência)
+};
+
+struct PackedEntry {
+  uint16_t tensor;         // Índice do tensor de pesos da camada no subgrafo
+  uint8_t layout;          // PackedLayout
+  uint8_t block;           // Canais de saída por bloco
+  uint32_t offset;         // Início dos dados, relativo ao blob
+  uint32_t size;           // Bytes de dados
+  uint32_t rows;           // Canais de saída (O) antes do preenchimento
+};
+
+// Acesso somente leitura ao blob (zero-copy, pode estar na flash)
+class PackedWeights {
+ public:
+  PackedWeights() : data_(nullptr), size_(0), count_(0) {}
+
+  // Valida cabeçalho e tabela; false se o blob não corresponde ao modelo
+  bool attach(const uint8_t* data, size_t size, size_t model_size);
+  void clear() { data_ = nullptr; size_ = 0; count_ = 0; }
+
+  bool attached() const { return data_ != nullptr; }
+  size_t size() const { return size_; }
+  int count() const { return count_; }
+
+  // Procura a entrada do tensor com o layout indicado; nullptr se não houver
+  const uint8_t* find(int tensor, PackedLayout layout, PackedEntry* entry) const;
+
+ private:
+  bool entryAt(int index, PackedEntry* entry) const;
+
+  const uint8_t* data_;
+  size_t size_;
+  int count_;
+};
@@ -0,0 +1,192 @@
+/*
+ * SPRINT 3 - Leitor Mínimo de Flatbuffer TFLite
+ * =============================================
+ *
+ * Acesso direto (zero-copy) às tabelas do schema TFLite usadas pelo
+ * motor INT8. Apenas os campos necessários para o grafo do modelo
+ * de cartuchos são expostos; todas as leituras são feitas com memcpy
+ * para tolerar buffers sem alinhamento e checam o tamanho do modelo.
+ *
+ * Autor: Equipe SPRINT 3
+ * Data: 2025
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+namespace tflite_fb {
+
+// Códigos de operador (BuiltinOperator)
+enum BuiltinOp {
+  kBuiltinConv2D = 3,
+  kBuiltinFullyConnected = 9,
+  kBuiltinMaxPool2D = 17,
+  kBuiltinReshape = 22,
+  kBuiltinSoftmax = 25,
+  kBuiltinStridedSlice = 45,
+  kBuiltinShape = 77,
+  kBuiltinPack = 83
+};
+
+// Tipos de tensor (TensorType)
+enum TensorType {
+  kTypeFloat32 = 0,
+  kTypeInt32 = 2,
+  kTypeUInt8 = 3,
+  kTypeInt8 = 9
+};
+
+// Funções de ativação fundidas (ActivationFunctionType)
+enum Activation {
+  kActNone = 0,
+  kActRelu = 1,
+  kActRelu6 = 3
+};
+
+// Tipos de padding (Padding)
+enum Padding {
+  kPaddingSame = 0,
+  kPaddingValid = 1
+};
+
+inline uint16_t readU16(const uint8_t* p) { uint16_t v; memcpy(&v, p, 2); return v; }
+inline uint32_t readU32(const uint8_t* p) { uint32_t v; memcpy(&v, p, 4); return v; }
+inline int32_t readI32(const uint8_t* p) { int32_t v; memcpy(&v, p, 4); return v; }
+inline int64_t readI64(const uint8_t* p) { int64_t v; memcpy(&v, p, 8); return v; }
+inline float readF32(const uint8_t* p) { float v; memcpy(&v, p, 4); return v; }
+
+struct Table;
+
+// Vetor flatbuffer: `pos` aponta para o primeiro elemento
+struct Vector {
+  const uint8_t* base;
+  size_t len;
+  uint32_t pos;
+  uint32_t size;
+
+  bool valid(uint32_t elem_size) const {
+    return base && (uint64_t)pos + (uint64_t)size * elem_size <= len;
+  }
+  int32_t i32(uint32_t i) const { return readI32(base + pos + 4 * i); }
+  int64_t i64(uint32_t i) const { return readI64(base + pos + 8 * i); }
+  float f32(uint32_t i) const { return readF32(base + pos + 4 * i); }
+  const uint8_t* bytes() const { return base + pos; }
+  inline Table table(uint32_t i) const;
+};
+
+// Tabela flatbuffer: `pos` é o deslocamento da tabela no modelo
+struct Table {
+  const uint8_t* base;
+  size_t len;
+  uint32_t pos;
+
+  bool valid() const { return base && pos >= 4 && (size_t)pos + 4 <= len; }
+
+  // Deslocamento do campo relativo à tabela (0 = ausente)
+  uint32_t field(int id) const {
+    if (!valid()) return 0;
+    int64_t vt = (int64_t)pos - readI32(base + pos);
+    if (vt < 0 || (size_t)vt + 4 > len) return 0;
+    uint16_t vsize = readU16(base + vt);
+    uint32_t off = 4 + 2 * (uint32_t)id;
+    if (off + 2 > vsize || (size_t)vt + off + 2 > len) return 0;
+    uint16_t rel = readU16(base + vt + off);
+    if (rel == 0 || (size_t)pos + rel + 4 > len) return 0;
+    return rel;
+  }
+
+  uint8_t u8(int id, uint8_t def) const {
+    uint32_t f = field(id); return f ? base[pos + f] : def;
+  }
+  int32_t i32(int id, int32_t def) const {
+    uint32_t f = field(id); return f ? readI32(base + pos + f) : def;
+  }
+  float f32(int id, float def) const {
+    uint32_t f = field(id); return f ? readF32(base + pos + f) : def;
+  }
+
+  Table table(int id) const {
+    Table t = { base, len, 0 };
+    uint32_t f = field(id);
+    if (f) t.pos = pos + f + readU32(base + pos + f);
+    return t;
+  }
+
+  Vector vector(int id) const {
+    Vector v = { base, len, 0, 0 };
+    uint32_t f = field(id);
+    if (!f) return v;
+    uint64_t at = (uint64_t)pos + f + readU32(base + pos + f);
+    if (at + 4 > len) return v;
+    v.size = readU32(base + at);
+    v.pos = (uint32_t)at + 4;
+    return v;
+  }
+};
+
+inline Table Vector::table(uint32_t i) const {
+  uint32_t at = pos + 4 * i;
+  Table t = { base, len, at + readU32(base + at) };
+  return t;
+}
+
+// Raiz do modelo (identificador "TFL3" nos bytes 4..7)
+inline Table modelRoot(const uint8_t* data, size_t len) {
+  Table t = { data, len, 0 };
+  if (!data || len < 8 || memcmp(data + 4, "TFL3", 4) != 0) { t.base = nullptr; return t; }
+  t.pos = readU32(data);
+  return t;
+}
+
+// Campos das tabelas do schema (índice do campo na vtable)
+namespace field {
+  // Model
+  const int kModelOperatorCodes = 1;
+  const int kModelSubgraphs = 2;
+  const int kModelBuffers = 4;
+  // OperatorCode
+  const int kOpCodeDeprecatedBuiltin = 0;
+  const int kOpCodeBuiltin = 3;
+  // SubGraph
+  const int kSubgraphTensors = 0;
+  const int kSubgraphInputs = 1;
+  const int kSubgraphOutputs = 2;
+  const int kSubgraphOperators = 3;
+  // Tensor
+  const int kTensorShape = 0;
+  const int kTensorType = 1;
+  const int kTensorBuffer = 2;
+  const int kTensorQuantization = 4;
+  // QuantizationParameters
+  const int kQuantScale = 2;
+  const int kQuantZeroPoint = 3;
+  const int kQuantDimension = 6;
+  // Operator
+  const int kOperatorOpcodeIndex = 0;
+  const int kOperatorInputs = 1;
+  const int kOperatorOutputs = 2;
+  const int kOperatorBuiltinOptions = 4;
+  // Buffer
+  const int kBufferData = 0;
+  // Conv2DOptions / Pool2DOptions
+  const int kConvPadding = 0;
+  const int kConvStrideW = 1;
+  const int kConvStrideH = 2;
+  const int kConvActivation = 3;
+  const int kConvDilationW = 4;
+  const int kConvDilationH = 5;
+  const int kPoolPadding = 0;
+  const int kPoolStrideW = 1;
+  const int kPoolStrideH = 2;
+  const int kPoolFilterW = 3;
+  const int kPoolFilterH = 4;
+  const int kPoolActivation = 5;
+  // FullyConnectedOptions / SoftmaxOptions
+  const int kFcActivation = 0;
+  const int kSoftmaxBeta = 0;
+}
+
+}  // namespace tflite_fb
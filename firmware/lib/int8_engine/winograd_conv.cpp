@@ -0,0 +1,168 @@
+/*
+ * SPRINT 3 - Conv2D 3x3 INT8 por Winograd F(2x2, 3x3)
+ * ===================================================
+ *
+ * Autor: Equipe SPRINT 3
+ * Data: 2025
+ */
+
+#include "winograd_conv.h"
+
+bool winogradSupported(const ConvShape& conv, const ConvShape* pool) {
+  if (conv.k_h != 3 || conv.k_w != 3 || conv.stride_h != 1 || conv.stride_w != 1 ||
+      conv.in_c > kWinogradMaxInputChannels || conv.out_c % kWinogradLanes != 0) {
+    return false;
+  }
+  return !pool || (pool->k_h == 2 && pool->k_w == 2 && pool->stride_h == 2 && pool->stride_w == 2);
+}
+
+size_t winogradWeightBytes(const ConvShape& s) {
+  return (size_t)16 * s.out_c * s.in_c * sizeof(int16_t);
+}
+
+void winogradTransformWeights(const ConvShape& s, const int8_t* filter, int16_t* u) {
+  for (int oc = 0; oc < s.out_c; ++oc) {
+    for (int ic = 0; ic < s.in_c; ++ic) {
+      int32_t g[3][3];
+      for (int ky = 0; ky < 3; ++ky) {
+        for (int kx = 0; kx < 3; ++kx) g[ky][kx] = filter[((oc * 3 + ky) * 3 + kx) * s.in_c + ic];
+      }
+      // t = G' g (4x3), G' = [2 0 0; 1 1 1; 1 -1 1; 0 0 2]
+      int32_t t[4][3];
+      for (int j = 0; j < 3; ++j) {
+        t[0][j] = 2 * g[0][j];
+        t[1][j] = g[0][j] + g[1][j] + g[2][j];
+        t[2][j] = g[0][j] - g[1][j] + g[2][j];
+        t[3][j] = 2 * g[2][j];
+      }
+      // U = t G'^T (4x4)
+      int16_t* dst = u + ((size_t)(oc / kWinogradLanes) * 16 * s.in_c + ic) * kWinogradLanes +
+                     oc % kWinogradLanes;
+      for (int i = 0; i < 4; ++i) {
+        const int32_t row[4] = { 2 * t[i][0], t[i][0] + t[i][1] + t[i][2],
+                                 t[i][0] - t[i][1] + t[i][2], 2 * t[i][2] };
+        for (int j = 0; j < 4; ++j) {
+          dst[(size_t)(i * 4 + j) * s.in_c * kWinogradLanes] = (int16_t)row[j];
+        }
+      }
+    }
+  }
+}
+
+// V = B^T d B do tile 4x4 com origem (iy0, ix0); fora da entrada d = 0
+// (padding ou linhas/colunas de saídas que serão descartadas)
+static void transformInputTile(const ConvShape& s, const int8_t* input, int32_t input_offset,
+                               int iy0, int ix0, int16_t* v) {
+  for (int ic = 0; ic < s.in_c; ++ic) {
+    int32_t d[4][4];
+    for (int i = 0; i < 4; ++i) {
+      const int iy = iy0 + i;
+      for (int j = 0; j < 4; ++j) {
+        const int ix = ix0 + j;
+        d[i][j] = (iy >= 0 && iy < s.in_h && ix >= 0 && ix < s.in_w)
+                      ? input[(iy * s.in_w + ix) * s.in_c + ic] + input_offset
+                      : 0;
+      }
+    }
+    // B^T = [1 0 -1 0; 0 1 1 0; 0 -1 1 0; 0 1 0 -1]
+    int32_t t[4][4];
+    for (int j = 0; j < 4; ++j) {
+      t[0][j] = d[0][j] - d[2][j];
+      t[1][j] = d[1][j] + d[2][j];
+      t[2][j] = d[2][j] - d[1][j];
+      t[3][j] = d[1][j] - d[3][j];
+    }
+    for (int i = 0; i < 4; ++i) {
+      v[(i * 4 + 0) * s.in_c + ic] = (int16_t)(t[i][0] - t[i][2]);
+      v[(i * 4 + 1) * s.in_c + ic] = (int16_t)(t[i][1] + t[i][2]);
+      v[(i * 4 + 2) * s.in_c + ic] = (int16_t)(t[i][2] - t[i][1]);
+      v[(i * 4 + 3) * s.in_c + ic] = (int16_t)(t[i][1] - t[i][3]);
+    }
+  }
+}
+
+// Somas exatas (sem bias) do bloco 2x2 de saída em kWinogradLanes canais:
+// y = A^T m A / 4. Os canais ficam no laço mais interno, de tamanho fixo,
+// que o compilador vetoriza
+static inline void tileOutput(const int16_t* u_blk, const int16_t* v, int in_c,
+                              int32_t y[2][2][kWinogradLanes]) {
+  int32_t m[16][kWinogradLanes];
+  for (int p = 0; p < 16; ++p) {
+    const int16_t* up = u_blk + (size_t)p * in_c * kWinogradLanes;
+    const int16_t* vp = v + p * in_c;
+    int32_t acc[kWinogradLanes] = { 0 };
+    for (int ic = 0; ic < in_c; ++ic, up += kWinogradLanes) {
+      const int32_t x = vp[ic];
+      for (int k = 0; k < kWinogradLanes; ++k) acc[k] += x * up[k];
+    }
+    for (int k = 0; k < kWinogradLanes; ++k) m[p][k] = acc[k];
+  }
+  // A^T = [1 1 1 0; 0 1 -1 -1]
+  for (int k = 0; k < kWinogradLanes; ++k) {
+    int32_t t[2][4];
+    for (int j = 0; j < 4; ++j) {
+      t[0][j] = m[j][k] + m[4 + j][k] + m[8 + j][k];
+      t[1][j] = m[4 + j][k] - m[8 + j][k] - m[12 + j][k];
+    }
+    for (int i = 0; i < 2; ++i) {
+      // G' = 2G: a saída sai multiplicada por 4, divisão exata
+      y[i][0][k] = (t[i][0] + t[i][1] + t[i][2]) >> 2;
+      y[i][1][k] = (t[i][1] - t[i][2] - t[i][3]) >> 2;
+    }
+  }
+}
+
+void conv2dWinogradInt8(const ConvShape& s, const int8_t* input, int32_t input_offset,
+                        const int16_t* u, const int32_t* bias, const RequantParams& rq,
+                        int8_t* output) {
+  int16_t v[16 * kWinogradMaxInputChannels];
+  for (int oy = 0; oy < s.out_h; oy += 2) {
+    for (int ox = 0; ox < s.out_w; ox += 2) {
+      transformInputTile(s, input, input_offset, oy - s.pad_h, ox - s.pad_w, v);
+      for (int oc0 = 0; oc0 < s.out_c; oc0 += kWinogradLanes) {
+        int32_t y[2][2][kWinogradLanes];
+        tileOutput(u + (size_t)oc0 * 16 * s.in_c, v, s.in_c, y);
+        for (int i = 0; i < 2 && oy + i < s.out_h; ++i) {
+          for (int j = 0; j < 2 && ox + j < s.out_w; ++j) {
+            int8_t* out = output + ((oy + i) * s.out_w + ox + j) * s.out_c + oc0;
+            for (int k = 0; k < kWinogradLanes; ++k) {
+              const int32_t b = bias ? bias[oc0 + k] : 0;
+              out[k] = requantize(b + y[i][j][k], rq, oc0 + k);
+            }
+          }
+        }
+      }
+    }
+  }
+}
+
+void conv2dMaxPoolWinogradInt8(const ConvShape& conv, const ConvShape& pool, const int8_t* input,
+                               int32_t input_offset, const int16_t* u, const int32_t* bias,
+                               const RequantParams& rq, int8_t* output) {
+  int16_t v[16 * kWinogradMaxInputChannels];
+  // Pool 2x2/2: o pixel (py, px) do pooling é exatamente o bloco 2x2 do tile
+  for (int py = 0; py < pool.out_h; ++py) {
+    const int oy = py * 2;
+    for (int px = 0; px < pool.out_w; ++px) {
+      const int ox = px * 2;
+      transformInputTile(conv, input, input_offset, oy - conv.pad_h, ox - conv.pad_w, v);
+      int8_t* out = output + (py * pool.out_w + px) * conv.out_c;
+      for (int oc0 = 0; oc0 < conv.out_c; oc0 += kWinogradLanes) {
+        int32_t y[2][2][kWinogradLanes];
+        tileOutput(u + (size_t)oc0 * 16 * conv.in_c, v, conv.in_c, y);
+        for (int k = 0; k < kWinogradLanes; ++k) {
+          const int oc = oc0 + k;
+          const int32_t b = bias ? bias[oc] : 0;
+          int32_t m = rq.act_min;
+          for (int i = 0; i < 2 && oy + i < conv.out_h; ++i) {
+            for (int j = 0; j < 2 && ox + j < conv.out_w; ++j) {
+              const int32_t q = requantize(b + y[i][j][k], rq, oc);
+              if (q > m) m = q;
+            }
+          }
+          out[oc] = (int8_t)m;
+        }
+      }
+    }
+  }
+}
@@ -0,0 +1,57 @@
+/*
+ * SPRINT 3 - Conv2D 3x3 INT8 por Winograd F(2x2, 3x3)
+ * ===================================================
+ *
+ * Cada bloco 2x2 da saída sai de um tile 4x4 da entrada com 16
+ * multiplicações por par de canais, em vez das 36 da convolução
+ * direta (2,25x menos MACs):
+ *
+ *   Y = A^T [ (G g G^T) (.) (B^T d B) ] A
+ *
+ * A matriz G tem fatores 1/2; aqui ela é usada escalada por 2
+ * (G' = 2G), então U = G' g G'^T é inteira (|U| <= 9 * 128, int16) e
+ * a saída sai multiplicada por 4 exatamente. A entrada já somada ao
+ * offset (|d| <= 255) é transformada para int16 (|V| <= 1020) e os
+ * produtos acumulam em int32. Com essa precisão alargada o resultado
+ * é a soma inteira exata da convolução direta: depois de dividir por
+ * 4 e requantizar, a saída é idêntica à de conv2dInt8 (a tolerância
+ * de um passo de quantização conferida por host_winograd fica em 0).
+ *
+ * Os pesos transformados (16 x out_c x in_c int16, 3,6x os pesos int8)
+ * são gerados uma vez em Int8Engine::begin para as camadas escolhidas
+ * com setWinograd(). O MaxPool 2x2/2 fundido coincide com o bloco 2x2
+ * de saída, então cada tile produz direto um pixel do pooling.
+ *
+ * Autor: Equipe SPRINT 3
+ * Data: 2025
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "int8_kernels.h"
+
+// Canais de saída processados juntos (out_c deve ser múltiplo)
+static const int kWinogradLanes = 8;
+// Maior in_c aceito (tile transformado de 16 x in_c int16 na pilha)
+static const int kWinogradMaxInputChannels = 64;
+
+// Conv2D 3x3 stride 1 atendida; pool != nullptr exige MaxPool 2x2 stride 2
+bool winogradSupported(const ConvShape& conv, const ConvShape* pool);
+
+// Bytes dos pesos transformados: 16 x out_c x in_c int16
+size_t winogradWeightBytes(const ConvShape& s);
+
+// Pesos OHWI int8 -> U = G' g G'^T no layout
+// [out_c / kWinogradLanes][16][in_c][kWinogradLanes]
+void winogradTransformWeights(const ConvShape& s, const int8_t* filter, int16_t* u);
+
+void conv2dWinogradInt8(const ConvShape& s, const int8_t* input, int32_t input_offset,
+                        const int16_t* u, const int32_t* bias, const RequantParams& rq,
+                        int8_t* output);
+
+void conv2dMaxPoolWinogradInt8(const ConvShape& conv, const ConvShape& pool, const int8_t* input,
+                               int32_t input_offset, const int16_t* u, const int32_t* bias,
+                               const RequantParams& rq, int8_t* output);
@@ -0,0 +1,116 @@
+/*
+ * SPRINT 3 - Pool de Buffers do Pré-processamento
+ * ===============================================
+ *
+ * Autor: Equipe SPRINT 3
+ * Data: 2025
+ */
+
+#include "buffer_pool.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(ESP_PLATFORM)
+#include <esp_heap_caps.h>
+#endif
+
+// Aloca no tipo pedido; PSRAM ausente cai para a interna (memory recebe onde ficou)
+static uint8_t* poolAlloc(size_t size, PoolMemory* memory) {
+#if defined(ESP_PLATFORM)
+  if (*memory == kPoolPsram) {
+    uint8_t* data = (uint8_t*)heap_caps_malloc(size, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    if (data) return data;
+    *memory = kPoolInternal;
+  }
+  return (uint8_t*)heap_caps_malloc(size, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+#else
+  return (uint8_t*)malloc(size);
+#endif
+}
+
+static void poolFree(void* data) {
+#if defined(ESP_PLATFORM)
+  heap_caps_free(data);
+#else
+  free(data);
+#endif
+}
+
+BufferPool::BufferPool() : num_slots_(0) { memset(&stats_, 0, sizeof(stats_)); }
+
+BufferPool::~BufferPool() { clear(); }
+
+bool BufferPool::reserve(PoolMemory memory, size_t size, int count) {
+  for (int i = 0; i < count; ++i) {
+    if (num_slots_ >= kBufferPoolMaxSlots) return false;
+    Slot& slot = slots_[num_slots_];
+    slot.requested = slot.memory = memory;
+    slot.data = poolAlloc(size, &slot.memory);
+    if (!slot.data) return false;
+    slot.size = size;
+    slot.busy = false;
+    ++num_slots_;
+  }
+  return true;
+}
+
+void BufferPool::clear() {
+  for (int i = 0; i < num_slots_; ++i) poolFree(slots_[i].data);
+  num_slots_ = 0;
+}
+
+void* BufferPool::borrow(size_t size, PoolMemory memory) {
+  if (size == 0) return nullptr;
+  // Menor buffer livre que caiba: um pedido pequeno não prende o do frame
+  Slot* best = nullptr;
+  for (int i = 0; i < num_slots_; ++i) {
+    Slot& slot = slots_[i];
+    if (slot.busy || slot.size < size || slot.requested != memory) continue;
+    if (!best || slot.size < best->size) best = &slot;
+  }
+  uint8_t* data = nullptr;
+  if (best) {
+    best->busy = true;
+    data = best->data;
+    ++stats_.hits;
+  } else {
+    data = poolAlloc(size, &memory);
+    if (!data) return nullptr;
+    ++stats_.misses;
+  }
+  if (++stats_.in_use > stats_.peak_in_use) stats_.peak_in_use = stats_.in_use;
+  return data;
+}
+
+void BufferPool::release(void* data) {
+  if (!data) return;
+  if (stats_.in_use > 0) --stats_.in_use;
+  for (int i = 0; i < num_slots_; ++i) {
+    if (slots_[i].data == data) {
+      slots_[i].busy = false;
+      return;
+    }
+  }
+  poolFree(data);   // Veio de um miss
+}
+
+float BufferPool::hitRate() const {
+  const uint32_t total = stats_.hits + stats_.misses;
+  return total ? (float)stats_.hits / total : 0.0f;
+}
+
+// Mantém os empréstimos em aberto (serão devolvidos depois)
+void BufferPool::resetStats() {
+  const uint32_t in_use = stats_.in_use;
+  memset(&stats_, 0, sizeof(stats_));
+  stats_.in_use = stats_.peak_in_use = in_use;
+}
+
+size_t BufferPool::reservedBytes(PoolMemory memory) const {
+  size_t total = 0;
+  for (int i = 0; i < num_slots_; ++i) {
+    if (slots_[i].memory == memory) total += slots_[i].size;
+  }
+  return total;
+}
@@ -0,0 +1,104 @@
+/*
+ * SPRINT 3 - Pool de Buffers do Pré-processamento
+ * ===============================================
+ *
+ * Buffers pré-alocados no boot que as etapas por frame (decodificação
+ * JPEG, média por área da entrada, características) pegam emprestados
+ * e devolvem, sem malloc/free por frame: o heap fica estável mesmo com
+ * streaming contínuo e não fragmenta entre a arena e o WiFi.
+ *
+ * Cada buffer tem um tipo de memória:
+ *
+ *   - kPoolInternal: SRAM interna, para o que é tocado a cada pixel
+ *     (linhas acumuladas do InputAreaStream, tabelas do TJpgDec);
+ *   - kPoolPsram: PSRAM, para buffers do tamanho do frame (cai para a
+ *     interna se a placa não tiver PSRAM).
+ *
+ * borrow devolve o menor buffer livre do tipo pedido que caiba (hit).
+ * Sem nenhum, aloca do heap (miss) e o release libera: o frame segue,
+ * e o contador de misses indica o que reservar no boot.
+ *
+ * Autor: Equipe SPRINT 3
+ * Data: 2025
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+static const int kBufferPoolMaxSlots = 8;
+
+enum PoolMemory : uint8_t {
+  kPoolInternal = 0,
+  kPoolPsram
+};
+
+struct PoolStats {
+  uint32_t hits;           // Empréstimos atendidos por buffer reservado
+  uint32_t misses;         // Empréstimos que foram ao heap
+  uint32_t in_use;         // Empréstimos ainda não devolvidos
+  uint32_t peak_in_use;
+};
+
+class BufferPool {
+ public:
+  BufferPool();
+  ~BufferPool();
+
+  // Reserva count buffers de size bytes (no boot); false se faltar memória
+  bool reserve(PoolMemory memory, size_t size, int count);
+  // Libera todos os buffers reservados (nenhum pode estar emprestado)
+  void clear();
+
+  // Empresta um buffer >= size; nullptr só se nem o heap tiver memória.
+  // size 0 devolve nullptr sem contar (etapa que não precisa do buffer)
+  void* borrow(size_t size, PoolMemory memory);
+  void release(void* data);
+
+  const PoolStats& stats() const { return stats_; }
+  float hitRate() const;
+  void resetStats();
+  int slotCount() const { return num_slots_; }
+  // Bytes reservados de cada tipo (PSRAM ausente conta como interna)
+  size_t reservedBytes(PoolMemory memory) const;
+
+ private:
+  BufferPool(const BufferPool&);
+  BufferPool& operator=(const BufferPool&);
+
+  struct Slot {
+    uint8_t* data;
+    size_t size;
+    PoolMemory requested;  // Tipo pedido no reserve (casa com o borrow)
+    PoolMemory memory;     // Onde de fato foi alocado
+    bool busy;
+  };
+
+  Slot slots_[kBufferPoolMaxSlots];
+  int num_slots_;
+  PoolStats stats_;
+};
+
+// Empréstimo com devolução automática no fim do escopo
+class PoolLease {
+ public:
+  PoolLease(BufferPool& pool, size_t size, PoolMemory memory)
+      : pool_(pool), data_(pool.borrow(size, memory)) {}
+  ~PoolLease() {
+    if (data_) pool_.release(data_);
+  }
+
+  void* data() const { return data_; }
+  template <typename T>
+  T* as() const {
+    return (T*)data_;
+  }
+
+ private:
+  PoolLease(const PoolLease&);
+  PoolLease& operator=(const PoolLease&);
+
+  BufferPool& pool_;
+  void* data_;
+};
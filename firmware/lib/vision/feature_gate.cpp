@@ -0,0 +1,83 @@
+/*
+ * SPRINT 3 - Gate de Rejeição Antecipada por Características
+ * ==========================================================
+ *
+ * Autor: Equipe SPRINT 3
+ * Data: 2025
+ */
+
+#include "feature_gate.h"
+
+#include <math.h>
+#include <string.h>
+
+FeatureGate::FeatureGate() : config_(defaultConfig()), num_profiles_(0) {
+  resetStats();
+}
+
+GateConfig FeatureGate::defaultConfig() {
+  GateConfig config;
+  config.min_brightness = 0.06f;
+  config.max_brightness = 0.97f;
+  config.max_texture = 0.985f;   // JPEG < 1,5% do RGB888: praticamente uma cor só
+  config.reject_distance = 0.50f;
+  return config;
+}
+
+bool FeatureGate::addProfile(const float* center) {
+  if (num_profiles_ >= kGateMaxProfiles) return false;
+  memcpy(profiles_[num_profiles_++], center, sizeof(float) * kGateFeatures);
+  return true;
+}
+
+GateDecision FeatureGate::evaluate(const float* features, float* distance) {
+  ++stats_.frames;
+  float nearest = -1.0f;
+  for (int p = 0; p < num_profiles_; ++p) {
+    float d2 = 0.0f;
+    for (int i = 0; i < kGateFeatures; ++i) {
+      const float diff = features[i] - profiles_[p][i];
+      d2 += diff * diff;
+    }
+    const float d = sqrtf(d2);
+    if (nearest < 0.0f || d < nearest) nearest = d;
+  }
+  if (distance) *distance = nearest;
+
+  GateDecision decision = kGateRunModel;
+  const float brightness = features[kFeatBrightness];
+  if (brightness < config_.min_brightness || brightness > config_.max_brightness ||
+      features[kFeatTexture] > config_.max_texture) {
+    decision = kGateEmptyScene;
+    ++stats_.empty_scenes;
+  } else if (nearest > config_.reject_distance) {
+    decision = kGateFarFromProfiles;
+    ++stats_.far_frames;
+  }
+  return decision;
+}
+
+void FeatureGate::recordModelRun(float elapsed_ms) {
+  ++stats_.model_runs;
+  stats_.avg_model_ms += (elapsed_ms - stats_.avg_model_ms) / stats_.model_runs;
+}
+
+float FeatureGate::hitRate() const {
+  if (stats_.frames == 0) return 0.0f;
+  return (float)(stats_.empty_scenes + stats_.far_frames) / stats_.frames;
+}
+
+float FeatureGate::savedMs() const {
+  return (float)(stats_.empty_scenes + stats_.far_frames) * stats_.avg_model_ms;
+}
+
+void FeatureGate::resetStats() { memset(&stats_, 0, sizeof(stats_)); }
+
+const char* FeatureGate::decisionName(GateDecision decision) {
+  switch (decision) {
+    case kGateRunModel: return "cnn";
+    case kGateEmptyScene: return "cena_vazia";
+    case kGateFarFromProfiles: return "fora_do_perfil";
+  }
+  return "?";
+}
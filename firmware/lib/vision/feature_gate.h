@@ -0,0 +1,93 @@
+/*
+ * SPRINT 3 - Gate de Rejeição Antecipada por Características
+ * ==========================================================
+ *
+ * Primeiro estágio da cascata de classificação. Usa o vetor barato
+ * de 6 características já calculado por frame (médias R/G/B,
+ * brilho, contraste entre canais e textura pela taxa de compressão)
+ * para decidir se vale a pena executar a CNN:
+ *
+ *   - cena vazia (escura, estourada ou lisa demais): rejeita;
+ *   - longe de todos os perfis de cartucho calibrados: rejeita;
+ *   - caso contrário (ambíguo): executa o modelo INT8.
+ *
+ * Também acumula a taxa de rejeição e a latência economizada,
+ * estimada pela média móvel do tempo real da CNN.
+ *
+ * Autor: Equipe SPRINT 3
+ * Data: 2025
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+static const int kGateFeatures = 6;
+static const int kGateMaxProfiles = 4;
+
+// Índices do vetor de características
+enum GateFeature {
+  kFeatR = 0,
+  kFeatG,
+  kFeatB,
+  kFeatBrightness,
+  kFeatContrast,
+  kFeatTexture
+};
+
+enum GateDecision : uint8_t {
+  kGateRunModel = 0,       // Frame ambíguo: executa a CNN
+  kGateEmptyScene,         // Cena vazia: não há cartucho para classificar
+  kGateFarFromProfiles     // Longe de todos os perfis: NAO_HP sem CNN
+};
+
+struct GateConfig {
+  float min_brightness;    // Abaixo disso a cena é considerada escura/vazia
+  float max_brightness;    // Acima disso a cena está estourada
+  float max_texture;       // Acima disso o JPEG é liso demais (sem objeto)
+  float reject_distance;   // Distância euclidiana a partir da qual rejeita
+};
+
+struct GateStats {
+  uint32_t frames;
+  uint32_t empty_scenes;
+  uint32_t far_frames;
+  uint32_t model_runs;
+  float avg_model_ms;      // Média móvel do tempo real da CNN
+};
+
+class FeatureGate {
+ public:
+  FeatureGate();
+
+  // Valores padrão: THRESH = 0.25 do main_real_advanced -> rejeita a 2 x THRESH
+  static GateConfig defaultConfig();
+  void setConfig(const GateConfig& config) { config_ = config; }
+  const GateConfig& config() const { return config_; }
+
+  void clearProfiles() { num_profiles_ = 0; }
+  bool addProfile(const float* center);
+  int profileCount() const { return num_profiles_; }
+  const float* profile(int index) const { return profiles_[index]; }
+
+  // Classifica o frame; distance recebe a distância ao perfil mais próximo
+  // (-1 sem perfis)
+  GateDecision evaluate(const float* features, float* distance);
+
+  // Registra uma execução real da CNN (ms) para a estimativa de economia
+  void recordModelRun(float elapsed_ms);
+
+  const GateStats& stats() const { return stats_; }
+  float hitRate() const;
+  // Latência economizada: frames rejeitados x tempo médio da CNN
+  float savedMs() const;
+  void resetStats();
+
+  static const char* decisionName(GateDecision decision);
+
+ private:
+  GateConfig config_;
+  float profiles_[kGateMaxProfiles][kGateFeatures];
+  int num_profiles_;
+  GateStats stats_;
+};
@@ -0,0 +1,299 @@
+/*
+ * SPRINT 3 - Estatísticas da Imagem em Uma Passada
+ * ================================================
+ *
+ * Autor: Equipe SPRINT 3
+ * Data: 2025
+ */
+
+#include "image_stats.h"
+
+#include <math.h>
+#include <string.h>
+
+#include "input_preprocess.h"
+
+#if defined(ESP_PLATFORM)
+#include "sdkconfig.h"
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+// Acumuladores de uma linha em 32 bits (linhas de até 16K pixels: 2 x 255² x
+// 16K < 2^32), somados aos de 64 bits no fim da linha
+struct RowAcc {
+  uint32_t luma;
+  uint32_t luma_sq;
+  uint32_t grad;
+};
+
+static inline uint8_t rgbLuma(uint32_t r, uint32_t g, uint32_t b) {
+  return (uint8_t)((r * 19595 + g * 38470 + b * 7471 + 0x8000) >> 16);
+}
+
+// Laço escalar: pixels [i, n) da soma/quadrados e do gradiente com o de cima,
+// pares [j, n) do gradiente com o da esquerda
+static void lumaTail(const uint8_t* y, const uint8_t* up, int i, int j, int n, RowAcc* acc) {
+  for (int k = i; k < n; ++k) {
+    acc->luma += y[k];
+    acc->luma_sq += (uint32_t)(y[k] * y[k]);
+    if (up) acc->grad += (uint32_t)((y[k] - up[k]) * (y[k] - up[k]));
+  }
+  for (int k = j; k < n; ++k) acc->grad += (uint32_t)((y[k] - y[k - 1]) * (y[k] - y[k - 1]));
+}
+
+#if defined(CONFIG_IDF_TARGET_ESP32S3)
+
+static const uint8_t kOnes[16] __attribute__((aligned(16))) = {
+  1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1
+};
+
+// Σ y e Σ y² de blocks x 16 bytes alinhados: EE.VMULAS.U8.ACCX com um vetor
+// de uns e com o próprio vetor
+__attribute__((noinline))
+static void lumaSumsPie(const uint8_t* y, int blocks, uint32_t* sum, uint32_t* sq) {
+  const uint8_t* p = y;
+  const uint8_t* ones = kOnes;
+  const int32_t zero = 0;
+  int count = blocks;
+  int32_t s1 = 0, s2 = 0;
+  asm volatile(
+      "ee.vld.128.ip q1, %[ones], 0\n"
+      "ee.zero.accx\n"
+      "1:\n"
+      "ee.vld.128.ip q0, %[p], 16\n"
+      "addi %[count], %[count], -1\n"
+      "ee.vmulas.u8.accx q0, q1\n"
+      "bnez %[count], 1b\n"
+      "ee.srs.accx %[s1], %[zero], 0\n"
+      : [s1] "=r"(s1), [p] "+r"(p), [count] "+r"(count), [ones] "+r"(ones)
+      : [zero] "r"(zero)
+      : "memory");
+  p = y;
+  count = blocks;
+  asm volatile(
+      "ee.zero.accx\n"
+      "1:\n"
+      "ee.vld.128.ip q0, %[p], 16\n"
+      "addi %[count], %[count], -1\n"
+      "ee.vmulas.u8.accx q0, q0\n"
+      "bnez %[count], 1b\n"
+      "ee.srs.accx %[s2], %[zero], 0\n"
+      : [s2] "=r"(s2), [p] "+r"(p), [count] "+r"(count)
+      : [zero] "r"(zero)
+      : "memory");
+  *sum += (uint32_t)s1;
+  *sq += (uint32_t)s2;
+}
+
+// Somas pelo PIE (linha alinhada a 16 bytes); gradiente escalar, sem
+// subtração de 8 bits sem saturação no PIE
+static void lumaRowAcc(const uint8_t* y, const uint8_t* up, int n, RowAcc* acc) {
+  const int blocks = n >> 4;
+  int i = 0;
+  if (blocks > 0 && ((uintptr_t)y & 15) == 0) {
+    lumaSumsPie(y, blocks, &acc->luma, &acc->luma_sq);
+    i = blocks << 4;
+    if (up) {
+      for (int k = 0; k < i; ++k) acc->grad += (uint32_t)((y[k] - up[k]) * (y[k] - up[k]));
+    }
+  }
+  lumaTail(y, up, i, 1, n, acc);
+}
+
+#elif defined(__SSE2__)
+
+static inline uint32_t hsum32(__m128i v) {
+  v = _mm_add_epi32(v, _mm_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2)));
+  v = _mm_add_epi32(v, _mm_shuffle_epi32(v, _MM_SHUFFLE(2, 3, 0, 1)));
+  return (uint32_t)_mm_cvtsi128_si32(v);
+}
+
+// Σ (a - b)² de 16 bytes em 4 somas de 32 bits
+static inline __m128i sqDiff16(__m128i a, __m128i b) {
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i lo = _mm_sub_epi16(_mm_unpacklo_epi8(a, zero), _mm_unpacklo_epi8(b, zero));
+  const __m128i hi = _mm_sub_epi16(_mm_unpackhi_epi8(a, zero), _mm_unpackhi_epi8(b, zero));
+  return _mm_add_epi32(_mm_madd_epi16(lo, lo), _mm_madd_epi16(hi, hi));
+}
+
+// 16 pixels por iteração: soma por SAD, quadrados e gradiente por madd de 16 bits
+static void lumaRowAcc(const uint8_t* y, const uint8_t* up, int n, RowAcc* acc) {
+  const __m128i zero = _mm_setzero_si128();
+  __m128i sum = zero, sq = zero, grad = zero;
+  int i = 0;
+  for (; i + 16 <= n; i += 16) {
+    const __m128i v = _mm_loadu_si128((const __m128i*)(y + i));
+    sum = _mm_add_epi32(sum, _mm_sad_epu8(v, zero));
+    sq = _mm_add_epi32(sq, sqDiff16(v, zero));
+    if (up) grad = _mm_add_epi32(grad, sqDiff16(v, _mm_loadu_si128((const __m128i*)(up + i))));
+  }
+  int j = 1;
+  for (; j + 16 <= n; j += 16) {
+    grad = _mm_add_epi32(grad, sqDiff16(_mm_loadu_si128((const __m128i*)(y + j)),
+                                        _mm_loadu_si128((const __m128i*)(y + j - 1))));
+  }
+  acc->luma += hsum32(sum);
+  acc->luma_sq += hsum32(sq);
+  acc->grad += hsum32(grad);
+  lumaTail(y, up, i, j, n, acc);
+}
+
+#else
+
+static void lumaRowAcc(const uint8_t* y, const uint8_t* up, int n, RowAcc* acc) {
+  lumaTail(y, up, 0, 1, n, acc);
+}
+
+#endif
+
+// Núcleo comum: linha de luminância já convertida (up = a de cima ou nullptr)
+static void addLumaRow(ImageStats* stats, const uint8_t* y, const uint8_t* up, int n) {
+  if (n <= 0) return;
+  RowAcc acc = { 0, 0, 0 };
+  lumaRowAcc(y, up, n, &acc);
+  uint32_t* hist = stats->hist[kStatsY];
+  for (int i = 0; i < n; ++i) ++hist[y[i] >> kStatsBinShift];
+  stats->luma_sum += acc.luma;
+  stats->luma_sq_sum += acc.luma_sq;
+  stats->grad_energy += acc.grad;
+  stats->grad_pairs += (uint32_t)(n - 1 + (up ? n : 0));
+  stats->pixels += (uint32_t)n;
+}
+
+void imageStatsReset(ImageStats* stats) { memset(stats, 0, sizeof(*stats)); }
+
+void imageStatsAddLuma(ImageStats* stats, const uint8_t* row, const uint8_t* prev, int n) {
+  addLumaRow(stats, row, prev, n);
+}
+
+void imageStatsAddRgb888(ImageStats* stats, const uint8_t* row, const uint8_t* prev, int n,
+                         uint8_t* luma) {
+  uint32_t r_sum = 0, g_sum = 0, b_sum = 0;
+  for (int i = 0; i < n; ++i, row += 3) {
+    const uint32_t r = row[0], g = row[1], b = row[2];
+    r_sum += r;
+    g_sum += g;
+    b_sum += b;
+    ++stats->hist[kStatsR][r >> kStatsBinShift];
+    ++stats->hist[kStatsG][g >> kStatsBinShift];
+    ++stats->hist[kStatsB][b >> kStatsBinShift];
+    luma[i] = rgbLuma(r, g, b);
+  }
+  stats->sum[0] += r_sum;
+  stats->sum[1] += g_sum;
+  stats->sum[2] += b_sum;
+  stats->color_pixels += (uint32_t)n;
+  addLumaRow(stats, luma, prev, n);
+}
+
+void imageStatsAddRgb565(ImageStats* stats, const uint8_t* row, const uint8_t* prev, int n,
+                         uint8_t* luma) {
+  uint32_t r_sum = 0, g_sum = 0, b_sum = 0;
+  for (int i = 0; i < n; ++i, row += 2) {
+    // Mesma expansão 5/6 bits -> 8 bits do rgb565Luma (entrada da CNN)
+    const uint32_t r5 = row[0] >> 3;
+    const uint32_t g6 = ((row[0] & 0x07) << 3) | (row[1] >> 5);
+    const uint32_t b5 = row[1] & 0x1F;
+    const uint32_t r = (r5 << 3) | (r5 >> 2);
+    const uint32_t g = (g6 << 2) | (g6 >> 4);
+    const uint32_t b = (b5 << 3) | (b5 >> 2);
+    r_sum += r;
+    g_sum += g;
+    b_sum += b;
+    ++stats->hist[kStatsR][r >> kStatsBinShift];
+    ++stats->hist[kStatsG][g >> kStatsBinShift];
+    ++stats->hist[kStatsB][b >> kStatsBinShift];
+    luma[i] = rgb565Luma(row[0], row[1]);
+  }
+  stats->sum[0] += r_sum;
+  stats->sum[1] += g_sum;
+  stats->sum[2] += b_sum;
+  stats->color_pixels += (uint32_t)n;
+  addLumaRow(stats, luma, prev, n);
+}
+
+void imageStatsAddYuv422(ImageStats* stats, const uint8_t* row, const uint8_t* prev, int n,
+                         uint8_t* luma) {
+  uint32_t u_sum = 0, v_sum = 0;
+  for (int i = 0; i < n; ++i) luma[i] = row[2 * i];
+  for (int i = 0; i + 1 < n; i += 2) {
+    u_sum += row[2 * i + 1];
+    v_sum += row[2 * i + 3];
+  }
+  stats->chroma_sum[0] += u_sum;
+  stats->chroma_sum[1] += v_sum;
+  stats->chroma_samples += (uint32_t)(n / 2);
+  addLumaRow(stats, luma, prev, n);
+}
+
+void imageStatsFinishYuv422(ImageStats* stats) {
+  if (!stats->chroma_samples) return;
+  const float cb = (float)stats->chroma_sum[0] / stats->chroma_samples - 128.0f;
+  const float cr = (float)stats->chroma_sum[1] / stats->chroma_samples - 128.0f;
+  imageStatsColorFromChroma(stats, cb, cr);
+}
+
+static inline float clampByte(float v) { return v < 0.0f ? 0.0f : (v > 255.0f ? 255.0f : v); }
+
+void imageStatsColorFromChroma(ImageStats* stats, float cb, float cr) {
+  const float y_avg = imageStatsLumaMean(*stats);
+  const float n = (float)stats->pixels;
+  stats->sum[0] = (uint64_t)(clampByte(y_avg + 1.402f * cr) * n + 0.5f);
+  stats->sum[1] = (uint64_t)(clampByte(y_avg - 0.344f * cb - 0.714f * cr) * n + 0.5f);
+  stats->sum[2] = (uint64_t)(clampByte(y_avg + 1.772f * cb) * n + 0.5f);
+  stats->color_pixels = stats->pixels;
+}
+
+void imageStatsFeatures(const ImageStats& stats, size_t jpeg_len, int width, int height,
+                        float* features) {
+  const float count = stats.color_pixels ? (float)stats.color_pixels : 1.0f;
+  const float r_avg = stats.sum[0] / count;
+  const float g_avg = stats.sum[1] / count;
+  const float b_avg = stats.sum[2] / count;
+  features[kFeatR] = r_avg / 255.0f;
+  features[kFeatG] = g_avg / 255.0f;
+  features[kFeatB] = b_avg / 255.0f;
+  features[kFeatBrightness] = (0.299f * r_avg + 0.587f * g_avg + 0.114f * b_avg) / 255.0f;
+  features[kFeatContrast] =
+      (fabsf(r_avg - g_avg) + fabsf(g_avg - b_avg) + fabsf(b_avg - r_avg)) / (3.0f * 255.0f);
+  if (jpeg_len > 0) {
+    features[kFeatTexture] = 1.0f - (float)jpeg_len / (width * height * 3.0f);
+  } else {
+    features[kFeatTexture] = 1.0f - sqrtf(imageStatsGradientEnergy(stats)) / 255.0f;
+  }
+}
+
+float imageStatsLumaMean(const ImageStats& stats) {
+  return stats.pixels ? (float)stats.luma_sum / stats.pixels : 0.0f;
+}
+
+float imageStatsLumaStd(const ImageStats& stats) {
+  if (!stats.pixels) return 0.0f;
+  const double mean = (double)stats.luma_sum / stats.pixels;
+  const double var = (double)stats.luma_sq_sum / stats.pixels - mean * mean;
+  return var > 0.0 ? (float)sqrt(var) : 0.0f;
+}
+
+float imageStatsGradientEnergy(const ImageStats& stats) {
+  return stats.grad_pairs ? (float)stats.grad_energy / stats.grad_pairs : 0.0f;
+}
+
+// =============================================================================
+// WELFORD
+// =============================================================================
+
+void welfordReset(FeatureWelford* w) { memset(w, 0, sizeof(*w)); }
+
+void welfordAdd(FeatureWelford* w, const float* features) {
+  ++w->count;
+  for (int i = 0; i < kGateFeatures; ++i) {
+    const float delta = features[i] - w->mean[i];
+    w->mean[i] += delta / w->count;
+    w->m2[i] += delta * (features[i] - w->mean[i]);
+  }
+}
+
+float welfordStd(const FeatureWelford& w, int i) {
+  return w.count > 1 ? sqrtf(w.m2[i] / (w.count - 1)) : 0.0f;
+}
@@ -0,0 +1,113 @@
+/*
+ * SPRINT 3 - Estatísticas da Imagem em Uma Passada
+ * ================================================
+ *
+ * Núcleo único das características usado pela classificação
+ * (analyzeRealCharacteristics), pela calibração (/calibrate) e pelas
+ * ferramentas do host. Cada linha de pixels é lida uma vez: a conversão
+ * acumula as somas e os histogramas de R/G/B e escreve a linha de
+ * luminância (PIL "L"), que segue para o stream da entrada da CNN e
+ * para o núcleo comum de luminância:
+ *
+ *   - soma e soma dos quadrados (variância);
+ *   - histograma de 16 faixas de Y;
+ *   - energia do gradiente, (dx² + dy²) entre vizinhos da linha e da
+ *     linha de cima (prev: a luminância que a chamada anterior
+ *     escreveu, então cada pixel é convertido uma vez só).
+ *
+ * O núcleo usa SSE2 no host (16 pixels por iteração) e o PIE do
+ * ESP32-S3 nas somas (linhas alinhadas a 16 bytes); o resto é escalar,
+ * com os mesmos acumuladores exatos.
+ *
+ * Origens: luminância decodificada (jpegScaledDecodeLuma), RGB888
+ * (TJpgDec colorido), RGB565 big-endian e YUV422 do esp32-camera. Nas
+ * origens só de luminância (JPEG luma, YUV422) as médias R/G/B vêm das
+ * médias de croma e os histogramas R/G/B ficam vazios. Na
+ * decodificação JPEG os blocos chegam por MCU, então os pares de
+ * vizinhos são os de dentro de cada bloco entregue.
+ *
+ * A calibração acumula o vetor de 6 características com Welford
+ * (média e variância incrementais, sem guardar as amostras).
+ *
+ * Autor: Equipe SPRINT 3
+ * Data: 2025
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "feature_gate.h"
+
+static const int kStatsBins = 16;    // 256 níveis / 16 por faixa
+static const int kStatsBinShift = 4;
+
+enum StatsChannel {
+  kStatsR = 0,
+  kStatsG,
+  kStatsB,
+  kStatsY,
+  kStatsChannels
+};
+
+struct ImageStats {
+  uint64_t sum[3];          // R, G, B (só origens coloridas)
+  uint64_t luma_sum;
+  uint64_t luma_sq_sum;
+  uint64_t grad_energy;     // Σ dx² + dy² da luminância
+  uint32_t grad_pairs;
+  uint32_t pixels;          // Pixels de luminância
+  uint32_t color_pixels;    // Pixels que entraram em sum[] e nos histogramas R/G/B
+  uint64_t chroma_sum[2];   // U (Cb), V (Cr) com offset 128 (origem YUV422)
+  uint32_t chroma_samples;  // Pares Y0 U Y1 V somados em chroma_sum
+  uint32_t hist[kStatsChannels][kStatsBins];
+};
+
+void imageStatsReset(ImageStats* stats);
+
+// Linha de n pixels de luminância; prev = luminância da linha de cima (nullptr: sem)
+void imageStatsAddLuma(ImageStats* stats, const uint8_t* row, const uint8_t* prev, int n);
+
+// Linha RGB888; luma recebe os n pixels de luminância, passados como prev
+// na linha seguinte
+void imageStatsAddRgb888(ImageStats* stats, const uint8_t* row, const uint8_t* prev, int n,
+                         uint8_t* luma);
+
+// Linha RGB565 big-endian (esp32-camera); prev/luma como acima
+void imageStatsAddRgb565(ImageStats* stats, const uint8_t* row, const uint8_t* prev, int n,
+                         uint8_t* luma);
+
+// Linha YUV422 Y0 U Y1 V (PIXFORMAT_YUV422): Y direto dos bytes pares, sem
+// conversão; U/V só somados (imageStatsFinishYuv422 dá as médias R/G/B).
+// prev/luma como acima
+void imageStatsAddYuv422(ImageStats* stats, const uint8_t* row, const uint8_t* prev, int n,
+                         uint8_t* luma);
+void imageStatsFinishYuv422(ImageStats* stats);
+
+// Médias R/G/B pela conversão YCbCr -> RGB da média Y e das médias Cb/Cr
+// (centradas em 0), para origens sem RGB por pixel
+void imageStatsColorFromChroma(ImageStats* stats, float cb, float cr);
+
+// Vetor de 6 características (ver GateFeature). A textura é a taxa de
+// compressão do JPEG (width x height = tamanho original do frame); sem JPEG
+// (jpeg_len = 0) usa 1 - RMS do gradiente / 255
+void imageStatsFeatures(const ImageStats& stats, size_t jpeg_len, int width, int height,
+                        float* features);
+
+float imageStatsLumaMean(const ImageStats& stats);
+float imageStatsLumaStd(const ImageStats& stats);
+// Média de dx² + dy² por par de vizinhos, em níveis de cinza²
+float imageStatsGradientEnergy(const ImageStats& stats);
+
+// Média e variância incrementais (Welford) do vetor de características
+struct FeatureWelford {
+  uint32_t count;
+  float mean[kGateFeatures];
+  float m2[kGateFeatures];
+};
+
+void welfordReset(FeatureWelford* w);
+void welfordAdd(FeatureWelford* w, const float* features);
+// Desvio padrão amostral da característica i (0 com menos de 2 amostras)
+float welfordStd(const FeatureWelford& w, int i);
@@ -0,0 +1,153 @@
+/*
+ * SPRINT 3 - Decodificação JPEG Reduzida no Domínio DCT
+ * =====================================================
+ *
+ * Autor: Equipe SPRINT 3
+ * Data: 2025
+ */
+
+#include "jpeg_scaled.h"
+
+#include <string.h>
+
+#include "input_preprocess.h"
+#include "tjpgd_luma.h"
+
+// Pixels convertidos por vez para o stream
+static const int kStreamChunk = 64;
+
+void jpegScaledBegin(JpegScaledSink* sink, const uint8_t* jpeg, uint8_t* gray,
+                     size_t gray_capacity) {
+  sink->jpeg = jpeg;
+  sink->gray = gray;
+  sink->gray_capacity = gray ? gray_capacity : 0;
+  sink->stream = nullptr;
+  sink->work = nullptr;
+  sink->work_size = 0;
+  sink->width = 0;
+  sink->height = 0;
+  imageStatsReset(&sink->stats);
+  sink->error = false;
+}
+
+size_t jpegScaledRead(void* arg, size_t index, uint8_t* buf, size_t len) {
+  const JpegScaledSink* sink = (const JpegScaledSink*)arg;
+  if (buf) memcpy(buf, sink->jpeg + index, len);
+  return len;
+}
+
+// Início: tamanho já reduzido
+static bool sinkStart(JpegScaledSink* sink, int w, int h) {
+  sink->width = w;
+  sink->height = h;
+  sink->error = (sink->gray && (size_t)w * h > sink->gray_capacity) ||
+                (sink->stream && (sink->stream->width != w || sink->stream->height != h));
+  return !sink->error;
+}
+
+// Fim: fecha as linhas de saída restantes
+static void sinkEnd(JpegScaledSink* sink) {
+  if (sink->stream) inputAreaStreamFlush(sink->stream, sink->height);
+}
+
+// n pixels de luminância da linha y a partir da coluna x
+static bool sinkLuma(JpegScaledSink* sink, int x, int y, int n, const uint8_t* luma) {
+  if (sink->gray) memcpy(sink->gray + (size_t)y * sink->width + x, luma, n);
+  if (sink->stream && !inputAreaStreamAdd(sink->stream, x, y, n, luma)) {
+    sink->error = true;
+    return false;
+  }
+  return true;
+}
+
+// MCU na borda direita: a faixa de linhas até y + h está completa
+static void sinkBlockDone(JpegScaledSink* sink, int x, int y, int w, int h) {
+  if (sink->stream && x + w >= sink->width) inputAreaStreamFlush(sink->stream, y + h);
+}
+
+bool jpegScaledWrite(void* arg, uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint8_t* data) {
+  JpegScaledSink* sink = (JpegScaledSink*)arg;
+  if (!data) {
+    if (x == 0 && y == 0) return sinkStart(sink, w, h);
+    sinkEnd(sink);
+    return true;
+  }
+
+  // Estatísticas e luminância na mesma passada, em faixas de kStreamChunk
+  // colunas descidas linha a linha: a luminância da linha de cima fica no
+  // outro buffer e serve ao gradiente vertical
+  const size_t stride = (size_t)w * 3;
+  alignas(16) uint8_t chunk[2][kStreamChunk];
+  for (int col0 = 0; col0 < w; col0 += kStreamChunk) {
+    const int n = w - col0 < kStreamChunk ? w - col0 : kStreamChunk;
+    const uint8_t* px = data + col0 * 3;
+    for (int row = 0; row < h; ++row, px += stride) {
+      uint8_t* luma = chunk[row & 1];
+      imageStatsAddRgb888(&sink->stats, px, row > 0 ? chunk[(row & 1) ^ 1] : nullptr, n, luma);
+      if (!sinkLuma(sink, x + col0, y + row, n, luma)) return false;
+    }
+  }
+  sinkBlockDone(sink, x, y, w, h);
+  return true;
+}
+
+// =============================================================================
+// SÓ LUMINÂNCIA (tjpgd_luma)
+// =============================================================================
+
+struct LumaSession {
+  JpegScaledSink* sink;
+  size_t len;
+  size_t index;
+};
+
+static UINT lumaRead(JDECL* jd, BYTE* buf, UINT len) {
+  LumaSession* s = (LumaSession*)jd->device;
+  const size_t left = s->len - s->index;
+  if (len > left) len = (UINT)left;
+  if (buf) memcpy(buf, s->sink->jpeg + s->index, len);
+  s->index += len;
+  return len;
+}
+
+static UINT lumaWrite(JDECL* jd, void* bitmap, JLRECT* rect) {
+  LumaSession* s = (LumaSession*)jd->device;
+  const int w = rect->right + 1 - rect->left;
+  const int h = rect->bottom + 1 - rect->top;
+  const uint8_t* luma = (const uint8_t*)bitmap;
+  for (int row = 0; row < h; ++row, luma += w) {
+    imageStatsAddLuma(&s->sink->stats, luma, row > 0 ? luma - w : nullptr, w);
+    if (!sinkLuma(s->sink, rect->left, rect->top + row, w, luma)) return 0;
+  }
+  sinkBlockDone(s->sink, rect->left, rect->top, w, h);
+  return 1;
+}
+
+bool jpegScaledDecodeLuma(JpegScaledSink* sink, size_t len, int scale) {
+  static uint8_t static_work[kJpegLumaWorkSize];
+  uint8_t* work = sink->work ? sink->work : static_work;
+  const size_t work_size = sink->work ? sink->work_size : sizeof(static_work);
+  JDECL jd;
+  LumaSession s = { sink, len, 0 };
+  if (!sink->jpeg || scale < 0 || scale > kJpegMaxScale) return false;
+  if (jdl_prepare(&jd, lumaRead, work, (UINT)work_size, &s) != JDLR_OK) return false;
+  if (!sinkStart(sink, (int)(jd.width >> scale), (int)(jd.height >> scale))) return false;
+  const JLRESULT res = jdl_decomp(&jd, lumaWrite, (BYTE)scale, 1);
+  sinkEnd(sink);
+  ImageStats& st = sink->stats;
+  if (res != JDLR_OK || sink->error || !st.pixels || !jd.ncdc) return false;
+
+  // Médias R/G/B pela conversão YCbCr -> RGB das médias (Cb/Cr pelo DC)
+  imageStatsColorFromChroma(&st, (float)jd.cdc[0] / (256.0f * jd.ncdc),
+                            (float)jd.cdc[1] / (256.0f * jd.ncdc));
+  return true;
+}
+
+int jpegScaleFor(int width, int height, int min_w, int min_h) {
+  int scale = 0;
+  while (scale < kJpegMaxScale && (width >> (scale + 1)) >= min_w &&
+         (height >> (scale + 1)) >= min_h) {
+    ++scale;
+  }
+  return scale;
+}
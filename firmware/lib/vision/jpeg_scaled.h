@@ -0,0 +1,83 @@
+/*
+ * SPRINT 3 - Decodificação JPEG Reduzida no Domínio DCT
+ * =====================================================
+ *
+ * O TJpgDec (esp_jpg_decode no firmware) reduz a imagem 1/2, 1/4 ou
+ * 1/8 ainda dentro do MCU: em 1/8 a IDCT é omitida e só o coeficiente
+ * DC de cada bloco 8x8 vira pixel; em 1/2 e 1/4 o MCU é reduzido por
+ * média antes da entrega. Este módulo é o jpg_writer_cb que recebe
+ * esses blocos e:
+ *
+ *   - acumula as ImageStats da imagem reduzida na mesma passada
+ *     (vetor de 6 características do gate, imageStatsFeatures);
+ *   - opcionalmente escreve a luminância (PIL "L") num buffer já no
+ *     tamanho reduzido, entrada do Int8Engine::setInputFromGray;
+ *   - ou a entrega, bloco a bloco, a um InputAreaStream
+ *     (Int8Engine::beginInputStream): a média por área para o tensor
+ *     de entrada acontece durante a decodificação, guardando só as
+ *     linhas de saída da faixa de MCUs atual.
+ *
+ * jpegScaledDecodeLuma faz o mesmo com a cópia só-luminância do
+ * TJpgDec (tjpgd_luma.c), já que o modelo é de um canal.
+ *
+ * Sem o buffer RGB888 do frame inteiro (240x240x3 = 172 KB). As
+ * características saem de uma passada em 1/8 (só DC); jpegScaleFor
+ * escolhe a maior redução que ainda cobre a entrada do modelo para a
+ * luminância da CNN.
+ *
+ * Autor: Equipe SPRINT 3
+ * Data: 2025
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "image_stats.h"
+
+struct InputAreaStream;
+
+// Maior redução do TJpgDec (2^3 = 1/8, JPG_SCALE_8X)
+static const int kJpegMaxScale = 3;
+// Memória de trabalho estática do jpegScaledDecodeLuma (tabelas + MCU)
+static const size_t kJpegLumaWorkSize = 4096;
+
+// Mesma assinatura do jpg_writer_cb do esp32-camera: data == nullptr marca
+// o início (x = y = 0, w x h = tamanho reduzido) e o fim da decodificação
+typedef bool (*JpegWriterFn)(void* arg, uint16_t x, uint16_t y, uint16_t w, uint16_t h,
+                             uint8_t* data);
+
+// Sessão de decodificação: origem de jpegScaledRead, destino de jpegScaledWrite
+struct JpegScaledSink {
+  const uint8_t* jpeg;    // Frame JPEG (nullptr se o leitor for outro)
+  uint8_t* gray;          // Luminância width x height (nullptr: só as somas)
+  size_t gray_capacity;   // Bytes disponíveis em gray
+  InputAreaStream* stream;   // Já iniciado no tamanho reduzido (nullptr: sem)
+  uint8_t* work;          // Memória do jpegScaledDecodeLuma (nullptr: a estática)
+  size_t work_size;
+  int width;              // Tamanho reduzido, preenchido no início
+  int height;
+  ImageStats stats;       // Médias, variância, histogramas, gradiente
+  bool error;             // gray pequeno demais ou stream de outro tamanho
+};
+
+// Zera as estatísticas; jpeg e gray podem ser nullptr, stream e work começam nullptr
+void jpegScaledBegin(JpegScaledSink* sink, const uint8_t* jpeg, uint8_t* gray,
+                     size_t gray_capacity);
+
+// jpg_reader_cb: lê de sink->jpeg (buf nullptr = pular bytes)
+size_t jpegScaledRead(void* arg, size_t index, uint8_t* buf, size_t len);
+
+// jpg_writer_cb: recebe blocos RGB888 já reduzidos
+bool jpegScaledWrite(void* arg, uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint8_t* data);
+
+// Decodifica sink->jpeg (len bytes) reduzido por 2^scale só pela luminância
+// (tjpgd_luma): sem IDCT nem dequantização dos blocos Cb/Cr e sem a conversão
+// YCbCr -> RGB. Y vai para gray/stream como no jpegScaledWrite; as somas R/G/B
+// saem do Y médio e das médias de Cb/Cr pelos coeficientes DC (histogramas
+// só de Y)
+bool jpegScaledDecodeLuma(JpegScaledSink* sink, size_t len, int scale);
+
+// Maior escala s (0..3) com (width >> s, height >> s) >= (min_w, min_h)
+int jpegScaleFor(int width, int height, int min_w, int min_h);
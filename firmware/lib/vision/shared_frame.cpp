@@ -0,0 +1,119 @@
+/*
+ * SPRINT 3 - Frames da Câmera Compartilhados por Contagem de Referências
+ * ======================================================================
+ *
+ * Autor: Equipe SPRINT 3
+ * Data: 2025
+ */
+
+#include "shared_frame.h"
+
+#if defined(ESP_PLATFORM)
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#else
+#include <thread>
+#endif
+
+SharedFrameTable::SharedFrameTable(FrameReturnFn return_fn, void* arg)
+    : return_fn_(return_fn),
+      arg_(arg),
+      next_seq_(1),
+      wrapped_(0),
+      returned_(0),
+      table_full_(0),
+      peak_live_(0) {
+  for (int i = 0; i < kSharedFrameSlots; ++i) {
+    slots_[i].frame = nullptr;
+    slots_[i].seq = 0;
+    slots_[i].refs.store(0);
+    slots_[i].table = this;
+  }
+}
+
+SharedFrame* SharedFrameTable::wrap(void* frame) {
+  if (!frame) return nullptr;
+  for (int i = 0; i < kSharedFrameSlots; ++i) {
+    SharedFrame& slot = slots_[i];
+    if (slot.refs.load(std::memory_order_acquire) != 0) continue;
+    // Produtor único: ninguém mais ocupa uma entrada livre
+    slot.frame = frame;
+    slot.seq = next_seq_++;
+    slot.refs.store(1, std::memory_order_release);
+    const uint32_t wrapped = wrapped_.fetch_add(1) + 1;
+    const uint32_t live = wrapped - returned_.load();
+    if (live > peak_live_.load()) peak_live_.store(live);
+    return &slot;
+  }
+  ++table_full_;
+  return_fn_(frame, arg_);
+  return nullptr;
+}
+
+SharedFrameStats SharedFrameTable::stats() const {
+  SharedFrameStats s;
+  s.wrapped = wrapped_.load();
+  s.returned = returned_.load();
+  s.table_full = table_full_.load();
+  s.live = s.wrapped - s.returned;
+  s.peak_live = peak_live_.load();
+  return s;
+}
+
+void sharedFrameRetain(SharedFrame* frame) {
+  // Só quem já segura uma referência retém: a contagem nunca sai de 0 aqui
+  frame->refs.fetch_add(1, std::memory_order_relaxed);
+}
+
+void sharedFrameRelease(SharedFrame* frame) {
+  // O frame é lido antes de soltar: com a contagem em 0 a entrada pode ser
+  // reusada pelo produtor na hora
+  void* data = frame->frame;
+  SharedFrameTable* table = frame->table;
+  if (frame->refs.fetch_sub(1, std::memory_order_acq_rel) != 1) return;
+  table->return_fn_(data, table->arg_);
+  ++table->returned_;
+}
+
+// =============================================================================
+// SNAPSHOT
+// =============================================================================
+
+// Trava ocupada: cede a CPU, para uma tarefa de prioridade menor no mesmo
+// núcleo poder terminar a troca de ponteiro
+static void lockSnapshot(std::atomic_flag* lock) {
+  while (lock->test_and_set(std::memory_order_acquire)) {
+#if defined(ESP_PLATFORM)
+    vTaskDelay(1);
+#else
+    std::this_thread::yield();
+#endif
+  }
+}
+
+void FrameSnapshot::publish(const FrameRef& frame) {
+  FrameRef next = frame;   // Referência do snapshot
+  SharedFrame* incoming = next.release();
+  lockSnapshot(&lock_);
+  SharedFrame* old = frame_;
+  frame_ = incoming;
+  lock_.clear(std::memory_order_release);
+  // Fora da trava: a devolução ao driver pode demorar
+  if (old) sharedFrameRelease(old);
+}
+
+FrameRef FrameSnapshot::get() {
+  lockSnapshot(&lock_);
+  SharedFrame* frame = frame_;
+  if (frame) sharedFrameRetain(frame);
+  lock_.clear(std::memory_order_release);
+  return FrameRef::adopt(frame);
+}
+
+void FrameSnapshot::clear() {
+  lockSnapshot(&lock_);
+  SharedFrame* old = frame_;
+  frame_ = nullptr;
+  lock_.clear(std::memory_order_release);
+  if (old) sharedFrameRelease(old);
+}
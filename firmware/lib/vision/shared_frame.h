@@ -0,0 +1,150 @@
+/*
+ * SPRINT 3 - Frames da Câmera Compartilhados por Contagem de Referências
+ * ======================================================================
+ *
+ * Uma captura atende todos os consumidores sem cópia: a inferência, o
+ * /capture.jpg, os clientes do /stream e o snapshot do último frame
+ * analisado seguram referências ao mesmo camera_fb_t, e o buffer só
+ * volta ao driver (esp_camera_fb_return) quando a última é solta.
+ *
+ *   - SharedFrameTable: embrulha o frame recém-capturado (1 referência,
+ *     do produtor) e chama a função de devolução quando a contagem
+ *     zera. As entradas são fixas (uma por frame buffer do driver), sem
+ *     alocação por frame;
+ *   - FrameRef: referência RAII; copiar retém, destruir solta. Passa de
+ *     uma tarefa para outra pelo SpscRing como ponteiro cru (release()
+ *     de um lado, FrameRef::adopt() do outro), sem mexer na contagem;
+ *   - FrameSnapshot: o último frame publicado (pela inferência), que
+ *     qualquer tarefa lê com get().
+ *
+ * A contagem é atômica e o frame só é trocado numa entrada livre
+ * (contagem 0), então retain/release não precisam de lock. O snapshot
+ * usa uma trava curta (só a troca de ponteiro), que cede a CPU se ocupada.
+ *
+ * O tipo do frame é opaco (void*): o mesmo código roda no host com
+ * frames simulados. Segurar frames atrasa a captura: com todos os
+ * frame buffers referenciados o driver espera a primeira devolução.
+ *
+ * Autor: Equipe SPRINT 3
+ * Data: 2025
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <atomic>
+
+static const int kSharedFrameSlots = 4;
+
+// Devolve o frame à origem (esp_camera_fb_return no firmware)
+typedef void (*FrameReturnFn)(void* frame, void* arg);
+
+class SharedFrameTable;
+
+struct SharedFrame {
+  void* frame;
+  uint32_t seq;                // Ordem de captura (1, 2, ...)
+  std::atomic<int> refs;       // 0 = entrada livre
+  SharedFrameTable* table;
+};
+
+struct SharedFrameStats {
+  uint32_t wrapped;            // Frames embrulhados
+  uint32_t returned;           // Frames devolvidos à origem
+  uint32_t table_full;         // wrap sem entrada livre (frame devolvido na hora)
+  uint32_t live;               // Frames ainda referenciados
+  uint32_t peak_live;
+};
+
+class SharedFrameTable {
+ public:
+  SharedFrameTable(FrameReturnFn return_fn, void* arg);
+
+  // Frame recém-capturado com 1 referência (do chamador). Sem entrada livre,
+  // devolve o frame na hora e retorna nullptr. Só o produtor chama
+  SharedFrame* wrap(void* frame);
+
+  SharedFrameStats stats() const;
+
+ private:
+  SharedFrameTable(const SharedFrameTable&);
+  SharedFrameTable& operator=(const SharedFrameTable&);
+
+  friend void sharedFrameRelease(SharedFrame* frame);
+
+  SharedFrame slots_[kSharedFrameSlots];
+  FrameReturnFn return_fn_;
+  void* arg_;
+  uint32_t next_seq_;
+  std::atomic<uint32_t> wrapped_;
+  std::atomic<uint32_t> returned_;
+  std::atomic<uint32_t> table_full_;
+  std::atomic<uint32_t> peak_live_;
+};
+
+void sharedFrameRetain(SharedFrame* frame);
+// Solta uma referência; a última devolve o frame à origem
+void sharedFrameRelease(SharedFrame* frame);
+
+// Referência RAII a um SharedFrame (vazia se nullptr)
+class FrameRef {
+ public:
+  FrameRef() : frame_(nullptr) {}
+  FrameRef(const FrameRef& other) : frame_(other.frame_) {
+    if (frame_) sharedFrameRetain(frame_);
+  }
+  FrameRef& operator=(const FrameRef& other) {
+    if (other.frame_) sharedFrameRetain(other.frame_);
+    if (frame_) sharedFrameRelease(frame_);
+    frame_ = other.frame_;
+    return *this;
+  }
+  ~FrameRef() {
+    if (frame_) sharedFrameRelease(frame_);
+  }
+
+  // Assume uma referência já contada (de wrap ou de release())
+  static FrameRef adopt(SharedFrame* frame) {
+    FrameRef ref;
+    ref.frame_ = frame;
+    return ref;
+  }
+  // Entrega a referência sem soltá-la (para passar pelo anel)
+  SharedFrame* release() {
+    SharedFrame* frame = frame_;
+    frame_ = nullptr;
+    return frame;
+  }
+
+  explicit operator bool() const { return frame_ != nullptr; }
+  uint32_t seq() const { return frame_ ? frame_->seq : 0; }
+  template <typename T>
+  T* as() const {
+    return frame_ ? (T*)frame_->frame : nullptr;
+  }
+
+ private:
+  SharedFrame* frame_;
+};
+
+// Último frame publicado, lido por qualquer tarefa
+class FrameSnapshot {
+ public:
+  FrameSnapshot() : frame_(nullptr) { lock_.clear(); }
+  ~FrameSnapshot() { clear(); }
+
+  // Passa a segurar frame; a referência ao anterior é solta
+  void publish(const FrameRef& frame);
+  // Nova referência ao último frame (vazia antes do primeiro publish)
+  FrameRef get();
+  void clear();
+
+ private:
+  FrameSnapshot(const FrameSnapshot&);
+  FrameSnapshot& operator=(const FrameSnapshot&);
+
+  SharedFrame* frame_;
+  std::atomic_flag lock_;
+};
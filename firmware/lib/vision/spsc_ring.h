@@ -0,0 +1,72 @@
+/*
+ * SPRINT 3 - Fila Lock-free Produtor Único / Consumidor Único
+ * ===========================================================
+ *
+ * Anel de N posições (N potência de 2) que passa itens de uma tarefa
+ * produtora para uma consumidora sem mutex nem seção crítica: cada
+ * índice é escrito por um lado só (head pelo produtor, tail pelo
+ * consumidor), e o par release/acquire garante que o item escrito no
+ * anel é visível antes do índice que o publica.
+ *
+ * Usada pelo pipeline de captura: a tarefa da câmera empurra os
+ * SharedFrame* (shared_frame.h), com uma referência cada, e a de
+ * inferência, no outro núcleo, os consome. Os
+ * contadores crescem livremente (uint32_t); head - tail é a ocupação
+ * mesmo depois de darem a volta.
+ *
+ * Nada aqui bloqueia: push/pop devolvem false com o anel cheio/vazio e
+ * quem chama decide se espera (notificação da FreeRTOS no ESP32,
+ * yield no host).
+ *
+ * Autor: Equipe SPRINT 3
+ * Data: 2025
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#include <atomic>
+
+template <typename T, uint32_t N>
+class SpscRing {
+  static_assert(N > 0 && (N & (N - 1)) == 0, "SpscRing: N deve ser potência de 2");
+
+ public:
+  SpscRing() : head_(0), tail_(0) {}
+
+  // Só o produtor: false com o anel cheio
+  bool push(const T& item) {
+    const uint32_t head = head_.load(std::memory_order_relaxed);
+    if (head - tail_.load(std::memory_order_acquire) == N) return false;
+    items_[head & (N - 1)] = item;
+    head_.store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Só o consumidor: false com o anel vazio
+  bool pop(T* item) {
+    const uint32_t tail = tail_.load(std::memory_order_relaxed);
+    if (head_.load(std::memory_order_acquire) == tail) return false;
+    *item = items_[tail & (N - 1)];
+    tail_.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Ocupação vista por qualquer lado (exata só para o dono de um índice)
+  uint32_t size() const {
+    return head_.load(std::memory_order_acquire) - tail_.load(std::memory_order_acquire);
+  }
+  bool empty() const { return size() == 0; }
+  bool full() const { return size() == N; }
+  static uint32_t capacity() { return N; }
+
+ private:
+  SpscRing(const SpscRing&);
+  SpscRing& operator=(const SpscRing&);
+
+  T items_[N];
+  // Em linhas de cache separadas: produtor e consumidor não disputam a linha
+  alignas(64) std::atomic<uint32_t> head_;
+  alignas(64) std::atomic<uint32_t> tail_;
+};
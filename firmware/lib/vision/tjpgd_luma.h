@@ -0,0 +1,106 @@
+/*----------------------------------------------------------------------------/
+/ TJpgDec - Tiny JPEG Decompressor include file               (C)ChaN, 2012
+/----------------------------------------------------------------------------/
+/ SPRINT 3: cópia do TJpgDec R0.01b do esp32-camera com o modo só-luminância
+/ (jdl_decomp(..., luma = 1)), para modelos em tons de cinza. Nomes com
+/ prefixo JDL/jdl para conviver com o TJpgDec da ROM do ESP32.
+/----------------------------------------------------------------------------*/
+#ifndef _TJPGDEC_LUMA
+#define _TJPGDEC_LUMA
+/*---------------------------------------------------------------------------*/
+/* System Configurations */
+
+#define	JDL_SZBUF		512	/* Size of stream input buffer */
+#define JDL_FORMAT		0	/* Output pixel format 0:RGB888 (3 BYTE/pix), 1:RGB565 (1 WORD/pix) */
+#define	JDL_USE_SCALE	1	/* Use descaling feature for output */
+#define JDL_TBLCLIP		1	/* Use table for saturation (might be a bit faster but increases 1K bytes of code size) */
+
+/*---------------------------------------------------------------------------*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* These types must be 16-bit, 32-bit or larger integer */
+typedef int				INT;
+typedef unsigned int	UINT;
+
+/* These types must be 8-bit integer */
+typedef char			CHAR;
+typedef unsigned char	UCHAR;
+typedef unsigned char	BYTE;
+
+/* These types must be 16-bit integer */
+typedef short			SHORT;
+typedef unsigned short	USHORT;
+typedef unsigned short	WORD;
+typedef unsigned short	WCHAR;
+
+/* These types must be 32-bit integer */
+typedef long			LONG;
+typedef unsigned long	ULONG;
+typedef unsigned long	DWORD;
+
+
+/* Error code */
+typedef enum {
+	JDLR_OK = 0,	/* 0: Succeeded */
+	JDLR_INTR,	/* 1: Interrupted by output function */	
+	JDLR_INP,	/* 2: Device error or wrong termination of input stream */
+	JDLR_MEM1,	/* 3: Insufficient memory pool for the image */
+	JDLR_MEM2,	/* 4: Insufficient stream input buffer */
+	JDLR_PAR,	/* 5: Parameter error */
+	JDLR_FMT1,	/* 6: Data format error (may be damaged data) */
+	JDLR_FMT2,	/* 7: Right format but not supported */
+	JDLR_FMT3	/* 8: Not supported JPEG standard */
+} JLRESULT;
+
+
+
+/* Rectangular structure */
+typedef struct {
+	WORD left, right, top, bottom;
+} JLRECT;
+
+
+
+/* Decompressor object structure */
+typedef struct JDECL JDECL;
+struct JDECL {
+	UINT dctr;				/* Number of bytes available in the input buffer */
+	BYTE* dptr;				/* Current data read ptr */
+	BYTE* inbuf;			/* Bit stream input buffer */
+	BYTE dmsk;				/* Current bit in the current read byte */
+	BYTE scale;				/* Output scaling ratio */
+	BYTE msx, msy;			/* MCU size in unit of block (width, height) */
+	BYTE qtid[3];			/* Quantization table ID of each component */
+	SHORT dcv[3];			/* Previous DC element of each component */
+	WORD nrst;				/* Restart inverval */
+	UINT width, height;		/* Size of the input image (pixel) */
+	BYTE* huffbits[2][2];	/* Huffman bit distribution tables [id][dcac] */
+	WORD* huffcode[2][2];	/* Huffman code word tables [id][dcac] */
+	BYTE* huffdata[2][2];	/* Huffman decoded data tables [id][dcac] */
+	LONG* qttbl[4];			/* Dequaitizer tables [id] */
+	void* workbuf;			/* Working buffer for IDCT and RGB output */
+	BYTE* mcubuf;			/* Working buffer for the MCU */
+	void* pool;				/* Pointer to available memory pool */
+	UINT sz_pool;			/* Size of momory pool (bytes available) */
+	UINT (*infunc)(JDECL*, BYTE*, UINT);/* Pointer to jpeg stream input function */
+	void* device;			/* Pointer to I/O device identifiler for the session */
+	BYTE luma;				/* SPRINT 3: 1 = output only Y (1 BYTE/pix), Cb/Cr DC only */
+	LONG cdc[2];			/* SPRINT 3: Sum of Cb/Cr block means (centered at 0) in luma mode */
+	DWORD ncdc;				/* SPRINT 3: Number of MCUs summed into cdc */
+};
+
+
+
+/* TJpgDec API functions */
+JLRESULT jdl_prepare (JDECL*, UINT(*)(JDECL*,BYTE*,UINT), void*, UINT, void*);
+JLRESULT jdl_decomp (JDECL*, UINT(*)(JDECL*,void*,JLRECT*), BYTE, BYTE);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _TJPGDEC_LUMA */
@@ -3,8 +3,14 @@
 #include <WebServer.h>
 #include <ArduinoJson.h>
 #include <esp_camera.h>
+#include <esp_heap_caps.h>
+#include <img_converters.h>
 #include <math.h>
 
+#include "int8_engine.h"
+#include "labels.h"
+#include "model.h"
+
 // Pinout do XIAO ESP32S3 Sense
 #define PWDN_GPIO_NUM     -1
 #define RESET_GPIO_NUM    -1
@@ -54,6 +60,14 @@ ClassificationResult current_result;
 bool camera_initialized = false;
 bool wifi_connected = false;
 
+// Motor INT8: ativações posicionadas pelo planejador estático (tempo de vida) e
+// Conv2D+MaxPool2D fundidos; pico do g_model ~100 KB dentro do orçamento
+// TENSOR_ARENA_SIZE_KB do config.py
+static const size_t kTensorArenaSize = 380 * 1024;
+static uint8_t* tensor_arena = nullptr;
+static Int8Engine engine;
+bool model_ready = false;
+
 // Função para inicializar a câmera
 bool initCamera() {
   camera_config_t config;
@@ -94,90 +108,95 @@ bool initCamera() {
   return true;
 }
 
-// Função para análise REAL baseada no modelo CNN treinado
+// Inicializa o motor INT8 com o modelo embutido (g_model)
+bool initModel() {
+  // SRAM interna primeiro (mais rápida); PSRAM se não houver bloco contíguo
+  const char* arena_location = "SRAM";
+  tensor_arena = (uint8_t*)heap_caps_malloc(kTensorArenaSize, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+  if (!tensor_arena) {
+    arena_location = "PSRAM";
+    tensor_arena = (uint8_t*)heap_caps_malloc(kTensorArenaSize, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+  }
+  if (!tensor_arena) {
+    Serial.println("❌ Falha ao alocar a arena de tensores");
+    return false;
+  }
+  // Pesos em blocos de canais, lidos direto da flash (sem reempacotar no boot)
+  engine.setPackedWeights(g_model_packed, g_model_packed_len);
+  // Sem pré-busca da densa: o GDMA não lê a flash e uma cópia pela CPU só somaria trabalho
+  if (!engine.begin(g_model, g_model_len, tensor_arena, kTensorArenaSize)) {
+    Serial.printf("❌ Erro ao carregar o modelo: %s\n", engine.errorMessage());
+    return false;
+  }
+  Serial.printf("✅ Modelo INT8 carregado: %d camadas, arena %u/%u bytes (%s, soma das ativações %u)\n",
+                engine.layerCount(), (unsigned)engine.arenaUsed(), (unsigned)kTensorArenaSize,
+                arena_location, (unsigned)engine.activationBytes());
+  Serial.printf("📦 Pesos empacotados em %d/%d camadas\n", engine.packedLayerCount(),
+                engine.layerCount());
+  return true;
+}
+
+// Função para análise REAL executando o modelo CNN INT8 (g_model)
 void analyzeRealCNN(camera_fb_t* fb) {
-  // ANÁLISE REAL baseada no modelo CNN treinado (90% precisão)
-  // Usa características REAIS da imagem capturada
-  
-  // 1. Análise de características reais da imagem
-  float image_size = fb->width * fb->height;
-  float compression_ratio = (float)fb->len / (image_size * 3);
-  
-  // 2. Análise REAL de padrões visuais baseada no modelo CNN treinado
-  // HP Original: padrões específicos de cor, textura, forma
-  // Não HP: padrões diferentes de cor, textura, forma
-  
-  // 3. Características RGB REAIS baseadas no conteúdo da imagem
-  float r_avg, g_avg, b_avg;
-  
-  // ANÁLISE REAL baseada no modelo CNN treinado com 90% precisão
-  // Usa características REAIS extraídas do JPEG
-  
-  // HP Original: características específicas do dataset treinado
-  // - Mais vermelho (R > 150)
-  // - Menos azul (B < 100)
-  // - Padrões de textura específicos
-  // - Compressão específica
-  
-  // Não HP: características diferentes do dataset treinado
-  // - Mais azul (B > 120)
-  // - Menos vermelho (R < 120)
-  // - Padrões de textura diferentes
-  // - Compressão diferente
-  
-  // Análise REAL baseada no modelo CNN treinado
-  if (compression_ratio < 0.08) {
-    // Imagem com muitos detalhes (característica de HP Original)
-    // Baseado no dataset treinado: HP Original tem mais detalhes
-    r_avg = 180.0f + fmod(image_size, 100.0f) * 0.5f;
-    g_avg = 120.0f + fmod(image_size, 80.0f) * 0.3f;
-    b_avg = 80.0f + fmod(image_size, 60.0f) * 0.2f;
-  } else if (compression_ratio > 0.25) {
-    // Imagem com poucos detalhes (característica de Não HP)
-    // Baseado no dataset treinado: Não HP tem menos detalhes
-    r_avg = 100.0f + fmod(image_size, 50.0f) * 0.4f;
-    g_avg = 80.0f + fmod(image_size, 40.0f) * 0.5f;
-    b_avg = 120.0f + fmod(image_size, 80.0f) * 0.6f;
-  } else {
-    // Caso neutro - análise mais detalhada
-    r_avg = 140.0f + fmod(image_size, 70.0f) * 0.3f;
-    g_avg = 100.0f + fmod(image_size, 60.0f) * 0.4f;
-    b_avg = 100.0f + fmod(image_size, 70.0f) * 0.3f;
+  if (!model_ready) {
+    Serial.println("❌ Modelo não carregado");
+    return;
   }
-  
-  // 4. Classificação REAL baseada no modelo CNN treinado
-  // Usa as características REAIS para determinar HP vs Não HP
-  
-  // HP Original: mais vermelho, menos azul, padrões específicos
-  float hp_score = (r_avg * 0.4f + g_avg * 0.3f + (255.0f - b_avg) * 0.3f) / 255.0f;
-  
-  // Não HP: mais azul, menos vermelho, padrões diferentes
-  float nao_hp_score = (b_avg * 0.4f + g_avg * 0.3f + (255.0f - r_avg) * 0.3f) / 255.0f;
-  
-  // Normalizar scores
-  float total = hp_score + nao_hp_score;
-  if (total > 0) {
-    hp_score = (hp_score / total) * 100.0f;
-    nao_hp_score = (nao_hp_score / total) * 100.0f;
+
+  // 1. Decodifica o JPEG para RGB888
+  int pixel_count = fb->width * fb->height;
+  uint8_t* rgb_buf = (uint8_t*)malloc(pixel_count * 3);
+  if (!rgb_buf) {
+    Serial.println("❌ Falha ao alocar buffer RGB");
+    return;
   }
-  
-  // 5. Determinar predição baseada no modelo treinado
-  if (hp_score > nao_hp_score) {
-    current_result.prediction = "HP_ORIGINAL";
+  if (!fmt2rgb888(fb->buf, fb->len, PIXFORMAT_JPEG, rgb_buf)) {
+    Serial.println("❌ Falha ao decodificar JPEG");
+    free(rgb_buf);
+    return;
+  }
+
+  // 2. Médias RGB e conversão para tons de cinza no próprio buffer
+  long r_sum = 0, g_sum = 0, b_sum = 0;
+  for (int i = 0; i < pixel_count; ++i) {
+    uint32_t r = rgb_buf[i * 3], g = rgb_buf[i * 3 + 1], b = rgb_buf[i * 3 + 2];
+    r_sum += r; g_sum += g; b_sum += b;
+    rgb_buf[i] = (uint8_t)((r * 19595 + g * 38470 + b * 7471 + 0x8000) >> 16);
+  }
+
+  // 3. Redimensiona/quantiza para a entrada 96x96 e executa o modelo
+  unsigned long t0 = micros();
+  engine.setInputFromGray(rgb_buf, fb->width, fb->height);
+  bool ok = engine.invoke();
+  float elapsed_ms = (micros() - t0) / 1000.0f;
+  free(rgb_buf);
+  if (!ok) {
+    Serial.printf("❌ Falha na inferência: %s\n", engine.errorMessage());
+    return;
+  }
+
+  // 4. Scores do softmax (classe 0 = HP_ORIGINAL, classe 1 = NAO_HP)
+  float hp_score = engine.outputValue(0) * 100.0f;
+  float nao_hp_score = engine.outputValue(1) * 100.0f;
+
+  if (hp_score >= nao_hp_score) {
+    current_result.prediction = kCategoryLabels[0];
     current_result.confidence = hp_score;
   } else {
-    current_result.prediction = "NAO_HP";
+    current_result.prediction = kCategoryLabels[1];
     current_result.confidence = nao_hp_score;
   }
-  
+
   // Armazenar resultados
   current_result.scores.hp_original = hp_score;
   current_result.scores.nao_hp = nao_hp_score;
-  current_result.features.r = r_avg;
-  current_result.features.g = g_avg;
-  current_result.features.b = b_avg;
+  current_result.features.r = (float)r_sum / pixel_count;
+  current_result.features.g = (float)g_sum / pixel_count;
+  current_result.features.b = (float)b_sum / pixel_count;
   current_result.stats.total_inferences++;
-  current_result.stats.avg_time = 150.0f; // Tempo real de inferência
+  // Média móvel do tempo real de inferência
+  current_result.stats.avg_time += (elapsed_ms - current_result.stats.avg_time) /
+                                   current_result.stats.total_inferences;
   current_result.using_real_model = true;
 }
 
@@ -451,7 +470,8 @@ void handleHealth() {
   health_status += (camera_initialized ? "OK" : "Erro");
   health_status += "\nPSRAM: ";
   health_status += (psramFound() ? "SIM" : "NÃO");
-  health_status += "\nModelo: CNN Real (90% precisão)";
+  health_status += "\nModelo: ";
+  health_status += (model_ready ? "CNN INT8 carregado" : "Erro ao carregar");
   server.send(200, "text/plain", health_status);
 }
 
@@ -465,6 +485,9 @@ void setup() {
   // Inicializar câmera
   camera_initialized = initCamera();
 
+  // Carregar modelo INT8
+  model_ready = initModel();
+
   // Tentar conectar ao WiFi
   Serial.println("📶 Conectando ao WiFi...");
   WiFi.begin(ssid, password);
@@ -3,8 +3,26 @@
 #include <WebServer.h>
 #include <ArduinoJson.h>
 #include <Wire.h>
+#include <SPIFFS.h>
+#include <esp_heap_caps.h>
+#include <img_converters.h>
 #include <math.h>
 
+#include <atomic>
+
+#include "buffer_pool.h"
+#include "feature_gate.h"
+#include "image_stats.h"
+#include "int8_engine.h"
+#include "jpeg_scaled.h"
+#include "labels.h"
+#include "model_file.h"
+#include "shared_frame.h"
+#include "spsc_ring.h"
+#ifdef EMBEDDED_MODEL
+#include "model.h"   // Fallback compilado (-DEMBEDDED_MODEL) sem partição nem SPIFFS
+#endif
+
 // ===== CONFIGURAÇÕES WIFI =====
 const char* ssid = "SMS Tecnologia";
 const char* password = "23pipocas";
@@ -32,6 +50,15 @@ const char* password = "23pipocas";
 // ===== CONFIGURAÇÕES AVANÇADAS =====
 #define IMG_W 320
 #define IMG_H 240
+// Captura em JPEG (padrão) ou, com -DCAPTURE_YUV422, em YUV422 cru: a entrada
+// da CNN sai direto dos bytes Y do frame, sem decodificação nem conversão de
+// cor. A textura passa a ser a do gradiente (sem taxa de compressão), então
+// calibre de novo ao trocar o modo
+#ifdef CAPTURE_YUV422
+static const pixformat_t kCapturePixelFormat = PIXFORMAT_YUV422;
+#else
+static const pixformat_t kCapturePixelFormat = PIXFORMAT_JPEG;
+#endif
 const int CALIB_SAMPLES = 8;
 float THRESH = 0.25f;
 
@@ -41,6 +68,90 @@ bool camera_available = false;
 bool calibrated = false;
 float center_vec[6] = {0};
 
+// Cascata: o gate de características rejeita cenas vazias e frames longe do
+// perfil calibrado; só os ambíguos pagam a CNN INT8 (g_model)
+// As 3 Conv2D+MaxPool rodam em patches 4x4 (MCUNet): pico de ~36 KB em vez
+// de ~100 KB, então a arena cabe na SRAM interna
+static const int kPatchLayers = 3;
+static const int kPatchGrid = 4;
+static const size_t kTensorArenaSize = 48 * 1024;
+static const size_t kWeightScratchSize = 8 * 1024;
+// Candidatas ao Winograd F(2x2, 3x3): as três Conv2D+MaxPool 3x3, aprovadas
+// no host_winograd (erro 0 contra a referência). No boot, tuneWinograd mantém
+// só as que ganham ao menos 5% do backend escolhido neste ESP32-S3 (melhor de
+// 8 medições: com 2 a variação entre execuções encobre ganhos de 3-15%). Os
+// pesos transformados (193 KB) ficam na PSRAM, que depois do ajuste só guarda
+// os das camadas mantidas
+static const uint32_t kWinogradLayers = (1u << 0) | (1u << 1) | (1u << 2);
+static const size_t kWinogradBufferSize = 196 * 1024;
+static const int kWinogradTuneRepeats = 8;
+static const int kWinogradMinGainPercent = 5;
+// Dense 6400 -> 64 com os pesos int4 do .i8pk: metade dos bytes lidos da
+// flash (host_int4: mesma classificação em todas as fotos da Sprint 1)
+static const bool kInt4Dense = true;
+static uint8_t* tensor_arena = nullptr;
+static int8_t* weight_scratch = nullptr;
+static int16_t* winograd_weights = nullptr;
+static Int8Engine engine;
+static FeatureGate gate;
+// Modelo e pesos empacotados mapeados das partições model/packed (gravadas
+// pelo data_upload.py), sem cópia; a SPIFFS (cópia na PSRAM) é o fallback
+static ModelFile model_file;
+static ModelFile packed_file;
+static LayerProfiler profiler;   // Ciclos/MACs/bytes por camada, servido em /profile
+// Scratch temporário do teste diferencial do backend no boot (maior saída
+// comparada: a do bloco em patches, 10x10x64), emprestado do buffer de frame
+static const size_t kBackendCheckScratch = 8 * 1024;
+// Buffers por frame reservados no boot (sem malloc/free por frame):
+//   - SRAM interna: memória do TJpgDec e o InputAreaStream, a média por área
+//     da entrada da CNN feita MCU a MCU na decodificação (~10 KB de linhas
+//     acumuladas no lugar do RGB888 de 172 KB);
+//   - PSRAM: luminância de um frame, para tamanhos fora dos limites do stream
+static const size_t kFrameLumaSize = IMG_W * IMG_H;
+static BufferPool buffer_pool;
+bool model_ready = false;
+
+// Pipeline de captura: a tarefa da câmera (núcleo 0, junto do WiFi) passa os
+// frames por um anel lock-free para a de inferência (núcleo 1), e o loop() só
+// atende o HTTP. Com CAMERA_GRAB_LATEST, um frame espera no anel enquanto o
+// outro é analisado, e o terceiro buffer fica com o último frame analisado
+// (snapshot), servido sem nova captura ao /capture.jpg e ao /stream
+static const int kCameraFbCount = 3;
+static const uint32_t kFrameRingSize = 1;
+static const uint32_t kCaptureTaskStack = 4096;
+static const uint32_t kInferenceTaskStack = 16 * 1024;
+static const uint32_t kStreamTaskStack = 4096;
+static const int kMaxStreamClients = 2;
+// Com análise contínua, o log completo no Serial (~90 ms a 115200) só a cada N
+static const int kSerialLogEvery = 20;
+// Os frames circulam contados por referência (shared_frame.h): a inferência,
+// o snapshot e os clientes HTTP dividem a mesma captura, e o buffer só volta
+// ao driver quando o último deles solta
+static void returnCameraFrame(void* frame, void*) {
+  esp_camera_fb_return((camera_fb_t*)frame);
+}
+static SharedFrameTable frame_table(returnCameraFrame, nullptr);
+static FrameSnapshot frame_snapshot;
+static std::atomic<int> stream_clients(0);
+static SpscRing<SharedFrame*, kFrameRingSize> frame_ring;
+static TaskHandle_t capture_task = nullptr;
+static TaskHandle_t inference_task = nullptr;
+// Resultado, gate, perfilador e pool: escritos pela inferência, lidos pelo HTTP
+static SemaphoreHandle_t analysis_mutex = nullptr;
+// /calibrate pausa o pipeline: a captura para de empurrar e a inferência
+// esvazia o anel e devolve os buffers antes de a calibração pegar os seus
+static std::atomic<bool> pipeline_pause(false);
+static std::atomic<bool> capture_paused(false);
+static std::atomic<bool> inference_idle(true);
+
+struct PipelineStats {
+  uint32_t captured;
+  uint32_t analyzed;
+  uint32_t ring_full_waits;   // Vezes que a captura esperou a inferência
+  float fps;                  // Média móvel de frames analisados por segundo
+};
+static PipelineStats pipeline_stats;
+
 // Estrutura para resultados de classificação
 struct ClassificationResult {
   String label;
@@ -51,77 +162,261 @@ struct ClassificationResult {
   float brightness;
   float contrast;
   float texture;
+  float luma_std;              // Desvio da luminância (ImageStats)
+  float gradient_energy;       // Média de dx² + dy² da luminância
+  uint32_t luma_hist[kStatsBins];
   int image_width;
   int image_height;
   int image_size;
   int analysis_count;
   unsigned long analysis_time_ms;
+  const char* gate_decision;   // FeatureGate::decisionName
+  float profile_distance;      // Distância ao perfil calibrado (-1 sem calibração)
+  bool used_cnn;
 };
 
 ClassificationResult classificationResult;
 
 // ===== FUNÇÕES DE ANÁLISE REAL =====
 
-// Análise real de características da imagem
-void analyzeRealCharacteristics(camera_fb_t* fb) {
-  if (!fb || !fb->buf) {
-    Serial.println("Erro: Frame buffer inválido");
-    return;
+// Usa o backend vetorial mais rápido só se ele reproduzir bit a bit o escalar
+// numa entrada pseudoaleatória; caso contrário fica nos kernels de referência
+void selectKernelBackend() {
+  const KernelBackend* best = bestKernelBackend();
+  if (best == scalarKernelBackend()) return;
+  PoolLease lease(buffer_pool, kBackendCheckScratch, kPoolPsram);
+  int8_t* scratch = lease.as<int8_t>();
+  if (!scratch) return;
+  const int input_size = engine.inputWidth() * engine.inputHeight() * engine.inputChannels();
+  uint32_t seed = 0x12345678;
+  for (int i = 0; i < input_size; ++i) {
+    seed = seed * 1664525u + 1013904223u;
+    engine.input()[i] = (int8_t)(seed >> 24);
   }
+  const int mismatch = engine.compareKernelBackends(scalarKernelBackend(), best, scratch,
+                                                    kBackendCheckScratch);
+  if (mismatch == -1) {
+    engine.setKernelBackend(best);
+    Serial.printf("✅ Backend de kernels: %s (confere com o escalar)\n", best->name);
+  } else {
+    Serial.printf("⚠️ Backend %s diverge do escalar (camada %d): usando referência\n",
+                  best->name, mismatch);
+  }
+}
 
-  // Inicializa variáveis para calcular a média de RGB
-  long r_sum = 0;
-  long g_sum = 0;
-  long b_sum = 0;
-  int pixel_count = 0;
-
-  // Decodifica o JPEG para RGB888 para análise de pixels
-  uint8_t *rgb_buf = (uint8_t *)malloc(fb->width * fb->height * 3);
-  if (!rgb_buf) {
-    Serial.println("Erro: Falha ao alocar buffer RGB.");
-    return;
+// Inicializa o motor INT8 com o modelo das partições, da SPIFFS ou o g_model embutido
+bool initModel() {
+  const char* arena_location = "SRAM";
+  tensor_arena = (uint8_t*)heap_caps_malloc(kTensorArenaSize, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+  if (!tensor_arena) {
+    arena_location = "PSRAM";
+    tensor_arena = (uint8_t*)heap_caps_malloc(kTensorArenaSize, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+  }
+  if (!tensor_arena) {
+    Serial.println("❌ Falha ao alocar a arena de tensores");
+    return false;
   }
 
-  bool decode_success = fmt2rgb888(fb->buf, fb->len, PIXFORMAT_JPEG, rgb_buf);
-  if (!decode_success) {
-    Serial.println("Erro: Falha ao decodificar JPEG para RGB888.");
-    free(rgb_buf);
-    return;
+  const uint8_t* model_data = nullptr;
+  size_t model_size = 0;
+  const char* model_source = "partição, mmap";
+  if (model_file.openPartition(kModelPartition)) {
+    packed_file.openPartition(kPackedPartition);
+  } else {
+    Serial.printf("⚠️ Partição %s: %s; lendo da SPIFFS (cópia na PSRAM)\n", kModelPartition,
+                  model_file.errorMessage());
+    model_source = "SPIFFS, cópia";
+    if (SPIFFS.begin(false) && model_file.open(kSpiffsModelPath)) {
+      packed_file.open(kSpiffsPackedPath);
+    }
+  }
+  if (model_file.data()) {
+    model_data = model_file.data();
+    model_size = model_file.size();
+    if (packed_file.data()) engine.setPackedWeights(packed_file.data(), packed_file.size());
+  }
+#ifdef EMBEDDED_MODEL
+  if (!model_data) {
+    model_source = "embutido";
+    model_data = g_model;
+    model_size = g_model_len;
+    engine.setPackedWeights(g_model_packed, g_model_packed_len);
+  }
+#endif
+  if (!model_data) {
+    Serial.printf("❌ Modelo ausente (partição %s e %s): grave com data_upload.py\n",
+                  kModelPartition, kSpiffsModelPath);
+    return false;
   }
 
-  // Análise real dos pixels
-  for (int i = 0; i < fb->width * fb->height; ++i) {
-    r_sum += rgb_buf[i * 3];
-    g_sum += rgb_buf[i * 3 + 1];
-    b_sum += rgb_buf[i * 3 + 2];
-    pixel_count++;
+  // Pré-busca da densa (cópia int4 ou blocos int8) só com os pesos na PSRAM
+  // (fallback da SPIFFS), que o GDMA lê em paralelo ao cálculo (host_gemv: 1.08x
+  // sobre a cópia síncrona). Da flash mapeada, o caminho padrão, o GDMA não lê e
+  // uma cópia pela CPU só somaria trabalho: a densa lê direto pelo cache.
+  const WeightFetcher* fetcher = nullptr;
+  if (packed_file.data() && !packed_file.mapped()) fetcher = dmaWeightFetcher();
+  if (fetcher) {
+    weight_scratch = (int8_t*)heap_caps_malloc(kWeightScratchSize,
+                                               MALLOC_CAP_INTERNAL | MALLOC_CAP_DMA);
+    if (weight_scratch) engine.setWeightStreaming(weight_scratch, kWeightScratchSize, fetcher);
+    if (weight_scratch) Serial.println("📥 Densa com pré-busca GDMA (pesos na PSRAM)");
+  }
+  winograd_weights = (int16_t*)heap_caps_malloc(kWinogradBufferSize, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+  if (winograd_weights) engine.setWinograd(kWinogradLayers, winograd_weights, kWinogradBufferSize);
+  engine.setInt4Dense(kInt4Dense);
+  engine.setProfiler(&profiler);
+  engine.setPatchInference(kPatchLayers, kPatchGrid);
+  bool loaded = engine.begin(model_data, model_size, tensor_arena, kTensorArenaSize);
+  if (!loaded && packed_file.data()) {
+    // .i8pk de outro modelo: segue com os pesos OHWI do .tflite
+    Serial.printf("⚠️ Pesos empacotados ignorados: %s\n", engine.errorMessage());
+    engine.setPackedWeights(nullptr, 0);
+    packed_file.close();
+    loaded = engine.begin(model_data, model_size, tensor_arena, kTensorArenaSize);
   }
-  free(rgb_buf);
+  if (!loaded) {
+    Serial.printf("❌ Erro ao carregar o modelo: %s\n", engine.errorMessage());
+    return false;
+  }
+  Serial.printf("✅ Modelo INT8 (%s, %u bytes) carregado: %d camadas, %d empacotadas, "
+                "%d Winograd, %d int4, %d esparsas, arena %u bytes (%s)\n", model_source,
+                (unsigned)model_size, engine.layerCount(), engine.packedLayerCount(),
+                engine.winogradLayerCount(), engine.int4LayerCount(), engine.sparseLayerCount(),
+                (unsigned)engine.arenaUsed(), arena_location);
+  selectKernelBackend();
+  if (engine.winogradLayerCount() > 0) {
+    const uint32_t winograd = engine.tuneWinograd(kWinogradTuneRepeats,
+                                                  kWinogradMinGainPercent);
+    Serial.printf("🎛️ Winograd mais rápido que o backend nas camadas 0x%x (candidatas 0x%x)\n",
+                  (unsigned)winograd, (unsigned)kWinogradLayers);
+  }
+  // Devolve à PSRAM o espaço das camadas que o ajuste desligou
+  const size_t winograd_used = engine.winogradBytes();
+  if (winograd_weights && winograd_used < kWinogradBufferSize) {
+    int16_t* compact = nullptr;
+    if (winograd_used > 0) {
+      compact = (int16_t*)heap_caps_malloc(winograd_used, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    }
+    if ((compact || winograd_used == 0) && engine.moveWinograd(compact, winograd_used)) {
+      heap_caps_free(winograd_weights);
+      winograd_weights = compact;
+      Serial.printf("🧹 Pesos Winograd: %u de %u bytes mantidos na PSRAM\n",
+                    (unsigned)winograd_used, (unsigned)kWinogradBufferSize);
+    } else if (compact) {
+      heap_caps_free(compact);
+    }
+  }
+  return true;
+}
 
-  // Calcula médias reais
-  float r_avg = (float)r_sum / pixel_count;
-  float g_avg = (float)g_sum / pixel_count;
-  float b_avg = (float)b_sum / pixel_count;
+// Executa a CNN sobre o tensor de entrada já preenchido pelo stream; scores em %
+bool runCNN(float* hp_score, float* nao_hp_score) {
+  unsigned long t0 = micros();
+  if (!engine.invoke()) {
+    Serial.printf("❌ Falha na inferência: %s\n", engine.errorMessage());
+    return false;
+  }
+  gate.recordModelRun((micros() - t0) / 1000.0f);
+  *hp_score = engine.outputValue(0) * 100.0f;
+  *nao_hp_score = engine.outputValue(1) * 100.0f;
+  return true;
+}
 
-  // Calcula brilho real (luminância)
-  float brightness = (0.299 * r_avg + 0.587 * g_avg + 0.114 * b_avg) / 255.0f;
+// Estatísticas de um frame YUV422 numa passada pelas linhas (Y direto, U/V
+// só somados para as médias de cor). Duas linhas de Y se alternam como linha
+// atual e de cima; a análise e a calibração nunca rodam juntas (pausePipeline)
+static void yuv422FrameStats(const camera_fb_t* fb, ImageStats* stats) {
+  alignas(16) static uint8_t luma_rows[2][IMG_W];
+  imageStatsReset(stats);
+  if (fb->width > IMG_W) return;
+  const size_t stride = (size_t)fb->width * 2;
+  for (size_t y = 0; y < fb->height; ++y) {
+    const uint8_t* row = fb->buf + y * stride;
+    imageStatsAddYuv422(stats, row, y > 0 ? luma_rows[(y & 1) ^ 1] : nullptr, fb->width,
+                        luma_rows[y & 1]);
+  }
+  imageStatsFinishYuv422(stats);
+}
 
-  // Calcula contraste real
-  float contrast = (abs(r_avg - g_avg) + abs(g_avg - b_avg) + abs(b_avg - r_avg)) / (3.0f * 255.0f);
+// Análise real de características da imagem
+void analyzeRealCharacteristics(camera_fb_t* fb) {
+  if (!fb || !fb->buf) {
+    Serial.println("Erro: Frame buffer inválido");
+    return;
+  }
+  unsigned long t_start = millis();
+  // YUV422: nada a decodificar, o Y do frame já é a luminância da entrada
+  const bool yuv = fb->format == PIXFORMAT_YUV422;
 
-  // Calcula textura real (baseada na compressão)
-  float texture = 1.0f - ((float)fb->len / (fb->width * fb->height * 3.0f));
+  // Decodifica já reduzido no domínio DCT: com o modelo, na maior escala que
+  // ainda cobre a entrada da CNN, e cada MCU vai direto para as somas das
+  // características e para a média por área do tensor de entrada; só com o
+  // gate, em 1/8 (apenas o DC de cada bloco, sem IDCT). Só luminância: o
+  // modelo é de um canal, Cb/Cr entram apenas pelo DC nas médias de cor
+  const int scale = model_ready ? jpegScaleFor(fb->width, fb->height, engine.inputWidth(),
+                                               engine.inputHeight())
+                                : kJpegMaxScale;
+  // Buffers emprestados do pool, devolvidos no fim da análise
+  const int scaled_w = fb->width >> scale, scaled_h = fb->height >> scale;
+  PoolLease work(buffer_pool, yuv ? 0 : kJpegLumaWorkSize, kPoolInternal);
+  PoolLease stream(buffer_pool, model_ready && !yuv ? sizeof(InputAreaStream) : 0,
+                   kPoolInternal);
+  InputAreaStream* input_stream = stream.as<InputAreaStream>();
+  const bool use_stream =
+      input_stream && engine.beginInputStream(input_stream, scaled_w, scaled_h);
+  // Frame fora dos limites do stream: luminância reduzida na PSRAM
+  const size_t luma_size =
+      model_ready && !yuv && !use_stream ? (size_t)scaled_w * scaled_h : 0;
+  PoolLease luma(buffer_pool, luma_size, kPoolPsram);
+  JpegScaledSink sink;
+  jpegScaledBegin(&sink, fb->buf, luma.as<uint8_t>(), luma_size);
+  sink.stream = use_stream ? input_stream : nullptr;
+  sink.work = work.as<uint8_t>();
+  sink.work_size = kJpegLumaWorkSize;
+  if (yuv) {
+    yuv422FrameStats(fb, &sink.stats);
+  } else if (!jpegScaledDecodeLuma(&sink, fb->len, scale)) {
+    Serial.println("Erro: Falha ao decodificar JPEG reduzido.");
+    return;
+  }
 
-  // Vetor de características normalizado
-  float feat[6] = { r_avg/255.0f, g_avg/255.0f, b_avg/255.0f, brightness, contrast, texture };
+  // Vetor de características normalizado (médias da imagem reduzida)
+  float feat[kGateFeatures];
+  imageStatsFeatures(sink.stats, yuv ? 0 : fb->len, fb->width, fb->height, feat);
+  float r_avg = feat[kFeatR] * 255.0f;
+  float g_avg = feat[kFeatG] * 255.0f;
+  float b_avg = feat[kFeatB] * 255.0f;
+  float brightness = feat[kFeatBrightness];
+  float contrast = feat[kFeatContrast];
+  float texture = feat[kFeatTexture];
 
   float hp_score = 0.0f;
   float nao_hp_score = 0.0f;
 
-  if (calibrated) {
-    float d2 = 0.0f;
-    for (int i = 0; i < 6; ++i) { float diff = feat[i] - center_vec[i]; d2 += diff * diff; }
-    float dist = sqrtf(d2);
+  // 1º estágio: gate barato; só frames ambíguos seguem para a CNN
+  float dist = -1.0f;
+  GateDecision decision = gate.evaluate(feat, &dist);
+  classificationResult.gate_decision = FeatureGate::decisionName(decision);
+  classificationResult.profile_distance = dist;
+  classificationResult.used_cnn = false;
+
+  if (decision != kGateRunModel) {
+    // Cena vazia ou longe do perfil HP: NAO_HP sem executar o modelo
+    float conf_nao = decision == kGateEmptyScene ? 1.0f : min(dist / (THRESH * 2.0f), 1.0f);
+    hp_score = (1.0f - conf_nao) * 100.0f; nao_hp_score = conf_nao * 100.0f;
+    classificationResult.label = kCategoryLabels[1]; classificationResult.confidence = conf_nao;
+  } else if ((yuv           ? engine.setInputFromYuv422(fb->buf, fb->width, fb->height)
+              : sink.stream ? inputAreaStreamDone(*input_stream)
+                            : sink.gray && engine.setInputFromGray(sink.gray, sink.width,
+                                                                   sink.height)) &&
+             runCNN(&hp_score, &nao_hp_score)) {
+    // 2º estágio: CNN INT8 sobre a luminância
+    classificationResult.used_cnn = true;
+    int best = hp_score >= nao_hp_score ? 0 : 1;
+    classificationResult.label = kCategoryLabels[best];
+    classificationResult.confidence = (best == 0 ? hp_score : nao_hp_score) / 100.0f;
+  } else if (calibrated) {
+    // Sem modelo: distância ao centro calibrado (já calculada pelo gate)
     float conf_hp = 1.0f - min(dist / (THRESH * 2.0f), 1.0f);
     float conf_nao = 1.0f - conf_hp;
     hp_score = conf_hp * 100.0f; nao_hp_score = conf_nao * 100.0f;
@@ -146,13 +441,18 @@ void analyzeRealCharacteristics(camera_fb_t* fb) {
   classificationResult.brightness = brightness;
   classificationResult.contrast = contrast;
   classificationResult.texture = texture;
+  classificationResult.luma_std = imageStatsLumaStd(sink.stats);
+  classificationResult.gradient_energy = imageStatsGradientEnergy(sink.stats);
+  memcpy(classificationResult.luma_hist, sink.stats.hist[kStatsY],
+         sizeof(classificationResult.luma_hist));
   classificationResult.image_width = fb->width;
   classificationResult.image_height = fb->height;
   classificationResult.image_size = fb->len;
   classificationResult.analysis_count++;
-  classificationResult.analysis_time_ms = millis() - classificationResult.analysis_time_ms;
+  classificationResult.analysis_time_ms = millis() - t_start;
 
   // Log detalhado
+  if (classificationResult.analysis_count % kSerialLogEvery != 1) return;
   Serial.println("🔍 === RESULTADO DA CLASSIFICAÇÃO (ANÁLISE REAL) ===");
   Serial.printf("📊 HP Original: %.1f%%\n", hp_score);
   Serial.printf("📊 Não HP: %.1f%%\n", nao_hp_score);
@@ -161,63 +461,235 @@ void analyzeRealCharacteristics(camera_fb_t* fb) {
   Serial.printf("🎨 RGB: R=%.0f, G=%.0f, B=%.0f\n", r_avg, g_avg, b_avg);
   Serial.printf("🔍 Brilho: %.1f | Contraste: %.1f | Textura: %.1f\n", 
                 brightness, contrast, texture);
-  Serial.printf("📈 Análises: %d | Tempo: %.1fms\n", 
+  Serial.printf("📐 Desvio Y: %.1f | Energia do gradiente: %.1f\n",
+                classificationResult.luma_std, classificationResult.gradient_energy);
+  Serial.printf("📈 Análises: %d | Tempo: %lums\n", 
                 classificationResult.analysis_count, classificationResult.analysis_time_ms);
+  Serial.printf("🚦 Gate: %s | distância: %.3f | rejeição: %.1f%% | economia: %.0fms\n",
+                classificationResult.gate_decision, dist, gate.hitRate() * 100.0f, gate.savedMs());
   Serial.printf("📏 Imagem: %dx%d, %d bytes\n", 
                 fb->width, fb->height, fb->len);
-  Serial.println("🧠 MODELO: Análise Real Avançada (90% precisão)");
+  Serial.println(classificationResult.used_cnn ? "🧠 MODELO: CNN INT8 (2º estágio)"
+                                              : "🧠 MODELO: Gate de características (1º estágio)");
   Serial.println("=====================================================");
 }
 
+// ===== PIPELINE DE CAPTURA =====
+
+// Produtor: pega o frame mais recente e o empurra no anel
+static void captureTask(void*) {
+  for (;;) {
+    if (pipeline_pause.load()) {
+      capture_paused.store(true);
+      vTaskDelay(pdMS_TO_TICKS(10));
+      continue;
+    }
+    if (frame_ring.full()) {
+      // Dorme até a inferência liberar a vaga; o sensor segue no GRAB_LATEST
+      ++pipeline_stats.ring_full_waits;
+      ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(100));
+      continue;
+    }
+    camera_fb_t* fb = esp_camera_fb_get();
+    if (!fb) {
+      vTaskDelay(pdMS_TO_TICKS(10));
+      continue;
+    }
+    // A referência da captura passa para a inferência pelo anel
+    SharedFrame* frame = frame_table.wrap(fb);
+    if (!frame) continue;
+    frame_ring.push(frame);   // Produtor único: a vaga vista acima continua livre
+    ++pipeline_stats.captured;
+    xTaskNotifyGive(inference_task);
+  }
+}
+
+// Consumidor: analisa cada frame do anel e o devolve ao driver
+static void inferenceTask(void*) {
+  unsigned long last_ms = millis();
+  for (;;) {
+    inference_idle.store(false);
+    SharedFrame* shared = nullptr;
+    if (!frame_ring.pop(&shared)) {
+      inference_idle.store(true);
+      ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(100));
+      continue;
+    }
+    xTaskNotifyGive(capture_task);   // Vaga no anel: a captura já pega o próximo
+    FrameRef frame = FrameRef::adopt(shared);
+    xSemaphoreTake(analysis_mutex, portMAX_DELAY);
+    analyzeRealCharacteristics(frame.as<camera_fb_t>());
+    xSemaphoreGive(analysis_mutex);
+    // O snapshot passa a segurar este frame e solta o anterior; a referência
+    // da inferência cai no fim da iteração
+    frame_snapshot.publish(frame);
+
+    const unsigned long now = millis();
+    const float fps = 1000.0f / (float)max(now - last_ms, 1UL);
+    pipeline_stats.fps = pipeline_stats.analyzed ? 0.9f * pipeline_stats.fps + 0.1f * fps : fps;
+    ++pipeline_stats.analyzed;
+    last_ms = now;
+  }
+}
+
+static bool startPipeline() {
+  if (xTaskCreatePinnedToCore(inferenceTask, "inference", kInferenceTaskStack, nullptr, 1,
+                              &inference_task, 1) != pdPASS) {
+    return false;
+  }
+  return xTaskCreatePinnedToCore(captureTask, "capture", kCaptureTaskStack, nullptr, 2,
+                                 &capture_task, 0) == pdPASS;
+}
+
+// Espera a captura parar e a inferência devolver todos os frames
+static void pausePipeline() {
+  if (!capture_task) return;
+  pipeline_pause.store(true);
+  capture_paused.store(false);
+  // Captura parada primeiro: depois disso o anel só esvazia
+  while (!capture_paused.load() || !frame_ring.empty() || !inference_idle.load()) {
+    vTaskDelay(pdMS_TO_TICKS(5));
+  }
+}
+
+static void resumePipeline() { pipeline_pause.store(false); }
+
 // Calibração dinâmica do centro HP Original
 void handleCalibrate() {
   if (!camera_available) { server.send(500, "text/plain", "Câmera não disponível"); return; }
-  int n = 0; float acc[6] = {0};
+  // Os frames da calibração vêm direto do driver, com o pipeline parado
+  pausePipeline();
+  // Média e desvio das características acumulados por Welford, frame a frame
+  FeatureWelford calib;
+  welfordReset(&calib);
   for (int k = 0; k < CALIB_SAMPLES; ++k) {
     camera_fb_t* fb = esp_camera_fb_get();
     if (!fb) continue;
-    uint8_t* rgb = (uint8_t*)malloc(fb->width * fb->height * 3);
-    if (rgb && fmt2rgb888(fb->buf, fb->len, PIXFORMAT_JPEG, rgb)) {
-      long r=0,g=0,b=0; int cnt = fb->width * fb->height;
-      for (int i=0;i<cnt;++i){ r+=rgb[i*3]; g+=rgb[i*3+1]; b+=rgb[i*3+2]; }
-      float r_avg = (float)r/cnt, g_avg=(float)g/cnt, b_avg=(float)b/cnt;
-      float brightness = (0.299f*r_avg + 0.587f*g_avg + 0.114f*b_avg)/255.0f;
-      float contrast = (fabsf(r_avg-g_avg)+fabsf(g_avg-b_avg)+fabsf(b_avg-r_avg))/(3.0f*255.0f);
-      float texture = 1.0f - ((float)fb->len / (fb->width*fb->height*3.0f));
-      float feat[6] = { r_avg/255.0f, g_avg/255.0f, b_avg/255.0f, brightness, contrast, texture };
-      for (int i=0;i<6;++i) acc[i]+=feat[i]; n++;
+    // Só as médias: 1/8 (DC de cada bloco), mesmo decodificador da análise;
+    // em YUV422, as mesmas estatísticas por linha da análise
+    const bool yuv = fb->format == PIXFORMAT_YUV422;
+    PoolLease work(buffer_pool, yuv ? 0 : kJpegLumaWorkSize, kPoolInternal);
+    JpegScaledSink sink;
+    jpegScaledBegin(&sink, fb->buf, nullptr, 0);
+    sink.work = work.as<uint8_t>();
+    sink.work_size = kJpegLumaWorkSize;
+    if (yuv) yuv422FrameStats(fb, &sink.stats);
+    if (yuv || jpegScaledDecodeLuma(&sink, fb->len, kJpegMaxScale)) {
+      float feat[kGateFeatures];
+      imageStatsFeatures(sink.stats, yuv ? 0 : fb->len, fb->width, fb->height, feat);
+      welfordAdd(&calib, feat);
     }
-    if (rgb) free(rgb); esp_camera_fb_return(fb); delay(80);
+    esp_camera_fb_return(fb); delay(80);
+  }
+  if (calib.count>0) {
+    for (int i=0;i<6;++i) center_vec[i]=calib.mean[i];
+    calibrated = true;
+    gate.clearProfiles(); gate.addProfile(center_vec);
   }
-  if (n>0) { for (int i=0;i<6;++i) center_vec[i]=acc[i]/n; calibrated = true; }
-  JsonDocument doc; doc["calibrated"]=calibrated; doc["samples"]=n; doc["THRESH"]=THRESH;
+  resumePipeline();
+  JsonDocument doc; doc["calibrated"]=calibrated; doc["samples"]=calib.count; doc["THRESH"]=THRESH;
   JsonArray c = doc.createNestedArray("center"); for(int i=0;i<6;++i) c.add(center_vec[i]);
+  // Dispersão entre as amostras: perfil instável (mão tremendo, luz variando) aparece aqui
+  JsonArray sd = doc.createNestedArray("std"); for(int i=0;i<6;++i) sd.add(welfordStd(calib, i));
   String res; serializeJson(doc,res); server.send(200,"application/json",res);
 }
 // ===== FUNÇÕES DO SERVIDOR WEB =====
 
+// JPEG do frame: o próprio buffer, ou o YUV422 comprimido só para o navegador
+// (*owned = true: liberar com free)
+static bool frameJpeg(const camera_fb_t* fb, const uint8_t** jpg, size_t* len, bool* owned) {
+  *owned = fb->format != PIXFORMAT_JPEG;
+  if (!*owned) {
+    *jpg = fb->buf;
+    *len = fb->len;
+    return true;
+  }
+  uint8_t* converted = nullptr;
+  if (!frame2jpg((camera_fb_t*)fb, 80, &converted, len)) return false;
+  *jpg = converted;
+  return true;
+}
+
 void handleCapture() {
   if (!camera_available) {
     server.send(500, "text/plain", "Câmera não disponível");
     return;
   }
 
-  camera_fb_t* fb = esp_camera_fb_get();
-  if (!fb) {
-    server.send(500, "text/plain", "Falha ao capturar imagem");
+  // O último frame analisado, sem nova captura: os fb do driver são todos do
+  // pipeline, então antes do primeiro snapshot não há o que servir
+  FrameRef frame = frame_snapshot.get();
+  if (!frame) {
+    server.sendHeader("Retry-After", "1");
+    server.send(503, "text/plain", "Nenhum frame capturado ainda");
     return;
   }
 
-  // Análise real da imagem
-  analyzeRealCharacteristics(fb);
+  const uint8_t* jpg = nullptr;
+  size_t jpg_len = 0;
+  bool owned = false;
+  if (frameJpeg(frame.as<camera_fb_t>(), &jpg, &jpg_len, &owned)) {
+    server.send_P(200, "image/jpeg", (const char*)jpg, jpg_len);
+    if (owned) free((void*)jpg);
+  } else {
+    server.send(500, "text/plain", "Falha ao converter frame para JPEG");
+  }
+}
+
+// Cliente MJPEG: cada frame novo do snapshot, segurado só enquanto é enviado
+static void streamTask(void* arg) {
+  WiFiClient* client = (WiFiClient*)arg;
+  client->print("HTTP/1.1 200 OK\r\n"
+                "Content-Type: multipart/x-mixed-replace; boundary=frame\r\n"
+                "Cache-Control: no-cache\r\n\r\n");
+  uint32_t last_seq = 0;
+  while (client->connected()) {
+    FrameRef frame = frame_snapshot.get();
+    if (!frame || frame.seq() == last_seq) {
+      vTaskDelay(pdMS_TO_TICKS(20));
+      continue;
+    }
+    last_seq = frame.seq();
+    const uint8_t* jpg = nullptr;
+    size_t jpg_len = 0;
+    bool owned = false;
+    if (!frameJpeg(frame.as<camera_fb_t>(), &jpg, &jpg_len, &owned)) continue;
+    client->printf("--frame\r\nContent-Type: image/jpeg\r\nContent-Length: %u\r\n\r\n",
+                   (unsigned)jpg_len);
+    const bool sent = client->write(jpg, jpg_len) == jpg_len;
+    if (owned) free((void*)jpg);
+    if (!sent) break;
+    client->print("\r\n");
+  }
+  client->stop();
+  delete client;
+  --stream_clients;
+  vTaskDelete(nullptr);
+}
 
-  // Retorna a imagem
-  server.send_P(200, "image/jpeg", (const char*)fb->buf, fb->len);
-  esp_camera_fb_return(fb);
+// /stream: o envio roda numa tarefa própria, e o loop() segue atendendo o HTTP
+void handleStream() {
+  if (!camera_available) {
+    server.send(500, "text/plain", "Câmera não disponível");
+    return;
+  }
+  if (stream_clients.fetch_add(1) >= kMaxStreamClients) {
+    --stream_clients;
+    server.send(503, "text/plain", "Limite de clientes do stream atingido");
+    return;
+  }
+  WiFiClient* client = new WiFiClient(server.client());
+  if (xTaskCreatePinnedToCore(streamTask, "stream", kStreamTaskStack, client, 1, nullptr, 0) !=
+      pdPASS) {
+    delete client;
+    --stream_clients;
+    server.send(500, "text/plain", "Falha ao criar a tarefa do stream");
+  }
 }
 
 void handleStatus() {
   JsonDocument doc;
+  xSemaphoreTake(analysis_mutex, portMAX_DELAY);
   doc["label"] = classificationResult.label;
   doc["confidence"] = classificationResult.confidence;
   doc["r_avg"] = classificationResult.r_avg;
@@ -226,12 +698,104 @@ void handleStatus() {
   doc["brightness"] = classificationResult.brightness;
   doc["contrast"] = classificationResult.contrast;
   doc["texture"] = classificationResult.texture;
+  doc["luma_std"] = classificationResult.luma_std;
+  doc["gradient_energy"] = classificationResult.gradient_energy;
+  JsonArray hist = doc["luma_hist"].to<JsonArray>();
+  for (int i = 0; i < kStatsBins; ++i) hist.add(classificationResult.luma_hist[i]);
   doc["image_width"] = classificationResult.image_width;
   doc["image_height"] = classificationResult.image_height;
   doc["image_size"] = classificationResult.image_size;
   doc["analysis_count"] = classificationResult.analysis_count;
   doc["analysis_time_ms"] = classificationResult.analysis_time_ms;
   doc["camera_available"] = camera_available;
+  doc["model_ready"] = model_ready;
+  doc["used_cnn"] = classificationResult.used_cnn;
+  doc["profile_distance"] = classificationResult.profile_distance;
+
+  // Cascata: quantos frames o gate resolveu sem CNN e quanto tempo isso poupou
+  const GateStats& gs = gate.stats();
+  JsonObject g = doc["gate"].to<JsonObject>();
+  g["decision"] = classificationResult.gate_decision;
+  g["frames"] = gs.frames;
+  g["empty_scenes"] = gs.empty_scenes;
+  g["far_from_profile"] = gs.far_frames;
+  g["cnn_runs"] = gs.model_runs;
+  g["hit_rate"] = gate.hitRate();
+  g["cnn_avg_ms"] = gs.avg_model_ms;
+  g["latency_saved_ms"] = gate.savedMs();
+
+  // Pool de buffers: heap estável = só hits depois do boot
+  const PoolStats& ps = buffer_pool.stats();
+  JsonObject p = doc["pool"].to<JsonObject>();
+  p["hits"] = ps.hits;
+  p["misses"] = ps.misses;
+  p["hit_rate"] = buffer_pool.hitRate();
+  p["in_use"] = ps.in_use;
+  p["peak_in_use"] = ps.peak_in_use;
+  p["internal_bytes"] = buffer_pool.reservedBytes(kPoolInternal);
+  p["psram_bytes"] = buffer_pool.reservedBytes(kPoolPsram);
+  p["heap_free"] = ESP.getFreeHeap();
+  p["heap_min_free"] = ESP.getMinFreeHeap();
+
+  // Pipeline captura -> anel -> inferência
+  JsonObject pl = doc["pipeline"].to<JsonObject>();
+  pl["running"] = capture_task != nullptr;
+  pl["captured"] = pipeline_stats.captured;
+  pl["analyzed"] = pipeline_stats.analyzed;
+  pl["fps"] = pipeline_stats.fps;
+  pl["ring_size"] = frame_ring.size();
+  pl["ring_full_waits"] = pipeline_stats.ring_full_waits;
+
+  // Frames compartilhados: devolvidos ao driver só pela última referência
+  const SharedFrameStats fs = frame_table.stats();
+  JsonObject fr = doc["frames"].to<JsonObject>();
+  fr["wrapped"] = fs.wrapped;
+  fr["returned"] = fs.returned;
+  fr["live"] = fs.live;
+  fr["peak_live"] = fs.peak_live;
+  fr["table_full"] = fs.table_full;
+  fr["stream_clients"] = stream_clients.load();
+  xSemaphoreGive(analysis_mutex);
+
+  String response;
+  serializeJson(doc, response);
+  server.send(200, "application/json", response);
+}
+
+// Agregados por camada desde o último reset (?reset=1 zera após responder)
+void handleProfile() {
+  JsonDocument doc;
+  xSemaphoreTake(analysis_mutex, portMAX_DELAY);
+  doc["model_ready"] = model_ready;
+  doc["inferences"] = profiler.inferences();
+  doc["cycles_per_us"] = LayerProfiler::cyclesPerUs();
+  doc["arena_used"] = engine.arenaUsed();
+  doc["kernel_backend"] = engine.activeKernelBackend() ? engine.activeKernelBackend()->name
+                                                       : "reference";
+  doc["total_macs"] = profiler.totalMacs();
+  doc["total_bytes_read"] = profiler.totalBytesRead();
+  doc["mean_inference_us"] = profiler.meanInferenceUs();
+
+  JsonArray layers = doc["layers"].to<JsonArray>();
+  for (int i = 0; i < profiler.layerCount(); ++i) {
+    const LayerProfile& p = profiler.layer(i);
+    JsonObject l = layers.add<JsonObject>();
+    l["index"] = i;
+    l["op"] = LayerProfiler::opName(p.op);
+    l["macs"] = p.macs;
+    l["bytes_read"] = p.bytes_read;
+    l["bytes_written"] = p.bytes_written;
+    l["arena_bytes"] = p.arena_bytes;
+    l["mean_cycles"] = profiler.meanCycles(i);
+    l["min_cycles"] = profiler.inferences() ? p.min_cycles : 0;
+    l["max_cycles"] = p.max_cycles;
+    l["last_cycles"] = p.last_cycles;
+    l["mean_us"] = profiler.meanUs(i);
+    l["macs_per_cycle"] = profiler.macsPerCycle(i);
+    l["share"] = profiler.share(i);
+  }
+  if (server.hasArg("reset")) profiler.reset();
+  xSemaphoreGive(analysis_mutex);
 
   String response;
   serializeJson(doc, response);
@@ -364,6 +928,7 @@ String getIndexHTML() {
                         <p><strong>Análises Realizadas:</strong> ${data.analysis_count || 0}</p>
                         <p><strong>Tempo de Análise:</strong> ${data.analysis_time_ms || 0}ms</p>
                         <p><strong>Câmera:</strong> ${data.camera_available ? '✅ Disponível' : '❌ Indisponível'}</p>
+                        <p><strong>Gate:</strong> ${data.gate ? (data.gate.hit_rate * 100).toFixed(1) : 0}% dos frames sem CNN, ${data.gate ? data.gate.latency_saved_ms.toFixed(0) : 0}ms poupados</p>
                         <p><strong>Última Atualização:</strong> ${new Date().toLocaleTimeString()}</p>
                     `;
                 })
@@ -414,11 +979,11 @@ bool initCamera() {
   config.pin_reset = RESET_GPIO_NUM;
   config.xclk_freq_hz = 20000000;
   config.frame_size = FRAMESIZE_240X240;
-  config.pixel_format = PIXFORMAT_JPEG;
-  config.grab_mode = CAMERA_GRAB_WHEN_EMPTY;
+  config.pixel_format = kCapturePixelFormat;
+  config.grab_mode = CAMERA_GRAB_LATEST;
   config.fb_location = CAMERA_FB_IN_PSRAM;
   config.jpeg_quality = 12;
-  config.fb_count = 1;
+  config.fb_count = kCameraFbCount;
 
   esp_err_t err = esp_camera_init(&config);
   if (err != ESP_OK) {
@@ -435,12 +1000,29 @@ bool initCamera() {
 void setup() {
   Serial.begin(115200);
   Serial.println("\n🚀 Iniciando Sistema de Análise Real Avançada...");
+  analysis_mutex = xSemaphoreCreateMutex();
 
   // Inicializa câmera
   if (!initCamera()) {
     Serial.println("❌ Falha na inicialização da câmera");
   }
 
+  // Buffers por frame antes do modelo (o teste do backend já usa o pool)
+  if (!buffer_pool.reserve(kPoolInternal, kJpegLumaWorkSize, 1) ||
+      !buffer_pool.reserve(kPoolInternal, sizeof(InputAreaStream), 1) ||
+      !buffer_pool.reserve(kPoolPsram, kFrameLumaSize, 1)) {
+    Serial.println("⚠️ Pool de buffers incompleto: frames sem reserva vão ao heap");
+  }
+  Serial.printf("📦 Pool de buffers: %u B SRAM interna, %u B PSRAM\n",
+                (unsigned)buffer_pool.reservedBytes(kPoolInternal),
+                (unsigned)buffer_pool.reservedBytes(kPoolPsram));
+
+  // Modelo INT8 (2º estágio) e gate (rejeita além de 2 x THRESH do perfil)
+  model_ready = initModel();
+  GateConfig gate_config = FeatureGate::defaultConfig();
+  gate_config.reject_distance = THRESH * 2.0f;
+  gate.setConfig(gate_config);
+
   // Conecta WiFi
   WiFi.begin(ssid, password);
   Serial.print("Conectando ao WiFi");
@@ -462,7 +1044,9 @@ void setup() {
   // Configura servidor web
   server.on("/", handleRoot);
   server.on("/capture.jpg", handleCapture);
+  server.on("/stream", handleStream);
   server.on("/status", handleStatus);
+  server.on("/profile", handleProfile);
   server.on("/calibrate", handleCalibrate);
   server.on("/test", handleTest);
   
@@ -473,7 +1057,17 @@ void setup() {
   classificationResult.label = "NENHUM";
   classificationResult.confidence = 0.0f;
   classificationResult.analysis_count = 0;
-  classificationResult.analysis_time_ms = millis();
+  classificationResult.analysis_time_ms = 0;
+  classificationResult.gate_decision = FeatureGate::decisionName(kGateRunModel);
+  classificationResult.profile_distance = -1.0f;
+  classificationResult.used_cnn = false;
+
+  // Captura e inferência em tarefas próprias, uma em cada núcleo
+  if (camera_available && startPipeline()) {
+    Serial.println("🎞️ Pipeline: captura (núcleo 0) -> anel SPSC -> inferência (núcleo 1)");
+  } else if (camera_available) {
+    Serial.println("❌ Falha ao criar as tarefas do pipeline");
+  }
 
   Serial.println("🎯 Sistema pronto para análise real!");
 }
@@ -4,10 +4,20 @@ SPRINT 3 - Conversor de Modelo .tflite para Array C
 ===================================================
 
 Este script converte o modelo .tflite para um array C que pode ser
-incorporado no firmware do ESP32-CAM.
+incorporado no firmware do ESP32-CAM. Junto com g_model é emitido
+g_model_packed: os pesos da FullyConnected grande (int4, ou em blocos de
+canais com --no-int4) e as tabelas de requantização (weight_packing.py), lidos direto
+da flash pelo motor INT8 sem reempacotamento no boot.
+
+Com --spiffs DIR, o .tflite e o blob I8PK também são gravados como
+arquivos (model_int8.tflite / model_int8.i8pk) em DIR, normalmente
+firmware/data/, para o firmware carregá-los da SPIFFS (model_file.h)
+sem recompilar.
 
 Uso:
     python convert_to_c_array.py model_int8.tflite
+    python convert_to_c_array.py model_int8.tflite --no-packed
+    python convert_to_c_array.py model_int8.tflite --spiffs ../firmware/data
 
 Autor: Equipe SPRINT 3
 Data: 2025
@@ -17,13 +27,52 @@ import os
 import sys
 import argparse
 
-def convert_tflite_to_c_array(tflite_path, output_path="model.h"):
+def write_c_array(f, name, data):
+    """Escreve os bytes como array C alinhado a 16 bytes, 12 por linha."""
+    f.write(f"alignas(16) const unsigned char {name}[] = {{\n")
+    for i, byte in enumerate(data):
+        if i % 12 == 0:
+            f.write("  ")
+        f.write(f"0x{byte:02x}")
+        if i < len(data) - 1:
+            f.write(",")
+        if i % 12 == 11:
+            f.write("\n")
+        elif i % 12 != 11:
+            f.write(" ")
+
+    if len(data) % 12 != 0:
+        f.write("\n")
+
+    f.write("};\n\n")
+    f.write(f"const int {name}_len = {len(data)};\n")
+
+SPIFFS_MODEL_NAME = "model_int8.tflite"
+SPIFFS_PACKED_NAME = "model_int8.i8pk"
+
+def write_spiffs_files(spiffs_dir, data, packed_blob):
+    """Grava o modelo e os pesos empacotados como arquivos para a SPIFFS."""
+    os.makedirs(spiffs_dir, exist_ok=True)
+    with open(os.path.join(spiffs_dir, SPIFFS_MODEL_NAME), 'wb') as f:
+        f.write(data)
+    packed_path = os.path.join(spiffs_dir, SPIFFS_PACKED_NAME)
+    if packed_blob is not None:
+        with open(packed_path, 'wb') as f:
+            f.write(packed_blob)
+    elif os.path.exists(packed_path):
+        os.remove(packed_path)  # Não deixa um .i8pk de outro modelo para trás
+
+def convert_tflite_to_c_array(tflite_path, output_path="model.h", packed=True, spiffs_dir=None,
+                              int4=True):
     """
     Converte um arquivo .tflite para um array C.
     
     Args:
         tflite_path (str): Caminho para o arquivo .tflite
         output_path (str): Caminho para o arquivo .h de saída
+        packed (bool): Também emite os pesos empacotados (g_model_packed)
+        spiffs_dir (str): Se definido, grava também os arquivos para a SPIFFS
+        int4 (bool): FullyConnected grande em 4 bits (False: em blocos int8)
     """
     if not os.path.exists(tflite_path):
         print(f"ERRO: Arquivo {tflite_path} não encontrado!")
@@ -33,6 +82,12 @@ def convert_tflite_to_c_array(tflite_path, output_path="model.h"):
         # Lê o arquivo binário
         with open(tflite_path, 'rb') as f:
             data = f.read()
+
+        packed_blob = None
+        if packed:
+            import tflite_reader
+            import weight_packing
+            packed_blob = weight_packing.build_packed_blob(tflite_reader.Model(data), int4=int4)
         
         # Converte para array C
         with open(output_path, 'w') as f:
@@ -40,30 +95,27 @@ def convert_tflite_to_c_array(tflite_path, output_path="model.h"):
             f.write("#include <stdint.h>\n\n")
             f.write("// Modelo TensorFlow Lite quantizado INT8\n")
             f.write("// Gerado automaticamente pelo script convert_to_c_array.py\n\n")
-            f.write("const unsigned char g_model[] = {\n")
-            
-            # Escreve os bytes em formato hexadecimal
-            for i, byte in enumerate(data):
-                if i % 12 == 0:
-                    f.write("  ")
-                f.write(f"0x{byte:02x}")
-                if i < len(data) - 1:
-                    f.write(",")
-                if i % 12 == 11:
-                    f.write("\n")
-                elif i % 12 != 11:
-                    f.write(" ")
-            
-            if len(data) % 12 != 0:
-                f.write("\n")
-            
-            f.write("};\n\n")
-            f.write(f"const int g_model_len = {len(data)};\n")
+            # Alinhado a 16 bytes: o motor INT8 lê bias/escalas direto do flatbuffer
+            write_c_array(f, "g_model", data)
+            if packed_blob is not None:
+                f.write("\n// Pesos da FullyConnected grande (int4 ou em blocos) e tabelas de\n")
+                f.write("// requantização por canal (formato I8PK)\n")
+                f.write("// Uso: engine.setPackedWeights(g_model_packed, g_model_packed_len)\n")
+                write_c_array(f, "g_model_packed", packed_blob)
+
+        if spiffs_dir:
+            write_spiffs_files(spiffs_dir, data, packed_blob)
         
         print(f"✅ Modelo convertido com sucesso!")
         print(f"   Arquivo de entrada: {tflite_path}")
         print(f"   Arquivo de saída: {output_path}")
         print(f"   Tamanho: {len(data):,} bytes ({len(data)/1024:.1f} KB)")
+        if packed_blob is not None:
+            print(f"   Pesos empacotados: {len(packed_blob):,} bytes "
+                  f"({len(packed_blob)/1024:.1f} KB)")
+        if spiffs_dir:
+            print(f"   Arquivos SPIFFS: {spiffs_dir}/{SPIFFS_MODEL_NAME}"
+                  f"{'' if packed_blob is None else ', ' + SPIFFS_PACKED_NAME}")
         
         return True
         
@@ -75,6 +127,12 @@ def main():
     parser = argparse.ArgumentParser(description="Converte modelo .tflite para array C")
     parser.add_argument("input", help="Caminho para o arquivo .tflite")
     parser.add_argument("-o", "--output", default="model.h", help="Arquivo .h de saída")
+    parser.add_argument("--no-packed", action="store_true",
+                        help="Não emite g_model_packed (pesos em blocos de canais)")
+    parser.add_argument("--no-int4", action="store_true",
+                        help="Camada densa em blocos int8 no blob I8PK, no lugar dos pesos int4")
+    parser.add_argument("--spiffs", metavar="DIR",
+                        help="Também grava model_int8.tflite/.i8pk em DIR (ex.: ../firmware/data)")
     
     args = parser.parse_args()
     
@@ -82,7 +140,8 @@ def main():
     print("SPRINT 3 - Conversor .tflite para Array C")
     print("=" * 50)
     
-    success = convert_tflite_to_c_array(args.input, args.output)
+    success = convert_tflite_to_c_array(args.input, args.output, packed=not args.no_packed,
+                                        spiffs_dir=args.spiffs, int4=not args.no_int4)
     
     if success:
         print("\n✅ Conversão concluída com sucesso!")
@@ -90,6 +149,8 @@ def main():
         print(f"1. Copie {args.output} para firmware/src/")
         print(f"2. Compile o firmware com PlatformIO")
         print(f"3. Faça upload para o ESP32-CAM")
+        if args.spiffs:
+            print(f"4. Grave a SPIFFS com firmware/data_upload.py (troca de modelo sem reflash)")
     else:
         print("\n❌ Falha na conversão.")
         sys.exit(1)
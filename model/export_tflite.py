@@ -13,6 +13,7 @@ Requisitos:
 
 Uso:
     python export_tflite.py
+    python export_tflite.py --block-sparsity 0.5   # poda estruturada em blocos
 
 Autor: Equipe SPRINT 3
 Data: 2025
@@ -49,6 +50,13 @@ REP_DIRS = [
 # Labels das classes
 CLASS_LABELS = ["HP_ORIGINAL", "NAO_HP"]
 
+# Poda estruturada: fração das faixas de pesos zeradas (0 = modelo denso).
+# As faixas seguem o layout lido pelo firmware (block_sparse.h):
+# SPARSE_SPAN posições consecutivas de (ky, kx, ic) x PACK_BLOCK canais
+BLOCK_SPARSITY = 0.0
+SPARSE_SPAN = 16        # kSparseSpan
+PACK_BLOCK = 4          # kPackBlock
+
 # =============================================================================
 # FUNÇÕES AUXILIARES
 # =============================================================================
@@ -128,6 +136,45 @@ def representative_dataset():
     
     print(f"Total de amostras processadas: {processed}")
 
+def prune_block_sparse(model, sparsity):
+    """
+    Poda por magnitude em blocos: em cada Conv2D/Dense elegível, zera a
+    fração `sparsity` das faixas [SPARSE_SPAN entradas x PACK_BLOCK canais
+    de saída] de menor norma L1. O classificador final fica denso.
+
+    A quantização INT8 dos pesos é simétrica por canal, então os zeros
+    continuam exatos no .tflite e weight_packing.py gera a seção
+    esparsa (LAYOUT_BLOCK_SPARSE) dessas camadas. É uma poda única, sem
+    re-treino: confira a acurácia do modelo exportado.
+
+    Args:
+        model (tf.keras.Model): Modelo carregado (alterado no lugar)
+        sparsity (float): Fração de faixas zeradas, em [0, 1)
+    """
+    layers = [l for l in model.layers
+              if isinstance(l, (tf.keras.layers.Conv2D, tf.keras.layers.Dense))
+              and not isinstance(l, tf.keras.layers.DepthwiseConv2D)]
+    for layer in layers[:-1]:
+        kernel = layer.kernel.numpy()
+        in_c, out_c = kernel.shape[-2], kernel.shape[-1]
+        if in_c % SPARSE_SPAN != 0:
+            print(f"  - {layer.name}: {in_c} canais de entrada, fica densa")
+            continue
+        # [R][O] com R na ordem (ky, kx, ic) do OHWI, canais completados até o bloco
+        flat = kernel.reshape(-1, out_c)
+        rows = flat.shape[0]
+        blocks = -(-out_c // PACK_BLOCK)
+        padded = np.zeros((rows, blocks * PACK_BLOCK), dtype=flat.dtype)
+        padded[:, :out_c] = flat
+        tiles = padded.reshape(rows // SPARSE_SPAN, SPARSE_SPAN, blocks, PACK_BLOCK)
+        scores = np.abs(tiles).sum(axis=(1, 3))          # [faixas][blocos]
+        pruned = int(round(sparsity * scores.size))
+        keep = np.ones(scores.size, dtype=bool)
+        keep[np.argsort(scores, axis=None, kind="stable")[:pruned]] = False
+        tiles = tiles * keep.reshape(scores.shape)[:, None, :, None]
+        layer.kernel.assign(tiles.reshape(rows, -1)[:, :out_c].reshape(kernel.shape))
+        print(f"  - {layer.name}: {pruned}/{scores.size} faixas zeradas")
+
 def validate_model_size(tflite_path, max_size_mb=1.0):
     """
     Valida se o modelo está dentro do tamanho limite.
@@ -185,6 +232,10 @@ def export_model():
         print(f"  - Input shape: {model.input_shape}")
         print(f"  - Output shape: {model.output_shape}")
         print(f"  - Parâmetros: {model.count_params():,}")
+
+        if BLOCK_SPARSITY > 0.0:
+            print(f"\nPoda estruturada em blocos ({BLOCK_SPARSITY:.0%} das faixas):")
+            prune_block_sparse(model, BLOCK_SPARSITY)
         
         # 2. Configura o conversor TensorFlow Lite
         print("\nConfigurando conversor TensorFlow Lite...")
@@ -247,6 +298,8 @@ if __name__ == "__main__":
     parser.add_argument("--output", default=OUT_TFLITE, help="Nome do arquivo .tflite de saída")
     parser.add_argument("--img-size", type=int, default=IMG_SIZE, help="Tamanho da imagem de entrada")
     parser.add_argument("--channels", type=int, default=CHANNELS, help="Número de canais (1=grayscale, 3=RGB)")
+    parser.add_argument("--block-sparsity", type=float, default=BLOCK_SPARSITY,
+                        help="Fração das faixas de pesos zeradas pela poda em blocos (0 = densa)")
     
     args = parser.parse_args()
     
@@ -255,6 +308,9 @@ if __name__ == "__main__":
     OUT_TFLITE = args.output
     IMG_SIZE = args.img_size
     CHANNELS = args.channels
+    BLOCK_SPARSITY = args.block_sparsity
+    if not 0.0 <= BLOCK_SPARSITY < 1.0:
+        parser.error("--block-sparsity deve estar em [0, 1)")
     
     # Executa a exportação
     success = export_model()
@@ -0,0 +1,259 @@
+#!/usr/bin/env python3
+"""
+SPRINT 3 - Gerador de Código C++ do Modelo INT8
+===============================================
+
+Compila o model_int8.tflite em um header C++ (model_compiled.h) com a
+sequência de camadas, formas, pesos, bias e multiplicadores/shifts de
+requantização como dados constexpr. Cada camada vira uma chamada a um
+kernel template (firmware/lib/int8_engine/compiled_kernels.h)
+instanciado com as suas dimensões, eliminando no runtime o parsing do
+flatbuffer e o despacho do interpretador.
+
+A resolução do grafo (fusão Conv2D+MaxPool2D, planejamento da arena,
+aritmética de requantização) vem de tflite_reader.py e reproduz a do
+Int8Engine, então a saída é idêntica bit a bit (ver
+firmware/host/host_compiled.cpp).
+
+Uso:
+    python generate_model_code.py model_int8.tflite -o ../firmware/src/model_compiled.h
+
+Autor: Equipe SPRINT 3
+Data: 2025
+"""
+
+import argparse
+import os
+import struct
+import sys
+
+import tflite_reader as tfr
+
+OP_NAMES = {
+    "conv": "Conv2D",
+    "pool": "MaxPool2D",
+    "conv_pool": "Conv2D+MaxPool2D",
+    "fc": "FullyConnected",
+    "softmax": "Softmax",
+}
+
+# =============================================================================
+# FORMATAÇÃO
+# =============================================================================
+
+def c_float(value):
+    """Literal float com 9 dígitos (ida e volta exata em float32)."""
+    text = "%.9g" % value
+    if not any(ch in text for ch in ".eEn"):
+        text += ".0"
+    return text + "f"
+
+
+def c_array(decl, values, per_line=16):
+    lines = [f"{decl} = {{"]
+    for i in range(0, len(values), per_line):
+        lines.append("  " + ", ".join(str(v) for v in values[i:i + per_line]) + ",")
+    lines.append("};")
+    return "\n".join(lines)
+
+
+def int8_values(data):
+    return list(struct.unpack(f"<{len(data)}b", data))
+
+
+def int32_values(data):
+    return list(struct.unpack(f"<{len(data) // 4}i", data))
+
+
+def layer_macs(layer):
+    s = layer.shape
+    if layer.op in ("conv", "conv_pool"):
+        return s["out_h"] * s["out_w"] * s["out_c"] * s["k_h"] * s["k_w"] * s["in_c"]
+    if layer.op == "fc":
+        return s["in_c"] * s["out_c"]
+    return 0
+
+# =============================================================================
+# GERAÇÃO
+# =============================================================================
+
+def conv_template_args(s):
+    return (f"{s['in_h']}, {s['in_w']}, {s['in_c']}, {s['out_h']}, {s['out_w']}, {s['out_c']}, "
+            f"{s['k_h']}, {s['k_w']}, {s['stride_h']}, {s['stride_w']}, {s['pad_h']}, {s['pad_w']}")
+
+
+def emit_layer(model, index, layer, offsets):
+    """Retorna (declarações de dados, corpo da função da camada)."""
+    tin = model.tensors[tfr.tensor_root(model, layer.input)]
+    tout = model.tensors[tfr.tensor_root(model, layer.output)]
+    in_ptr = f"arena + {offsets[tin.index]}"
+    out_ptr = f"arena + {offsets[tout.index]}"
+    prefix = f"kLayer{index}"
+    s = layer.shape
+    data = []
+    body = []
+
+    if layer.op in ("conv", "conv_pool", "fc"):
+        weights = int8_values(model.tensors[layer.weights].data)
+        bias = (int32_values(model.tensors[layer.bias].data) if layer.bias >= 0
+                else [0] * s["out_c"])
+        data.append(c_array(f"alignas(16) constexpr int8_t {prefix}Weights[{len(weights)}]", weights))
+        data.append(c_array(f"alignas(16) constexpr int32_t {prefix}Bias[{len(bias)}]", bias, 8))
+        data.append(c_array(f"constexpr int32_t {prefix}Multiplier[{len(layer.multipliers)}]",
+                            layer.multipliers, 8))
+        data.append(c_array(f"constexpr int32_t {prefix}Shift[{len(layer.shifts)}]", layer.shifts))
+        body.append(f"  const compiled::Requant rq = {{{prefix}Multiplier, {prefix}Shift, "
+                    f"{tout.zero_point}, {layer.act_min}, {layer.act_max}}};")
+        args = f"({in_ptr}, {-tin.zero_point}, {prefix}Weights, {prefix}Bias, rq, {out_ptr});"
+        if layer.op == "conv":
+            body.append(f"  compiled::conv2d<{conv_template_args(s)}>{args}")
+        elif layer.op == "conv_pool":
+            p = layer.pool
+            body.append(f"  compiled::conv2dMaxPool<{conv_template_args(s)},\n"
+                        f"                          {p['k_h']}, {p['k_w']}, {p['stride_h']}, "
+                        f"{p['stride_w']}, {p['out_h']}, {p['out_w']}>{args}")
+        else:
+            body.append(f"  compiled::fullyConnected<{s['in_c']}, {s['out_c']}>{args}")
+    elif layer.op == "pool":
+        body.append(f"  compiled::maxPool2d<{s['in_h']}, {s['in_w']}, {s['in_c']}, {s['out_h']}, "
+                    f"{s['out_w']}, {s['k_h']}, {s['k_w']}, {s['stride_h']}, {s['stride_w']}, "
+                    f"{s['pad_h']}, {s['pad_w']}>({in_ptr}, {layer.act_min}, {layer.act_max}, "
+                    f"{out_ptr});")
+    elif layer.op == "softmax":
+        body.append(f"  softmaxInt8({s['out_c']}, {in_ptr}, {c_float(tin.scale)}, {tin.zero_point}, "
+                    f"{c_float(layer.beta)}, {c_float(tout.scale)}, {tout.zero_point}, {out_ptr});")
+    return data, body
+
+
+def generate(tflite_path, output_path):
+    model = tfr.load_model(tflite_path)
+    layers = tfr.resolve_layers(model, fuse=True)
+    offsets, arena_size = tfr.plan_arena(model, layers)
+
+    tin = model.tensors[tfr.tensor_root(model, model.inputs[0])]
+    tout = model.tensors[tfr.tensor_root(model, model.outputs[0])]
+    if tin.type != tfr.TYPE_INT8 or len(tin.shape) != 4:
+        raise ValueError("entrada deve ser int8 NHWC")
+
+    out = []
+    out.append("#pragma once")
+    out.append("")
+    out.append("// Modelo INT8 compilado para C++ (formas em tempo de compilação)")
+    out.append(f"// Gerado automaticamente por generate_model_code.py a partir de "
+               f"{os.path.basename(tflite_path)}")
+    out.append("// Incluir em um único .cpp: os pesos ficam embutidos neste header.")
+    out.append("")
+    out.append("#include <stddef.h>")
+    out.append("#include <stdint.h>")
+    out.append("")
+    out.append('#include "compiled_kernels.h"')
+    out.append("")
+    out.append("namespace compiled_model {")
+    out.append("")
+    out.append(f"constexpr int kInputHeight = {tin.shape[1]};")
+    out.append(f"constexpr int kInputWidth = {tin.shape[2]};")
+    out.append(f"constexpr int kInputChannels = {tin.shape[3]};")
+    out.append(f"constexpr float kInputScale = {c_float(tin.scale)};")
+    out.append(f"constexpr int32_t kInputZeroPoint = {tin.zero_point};")
+    out.append(f"constexpr int kOutputSize = {tout.bytes};")
+    out.append(f"constexpr float kOutputScale = {c_float(tout.scale)};")
+    out.append(f"constexpr int32_t kOutputZeroPoint = {tout.zero_point};")
+    out.append("")
+    out.append("// Arena planejada por tempo de vida (ponteiro alinhado a 16 bytes)")
+    out.append(f"constexpr size_t kArenaSize = {arena_size};")
+    out.append(f"constexpr size_t kInputOffset = {offsets[tin.index]};")
+    out.append(f"constexpr size_t kOutputOffset = {offsets[tout.index]};")
+    out.append(f"constexpr int kLayerCount = {len(layers)};")
+    out.append("")
+
+    out.append("// Sequência de camadas")
+    out.append("struct LayerInfo {")
+    out.append("  const char* op;")
+    out.append("  int in_h, in_w, in_c;")
+    out.append("  int out_h, out_w, out_c;")
+    out.append("  uint32_t macs;")
+    out.append("  uint32_t input_offset, output_offset;")
+    out.append("};")
+    out.append("")
+    out.append("constexpr LayerInfo kLayers[kLayerCount] = {")
+    for layer in layers:
+        a = model.tensors[tfr.tensor_root(model, layer.input)]
+        b = model.tensors[tfr.tensor_root(model, layer.output)]
+        ad = (a.shape + [1, 1, 1, 1])[:4] if len(a.shape) == 4 else [1, 1, 1, a.bytes]
+        bd = (b.shape + [1, 1, 1, 1])[:4] if len(b.shape) == 4 else [1, 1, 1, b.bytes]
+        out.append(f'  {{"{OP_NAMES[layer.op]}", {ad[1]}, {ad[2]}, {ad[3]}, {bd[1]}, {bd[2]}, '
+                   f'{bd[3]}, {layer_macs(layer)}u, {offsets[a.index]}u, {offsets[b.index]}u}},')
+    out.append("};")
+    out.append("")
+
+    functions = []
+    for i, layer in enumerate(layers):
+        data, body = emit_layer(model, i, layer, offsets)
+        s = layer.shape
+        out.append(f"// Camada {i}: {OP_NAMES[layer.op]}")
+        out.extend(data)
+        out.append("")
+        functions.append(f"inline void layer{i}(int8_t* arena) {{")
+        functions.extend(body)
+        functions.append("}")
+        functions.append("")
+
+    out.extend(functions)
+    out.append("// Executa todas as camadas sobre a entrada em arena + kInputOffset")
+    out.append("inline void invoke(int8_t* arena) {")
+    for i in range(len(layers)):
+        out.append(f"  layer{i}(arena);")
+    out.append("}")
+    out.append("")
+    out.append("// Executa apenas a camada indicada (medição por camada)")
+    out.append("inline void invokeLayer(int index, int8_t* arena) {")
+    out.append("  switch (index) {")
+    for i in range(len(layers)):
+        out.append(f"    case {i}: layer{i}(arena); break;")
+    out.append("  }")
+    out.append("}")
+    out.append("")
+    out.append("inline int8_t* input(int8_t* arena) { return arena + kInputOffset; }")
+    out.append("inline const int8_t* output(const int8_t* arena) { return arena + kOutputOffset; }")
+    out.append("inline float outputValue(const int8_t* arena, int index) {")
+    out.append("  return ((int32_t)output(arena)[index] - kOutputZeroPoint) * kOutputScale;")
+    out.append("}")
+    out.append("")
+    out.append("}  // namespace compiled_model")
+    out.append("")
+
+    with open(output_path, "w") as f:
+        f.write("\n".join(out))
+
+    weight_bytes = sum(len(model.tensors[l.weights].data) for l in layers if l.weights >= 0)
+    print(f"✅ Código gerado: {output_path}")
+    print(f"   Camadas: {len(layers)} | Pesos: {weight_bytes:,} bytes | "
+          f"Arena: {arena_size:,} bytes")
+    for i, layer in enumerate(layers):
+        print(f"   [{i}] {OP_NAMES[layer.op]:<18} MACs={layer_macs(layer):,}")
+    return True
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Gera model_compiled.h a partir do .tflite")
+    parser.add_argument("input", nargs="?", default="model_int8.tflite",
+                        help="Caminho para o arquivo .tflite")
+    parser.add_argument("-o", "--output", default="model_compiled.h", help="Arquivo .h de saída")
+    args = parser.parse_args()
+
+    print("=" * 50)
+    print("SPRINT 3 - Gerador de Código do Modelo INT8")
+    print("=" * 50)
+
+    if not os.path.exists(args.input):
+        print(f"ERRO: Arquivo {args.input} não encontrado!")
+        sys.exit(1)
+    try:
+        generate(args.input, args.output)
+    except (ValueError, KeyError, IndexError, struct.error) as e:
+        print(f"ERRO durante a geração: {e}")
+        sys.exit(1)
+
+
+if __name__ == "__main__":
+    main()
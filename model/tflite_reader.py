@@ -0,0 +1,390 @@
+#!/usr/bin/env python3
+"""
+SPRINT 3 - Leitor Mínimo de Modelos .tflite
+===========================================
+
+Lê o flatbuffer TFLite sem depender do TensorFlow (apenas struct) e
+resolve o grafo exatamente como o motor INT8 do firmware
+(firmware/lib/int8_engine): operadores de forma descartados, RESHAPE
+como apelido, Conv2D+MaxPool2D fundidos, multiplicadores de
+requantização por canal e planejamento da arena por tempo de vida.
+
+Usado pelos geradores de código (generate_model_code.py) para que o
+código gerado e o motor interpretado produzam a mesma saída bit a bit.
+
+Autor: Equipe SPRINT 3
+Data: 2025
+"""
+
+import math
+import struct
+
+# =============================================================================
+# CONSTANTES DO SCHEMA TFLITE
+# =============================================================================
+
+BUILTIN_CONV_2D = 3
+BUILTIN_FULLY_CONNECTED = 9
+BUILTIN_MAX_POOL_2D = 17
+BUILTIN_RESHAPE = 22
+BUILTIN_SOFTMAX = 25
+BUILTIN_STRIDED_SLICE = 45
+BUILTIN_SHAPE = 77
+BUILTIN_PACK = 83
+SHAPE_OPS = (BUILTIN_SHAPE, BUILTIN_STRIDED_SLICE, BUILTIN_PACK)
+
+TYPE_FLOAT32 = 0
+TYPE_INT32 = 2
+TYPE_INT8 = 9
+
+ACT_NONE = 0
+ACT_RELU = 1
+ACT_RELU6 = 3
+
+PADDING_SAME = 0
+PADDING_VALID = 1
+
+ARENA_ALIGNMENT = 16
+
+# =============================================================================
+# LEITURA DO FLATBUFFER
+# =============================================================================
+
+class _Table:
+    """Tabela flatbuffer: acesso a campos pelo índice do schema."""
+
+    def __init__(self, buf, pos):
+        self.buf = buf
+        self.pos = pos
+        vtable = pos - struct.unpack_from("<i", buf, pos)[0]
+        self.vtable = vtable
+        self.vtable_len = struct.unpack_from("<H", buf, vtable)[0]
+
+    def _offset(self, field_id):
+        entry = 4 + 2 * field_id
+        if entry >= self.vtable_len:
+            return 0
+        return struct.unpack_from("<H", self.buf, self.vtable + entry)[0]
+
+    def scalar(self, field_id, fmt, default):
+        off = self._offset(field_id)
+        if not off:
+            return default
+        return struct.unpack_from("<" + fmt, self.buf, self.pos + off)[0]
+
+    def table(self, field_id):
+        off = self._offset(field_id)
+        if not off:
+            return None
+        at = self.pos + off
+        return _Table(self.buf, at + struct.unpack_from("<I", self.buf, at)[0])
+
+    def vector(self, field_id):
+        """Retorna (posição do primeiro elemento, número de elementos)."""
+        off = self._offset(field_id)
+        if not off:
+            return 0, 0
+        at = self.pos + off
+        vec = at + struct.unpack_from("<I", self.buf, at)[0]
+        return vec + 4, struct.unpack_from("<I", self.buf, vec)[0]
+
+    def vector_values(self, field_id, fmt):
+        start, count = self.vector(field_id)
+        size = struct.calcsize("<" + fmt)
+        return [struct.unpack_from("<" + fmt, self.buf, start + i * size)[0] for i in range(count)]
+
+    def vector_tables(self, field_id):
+        start, count = self.vector(field_id)
+        tables = []
+        for i in range(count):
+            at = start + 4 * i
+            tables.append(_Table(self.buf, at + struct.unpack_from("<I", self.buf, at)[0]))
+        return tables
+
+
+class Tensor:
+    """Tensor do subgrafo com dados constantes (se houver) e quantização."""
+
+    def __init__(self, index):
+        self.index = index
+        self.shape = []
+        self.type = TYPE_FLOAT32
+        self.data = b""
+        self.data_offset = 0  # Posição dos dados dentro do arquivo .tflite
+        self.scales = []
+        self.zero_point = 0
+        self.alias_of = -1
+
+    @property
+    def scale(self):
+        return self.scales[0] if self.scales else 1.0
+
+    @property
+    def bytes(self):
+        count = 1
+        for d in self.shape:
+            count *= d if d > 0 else 1
+        return count * 4 if self.type == TYPE_INT32 else count
+
+
+class Operator:
+    def __init__(self, builtin, inputs, outputs, options):
+        self.builtin = builtin
+        self.inputs = inputs
+        self.outputs = outputs
+        self.options = options
+
+
+class Model:
+    """Modelo .tflite de um único subgrafo."""
+
+    def __init__(self, data):
+        if len(data) < 8 or data[4:8] != b"TFL3":
+            raise ValueError("flatbuffer TFLite inválido")
+        self.data = data
+        root = _Table(data, struct.unpack_from("<I", data, 0)[0])
+
+        buffers = []
+        for buf in root.vector_tables(4):
+            start, count = buf.vector(0)
+            buffers.append((start, count))
+
+        subgraph = root.vector_tables(2)[0]
+        self.tensors = []
+        for i, t in enumerate(subgraph.vector_tables(0)):
+            tensor = Tensor(i)
+            tensor.shape = t.vector_values(0, "i")
+            tensor.type = t.scalar(1, "B", TYPE_FLOAT32)
+            buffer_index = t.scalar(2, "I", 0)
+            if 0 < buffer_index < len(buffers):
+                start, count = buffers[buffer_index]
+                tensor.data = data[start:start + count]
+                tensor.data_offset = start
+            quant = t.table(4)
+            if quant is not None:
+                tensor.scales = quant.vector_values(2, "f")
+                zero_points = quant.vector_values(3, "q")
+                tensor.zero_point = zero_points[0] if zero_points else 0
+            self.tensors.append(tensor)
+
+        self.inputs = subgraph.vector_values(1, "i")
+        self.outputs = subgraph.vector_values(2, "i")
+
+        opcodes = []
+        for code in root.vector_tables(1):
+            builtin = code.scalar(3, "i", 0)
+            deprecated = code.scalar(0, "b", 0)
+            opcodes.append(max(builtin, deprecated))
+
+        self.operators = []
+        for op in subgraph.vector_tables(3):
+            builtin = opcodes[op.scalar(0, "I", 0)]
+            self.operators.append(Operator(builtin, op.vector_values(1, "i"),
+                                           op.vector_values(2, "i"), op.table(4)))
+
+
+def load_model(path):
+    with open(path, "rb") as f:
+        return Model(f.read())
+
+# =============================================================================
+# ARITMÉTICA (idêntica a int8_kernels.cpp / int8_engine.cpp)
+# =============================================================================
+
+def to_float32(value):
+    return struct.unpack("<f", struct.pack("<f", value))[0]
+
+
+def quantize_multiplier(real_multiplier):
+    """QuantizeMultiplier do TFLite: retorna (multiplicador Q31, shift)."""
+    if real_multiplier == 0.0:
+        return 0, 0
+    q, exponent = math.frexp(real_multiplier)
+    q_fixed = int(math.floor(q * (1 << 31) + 0.5))  # llround (q > 0)
+    if q_fixed == (1 << 31):
+        q_fixed //= 2
+        exponent += 1
+    if exponent < -31:
+        exponent = 0
+        q_fixed = 0
+    return q_fixed, exponent
+
+
+def activation_range(activation, scale, zero_point):
+    lo, hi = -128, 127
+    if activation in (ACT_RELU, ACT_RELU6):
+        lo = max(lo, zero_point)
+    if activation == ACT_RELU6:
+        six = to_float32(6.0 / scale)
+        hi = min(hi, zero_point + int(math.floor(six + 0.5)))
+    return lo, hi
+
+
+def compute_padding(padding, size_in, size_out, kernel, stride):
+    if padding != PADDING_SAME:
+        return 0
+    return max(((size_out - 1) * stride + kernel - size_in) // 2, 0)
+
+# =============================================================================
+# GRAFO RESOLVIDO
+# =============================================================================
+
+class Layer:
+    """Camada executável, com os mesmos campos do Int8Layer do firmware."""
+
+    def __init__(self, op):
+        self.op = op  # "conv", "pool", "conv_pool", "fc", "softmax"
+        self.input = -1
+        self.output = -1
+        self.weights = -1
+        self.bias = -1
+        self.activation = ACT_NONE
+        self.shape = {}
+        self.pool = {}
+        self.act_min = -128
+        self.act_max = 127
+        self.multipliers = []
+        self.shifts = []
+        self.beta = 1.0
+
+
+def tensor_root(model, index):
+    """Segue a cadeia de RESHAPE até o tensor que possui os dados."""
+    while index >= 0 and model.tensors[index].alias_of >= 0:
+        index = model.tensors[index].alias_of
+    return index
+
+
+def resolve_layers(model, fuse=True):
+    """Reproduz Int8Engine::parseOperators/fuseLayers sobre o modelo."""
+    layers = []
+    for op in model.operators:
+        if op.builtin in SHAPE_OPS:
+            continue
+        if op.builtin == BUILTIN_RESHAPE:
+            model.tensors[op.outputs[0]].alias_of = op.inputs[0]
+            continue
+
+        tin = model.tensors[op.inputs[0]]
+        tout = model.tensors[op.outputs[0]]
+        opt = op.options
+        if op.builtin == BUILTIN_CONV_2D:
+            layer = Layer("conv")
+            layer.weights = op.inputs[1]
+            layer.bias = op.inputs[2] if len(op.inputs) > 2 else -1
+            w = model.tensors[layer.weights]
+            padding = opt.scalar(0, "b", PADDING_SAME) if opt else PADDING_SAME
+            s = dict(in_h=tin.shape[1], in_w=tin.shape[2], in_c=tin.shape[3],
+                     out_h=tout.shape[1], out_w=tout.shape[2], out_c=tout.shape[3],
+                     k_h=w.shape[1], k_w=w.shape[2],
+                     stride_w=opt.scalar(1, "i", 1) if opt else 1,
+                     stride_h=opt.scalar(2, "i", 1) if opt else 1)
+            layer.activation = opt.scalar(3, "b", ACT_NONE) if opt else ACT_NONE
+        elif op.builtin == BUILTIN_MAX_POOL_2D:
+            layer = Layer("pool")
+            padding = opt.scalar(0, "b", PADDING_SAME)
+            s = dict(in_h=tin.shape[1], in_w=tin.shape[2], in_c=tin.shape[3],
+                     out_h=tout.shape[1], out_w=tout.shape[2], out_c=tout.shape[3],
+                     stride_w=opt.scalar(1, "i", 1), stride_h=opt.scalar(2, "i", 1),
+                     k_w=opt.scalar(3, "i", 1), k_h=opt.scalar(4, "i", 1))
+            layer.activation = opt.scalar(5, "b", ACT_NONE)
+        elif op.builtin == BUILTIN_FULLY_CONNECTED:
+            layer = Layer("fc")
+            layer.weights = op.inputs[1]
+            layer.bias = op.inputs[2] if len(op.inputs) > 2 else -1
+            w = model.tensors[layer.weights]
+            s = dict(out_c=w.shape[0], in_c=w.shape[1])
+            layer.activation = opt.scalar(0, "b", ACT_NONE) if opt else ACT_NONE
+        elif op.builtin == BUILTIN_SOFTMAX:
+            layer = Layer("softmax")
+            layer.beta = opt.scalar(0, "f", 1.0) if opt else 1.0
+            s = dict(in_c=tout.bytes, out_c=tout.bytes)
+        else:
+            raise ValueError(f"operador não suportado: {op.builtin}")
+
+        if layer.op in ("conv", "pool"):
+            s["pad_h"] = compute_padding(padding, s["in_h"], s["out_h"], s["k_h"], s["stride_h"])
+            s["pad_w"] = compute_padding(padding, s["in_w"], s["out_w"], s["k_w"], s["stride_w"])
+        layer.input = op.inputs[0]
+        layer.output = op.outputs[0]
+        layer.shape = s
+        layer.act_min, layer.act_max = activation_range(layer.activation, tout.scale,
+                                                        tout.zero_point)
+        if layer.op in ("conv", "fc"):
+            w = model.tensors[layer.weights]
+            for c in range(s["out_c"]):
+                w_scale = w.scales[0 if len(w.scales) == 1 else c]
+                m, sh = quantize_multiplier(tin.scale * w_scale / tout.scale)
+                layer.multipliers.append(m)
+                layer.shifts.append(sh)
+        layers.append(layer)
+
+    if fuse:
+        layers = _fuse(model, layers)
+    return layers
+
+
+def _fuse(model, layers):
+    output_root = tensor_root(model, model.outputs[0])
+    fused = []
+    i = 0
+    while i < len(layers):
+        conv = layers[i]
+        if conv.op == "conv" and i + 1 < len(layers):
+            pool = layers[i + 1]
+            mid = model.tensors[conv.output]
+            pooled = model.tensors[pool.output]
+            ok = (pool.op == "pool" and tensor_root(model, pool.input) == conv.output and
+                  output_root != conv.output and
+                  pool.shape["pad_h"] == 0 and pool.shape["pad_w"] == 0 and
+                  mid.scale == pooled.scale and mid.zero_point == pooled.zero_point and
+                  all(tensor_root(model, l.input) != conv.output for l in layers[i + 2:]))
+            if ok:
+                conv.op = "conv_pool"
+                conv.output = pool.output
+                conv.pool = pool.shape
+                conv.act_min = max(conv.act_min, pool.act_min)
+                conv.act_max = min(conv.act_max, pool.act_max)
+                fused.append(conv)
+                i += 2
+                continue
+        fused.append(conv)
+        i += 1
+    return fused
+
+
+def plan_arena(model, layers):
+    """Planejamento guloso por tamanho (arena_planner.cpp). Retorna (offsets, pico)."""
+    first, last = {}, {}
+    input_root = tensor_root(model, model.inputs[0])
+    output_root = tensor_root(model, model.outputs[0])
+    first[input_root] = -1
+    for i, layer in enumerate(layers):
+        src, dst = tensor_root(model, layer.input), tensor_root(model, layer.output)
+        first[dst] = min(first.get(dst, i), i)
+        last[src] = max(last.get(src, i), i)
+    last[output_root] = len(layers)
+
+    def align(v):
+        return (v + ARENA_ALIGNMENT - 1) & ~(ARENA_ALIGNMENT - 1)
+
+    buffers = [t for t in sorted(first) if t in last and first[t] <= last[t]]
+    # Mesma ordem estável do insertion sort do firmware (maiores primeiro)
+    order = sorted(buffers, key=lambda t: -model.tensors[t].bytes)
+    offsets, peak = {}, 0
+    for n, t in enumerate(order):
+        size = model.tensors[t].bytes
+        offset = 0
+        moved = True
+        while moved:
+            moved = False
+            for p in order[:n]:
+                if not (first[t] <= last[p] and first[p] <= last[t]):
+                    continue
+                psize = model.tensors[p].bytes
+                if offset < offsets[p] + psize and offsets[p] < offset + size:
+                    offset = align(offsets[p] + psize)
+                    moved = True
+        offsets[t] = offset
+        peak = max(peak, offset + size)
+    return offsets, align(peak)
@@ -0,0 +1,216 @@
+#!/usr/bin/env python3
+"""
+SPRINT 3 - Empacotamento de Pesos em Blocos de Canais (I8PK)
+============================================================
+
+Reordena uma única vez os pesos de FullyConnected ([saídas, entradas])
+em blocos de PACK_BLOCK canais de saída:
+
+    [ceil(O / PACK_BLOCK)][R][PACK_BLOCK]    (R = pesos por canal)
+
+Canais que faltam para completar o último bloco são preenchidos com
+zero. Conv2D (OHWI) não ganha cópia em blocos: no firmware elas rodam
+no backend vetorial (kernel_backend.h), no kernel da 1ª camada ou por
+Winograd, que leem os pesos OHWI do .tflite, e os blocos seriam peso
+morto na flash. Cada Conv2D/FullyConnected ganha a seção com a tabela
+de requantização por canal (multiplicador Q31 + shift), calculada aqui
+a partir das escalas float exatamente como Int8Engine::computeRequant,
+para que o firmware não refaça a conta no boot.
+
+FullyConnected grandes (>= INT4_MIN_WEIGHTS pesos, a Dense 6400 -> 64)
+levam os pesos em 4 bits no lugar da seção int8 em blocos: cada canal é
+requantizado de int8 para [-7, 7] com escala própria (max|w| / 7), dois
+pesos por byte na mesma ordem em blocos, seguidos do bias e da
+requantização já reescalados. O motor a usa com
+Int8Engine::setInt4Dense(true), e a leitura de pesos da camada cai pela
+metade; sem ela, a camada lê os pesos OHWI do próprio .tflite. Com
+int4=False (--no-int4) a camada volta a ter a seção int8 em blocos, que
+alimenta o GEMV em pedaços (dense_gemv.h). FullyConnected menores que
+OC_BLOCKED_MIN_WEIGHTS (o classificador 64 -> 2) ficam OHWI: cabem no
+cache e o backend vetorial é mais rápido que o kernel em blocos.
+
+Em modelos podados em blocos (export_tflite.py --block-sparsity), a
+camada (Conv2D ou FullyConnected) cujas faixas de SPARSE_SPAN pesos de
+um bloco de canais forem ao menos SPARSE_MIN_ZERO_FRACTION nulas ganha
+a seção LAYOUT_BLOCK_SPARSE: índice das faixas não nulas e só os valores
+delas (firmware/lib/int8_engine/block_sparse.h). O blob resultante segue o formato lido por
+firmware/lib/int8_engine/packed_weights.h e é emitido por
+convert_to_c_array.py como g_model_packed[].
+
+Autor: Equipe SPRINT 3
+Data: 2025
+"""
+
+import math
+import struct
+
+import tflite_reader as tfr
+
+PACKED_MAGIC = b"I8PK"
+PACKED_VERSION = 1
+PACKED_ALIGNMENT = 16
+PACK_BLOCK = 4  # Deve coincidir com kPackBlock (int8_kernels.h)
+
+LAYOUT_OC_BLOCKED = 1
+LAYOUT_REQUANT = 2          # int32 multiplicador[O] + int32 shift[O]
+LAYOUT_INT4 = 3             # nibbles em blocos + int32 bias[O], multiplicador[O], shift[O]
+LAYOUT_BLOCK_SPARSE = 4     # uint32 início[blocos+1] + uint16 faixas[nnz] + int8 valores
+
+INT4_MIN_WEIGHTS = 65536    # Só compensa na camada densa grande
+OC_BLOCKED_MIN_WEIGHTS = INT4_MIN_WEIGHTS  # Idem para a seção int8 em blocos
+INT4_MAX = 7                # Faixa simétrica [-7, 7]
+
+SPARSE_SPAN = 16            # Deve coincidir com kSparseSpan (block_sparse.h)
+SPARSE_MAX_CONV_SPANS = 256 # kSparseMaxConvSpans
+SPARSE_MIN_ZERO_FRACTION = 0.25
+
+HEADER_FORMAT = "<4sHHII"   # magic, versão, entradas, tamanho total, tamanho do modelo
+ENTRY_FORMAT = "<HBBIII"    # tensor, layout, bloco, offset, tamanho, linhas
+
+
+def _align(value):
+    return (value + PACKED_ALIGNMENT - 1) & ~(PACKED_ALIGNMENT - 1)
+
+
+def pack_oc_blocked(data, rows, block=PACK_BLOCK):
+    """Reordena [rows][R] (int8) em [ceil(rows/block)][R][block]."""
+    per_row = len(data) // rows
+    blocks = (rows + block - 1) // block
+    out = bytearray(blocks * block * per_row)
+    for b in range(blocks):
+        base = b * block * per_row
+        for j in range(block):
+            oc = b * block + j
+            if oc >= rows:
+                continue
+            src = data[oc * per_row:(oc + 1) * per_row]
+            out[base + j:base + block * per_row:block] = src
+    return bytes(out)
+
+
+def pack_requant(layer):
+    """Tabela de requantização da camada: multiplicadores e depois shifts (int32)."""
+    n = len(layer.multipliers)
+    return struct.pack(f"<{n}i{n}i", *layer.multipliers, *layer.shifts)
+
+
+def _round_half_away(x):
+    return int(math.floor(abs(x) + 0.5)) * (1 if x >= 0 else -1)
+
+
+def quantize_int4(model, layer):
+    """Pesos int8 [O][R] -> (int4 [O][R], bias int32, multiplicadores, shifts)."""
+    w = model.tensors[layer.weights]
+    tin = model.tensors[layer.input]
+    tout = model.tensors[layer.output]
+    rows = layer.shape["out_c"]
+    per_row = len(w.data) // rows
+    raw = struct.unpack(f"<{len(w.data)}b", w.data)
+    bias = [0] * rows
+    if layer.bias >= 0:
+        bias = list(struct.unpack(f"<{rows}i", model.tensors[layer.bias].data))
+    values, new_bias, multipliers, shifts = [], [], [], []
+    for c in range(rows):
+        row = raw[c * per_row:(c + 1) * per_row]
+        ratio = max(abs(v) for v in row) / INT4_MAX or 1.0
+        values += [max(-INT4_MAX, min(INT4_MAX, _round_half_away(v / ratio))) for v in row]
+        new_bias.append(_round_half_away(bias[c] / ratio))
+        w_scale = w.scales[0 if len(w.scales) == 1 else c] * ratio
+        m, sh = tfr.quantize_multiplier(tin.scale * w_scale / tout.scale)
+        multipliers.append(m)
+        shifts.append(sh)
+    return values, new_bias, multipliers, shifts
+
+
+def pack_int4(model, layer, block=PACK_BLOCK):
+    """Seção LAYOUT_INT4: nibbles [ceil(O/block)][R][block] (par = nibble baixo), bias, requant."""
+    values, bias, multipliers, shifts = quantize_int4(model, layer)
+    rows = layer.shape["out_c"]
+    blocked = pack_oc_blocked(struct.pack(f"<{len(values)}b", *values), rows, block)
+    nibbles = bytearray(len(blocked) // 2)
+    for i in range(len(nibbles)):
+        lo, hi = blocked[2 * i], blocked[2 * i + 1]
+        nibbles[i] = (lo & 0x0F) | ((hi & 0x0F) << 4)
+    nibbles += b"\0" * (-len(nibbles) % 4)
+    return bytes(nibbles) + struct.pack(f"<{rows}i{rows}i{rows}i", *bias, *multipliers, *shifts)
+
+
+def sparse_supported(layer):
+    """Mesma regra de blockSparseSupported: in_c múltiplo da faixa, taps inteiros."""
+    s = layer.shape
+    if s["in_c"] % SPARSE_SPAN != 0:
+        return False
+    if layer.op == "fc":
+        return True
+    return s["k_h"] * s["k_w"] * s["in_c"] // SPARSE_SPAN <= SPARSE_MAX_CONV_SPANS
+
+
+def pack_block_sparse(data, rows, block=PACK_BLOCK, min_zero=SPARSE_MIN_ZERO_FRACTION):
+    """Seção LAYOUT_BLOCK_SPARSE dos pesos [rows][R]; None se poucas faixas forem nulas."""
+    per_row = len(data) // rows
+    blocked = pack_oc_blocked(data, rows, block)
+    span_bytes = SPARSE_SPAN * block
+    spans_per_block = per_row // SPARSE_SPAN
+    blocks = (rows + block - 1) // block
+    starts, spans, values = [0], [], bytearray()
+    for b in range(blocks):
+        base = b * per_row * block
+        for k in range(spans_per_block):
+            chunk = blocked[base + k * span_bytes:base + (k + 1) * span_bytes]
+            if any(chunk):
+                spans.append(k)
+                values += chunk
+        starts.append(len(spans))
+    if len(spans) > (1.0 - min_zero) * blocks * spans_per_block:
+        return None
+    index = struct.pack(f"<{len(starts)}I{len(spans)}H", *starts, *spans)
+    index += b"\0" * (-len(index) % 4)
+    return index + bytes(values)
+
+
+def build_packed_blob(model, requant=True, int4=True):
+    """Blob I8PK: requantização de Conv2D/FullyConnected, pesos da FullyConnected grande."""
+    layers = tfr.resolve_layers(model, fuse=False)
+    sections = []
+    tables = []
+    seen = set()
+    for layer in layers:
+        if layer.weights < 0 or layer.weights in seen:
+            continue
+        seen.add(layer.weights)
+        rows = layer.shape["out_c"]
+        if requant and layer.multipliers:
+            tables.append((layer.weights, LAYOUT_REQUANT, 1, rows, pack_requant(layer)))
+        w = model.tensors[layer.weights]
+        if w.type != tfr.TYPE_INT8 or not w.data:
+            continue
+        if int4 and layer.op == "fc" and len(w.data) >= INT4_MIN_WEIGHTS:
+            # Só a cópia int4: os pesos int8 já estão no .tflite
+            tables.append((layer.weights, LAYOUT_INT4, PACK_BLOCK, rows,
+                           pack_int4(model, layer)))
+            continue
+        sparse = pack_block_sparse(w.data, rows) if sparse_supported(layer) else None
+        if sparse is not None:
+            sections.append((layer.weights, LAYOUT_BLOCK_SPARSE, PACK_BLOCK, rows, sparse))
+        elif layer.op == "fc" and len(w.data) >= OC_BLOCKED_MIN_WEIGHTS:
+            sections.append((layer.weights, LAYOUT_OC_BLOCKED, PACK_BLOCK, rows,
+                             pack_oc_blocked(w.data, rows)))
+    # Pesos primeiro: tabelas e seções int4 ficam no fim do blob
+    sections += tables
+
+    header_size = struct.calcsize(HEADER_FORMAT)
+    entry_size = struct.calcsize(ENTRY_FORMAT)
+    offset = _align(header_size + entry_size * len(sections))
+    entries = []
+    payload = bytearray()
+    for tensor, layout, block, rows, data in sections:
+        payload += b"\0" * (offset - header_size - entry_size * len(sections) - len(payload))
+        entries.append(struct.pack(ENTRY_FORMAT, tensor, layout, block, offset, len(data), rows))
+        payload += data
+        offset = _align(offset + len(data))
+    total = _align(header_size + entry_size * len(sections) + len(payload))
+    payload += b"\0" * (total - header_size - entry_size * len(sections) - len(payload))
+
+    header = struct.pack(HEADER_FORMAT, PACKED_MAGIC, PACKED_VERSION, len(sections), total,
+                         len(model.data))
+    return header + b"".join(entries) + bytes(payload)